@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsFingerprintCache.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and memory size.
+//----------------------------------------------------------------------------
+
+ts::FingerprintCache::FingerprintCache(size_t max_memory)
+{
+    setMaxMemory(max_memory);
+}
+
+void ts::FingerprintCache::setMaxMemory(size_t max_memory)
+{
+    // Largest power of two number of sets which fits in the maximum memory size.
+    const size_t max_sets = max_memory / (SET_SIZE * sizeof(Slot));
+    _set_count = 1;
+    while (_set_count <= max_sets / 2) {
+        _set_count *= 2;
+    }
+    clear();
+}
+
+void ts::FingerprintCache::clear()
+{
+    std::vector<Slot>().swap(_slots);
+    _size = 0;
+    _clock = 0;
+    _evictions = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Index of the first slot of the set for a fingerprint.
+//----------------------------------------------------------------------------
+
+size_t ts::FingerprintCache::setIndex(uint64_t fingerprint) const
+{
+    // The fingerprint is supposed to be already well distributed but the caller may use
+    // simple values (identifiers, counters). Mix the bits before selecting the set.
+    fingerprint ^= fingerprint >> 30;
+    fingerprint *= 0xBF58476D1CE4E5B9;
+    fingerprint ^= fingerprint >> 27;
+    fingerprint *= 0x94D049BB133111EB;
+    fingerprint ^= fingerprint >> 31;
+    return size_t(fingerprint & (_set_count - 1)) * SET_SIZE;
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a fingerprint is present in the set.
+//----------------------------------------------------------------------------
+
+bool ts::FingerprintCache::contains(uint64_t fingerprint) const
+{
+    if (!_slots.empty()) {
+        const Slot* set = &_slots[setIndex(fingerprint)];
+        for (size_t i = 0; i < SET_SIZE; ++i) {
+            if (set[i].last_use != 0 && set[i].fingerprint == fingerprint) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a fingerprint in the set.
+//----------------------------------------------------------------------------
+
+bool ts::FingerprintCache::insert(uint64_t fingerprint)
+{
+    if (_slots.empty()) {
+        _slots.resize(capacity());
+    }
+
+    // Look for the fingerprint and for the least recently used slot in the set.
+    // A free slot has a zero use stamp and is always the least recently used one.
+    Slot* set = &_slots[setIndex(fingerprint)];
+    Slot* lru = set;
+    for (size_t i = 0; i < SET_SIZE; ++i) {
+        if (set[i].last_use != 0 && set[i].fingerprint == fingerprint) {
+            set[i].last_use = ++_clock;
+            return false;
+        }
+        if (set[i].last_use < lru->last_use) {
+            lru = &set[i];
+        }
+    }
+
+    // Not found, replace the least recently used slot.
+    if (lru->last_use == 0) {
+        _size++;
+    }
+    else {
+        _evictions++;
+    }
+    lru->fingerprint = fingerprint;
+    lru->last_use = ++_clock;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Compute a 64-bit fingerprint of a memory area.
+//----------------------------------------------------------------------------
+
+uint64_t ts::FingerprintCache::Fingerprint(const void* data, size_t size)
+{
+    // Mix all 64-bit words, then the remaining bytes, then final avalanche.
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    uint64_t h = size;
+    for (; size >= 8; p += 8, size -= 8) {
+        h ^= GetUInt64LE(p) * 0x87C37B91114253D5;
+        h = std::rotl(h, 31) * 0x4CF5AD432745937F + 0x52DCE729;
+    }
+    if (size > 0) {
+        uint64_t last = 0;
+        for (size_t i = 0; i < size; ++i) {
+            last |= uint64_t(p[i]) << (8 * i);
+        }
+        h ^= last * 0x87C37B91114253D5;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53;
+    h ^= h >> 33;
+    return h;
+}
@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Memory-bounded set of 64-bit fingerprints.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Memory-bounded set of 64-bit fingerprints, typically hash values of some data.
+    //! @ingroup libtscore cpp
+    //!
+    //! The fingerprints are stored in a fixed-size open-addressed table which is split in sets
+    //! of SET_SIZE slots. A fingerprint is always stored in the same set, selected from its value.
+    //! When a new fingerprint is inserted in a full set, the least recently used fingerprint of
+    //! that set is evicted. Therefore, the memory usage never exceeds the configured maximum,
+    //! regardless of the number of inserted fingerprints.
+    //!
+    //! Because only fingerprints are stored, two distinct data with the same fingerprint are
+    //! considered identical. With 64-bit fingerprints, the probability of collision is negligible.
+    //!
+    //! The table is allocated on first insertion. This class is not thread-safe.
+    //!
+    class TSCOREDLL FingerprintCache
+    {
+    public:
+        //!
+        //! Number of fingerprints in each set of the table.
+        //!
+        static constexpr size_t SET_SIZE = 8;
+
+        //!
+        //! Default maximum memory size of the table in bytes.
+        //!
+        static constexpr size_t DEFAULT_MAX_MEMORY = 16 * 1024 * 1024;
+
+        //!
+        //! Constructor.
+        //! @param [in] max_memory Maximum memory size of the table in bytes.
+        //! The actual size is rounded down to a power of two number of sets, with at least one set.
+        //!
+        FingerprintCache(size_t max_memory = DEFAULT_MAX_MEMORY);
+
+        //!
+        //! Change the maximum memory size of the table.
+        //! All fingerprints are removed and the eviction counter is reset.
+        //! @param [in] max_memory Maximum memory size of the table in bytes.
+        //!
+        void setMaxMemory(size_t max_memory);
+
+        //!
+        //! Remove all fingerprints and reset the eviction counter.
+        //! The memory of the table is freed.
+        //!
+        void clear();
+
+        //!
+        //! Insert a fingerprint in the set.
+        //! If the fingerprint is already present, it becomes the most recently used one.
+        //! @param [in] fingerprint The fingerprint to insert.
+        //! @return True if the fingerprint was inserted, false if it was already present.
+        //!
+        bool insert(uint64_t fingerprint);
+
+        //!
+        //! Check if a fingerprint is present in the set.
+        //! The least recently used order is unchanged.
+        //! @param [in] fingerprint The fingerprint to search.
+        //! @return True if the fingerprint is present.
+        //!
+        bool contains(uint64_t fingerprint) const;
+
+        //!
+        //! Get the number of fingerprints in the set.
+        //! @return The number of fingerprints in the set.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Get the maximum number of fingerprints in the set.
+        //! @return The maximum number of fingerprints in the set.
+        //!
+        size_t capacity() const { return _set_count * SET_SIZE; }
+
+        //!
+        //! Get the memory size of the table in bytes, once allocated.
+        //! @return The memory size of the table in bytes.
+        //!
+        size_t memorySize() const { return capacity() * sizeof(Slot); }
+
+        //!
+        //! Get the number of fingerprints which were evicted to make room for new ones.
+        //! @return The number of evicted fingerprints since the last clear().
+        //!
+        uint64_t evictions() const { return _evictions; }
+
+        //!
+        //! Compute a 64-bit fingerprint of a memory area.
+        //! This is a fast non-cryptographic hash.
+        //! @param [in] data Address of the memory area.
+        //! @param [in] size Size in bytes of the memory area.
+        //! @return The 64-bit fingerprint of the memory area.
+        //!
+        static uint64_t Fingerprint(const void* data, size_t size);
+
+    private:
+        // A slot in the table. A zero use stamp means a free slot.
+        struct Slot
+        {
+            uint64_t fingerprint = 0;  // Stored fingerprint.
+            uint64_t last_use = 0;     // Use stamp, greater is more recent.
+        };
+
+        std::vector<Slot> _slots {};       // The table, allocated on first insertion.
+        size_t            _set_count = 1;  // Number of sets, a power of two.
+        size_t            _size = 0;       // Number of used slots.
+        uint64_t          _clock = 0;      // Last use stamp.
+        uint64_t          _evictions = 0;  // Number of evicted fingerprints.
+
+        // Index of the first slot of the set for a fingerprint.
+        size_t setIndex(uint64_t fingerprint) const;
+    };
+}
@@ -18,13 +18,17 @@
 #include "tsCryptoAcceleration.h"
 
 // Check if Arm-64 CRC32 instructions can be used in asm() directives.
+// On Intel x86-64, check if PCLMULQDQ (carry-less multiplication) and SSSE3 can be used.
 #if defined(__ARM_FEATURE_CRC32) && !defined(TS_NO_ARM_CRC32_INSTRUCTIONS)
     #define TS_ARM_CRC32_INSTRUCTIONS 1
+#elif defined(__PCLMUL__) && defined(__SSSE3__) && !defined(TS_NO_PCLMUL_INSTRUCTIONS)
+    #define TS_X86_PCLMUL_INSTRUCTIONS 1
+    #include <immintrin.h>
 #endif
 
 // "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
 extern const bool tsCRC32IsAccelerated =
-#if defined(TS_ARM_CRC32_INSTRUCTIONS)
+#if defined(TS_ARM_CRC32_INSTRUCTIONS) || defined(TS_X86_PCLMUL_INSTRUCTIONS)
     true;
 #else
     false;
@@ -45,6 +49,9 @@ uint32_t ts::CRC32::valueAccel() const
     uint32_t x;
     asm("rbit %w0, %w1" : "=r" (x) : "r" (_fcs));
     return x;
+#elif defined(TS_X86_PCLMUL_INSTRUCTIONS)
+    // With PCLMULQDQ, the CRC32 is computed in natural bit order.
+    return _fcs;
 #else
     // Shall not be called.
     assert(false);
@@ -88,6 +95,102 @@ namespace {
 #endif
 
 
+//----------------------------------------------------------------------------
+// Basic operations for the Intel PCLMULQDQ instructions.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_PCLMUL_INSTRUCTIONS)
+namespace {
+
+    // The CRC32 of MPEG-2 is not bit-reflected: the first byte of the data is
+    // the most significant one. Each 16-byte block is loaded with a byte swap
+    // so that the 128-bit register is the polynomial of the block, with the
+    // most significant bit of the first byte as coefficient of x^127.
+    //
+    // The data are "folded" by 128 bits at a time: the accumulator A is split
+    // in two 64-bit halves, A = H.x^64 + L, and A.x^128 = H.x^192 + L.x^128.
+    // Both products are reduced using pre-computed constants (x^192 mod P and
+    // x^128 mod P), using carry-less multiplications. Folding 4 accumulators
+    // in parallel (by 512 bits) hides the latency of PCLMULQDQ.
+
+    // The CRC32 polynomial (without x^32).
+    constexpr uint32_t CRC_POLY = 0x04C11DB7;
+
+    // Compute x^n mod P at compile time.
+    constexpr uint64_t XPowMod(size_t n)
+    {
+        uint32_t r = 1;
+        while (n-- > 0) {
+            r = (r & 0x80000000) != 0 ? (r << 1) ^ CRC_POLY : r << 1;
+        }
+        return r;
+    }
+
+    // Compute floor(x^64 / P) at compile time, for the final Barrett reduction.
+    constexpr uint64_t BarrettMu()
+    {
+        // First step of the polynomial division: x^64 - x^32.P, without its x^64 term.
+        const uint64_t p = 0x100000000ULL | CRC_POLY;
+        uint64_t r = uint64_t(CRC_POLY) << 32;
+        uint64_t q = uint64_t(1) << 32;
+        for (int i = 63; i >= 32; --i) {
+            if (((r >> i) & 1) != 0) {
+                q |= uint64_t(1) << (i - 32);
+                r ^= p << (i - 32);
+            }
+        }
+        return q;
+    }
+
+    // Folding and reduction constants.
+    constexpr uint64_t CRC_X64 = XPowMod(64);
+    constexpr uint64_t CRC_X96 = XPowMod(96);
+    constexpr uint64_t CRC_X128 = XPowMod(128);
+    constexpr uint64_t CRC_X192 = XPowMod(192);
+    constexpr uint64_t CRC_X512 = XPowMod(512);
+    constexpr uint64_t CRC_X576 = XPowMod(576);
+    constexpr uint64_t CRC_MU = BarrettMu();
+    static_assert(CRC_MU == 0x104D101DF);
+
+    // Load 16 bytes of data as a polynomial (reverse byte order).
+    inline __m128i load128(const uint8_t* p)
+    {
+        const __m128i swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), swap);
+    }
+
+    // Fold an accumulator: return acc.x^N + data, where k contains x^(N+64) mod P (high) and x^N mod P (low).
+    inline __m128i fold128(__m128i acc, __m128i k, __m128i data)
+    {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x11), _mm_clmulepi64_si128(acc, k, 0x00)), data);
+    }
+
+    // Carry-less multiplication of two 64-bit values, returning the low 64 bits.
+    inline uint64_t clmul64(uint64_t a, uint64_t b)
+    {
+        return uint64_t(_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi64_si128(int64_t(a)), _mm_cvtsi64_si128(int64_t(b)), 0x00)));
+    }
+
+    // Reduce a 128-bit accumulator A into a 32-bit CRC: return A.x^32 mod P.
+    inline uint32_t reduce128(__m128i acc)
+    {
+        // A.x^32 = H.x^96 + L.x^32, with H.x^96 reduced to 95 bits.
+        const __m128i k96 = _mm_cvtsi64_si128(int64_t(CRC_X96));
+        const __m128i t = _mm_xor_si128(_mm_clmulepi64_si128(acc, k96, 0x01), _mm_slli_si128(_mm_unpacklo_epi64(acc, _mm_setzero_si128()), 4));
+
+        // T is 96 bits, reduce its upper 32 bits: Z = T[95:64].(x^64 mod P) + T[63:0].
+        const uint64_t tlo = uint64_t(_mm_cvtsi128_si64(t));
+        const uint64_t thi = uint64_t(_mm_cvtsi128_si64(_mm_unpackhi_epi64(t, t)));
+        const uint64_t z = clmul64(thi, CRC_X64) ^ tlo;
+
+        // Barrett reduction of a 64-bit value Z: q = floor(Z/P) = floor(Z[63:32].mu / x^32).
+        const uint64_t q = clmul64(z >> 32, CRC_MU) >> 32;
+        return uint32_t(z ^ clmul64(q, 0x100000000ULL | CRC_POLY));
+    }
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Continue the computation of a data area, following a previous CRC32.
 //----------------------------------------------------------------------------
@@ -133,6 +236,53 @@ void ts::CRC32::addAccel(const void* data, size_t size)
     while (size--) {
         crcAdd8(_fcs, *cp8++);
     }
+#elif defined(TS_X86_PCLMUL_INSTRUCTIONS)
+    // Small areas are more efficiently processed by the portable implementation.
+    if (size < 16) {
+        addPortable(data, size);
+        return;
+    }
+
+    // The current CRC is added to the first 32 bits of the data.
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    __m128i acc = _mm_xor_si128(load128(cp), _mm_set_epi32(int(_fcs), 0, 0, 0));
+    cp += 16;
+    size -= 16;
+
+    // Fold by 4 x 128 bits when there are enough data.
+    if (size >= 112) {
+        const __m128i k512 = _mm_set_epi64x(int64_t(CRC_X576), int64_t(CRC_X512));
+        __m128i acc1 = load128(cp);
+        __m128i acc2 = load128(cp + 16);
+        __m128i acc3 = load128(cp + 32);
+        cp += 48;
+        size -= 48;
+        while (size >= 64) {
+            acc = fold128(acc, k512, load128(cp));
+            acc1 = fold128(acc1, k512, load128(cp + 16));
+            acc2 = fold128(acc2, k512, load128(cp + 32));
+            acc3 = fold128(acc3, k512, load128(cp + 48));
+            cp += 64;
+            size -= 64;
+        }
+        // Combine the 4 accumulators into one.
+        const __m128i k128 = _mm_set_epi64x(int64_t(CRC_X192), int64_t(CRC_X128));
+        acc = fold128(acc, k128, acc1);
+        acc = fold128(acc, k128, acc2);
+        acc = fold128(acc, k128, acc3);
+    }
+
+    // Fold by 128 bits.
+    const __m128i k128 = _mm_set_epi64x(int64_t(CRC_X192), int64_t(CRC_X128));
+    while (size >= 16) {
+        acc = fold128(acc, k128, load128(cp));
+        cp += 16;
+        size -= 16;
+    }
+
+    // Reduce to 32 bits, then add remaining bytes.
+    _fcs = reduce128(acc);
+    addPortable(cp, size);
 #else
     // Shall not be called.
     assert(false);
@@ -320,6 +320,22 @@ namespace ts {
         //!
         void canProcessInPlace(bool can_do) { _can_process_in_place = can_do; }
 
+        //!
+        //! Check if encryption is allowed and count one encryption with the current key.
+        //! This is automatically done by encrypt(). Subclasses which provide other
+        //! forms of encryption shall call this method for each encrypted data block.
+        //! @return True if encryption is allowed, false otherwise.
+        //!
+        bool allowEncrypt();
+
+        //!
+        //! Check if decryption is allowed and count one decryption with the current key.
+        //! This is automatically done by decrypt(). Subclasses which provide other
+        //! forms of decryption shall call this method for each decrypted data block.
+        //! @return True if decryption is allowed, false otherwise.
+        //!
+        bool allowDecrypt();
+
 #if defined(TS_WINDOWS) || defined(DOXYGEN)
         //!
         //! Get the algorithm handle and subobject size, when the subclass uses Microsoft BCrypt library.
@@ -353,10 +369,6 @@ namespace ts {
         ByteBlock _current_iv {};                     // Current initialization vector.
         BlockCipherAlertInterface* _alert = nullptr;  // Alert handler.
 
-        // Check if encryption or decryption is allowed. Increment counters when allowed.
-        bool allowEncrypt();
-        bool allowDecrypt();
-
         // System-specific cryptographic library.
 #if defined(TS_WINDOWS)
         ::BCRYPT_ALG_HANDLE _algo = nullptr;
@@ -69,6 +69,22 @@ namespace ts {
         //!
         void reset() { _fcs = 0xFFFFFFFF; }
 
+        //!
+        //! Check if accelerated instructions are used to compute CRC32 values.
+        //! @return True if accelerated instructions are used.
+        //!
+        static bool IsAccelerated();
+
+        //!
+        //! Enable or disable the usage of accelerated instructions to compute CRC32 values.
+        //! By default, accelerated instructions are used when supported by the CPU.
+        //! This is typically used to test or benchmark the portable implementation.
+        //! This shall not be called while CRC32 values are being computed.
+        //! @param [in] on If true, use accelerated instructions when supported by the CPU.
+        //! If false, always use the portable implementation.
+        //!
+        static void EnableAcceleration(bool on);
+
         //!
         //! What to do with a CRC32.
         //! Used when building MPEG sections.
@@ -86,6 +102,9 @@ namespace ts {
         static volatile bool _accel_checked;
         static volatile bool _accel_supported;
 
+        // Portable version, slicing-by-8.
+        void addPortable(const void* data, size_t size);
+
         // Accelerated versions, compiled in a separated module.
         uint32_t valueAccel() const;
         void addAccel(const void* data, size_t size);
@@ -0,0 +1,186 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsjsonTextWriter.h"
+
+
+//----------------------------------------------------------------------------
+// Clear the text, keep the allocated buffer for reuse.
+//----------------------------------------------------------------------------
+
+void ts::json::TextWriter::clear()
+{
+    _text.clear();
+    _first.clear();
+    _after_key = false;
+}
+
+
+//----------------------------------------------------------------------------
+// Insert the separator before a new element.
+// The layout is the same as json::Value::oneLiner(): "{ "a": 1, "b": [ 2, 3 ] }"
+//----------------------------------------------------------------------------
+
+void ts::json::TextWriter::separator()
+{
+    if (_after_key) {
+        // Value of a field, directly after "name": "
+        _after_key = false;
+    }
+    else if (!_first.empty()) {
+        if (_first.back() == 0) {
+            _text.push_back(',');
+        }
+        _first.back() = 0;
+        _text.push_back(' ');
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Objects and arrays.
+//----------------------------------------------------------------------------
+
+void ts::json::TextWriter::beginObject()
+{
+    separator();
+    _text.push_back('{');
+    _first.push_back(1);
+}
+
+void ts::json::TextWriter::endObject()
+{
+    if (!_first.empty()) {
+        _first.pop_back();
+    }
+    _text.append(" }");
+}
+
+void ts::json::TextWriter::beginArray()
+{
+    separator();
+    _text.push_back('[');
+    _first.push_back(1);
+}
+
+void ts::json::TextWriter::endArray()
+{
+    if (!_first.empty()) {
+        _first.pop_back();
+    }
+    _text.append(" ]");
+}
+
+void ts::json::TextWriter::key(const UString& name)
+{
+    separator();
+    _text.push_back('"');
+    appendEscaped(name);
+    _text.append("\": ");
+    _after_key = true;
+}
+
+void ts::json::TextWriter::key(const UChar* name)
+{
+    separator();
+    _text.push_back('"');
+    appendEscaped(name == nullptr ? std::u16string_view() : std::u16string_view(name));
+    _text.append("\": ");
+    _after_key = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Simple values.
+//----------------------------------------------------------------------------
+
+void ts::json::TextWriter::stringValue(const UString& value)
+{
+    separator();
+    _text.push_back('"');
+    appendEscaped(value);
+    _text.push_back('"');
+}
+
+void ts::json::TextWriter::stringValue(const UChar* value)
+{
+    separator();
+    _text.push_back('"');
+    appendEscaped(value == nullptr ? std::u16string_view() : std::u16string_view(value));
+    _text.push_back('"');
+}
+
+void ts::json::TextWriter::integerValue(int64_t value)
+{
+    separator();
+    // Format digits backward, use unsigned magnitude to handle the most negative value.
+    std::array<char, 24> buf;
+    char* const end = buf.data() + buf.size();
+    char* cur = end;
+    uint64_t mag = value < 0 ? 0 - uint64_t(value) : uint64_t(value);
+    do {
+        *--cur = char('0' + mag % 10);
+        mag /= 10;
+    } while (mag != 0);
+    if (value < 0) {
+        *--cur = '-';
+    }
+    _text.append(cur, end);
+}
+
+void ts::json::TextWriter::boolValue(bool value)
+{
+    separator();
+    _text.append(value ? "true" : "false");
+}
+
+void ts::json::TextWriter::nullValue()
+{
+    separator();
+    _text.append("null");
+}
+
+void ts::json::TextWriter::value(const TextWriter& other)
+{
+    separator();
+    _text.append(other._text);
+}
+
+
+//----------------------------------------------------------------------------
+// Append a string with JSON escape sequences.
+// Same escape sequences as UString::toJSON(), the result is pure ASCII.
+//----------------------------------------------------------------------------
+
+void ts::json::TextWriter::appendEscaped(std::u16string_view str)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    for (const UChar c : str) {
+        switch (c) {
+            case QUOTATION_MARK: _text.append("\\\""); break;
+            case REVERSE_SOLIDUS: _text.append("\\\\"); break;
+            case BACKSPACE: _text.append("\\b"); break;
+            case FORM_FEED: _text.append("\\f"); break;
+            case LINE_FEED: _text.append("\\n"); break;
+            case CARRIAGE_RETURN: _text.append("\\r"); break;
+            case HORIZONTAL_TABULATION: _text.append("\\t"); break;
+            default:
+                if (c >= 0x0020 && c <= 0x007E) {
+                    _text.push_back(char(c));
+                }
+                else {
+                    _text.append("\\u");
+                    _text.push_back(hex[(c >> 12) & 0x0F]);
+                    _text.push_back(hex[(c >> 8) & 0x0F]);
+                    _text.push_back(hex[(c >> 4) & 0x0F]);
+                    _text.push_back(hex[c & 0x0F]);
+                }
+                break;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Direct serialization of one-line JSON text.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+
+namespace ts::json {
+    //!
+    //! Direct serialization of one-line JSON text into a UTF-8 buffer.
+    //! @ingroup libtscore json
+    //!
+    //! This class builds the JSON text of a value, piece by piece, without building
+    //! a tree of ts::json::Value objects. The produced text is identical to the result
+    //! of ts::json::Value::oneLiner() on the equivalent tree of values.
+    //!
+    //! The buffer is reused when clear() is called. Once its capacity has grown to the
+    //! size of the largest JSON text, serializing a value does not allocate memory.
+    //!
+    //! The caller is responsible for the consistency of the sequence of calls: each
+    //! beginObject() or beginArray() shall be closed by endObject() or endArray() and
+    //! each value in an object shall be preceded by key().
+    //!
+    class TSCOREDLL TextWriter
+    {
+        TS_NOCOPY(TextWriter);
+    public:
+        //!
+        //! Default constructor.
+        //!
+        TextWriter() = default;
+
+        //!
+        //! Clear the text, keep the allocated buffer for reuse.
+        //!
+        void clear();
+
+        //!
+        //! Get the serialized JSON text.
+        //! @return A constant reference to the serialized JSON text, in UTF-8.
+        //! Since all non-ASCII characters are escaped, this is also an ASCII string.
+        //!
+        const std::string& text() const { return _text; }
+
+        //!
+        //! Get the serialized JSON text as a UString.
+        //! @return The serialized JSON text.
+        //!
+        UString toString() const { return UString::FromUTF8(_text); }
+
+        //!
+        //! Start a JSON object.
+        //!
+        void beginObject();
+
+        //!
+        //! End the current JSON object.
+        //!
+        void endObject();
+
+        //!
+        //! Start a JSON array.
+        //!
+        void beginArray();
+
+        //!
+        //! End the current JSON array.
+        //!
+        void endArray();
+
+        //!
+        //! Start a field in the current JSON object.
+        //! The next value, object or array is the value of the field.
+        //! @param [in] name Field name.
+        //!
+        void key(const UString& name);
+
+        //!
+        //! Start a field in the current JSON object.
+        //! The next value, object or array is the value of the field.
+        //! @param [in] name Field name, a nul-terminated string, without intermediate UString.
+        //!
+        void key(const UChar* name);
+
+        //!
+        //! Add a JSON string value.
+        //! @param [in] value String value.
+        //!
+        void stringValue(const UString& value);
+
+        //!
+        //! Add a JSON string value.
+        //! @param [in] value String value, a nul-terminated string, without intermediate UString.
+        //!
+        void stringValue(const UChar* value);
+
+        //!
+        //! Add a JSON number value.
+        //! @param [in] value Integer value.
+        //!
+        void integerValue(int64_t value);
+
+        //!
+        //! Add a JSON true or false value.
+        //! @param [in] value Boolean value.
+        //!
+        void boolValue(bool value);
+
+        //!
+        //! Add a JSON null value.
+        //!
+        void nullValue();
+
+        //!
+        //! Add a complete JSON value which was serialized in another writer.
+        //! @param [in] other Another writer containing one complete JSON value, object or array.
+        //!
+        void value(const TextWriter& other);
+
+    private:
+        std::string          _text {};
+        std::vector<uint8_t> _first {};         // Stack of objects and arrays: true until the first element.
+        bool                 _after_key = false; // A key was written, the value follows without separator.
+
+        // Insert the separator before a new element in the current object or array.
+        void separator();
+
+        // Append a string with JSON escape sequences.
+        void appendEscaped(std::u16string_view str);
+    };
+}
@@ -0,0 +1,814 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTCPFanOutServer.h"
+#include "tsSysUtils.h"
+#include "tsMemory.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/epoll.h>
+    #include "tsAfterStandardHeaders.h"
+#elif defined(TS_UNIX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <poll.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Socket utilities.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Flags for send(), avoid SIGPIPE when the system supports it.
+#if defined(MSG_NOSIGNAL)
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    constexpr int SEND_FLAGS = 0;
+#endif
+
+    // Set a socket in non-blocking mode.
+    bool SetNonBlocking(ts::SysSocketType sock)
+    {
+#if defined(TS_WINDOWS)
+        ::u_long mode = 1;
+        return ::ioctlsocket(sock, FIONBIO, &mode) == 0;
+#else
+        const int flags = ::fcntl(sock, F_GETFL, 0);
+        return flags >= 0 && ::fcntl(sock, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    }
+
+    // Check if an error code means that a non-blocking operation would block.
+    bool WouldBlock(int code)
+    {
+#if defined(TS_WINDOWS)
+        return code == WSAEWOULDBLOCK;
+#else
+        return code == EAGAIN || code == EWOULDBLOCK;
+#endif
+    }
+
+    // Check if an error code means that a system call was interrupted.
+    bool Interrupted(int code)
+    {
+#if defined(TS_WINDOWS)
+        return code == WSAEINTR;
+#else
+        return code == EINTR;
+#endif
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Poller of socket events: epoll on Linux, poll() on other systems.
+//----------------------------------------------------------------------------
+
+class ts::TCPFanOutServer::Poller
+{
+    TS_NOCOPY(Poller);
+public:
+    // Description of an event on a socket.
+    class Event
+    {
+    public:
+        uint64_t id = 0;
+        bool     read = false;
+        bool     write = false;
+        bool     error = false;
+    };
+
+    // Constructor and destructor.
+    Poller() = default;
+    ~Poller();
+
+    // Open the poller, including the wake-up mechanism.
+    bool open(Report& report);
+
+    // Add, modify, remove a socket. Sockets are always polled for input.
+    bool add(SysSocketType sock, uint64_t id, bool write, Report& report);
+    bool modify(SysSocketType sock, uint64_t id, bool write, Report& report);
+    void remove(SysSocketType sock);
+
+    // Wait for events.
+    bool wait(std::vector<Event>& events, Report& report);
+
+    // Wake up a thread which waits for events (can be called from any thread) and reset the wake-up condition.
+    void wakeUp();
+    void drain();
+
+private:
+#if defined(TS_LINUX)
+    int _epoll = -1;
+#else
+    #if defined(TS_WINDOWS)
+    using PollFd = ::WSAPOLLFD;
+    #else
+    using PollFd = ::pollfd;
+    #endif
+    std::vector<PollFd>   _fds {};
+    std::vector<uint64_t> _ids {};
+    size_t indexOf(SysSocketType sock) const;
+#endif
+#if defined(TS_UNIX)
+    // Wake-up pipe. On Windows, there is no pipe which can be polled with sockets, use a short timeout.
+    int _pipe[2] {-1, -1};
+#endif
+};
+
+ts::TCPFanOutServer::Poller::~Poller()
+{
+#if defined(TS_LINUX)
+    if (_epoll >= 0) {
+        ::close(_epoll);
+    }
+#endif
+#if defined(TS_UNIX)
+    for (int fd : _pipe) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+}
+
+bool ts::TCPFanOutServer::Poller::open(Report& report)
+{
+#if defined(TS_LINUX)
+    if ((_epoll = ::epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        report.error(u"error creating epoll: %s", SysErrorCodeMessage());
+        return false;
+    }
+#endif
+#if defined(TS_UNIX)
+    if (::pipe(_pipe) < 0) {
+        report.error(u"error creating pipe: %s", SysErrorCodeMessage());
+        return false;
+    }
+    ::fcntl(_pipe[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(_pipe[1], F_SETFD, FD_CLOEXEC);
+    if (!SetNonBlocking(_pipe[0]) || !SetNonBlocking(_pipe[1])) {
+        report.error(u"error setting pipe in non-blocking mode: %s", SysErrorCodeMessage());
+        return false;
+    }
+    return add(_pipe[0], WAKE_ID, false, report);
+#else
+    return true;
+#endif
+}
+
+void ts::TCPFanOutServer::Poller::wakeUp()
+{
+#if defined(TS_UNIX)
+    const char c = 0;
+    [[maybe_unused]] const ssize_t ret = ::write(_pipe[1], &c, 1);
+#endif
+}
+
+void ts::TCPFanOutServer::Poller::drain()
+{
+#if defined(TS_UNIX)
+    char buffer[64];
+    while (::read(_pipe[0], buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+}
+
+#if defined(TS_LINUX)
+
+bool ts::TCPFanOutServer::Poller::add(SysSocketType sock, uint64_t id, bool write, Report& report)
+{
+    ::epoll_event ev;
+    TS_ZERO(ev);
+    ev.events = write ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    ev.data.u64 = id;
+    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, sock, &ev) < 0) {
+        report.error(u"epoll_ctl error: %s", SysErrorCodeMessage());
+        return false;
+    }
+    return true;
+}
+
+bool ts::TCPFanOutServer::Poller::modify(SysSocketType sock, uint64_t id, bool write, Report& report)
+{
+    ::epoll_event ev;
+    TS_ZERO(ev);
+    ev.events = write ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    ev.data.u64 = id;
+    if (::epoll_ctl(_epoll, EPOLL_CTL_MOD, sock, &ev) < 0) {
+        report.error(u"epoll_ctl error: %s", SysErrorCodeMessage());
+        return false;
+    }
+    return true;
+}
+
+void ts::TCPFanOutServer::Poller::remove(SysSocketType sock)
+{
+    ::epoll_event ev;
+    TS_ZERO(ev);
+    ::epoll_ctl(_epoll, EPOLL_CTL_DEL, sock, &ev);
+}
+
+bool ts::TCPFanOutServer::Poller::wait(std::vector<Event>& events, Report& report)
+{
+    std::array<::epoll_event, 256> sys_events;
+    events.clear();
+    const int count = ::epoll_wait(_epoll, sys_events.data(), int(sys_events.size()), -1);
+    if (count < 0) {
+        const int err = LastSysErrorCode();
+        if (Interrupted(err)) {
+            return true;
+        }
+        report.error(u"epoll_wait error: %s", SysErrorCodeMessage(err));
+        return false;
+    }
+    events.resize(count);
+    for (int i = 0; i < count; ++i) {
+        events[i].id = sys_events[i].data.u64;
+        events[i].read = (sys_events[i].events & EPOLLIN) != 0;
+        events[i].write = (sys_events[i].events & EPOLLOUT) != 0;
+        events[i].error = (sys_events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+    }
+    return true;
+}
+
+#else
+
+size_t ts::TCPFanOutServer::Poller::indexOf(SysSocketType sock) const
+{
+    for (size_t i = 0; i < _fds.size(); ++i) {
+        if (_fds[i].fd == sock) {
+            return i;
+        }
+    }
+    return NPOS;
+}
+
+bool ts::TCPFanOutServer::Poller::add(SysSocketType sock, uint64_t id, bool write, Report&)
+{
+    PollFd pfd;
+    TS_ZERO(pfd);
+    pfd.fd = sock;
+    pfd.events = write ? (POLLIN | POLLOUT) : POLLIN;
+    _fds.push_back(pfd);
+    _ids.push_back(id);
+    return true;
+}
+
+bool ts::TCPFanOutServer::Poller::modify(SysSocketType sock, uint64_t id, bool write, Report& report)
+{
+    const size_t index = indexOf(sock);
+    if (index == NPOS) {
+        report.error(u"socket not found in poll list");
+        return false;
+    }
+    _fds[index].events = write ? (POLLIN | POLLOUT) : POLLIN;
+    _ids[index] = id;
+    return true;
+}
+
+void ts::TCPFanOutServer::Poller::remove(SysSocketType sock)
+{
+    const size_t index = indexOf(sock);
+    if (index != NPOS) {
+        _fds[index] = _fds.back();
+        _ids[index] = _ids.back();
+        _fds.pop_back();
+        _ids.pop_back();
+    }
+}
+
+bool ts::TCPFanOutServer::Poller::wait(std::vector<Event>& events, Report& report)
+{
+    events.clear();
+#if defined(TS_WINDOWS)
+    const int count = ::WSAPoll(_fds.data(), ::ULONG(_fds.size()), 10);
+#else
+    const int count = ::poll(_fds.data(), ::nfds_t(_fds.size()), -1);
+#endif
+    if (count < 0) {
+        const int err = LastSysErrorCode();
+        if (Interrupted(err)) {
+            return true;
+        }
+        report.error(u"poll error: %s", SysErrorCodeMessage(err));
+        return false;
+    }
+    for (size_t i = 0; i < _fds.size() && events.size() < size_t(count); ++i) {
+        if (_fds[i].revents != 0) {
+            Event& ev(events.emplace_back());
+            ev.id = _ids[i];
+            ev.read = (_fds[i].revents & POLLIN) != 0;
+            ev.write = (_fds[i].revents & POLLOUT) != 0;
+            ev.error = (_fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+        }
+    }
+    return true;
+}
+
+#endif
+
+
+//----------------------------------------------------------------------------
+// Description of a client.
+//----------------------------------------------------------------------------
+
+class ts::TCPFanOutServer::Client
+{
+    TS_NOBUILD_NOCOPY(Client);
+public:
+    // Client state.
+    enum State {REQUEST, RESPONSE, STREAM};
+
+    // Constructor.
+    Client(uint64_t id_, SysSocketType sock_, const IPSocketAddress& address_) : id(id_), sock(sock_), address(address_) {}
+
+    // Accessed by the internal thread only.
+    const uint64_t        id;
+    const SysSocketType   sock;
+    const IPSocketAddress address;
+    State                 state = REQUEST;
+    bool                  accepted = false;     // The request was accepted, stream after the response.
+    bool                  want_write = false;   // Currently polling for output.
+    std::string           request {};
+    std::string           response {};
+    size_t                response_sent = 0;
+
+    // Ring buffer of data to send, protected by the mutex of the server.
+    // The application writes in the free part, the internal thread sends from the filled part.
+    ByteBlock ring {};
+    size_t    ring_start = 0;
+    size_t    ring_fill = 0;
+    bool      overflow = false;   // Client too slow, to be disconnected.
+    uint64_t  bytes_sent = 0;
+    uint64_t  bytes_skipped = 0;
+};
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::TCPFanOutServer::TCPFanOutServer() :
+    Thread(ThreadAttributes().setPriority(ThreadAttributes::GetHighPriority()))
+{
+}
+
+ts::TCPFanOutServer::~TCPFanOutServer()
+{
+    stop();
+}
+
+
+//----------------------------------------------------------------------------
+// Start the server.
+//----------------------------------------------------------------------------
+
+bool ts::TCPFanOutServer::start(const Options& options, Report& report)
+{
+    if (_server.isOpen()) {
+        report.error(u"TCP server already started");
+        return false;
+    }
+
+    _options = options;
+    _options.max_clients = std::max<size_t>(1, _options.max_clients);
+    _options.client_buffer_size = std::max<size_t>(1024, _options.client_buffer_size);
+    _report = &report;
+    _terminate = false;
+    _wake_pending = false;
+    _stats = Statistics();
+
+    // Open the server socket in non-blocking mode.
+    // Use an IPv6 socket, accepting IPv4 clients, unless a local IPv4 address is specified.
+    if (!_server.open(_options.server_address.hasAddress() ? _options.server_address.generation() : IP::Any, report)) {
+        return false;
+    }
+    _poller = std::make_unique<Poller>();
+    if (!_server.reusePort(_options.reuse_port, report) ||
+        (_options.send_buffer_size > 0 && !_server.setSendBufferSize(_options.send_buffer_size, report)) ||
+        !_server.bind(_options.server_address, report) ||
+        !_server.listen(int(std::min<size_t>(_options.max_clients, 128)), report) ||
+        !_poller->open(report) ||
+        !_poller->add(_server.getSocket(), LISTEN_ID, false, report))
+    {
+        _poller.reset();
+        _server.close(report);
+        return false;
+    }
+    if (!SetNonBlocking(_server.getSocket())) {
+        report.error(u"error setting server socket in non-blocking mode: %s", SysErrorCodeMessage());
+        _poller.reset();
+        _server.close(report);
+        return false;
+    }
+
+    // Start the event loop.
+    if (!Thread::start()) {
+        report.error(u"error starting TCP server thread");
+        _poller.reset();
+        _server.close(report);
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Stop the server.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::stop()
+{
+    if (_server.isOpen()) {
+        _terminate = true;
+        _poller->wakeUp();
+        waitForTermination();
+        _poller.reset();
+        _server.close(*_report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Default processing of a client request.
+//----------------------------------------------------------------------------
+
+bool ts::TCPFanOutServer::processRequest(const IPSocketAddress&, const std::string&, std::string& response)
+{
+    response.clear();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Send data to all clients.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::send(const void* data, size_t size)
+{
+    const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(data);
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& client : _streams) {
+            const size_t ring_size = client->ring.size();
+            if (client->overflow) {
+                // Already waiting for disconnection.
+                continue;
+            }
+
+            // Queue all data if possible, otherwise the complete data units which fit in the buffer.
+            const size_t free = ring_size - client->ring_fill;
+            const size_t count = size <= free ? size : (_options.data_unit == 0 ? 0 : free - free % _options.data_unit);
+            if (count > 0) {
+                // Copy the data in the free part of the ring buffer, in two parts if it wraps.
+                const size_t index = (client->ring_start + client->ring_fill) % ring_size;
+                const size_t first = std::min(count, ring_size - index);
+                MemCopy(client->ring.data() + index, bytes, first);
+                MemCopy(client->ring.data(), bytes + first, count - first);
+                wake = wake || client->ring_fill == 0;
+                client->ring_fill += count;
+            }
+            if (count < size) {
+                // Client too slow, the buffer is full.
+                if (_options.skip_slow_clients) {
+                    client->bytes_skipped += size - count;
+                    _stats.bytes_skipped += size - count;
+                }
+                else {
+                    client->overflow = true;
+                    wake = true;
+                }
+            }
+        }
+    }
+    if (wake) {
+        wakeUp();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up the internal thread, at most once until it processes the event.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::wakeUp()
+{
+    if (!_wake_pending.exchange(true)) {
+        _poller->wakeUp();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of streaming clients and the statistics.
+//----------------------------------------------------------------------------
+
+size_t ts::TCPFanOutServer::clientCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _streams.size();
+}
+
+ts::TCPFanOutServer::Statistics ts::TCPFanOutServer::statistics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+
+//----------------------------------------------------------------------------
+// Event loop, in the internal thread.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::main()
+{
+    _report->debug(u"TCP server thread started");
+    std::vector<Poller::Event> events;
+
+    while (!_terminate && _poller->wait(events, *_report)) {
+        for (const auto& ev : events) {
+            if (ev.id == LISTEN_ID) {
+                acceptClients();
+            }
+            else if (ev.id == WAKE_ID) {
+                _poller->drain();
+            }
+            else {
+                const auto it = _clients.find(ev.id);
+                if (it != _clients.end()) {
+                    const ClientPtr client(it->second);
+                    if (ev.read) {
+                        receiveFromClient(client);
+                    }
+                    if (ev.error && _clients.contains(client->id)) {
+                        closeClient(client);
+                    }
+                    else if (ev.write && _clients.contains(client->id)) {
+                        sendToClient(client);
+                    }
+                }
+            }
+        }
+
+        // Send new data to all streaming clients which are not already waiting for output.
+        // Also process clients which are too slow, even if they are waiting for output.
+        _wake_pending = false;
+        std::vector<ClientPtr> clients;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& client : _streams) {
+                if (!client->want_write || client->overflow) {
+                    clients.push_back(client);
+                }
+            }
+        }
+        for (const auto& client : clients) {
+            sendToClient(client);
+        }
+    }
+
+    // Disconnect all clients.
+    while (!_clients.empty()) {
+        const ClientPtr client(_clients.begin()->second);
+        closeClient(client);
+    }
+    _report->debug(u"TCP server thread terminated");
+}
+
+
+//----------------------------------------------------------------------------
+// Accept all pending client connections.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::acceptClients()
+{
+    for (;;) {
+        ::sockaddr_storage sock_addr;
+        SysSocketLengthType len = sizeof(sock_addr);
+        TS_ZERO(sock_addr);
+        const SysSocketType sock = ::accept(_server.getSocket(), reinterpret_cast<::sockaddr*>(&sock_addr), &len);
+        if (sock == SYS_SOCKET_INVALID) {
+            const int err = LastSysErrorCode();
+            if (!WouldBlock(err) && !Interrupted(err)) {
+                _report->error(u"error accepting TCP client: %s", SysErrorCodeMessage(err));
+            }
+            return;
+        }
+        const IPSocketAddress address(sock_addr);
+
+        if (_clients.size() >= _options.max_clients) {
+            _report->verbose(u"too many clients, rejecting connection from %s", address);
+            SysCloseSocket(sock);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.rejected_clients++;
+            continue;
+        }
+        if (!SetNonBlocking(sock)) {
+            _report->error(u"error setting client socket in non-blocking mode: %s", SysErrorCodeMessage());
+            SysCloseSocket(sock);
+            continue;
+        }
+        if (_options.send_buffer_size > 0) {
+            const int size = int(_options.send_buffer_size);
+            ::setsockopt(sock, SOL_SOCKET, SO_SNDBUF, SysSockOptPointer(&size), sizeof(size));
+        }
+
+        const ClientPtr client(std::make_shared<Client>(_next_id++, sock, address));
+        if (!_poller->add(sock, client->id, false, *_report)) {
+            SysCloseSocket(sock);
+            continue;
+        }
+        _clients[client->id] = client;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.accepted_clients++;
+        }
+        _report->verbose(u"client connected from %s, %d clients", address, _clients.size());
+
+        if (!_options.wait_request) {
+            startStreaming(client);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Receive data from a client.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::receiveFromClient(const ClientPtr& client)
+{
+    char buffer[1024];
+    const SysSocketSignedSizeType ret = ::recv(client->sock, SysRecvBufferPointer(buffer), int(sizeof(buffer)), 0);
+    if (ret < 0) {
+        const int err = LastSysErrorCode();
+        if (!WouldBlock(err) && !Interrupted(err)) {
+            _report->debug(u"error receiving from client %s: %s", client->address, SysErrorCodeMessage(err));
+            closeClient(client);
+        }
+    }
+    else if (ret == 0) {
+        // End of connection from client.
+        closeClient(client);
+    }
+    else if (client->state == Client::REQUEST) {
+        // Accumulate the request until an empty line.
+        client->request.append(buffer, size_t(ret));
+        size_t end = client->request.find("\r\n\r\n");
+        size_t eol_size = 4;
+        if (end == std::string::npos) {
+            end = client->request.find("\n\n");
+            eol_size = 2;
+        }
+        if (end == std::string::npos && client->request.size() > _options.max_request_size) {
+            _report->error(u"request too large from client %s", client->address);
+            closeClient(client);
+        }
+        else if (end != std::string::npos) {
+            client->request.resize(end + eol_size);
+            client->accepted = processRequest(client->address, client->request, client->response);
+            client->state = Client::RESPONSE;
+            sendToClient(client);
+        }
+    }
+    // In other states, data from the client are ignored.
+}
+
+
+//----------------------------------------------------------------------------
+// Send pending data to a client.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::sendToClient(const ClientPtr& client)
+{
+    bool blocked = false;
+
+    if (client->state == Client::RESPONSE) {
+        // Send the rest of the response.
+        while (client->response_sent < client->response.size()) {
+            const size_t size = client->response.size() - client->response_sent;
+            const SysSocketSignedSizeType ret = ::send(client->sock, SysSendBufferPointer(client->response.data() + client->response_sent), SysSendSizeType(size), SEND_FLAGS);
+            if (ret < 0) {
+                const int err = LastSysErrorCode();
+                if (WouldBlock(err)) {
+                    blocked = true;
+                    break;
+                }
+                else if (!Interrupted(err)) {
+                    _report->debug(u"error sending to client %s: %s", client->address, SysErrorCodeMessage(err));
+                    closeClient(client);
+                    return;
+                }
+            }
+            else {
+                client->response_sent += size_t(ret);
+            }
+        }
+        if (!blocked) {
+            if (client->accepted) {
+                startStreaming(client);
+            }
+            else {
+                closeClient(client);
+            }
+            return;
+        }
+    }
+    else if (client->state == Client::STREAM) {
+        // Send data from the ring buffer, without holding the mutex during send().
+        for (;;) {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (client->overflow) {
+                    _stats.dropped_clients++;
+                }
+                else {
+                    data = client->ring.data() + client->ring_start;
+                    size = std::min(client->ring_fill, client->ring.size() - client->ring_start);
+                }
+            }
+            if (data == nullptr) {
+                // Never log while holding the mutex, the report may be slow.
+                _report->verbose(u"client %s too slow, disconnecting", client->address);
+                closeClient(client);
+                return;
+            }
+            if (size == 0) {
+                break;
+            }
+            const SysSocketSignedSizeType ret = ::send(client->sock, SysSendBufferPointer(data), SysSendSizeType(size), SEND_FLAGS);
+            if (ret < 0) {
+                const int err = LastSysErrorCode();
+                if (WouldBlock(err)) {
+                    blocked = true;
+                    break;
+                }
+                else if (!Interrupted(err)) {
+                    _report->debug(u"error sending to client %s: %s", client->address, SysErrorCodeMessage(err));
+                    closeClient(client);
+                    return;
+                }
+            }
+            else {
+                std::lock_guard<std::mutex> lock(_mutex);
+                client->ring_start = (client->ring_start + size_t(ret)) % client->ring.size();
+                client->ring_fill -= size_t(ret);
+                client->bytes_sent += size_t(ret);
+                _stats.bytes_sent += size_t(ret);
+            }
+        }
+    }
+
+    // Poll for output only when the socket is full.
+    if (blocked != client->want_write && _poller->modify(client->sock, client->id, blocked, *_report)) {
+        client->want_write = blocked;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Start sending data to a client.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::startStreaming(const ClientPtr& client)
+{
+    client->state = Client::STREAM;
+    client->request.clear();
+    client->response.clear();
+    client->ring.resize(_options.client_buffer_size);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _streams.push_back(client);
+}
+
+
+//----------------------------------------------------------------------------
+// Close a client connection.
+//----------------------------------------------------------------------------
+
+void ts::TCPFanOutServer::closeClient(const ClientPtr& client)
+{
+    _poller->remove(client->sock);
+    SysCloseSocket(client->sock);
+    _clients.erase(client->id);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = std::find(_streams.begin(), _streams.end(), client);
+        if (it != _streams.end()) {
+            _streams.erase(it);
+        }
+    }
+    _report->verbose(u"client %s disconnected, %'d bytes sent, %'d bytes skipped, %d clients", client->address, client->bytes_sent, client->bytes_skipped, _clients.size());
+}
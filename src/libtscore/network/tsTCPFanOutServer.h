@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  TCP server which sends the same stream of data to many clients.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTCPServer.h"
+#include "tsThread.h"
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! TCP server which sends the same stream of data to many concurrent clients.
+    //! @ingroup libtscore net
+    //!
+    //! The server runs an event loop in an internal thread, using epoll() on Linux and
+    //! poll() on other systems. All client sockets are non-blocking. Each client has its
+    //! own bounded buffer of data to send.
+    //!
+    //! The application calls send() to push data to all clients. This method never blocks
+    //! on a socket, it only copies the data into the buffers of the clients. When the buffer
+    //! of a slow client is full, the data are either skipped for this client or the client
+    //! is disconnected. The data are queued in units of Options::data_unit bytes. When the
+    //! data unit is the size of a TS packet, a client always receives complete TS packets,
+    //! even if some of them are skipped.
+    //!
+    //! Optionally, a client shall first send a request, terminated by an empty line, as
+    //! in HTTP. The request is processed by processRequest() which builds the response.
+    //! Subclasses override processRequest() to implement a protocol such as HTTP.
+    //!
+    class TSCOREDLL TCPFanOutServer : private Thread
+    {
+        TS_NOCOPY(TCPFanOutServer);
+    public:
+        //!
+        //! Server options.
+        //!
+        class TSCOREDLL Options
+        {
+        public:
+            IPSocketAddress server_address {};         //!< Local address and port to listen to.
+            bool            reuse_port = true;         //!< Set the "reuse port" socket option on the server.
+            size_t          send_buffer_size = 0;      //!< Socket send buffer size of client connections, if not zero.
+            size_t          max_clients = 16;          //!< Maximum number of concurrent clients, additional clients are rejected.
+            size_t          client_buffer_size = 512 * 1024;  //!< Size in bytes of the buffer of each client.
+            //!
+            //! Size in bytes of the data units. When the buffer of a client cannot receive all data
+            //! from send(), the complete units which fit in the buffer are queued and the slow client
+            //! policy applies to the rest of the data only. When zero, the data from each call to
+            //! send() are either completely queued or completely skipped.
+            //!
+            size_t          data_unit = 0;
+            bool            skip_slow_clients = false; //!< Skip data for slow clients instead of disconnecting them.
+            bool            wait_request = false;      //!< Wait for a request from each client before sending data.
+            size_t          max_request_size = 8192;   //!< Maximum size of a client request, when @a wait_request is true.
+        };
+
+        //!
+        //! Server statistics.
+        //!
+        class TSCOREDLL Statistics
+        {
+        public:
+            uint64_t accepted_clients = 0;  //!< Number of accepted client connections.
+            uint64_t rejected_clients = 0;  //!< Number of client connections which were rejected because too many clients were connected.
+            uint64_t dropped_clients = 0;   //!< Number of clients which were disconnected because they were too slow.
+            uint64_t bytes_sent = 0;        //!< Total number of data bytes which were sent to all clients.
+            uint64_t bytes_skipped = 0;     //!< Total number of data bytes which were skipped for slow clients.
+        };
+
+        //!
+        //! Constructor.
+        //!
+        TCPFanOutServer();
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~TCPFanOutServer() override;
+
+        //!
+        //! Start the server.
+        //! @param [in] options Server options.
+        //! @param [in,out] report Where to report errors and client activity.
+        //! The report must be thread-safe and must remain valid until stop().
+        //! @return True on success, false on error.
+        //!
+        bool start(const Options& options, Report& report);
+
+        //!
+        //! Stop the server and disconnect all clients.
+        //!
+        void stop();
+
+        //!
+        //! Check if the server is started.
+        //! @return True if the server is started.
+        //!
+        bool isStarted() const { return _server.isOpen(); }
+
+        //!
+        //! Send data to all connected clients.
+        //! This method never blocks on a socket. Clients which are connected later
+        //! receive data from subsequent calls.
+        //! @param [in] data Address of the data to send.
+        //! @param [in] size Size in bytes of the data to send.
+        //!
+        void send(const void* data, size_t size);
+
+        //!
+        //! Get the number of clients which currently receive data.
+        //! @return The number of clients which currently receive data.
+        //!
+        size_t clientCount() const;
+
+        //!
+        //! Get the server statistics.
+        //! @return Current statistics of the server.
+        //!
+        Statistics statistics() const;
+
+    protected:
+        //!
+        //! Process the request of a client, when Options::wait_request is true.
+        //! This method is invoked in the context of the internal thread of the server.
+        //! The default implementation accepts all requests with an empty response.
+        //! @param [in] client Socket address of the client.
+        //! @param [in] request Complete request, up to and including the terminating empty line.
+        //! @param [out] response Response to send to the client.
+        //! @return True to accept the client and start sending data after the response,
+        //! false to disconnect the client after the response.
+        //!
+        virtual bool processRequest(const IPSocketAddress& client, const std::string& request, std::string& response);
+
+    private:
+        class Poller;
+        class Client;
+        using ClientPtr = std::shared_ptr<Client>;
+
+        // Identifiers of events in the poller, client identifiers start after these.
+        static constexpr uint64_t LISTEN_ID = 0;
+        static constexpr uint64_t WAKE_ID = 1;
+
+        // Set by start(), then accessed by the internal thread only, except options.
+        Options                       _options {};
+        Report*                       _report = nullptr;
+        TCPServer                     _server {};
+        std::unique_ptr<Poller>       _poller {};
+        std::map<uint64_t, ClientPtr> _clients {};
+        uint64_t                      _next_id = WAKE_ID + 1;
+
+        // Shared between the application and the internal thread.
+        std::atomic_bool       _terminate {false};
+        std::atomic_bool       _wake_pending {false};
+        mutable std::mutex     _mutex {};
+        std::vector<ClientPtr> _streams {};  // Clients which receive data, protected by _mutex.
+        Statistics             _stats {};    // Protected by _mutex.
+
+        // Implementation of Thread.
+        virtual void main() override;
+
+        // Wake up the internal thread.
+        void wakeUp();
+
+        // Event processing in the internal thread.
+        void acceptClients();
+        void receiveFromClient(const ClientPtr& client);
+        void sendToClient(const ClientPtr& client);
+        void startStreaming(const ClientPtr& client);
+        void closeClient(const ClientPtr& client);
+    };
+}
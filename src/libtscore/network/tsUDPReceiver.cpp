@@ -137,68 +137,116 @@ bool ts::UDPReceiver::receive(void* data,
             report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", sender, destination, timestamp != nullptr ? timestamp->count() : -1);
         }
 
-        // Check the destination address to exclude packets from other streams.
-        // When several multicast streams use the same destination port and several
-        // applications on the same system listen to these distinct streams,
-        // the multicast MAC address management is such that any socket which
-        // is bound to the common port will receive the traffic for all streams.
-        // This is why we need to check the destination address and exclude
-        // packets which are not from the intended stream.
-        //
-        // We accept a packet in any of:
-        // 1) Actual packet destination is unknown. Probably, the system cannot
-        //    report the destination address.
-        // 2) We listen to a multicast address and the actual destination is the same.
-        // 3) If we listen to unicast traffic and the actual destination is unicast.
-        //    In that case, unicast is by definition sent to us.
-
-        if (destination.hasAddress() && ((_args.destination.hasAddress() && destination != _args.destination) || (!_args.destination.hasAddress() && destination.isMulticast()))) {
-            // This is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, destination: %s, expecting: %s", destination, _args.destination);
-            }
-            continue;
+        // Return the first packet matching all criteria.
+        if (acceptMessage(sender, destination, report)) {
+            return true;
         }
+    }
+}
 
-        // Keep track of the first sender address.
-        if (!_first_source.hasAddress()) {
-            // First packet, keep address of the sender.
-            _first_source = sender;
-            _sources.insert(sender);
 
-            // With option --first-source, use this one to filter packets.
-            if (_args.use_first_source) {
-                _args.source = sender;
-                report.verbose(u"now filtering on source address %s", sender);
-            }
+//----------------------------------------------------------------------------
+// Receive several messages. Override UDPSocket::receiveMultiple().
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::receiveMultiple(void* data,
+                                      size_t max_size,
+                                      size_t max_count,
+                                      ReceivedMessageVector& messages,
+                                      const AbortInterface* abort,
+                                      Report& report)
+{
+    // Loop on packet reception until at least one matching filtering criteria is found.
+    for (;;) {
+
+        // Wait for UDP messages from the superclass.
+        if (!UDPSocket::receiveMultiple(data, max_size, max_count, messages, abort, report)) {
+            return false;
         }
 
-        // Keep track of senders (sources) to detect or filter multiple sources.
-        if (_sources.count(sender) == 0) {
-            // Detected an additional source, warn the user that distinct streams are potentially mixed.
-            // If no source filtering is applied, this is a warning since this may affect the resulting stream.
-            // With source filtering, this is just an informational verbose-level message.
-            const int level = _args.source.hasAddress() ? Severity::Verbose : Severity::Warning;
-            if (_sources.size() == 1) {
-                report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", destination);
-                report.log(level, u"detected source: %s", _first_source);
+        // Debug (level 2) message for each message.
+        if (report.maxSeverity() >= 2) {
+            for (const auto& msg : messages) {
+                report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", msg.sender, msg.destination, msg.timestamp.count());
             }
-            report.log(level, u"detected source: %s", sender);
-            _sources.insert(sender);
         }
 
-        // Filter packets based on source address if requested.
-        if (!sender.match(_args.source)) {
-            // Not the expected source, this is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, source: %s, expecting: %s", sender, _args.source);
-            }
-            continue;
+        // Remove messages which do not match the filtering criteria.
+        std::erase_if(messages, [this, &report](const ReceivedMessage& msg) { return !acceptMessage(msg.sender, msg.destination, report); });
+        if (!messages.empty()) {
+            return true;
         }
+    }
+}
+
 
-        // Now found a packet matching all criteria.
-        return true;
+//----------------------------------------------------------------------------
+// Check if a received message matches the filtering criteria.
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::acceptMessage(const IPSocketAddress& sender, const IPSocketAddress& destination, Report& report)
+{
+    // Check the destination address to exclude packets from other streams.
+    // When several multicast streams use the same destination port and several
+    // applications on the same system listen to these distinct streams,
+    // the multicast MAC address management is such that any socket which
+    // is bound to the common port will receive the traffic for all streams.
+    // This is why we need to check the destination address and exclude
+    // packets which are not from the intended stream.
+    //
+    // We accept a packet in any of:
+    // 1) Actual packet destination is unknown. Probably, the system cannot
+    //    report the destination address.
+    // 2) We listen to a multicast address and the actual destination is the same.
+    // 3) If we listen to unicast traffic and the actual destination is unicast.
+    //    In that case, unicast is by definition sent to us.
+
+    if (destination.hasAddress() && ((_args.destination.hasAddress() && destination != _args.destination) || (!_args.destination.hasAddress() && destination.isMulticast()))) {
+        // This is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, destination: %s, expecting: %s", destination, _args.destination);
+        }
+        return false;
+    }
+
+    // Keep track of the first sender address.
+    if (!_first_source.hasAddress()) {
+        // First packet, keep address of the sender.
+        _first_source = sender;
+        _sources.insert(sender);
+
+        // With option --first-source, use this one to filter packets.
+        if (_args.use_first_source) {
+            _args.source = sender;
+            report.verbose(u"now filtering on source address %s", sender);
+        }
     }
+
+    // Keep track of senders (sources) to detect or filter multiple sources.
+    if (_sources.count(sender) == 0) {
+        // Detected an additional source, warn the user that distinct streams are potentially mixed.
+        // If no source filtering is applied, this is a warning since this may affect the resulting stream.
+        // With source filtering, this is just an informational verbose-level message.
+        const int level = _args.source.hasAddress() ? Severity::Verbose : Severity::Warning;
+        if (_sources.size() == 1) {
+            report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", destination);
+            report.log(level, u"detected source: %s", _first_source);
+        }
+        report.log(level, u"detected source: %s", sender);
+        _sources.insert(sender);
+    }
+
+    // Filter packets based on source address if requested.
+    if (!sender.match(_args.source)) {
+        // Not the expected source, this is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, source: %s, expecting: %s", sender, _args.source);
+        }
+        return false;
+    }
+
+    // Now found a packet matching all criteria.
+    return true;
 }
@@ -66,10 +66,19 @@ namespace ts {
                              const AbortInterface* abort = nullptr,
                              Report& report = CERR,
                              cn::microseconds* timestamp = nullptr) override;
+        virtual bool receiveMultiple(void* data,
+                                     size_t max_size,
+                                     size_t max_count,
+                                     ReceivedMessageVector& messages,
+                                     const AbortInterface* abort = nullptr,
+                                     Report& report = CERR) override;
 
     private:
         UDPReceiverArgs    _args {};          // Reception parameters (typically from the command line).
         IPSocketAddress    _first_source {};  // Socket address of first received packet.
         IPSocketAddressSet _sources {};       // Set of all detected packet sources.
+
+        // Check if a received message matches the filtering criteria.
+        bool acceptMessage(const IPSocketAddress& sender, const IPSocketAddress& destination, Report& report);
     };
 }
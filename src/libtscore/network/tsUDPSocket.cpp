@@ -11,9 +11,10 @@
 #include "tsNullReport.h"
 #include "tsSysUtils.h"
 
-// Network timestampting feature in Linux.
+// Network timestampting and segmentation offload features in Linux.
 #if defined(TS_LINUX)
     #include <linux/net_tstamp.h>
+    #include <netinet/udp.h>
 #endif
 
 // Furiously idiotic Windows feature, see comment in receiveOne()
@@ -332,6 +333,25 @@ bool ts::UDPSocket::setBroadcast(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable UDP segmentation offload on output.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setSendSegmentation(bool on, Report& report)
+{
+    // The segment size is passed with each message. Only record the option here.
+#if defined(TS_LINUX) && defined(UDP_SEGMENT)
+    report.debug(u"%s UDP segmentation offload", on ? u"enabling" : u"disabling");
+    _send_gso = on;
+#else
+    if (on) {
+        report.verbose(u"UDP segmentation offload not supported on this system, ignored");
+    }
+#endif
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option, based on an IP address.
 //----------------------------------------------------------------------------
@@ -567,6 +587,162 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPSocketAddress& d
 }
 
 
+//----------------------------------------------------------------------------
+// Send several messages.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendMultiple(const void* data, const std::vector<size_t>& sizes, Report& report)
+{
+    return sendMultiple(data, sizes, _default_destination, report);
+}
+
+bool ts::UDPSocket::sendMultiple(const void* data, const std::vector<size_t>& sizes, const IPSocketAddress& dest_in, Report& report)
+{
+    // Trivial cases first.
+    if (sizes.empty()) {
+        return true;
+    }
+    else if (sizes.size() == 1) {
+        return send(data, sizes.front(), dest_in, report);
+    }
+
+    IPSocketAddress dest(dest_in);
+    if (!convert(dest, report)) {
+        return false;
+    }
+
+    ::sockaddr_storage addr;
+    const size_t addr_size = dest.get(addr);
+    const uint8_t* const base = reinterpret_cast<const uint8_t*>(data);
+
+#if defined(TS_LINUX)
+
+    // With UDP segmentation offload, all segments must have the same size, except the last one which can be shorter.
+    if (_send_gso && sizes.size() <= GSO_MAX_SEGMENTS) {
+        size_t total = 0;
+        bool eligible = true;
+        for (size_t i = 0; eligible && i < sizes.size(); ++i) {
+            total += sizes[i];
+            eligible = sizes[i] > 0 && (i + 1 < sizes.size() ? sizes[i] == sizes[0] : sizes[i] <= sizes[0]);
+        }
+        if (eligible && total <= GSO_MAX_SIZE) {
+            const int err = sendSegments(base, sizes, addr, addr_size);
+            if (err == 0) {
+                return true;
+            }
+            else if (err == EIO || err == EINVAL || err == ENOPROTOOPT || err == EOPNOTSUPP) {
+                // The kernel or the network interface does not support it, revert to sendmmsg().
+                report.verbose(u"UDP segmentation offload not supported (%s), reverting to multiple messages", SysErrorCodeMessage(err));
+                _send_gso = false;
+            }
+            else {
+                report.error(u"error sending UDP message: %s", SysErrorCodeMessage(err));
+                return false;
+            }
+        }
+    }
+
+    // Prepare the work areas for sendmmsg().
+    _mm_send_headers.resize(sizes.size());
+    _mm_send_vectors.resize(sizes.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        ::mmsghdr& mh(_mm_send_headers[i]);
+        TS_ZERO(mh);
+        _mm_send_vectors[i].iov_base = const_cast<uint8_t*>(base + offset);
+        _mm_send_vectors[i].iov_len = sizes[i];
+        mh.msg_hdr.msg_name = &addr;
+        mh.msg_hdr.msg_namelen = socklen_t(addr_size);
+        mh.msg_hdr.msg_iov = &_mm_send_vectors[i];
+        mh.msg_hdr.msg_iovlen = 1;
+        offset += sizes[i];
+    }
+
+    // The kernel may send fewer messages than requested, loop until all are sent.
+    for (size_t next = 0; next < sizes.size(); ) {
+        const int count = ::sendmmsg(getSocket(), &_mm_send_headers[next], static_cast<unsigned int>(sizes.size() - next), 0);
+        if (count < 0) {
+            const int err = LastSysErrorCode();
+            if (err != EINTR) {
+                report.error(u"error sending UDP messages: %s", SysErrorCodeMessage(err));
+                return false;
+            }
+        }
+        else {
+            next += size_t(count);
+        }
+    }
+    return true;
+
+#else
+
+    // On other systems, send one message at a time.
+    for (size_t size : sizes) {
+        if (::sendto(getSocket(), SysSendBufferPointer(base), SysSendSizeType(size), 0, reinterpret_cast<::sockaddr*>(&addr), socklen_t(addr_size)) < 0) {
+            report.error(u"error sending UDP message: %s", SysErrorCodeMessage());
+            return false;
+        }
+        base += size;
+    }
+    return true;
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Send messages using one UDP segmentation offload request.
+//----------------------------------------------------------------------------
+
+#if defined(TS_LINUX)
+int ts::UDPSocket::sendSegments(const uint8_t* data, const std::vector<size_t>& sizes, ::sockaddr_storage& addr, size_t addr_size)
+{
+#if defined(UDP_SEGMENT)
+    size_t total = 0;
+    for (size_t size : sizes) {
+        total += size;
+    }
+
+    ::iovec vec;
+    vec.iov_base = const_cast<uint8_t*>(data);
+    vec.iov_len = total;
+
+    // The segment size is passed as ancillary data.
+    uint8_t control[CMSG_SPACE(sizeof(uint16_t))];
+    TS_ZERO(control);
+
+    ::msghdr hdr;
+    TS_ZERO(hdr);
+    hdr.msg_name = &addr;
+    hdr.msg_namelen = socklen_t(addr_size);
+    hdr.msg_iov = &vec;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    ::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    const uint16_t segment_size = uint16_t(sizes.front());
+    MemCopy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+    for (;;) {
+        if (::sendmsg(getSocket(), &hdr, 0) >= 0) {
+            return 0;
+        }
+        const int err = LastSysErrorCode();
+        if (err != EINTR) {
+            return err;
+        }
+    }
+#else
+    return EOPNOTSUPP;
+#endif
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 //----------------------------------------------------------------------------
@@ -623,6 +799,175 @@ bool ts::UDPSocket::receive(void* data,
 }
 
 
+//----------------------------------------------------------------------------
+// Analyze the ancillary data of a received message (UNIX only).
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+namespace {
+    void GetAncillaryData(::msghdr& hdr, ts::IPSocketAddress::Port port, ts::IPSocketAddress& destination, cn::microseconds* timestamp)
+    {
+        TS_PUSH_WARNING()
+        TS_GCC_NOWARNING(zero-as-null-pointer-constant) // invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
+#if defined(TS_OPENBSD)
+        TS_LLVM_NOWARNING(cast-align) // invalid definition of CMSG_NXTHDR on OpenBSD
+#endif
+
+        for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+
+            // Look for destination IP address.
+            // IP_PKTINFO is used on all Unix, except FreeBSD.
+#if defined(IP_PKTINFO)
+            if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO && cmsg->cmsg_len >= sizeof(::in_pktinfo)) {
+                const ::in_pktinfo* info = reinterpret_cast<const ::in_pktinfo*>(CMSG_DATA(cmsg));
+                destination = ts::IPSocketAddress(info->ipi_addr, port);
+            }
+#endif
+#if defined(IPV6_PKTINFO)
+            if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO && cmsg->cmsg_len >= sizeof(::in6_pktinfo)) {
+                const ::in6_pktinfo* info = reinterpret_cast<const ::in6_pktinfo*>(CMSG_DATA(cmsg));
+                destination = ts::IPSocketAddress(info->ipi6_addr, port);
+            }
+#endif
+#if defined(IP_RECVDSTADDR)
+            if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR && cmsg->cmsg_len >= sizeof(::in_addr)) {
+                const ::in_addr* info = reinterpret_cast<const ::in_addr*>(CMSG_DATA(cmsg));
+                destination = ts::IPSocketAddress(*info, port);
+            }
+#endif
+
+            // On Linux, look for receive timestamp.
+#if defined(TS_LINUX)
+            if (timestamp != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS && cmsg->cmsg_len >= sizeof(::timespec)) {
+                // System time stamp in nanosecond.
+                const ::timespec* ts = reinterpret_cast<const ::timespec*>(CMSG_DATA(cmsg));
+                const cn::nanoseconds::rep nano = cn::nanoseconds::rep(ts->tv_sec) * 1'000'000'000 + cn::nanoseconds::rep(ts->tv_nsec);
+                // System time stamp is valid when not zero, convert it to micro-seconds.
+                if (nano != 0) {
+                    *timestamp = cn::duration_cast<cn::microseconds>(cn::nanoseconds(nano));
+                }
+            }
+#endif
+        }
+
+        TS_POP_WARNING()
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Receive several messages.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::receiveMultiple(void* data,
+                                    size_t max_size,
+                                    size_t max_count,
+                                    ReceivedMessageVector& messages,
+                                    const AbortInterface* abort,
+                                    Report& report)
+{
+    messages.clear();
+    if (max_count == 0) {
+        return true;
+    }
+
+    // Loop on unsollicited interrupts
+    for (;;) {
+
+        // Wait for at least one message.
+        const int err = receiveMany(reinterpret_cast<uint8_t*>(data), max_size, max_count, messages, report);
+
+        if (abort != nullptr && abort->aborting()) {
+            // Aborting, no error message.
+            return false;
+        }
+        else if (err == 0) {
+            // Sometimes, we get "successful" empty message coming from nowhere. Ignore them.
+            std::erase_if(messages, [](const ReceivedMessage& msg) { return msg.size == 0 && !msg.sender.hasAddress(); });
+            if (!messages.empty()) {
+                return true;
+            }
+        }
+#if defined(TS_UNIX)
+        else if (err == EINTR) {
+            // Got a signal, not a user interrupt, will ignore it
+            report.debug(u"signal, not user interrupt");
+        }
+#endif
+        else {
+            // Abort on non-interrupt errors.
+            if (isOpen()) {
+                // Report the error only if the error does not result from a close in another thread.
+                report.error(u"error receiving from UDP socket: %s", SysErrorCodeMessage(err));
+            }
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Perform one multi-message receive operation.
+//----------------------------------------------------------------------------
+
+int ts::UDPSocket::receiveMany(uint8_t* data, size_t max_size, size_t max_count, ReceivedMessageVector& messages, Report& report)
+{
+    messages.clear();
+
+#if defined(TS_LINUX)
+
+    // Prepare the work areas for recvmmsg().
+    _mm_headers.resize(max_count);
+    _mm_vectors.resize(max_count);
+    _mm_senders.resize(max_count);
+    _mm_ancillary.resize(max_count * MM_ANCILLARY_SIZE);
+    for (size_t i = 0; i < max_count; ++i) {
+        ::mmsghdr& mh(_mm_headers[i]);
+        TS_ZERO(mh);
+        _mm_vectors[i].iov_base = data + i * max_size;
+        _mm_vectors[i].iov_len = max_size;
+        TS_ZERO(_mm_senders[i]);
+        mh.msg_hdr.msg_name = &_mm_senders[i];
+        mh.msg_hdr.msg_namelen = sizeof(_mm_senders[i]);
+        mh.msg_hdr.msg_iov = &_mm_vectors[i];
+        mh.msg_hdr.msg_iovlen = 1;
+        mh.msg_hdr.msg_control = &_mm_ancillary[i * MM_ANCILLARY_SIZE];
+        mh.msg_hdr.msg_controllen = MM_ANCILLARY_SIZE;
+    }
+
+    // Wait for the first message, then get all immediately available messages.
+    const int count = ::recvmmsg(getSocket(), _mm_headers.data(), static_cast<unsigned int>(max_count), MSG_WAITFORONE, nullptr);
+    if (count < 0) {
+        return LastSysErrorCode();
+    }
+
+    messages.resize(size_t(count));
+    for (size_t i = 0; i < messages.size(); ++i) {
+        ReceivedMessage& msg(messages[i]);
+        msg.offset = i * max_size;
+        msg.size = size_t(_mm_headers[i].msg_len);
+        msg.sender = IPSocketAddress(_mm_senders[i]);
+        GetAncillaryData(_mm_headers[i].msg_hdr, _local_address.port(), msg.destination, &msg.timestamp);
+    }
+
+#else
+
+    // On other systems, receive one message at a time.
+    messages.resize(1);
+    ReceivedMessage& msg(messages.front());
+    const int err = receiveOne(data, max_size, msg.size, msg.sender, msg.destination, report, &msg.timestamp);
+    if (err != 0) {
+        messages.clear();
+        return err;
+    }
+
+#endif
+
+    return 0; // success
+}
+
+
 //----------------------------------------------------------------------------
 // Perform one receive operation. Hide the system mud.
 //----------------------------------------------------------------------------
@@ -742,51 +1087,8 @@ int ts::UDPSocket::receiveOne(void* data,
         return LastSysErrorCode();
     }
 
-    TS_PUSH_WARNING()
-    TS_GCC_NOWARNING(zero-as-null-pointer-constant) // invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
-#if defined(TS_OPENBSD)
-    TS_LLVM_NOWARNING(cast-align) // invalid definition of CMSG_NXTHDR on OpenBSD
-#endif
-
     // Browse returned ancillary data.
-    for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
-
-        // Look for destination IP address.
-        // IP_PKTINFO is used on all Unix, except FreeBSD.
-#if defined(IP_PKTINFO)
-        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO && cmsg->cmsg_len >= sizeof(::in_pktinfo)) {
-            const ::in_pktinfo* info = reinterpret_cast<const ::in_pktinfo*>(CMSG_DATA(cmsg));
-            destination = IPSocketAddress(info->ipi_addr, _local_address.port());
-        }
-#endif
-#if defined(IPV6_PKTINFO)
-        if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO && cmsg->cmsg_len >= sizeof(::in6_pktinfo)) {
-            const ::in6_pktinfo* info = reinterpret_cast<const ::in6_pktinfo*>(CMSG_DATA(cmsg));
-            destination = IPSocketAddress(info->ipi6_addr, _local_address.port());
-        }
-#endif
-#if defined(IP_RECVDSTADDR)
-        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR && cmsg->cmsg_len >= sizeof(::in_addr)) {
-            const ::in_addr* info = reinterpret_cast<const ::in_addr*>(CMSG_DATA(cmsg));
-            destination = IPSocketAddress(*info, _local_address.port());
-        }
-#endif
-
-        // On Linux, look for receive timestamp.
-#if defined(TS_LINUX)
-        if (timestamp != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS && cmsg->cmsg_len >= sizeof(::timespec)) {
-            // System time stamp in nanosecond.
-            const ::timespec* ts = reinterpret_cast<const ::timespec*>(CMSG_DATA(cmsg));
-            const cn::nanoseconds::rep nano = cn::nanoseconds::rep(ts->tv_sec) * 1'000'000'000 + cn::nanoseconds::rep(ts->tv_nsec);
-            // System time stamp is valid when not zero, convert it to micro-seconds.
-            if (nano != 0) {
-                *timestamp = cn::duration_cast<cn::microseconds>(cn::nanoseconds(nano));
-            }
-        }
-#endif
-    }
-
-    TS_POP_WARNING()
+    GetAncillaryData(hdr, _local_address.port(), destination, timestamp);
 
 #endif // Windows vs. UNIX
 
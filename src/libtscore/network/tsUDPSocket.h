@@ -217,6 +217,21 @@ namespace ts {
         //!
         bool setBroadcast(bool on, Report& report = CERR);
 
+        //!
+        //! Enable or disable UDP segmentation offload on output (UDP GSO).
+        //!
+        //! When enabled, sendMultiple() passes a batch of equal-size messages to the kernel in
+        //! one single large buffer and the kernel (or the NIC) splits it in individual datagrams.
+        //! When the kernel rejects the request, the socket silently reverts to sendmmsg().
+        //!
+        //! Currently, this option is supported on Linux only. It is ignored on other systems.
+        //!
+        //! @param [in] on If true, UDP segmentation offload is used when possible.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool setSendSegmentation(bool on, Report& report = CERR);
+
         //!
         //! Enable or disable the broadcast option, based on an IP address.
         //!
@@ -335,6 +350,34 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, Report& report = CERR);
 
+        //!
+        //! Send several messages to a destination address and port.
+        //!
+        //! The messages are contiguous in memory. On Linux, they are sent using one single system
+        //! call (sendmmsg() or one UDP segmentation offload request, see setSendSegmentation()).
+        //! On other systems, they are sent one by one.
+        //!
+        //! @param [in] data Address of the first message to send.
+        //! @param [in] sizes Sizes in bytes of the consecutive messages to send.
+        //! @param [in] destination Socket address of the destination.
+        //! Both address and port are mandatory in the socket address, they cannot
+        //! be set to IPAddress::AnyAddress4 or IPSocketAddress::AnyPort.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendMultiple(const void* data, const std::vector<size_t>& sizes, const IPSocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send several messages to the default destination address and port.
+        //!
+        //! @param [in] data Address of the first message to send.
+        //! @param [in] sizes Sizes in bytes of the consecutive messages to send.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendMultiple(const void*, const std::vector<size_t>&, const IPSocketAddress&, Report&)
+        //!
+        virtual bool sendMultiple(const void* data, const std::vector<size_t>& sizes, Report& report = CERR);
+
         //!
         //! Receive a message.
         //!
@@ -362,6 +405,50 @@ namespace ts {
                              Report& report = CERR,
                              cn::microseconds* timestamp = nullptr);
 
+        //!
+        //! Description of one message in a multi-message receive operation.
+        //! @see receiveMultiple()
+        //!
+        class ReceivedMessage
+        {
+        public:
+            ReceivedMessage() = default;                //!< Constructor.
+            size_t           offset = 0;                //!< Offset of the message in the reception buffer.
+            size_t           size = 0;                  //!< Size in bytes of the received message.
+            IPSocketAddress  sender {};                 //!< Socket address of the sender.
+            IPSocketAddress  destination {};            //!< Socket address of the packet destination.
+            cn::microseconds timestamp {-1};            //!< Receive timestamp in micro-seconds, negative if not available.
+        };
+
+        //!
+        //! Vector of message descriptions in a multi-message receive operation.
+        //!
+        using ReceivedMessageVector = std::vector<ReceivedMessage>;
+
+        //!
+        //! Receive several messages in one operation.
+        //! The method waits for at least one message. Then, all messages which are immediately available
+        //! are returned, up to @a max_count. On Linux, all messages are received using one single system
+        //! call (recvmmsg). On other systems, only one message is returned at a time.
+        //! @param [out] data Address of the buffer for the received messages. The size of the buffer
+        //! must be at least @a max_size * @a max_count bytes. Each message starts at a multiple of @a max_size
+        //! in the buffer.
+        //! @param [in] max_size Maximum size in bytes of each message.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] messages Description of the received messages. Received timestamps are
+        //! returned when setReceiveTimestamps() was previously used.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted
+        //! (in case of user-interrupt, return, otherwise retry).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receiveMultiple(void* data,
+                                     size_t max_size,
+                                     size_t max_count,
+                                     ReceivedMessageVector& messages,
+                                     const AbortInterface* abort = nullptr,
+                                     Report& report = CERR);
+
         // Implementation of Socket interface.
         virtual bool open(IP gen, Report& report = CERR) override;
         virtual bool close(Report& report = CERR) override;
@@ -438,9 +525,37 @@ namespace ts {
         SSMReqSet       _ssmcast {};  // Current set of source-specific multicast memberships
 #endif
 
+#if defined(TS_LINUX)
+        // Work areas for recvmmsg(), kept between calls to avoid reallocation.
+        std::vector<::mmsghdr>          _mm_headers {};
+        std::vector<::iovec>            _mm_vectors {};
+        std::vector<::sockaddr_storage> _mm_senders {};
+        std::vector<uint8_t>            _mm_ancillary {};
+
+        // Size of ancillary data area per message in recvmmsg().
+        static constexpr size_t MM_ANCILLARY_SIZE = 256;
+
+        // Work areas for sendmmsg(), separate from recvmmsg() ones since send and receive may run in distinct threads.
+        std::vector<::mmsghdr>          _mm_send_headers {};
+        std::vector<::iovec>            _mm_send_vectors {};
+
+        // Maximum number of segments and total size in one UDP segmentation offload request.
+        static constexpr size_t GSO_MAX_SEGMENTS = 64;
+        static constexpr size_t GSO_MAX_SIZE = 65000;
+#endif
+        bool _send_gso = false;  // Use UDP segmentation offload on output.
+
         // Perform one receive operation. Hide the system mud. Return a system socket error code.
         int receiveOne(void* data, size_t max_size, size_t& ret_size, IPSocketAddress& sender, IPSocketAddress& destination, Report& report, cn::microseconds* timestamp);
 
+        // Perform one multi-message receive operation. Return a system socket error code.
+        int receiveMany(uint8_t* data, size_t max_size, size_t max_count, ReceivedMessageVector& messages, Report& report);
+
+#if defined(TS_LINUX)
+        // Send messages using one UDP segmentation offload request. Return a system socket error code.
+        int sendSegments(const uint8_t* data, const std::vector<size_t>& sizes, ::sockaddr_storage& addr, size_t addr_size);
+#endif
+
         // Add multicast membership common code, local interface by index or by address.
         bool addMembershipImpl(const IPAddress& multicast, const IPAddress& local, int interface_index, const IPAddress& source, Report& report);
 
@@ -17,10 +17,16 @@
 ts::AsyncReport::AsyncReport(int max_severity, const AsyncReportArgs& args) :
     Report(max_severity),
     Thread(ThreadAttributes().setPriority(ThreadAttributes::GetMinimumPriority())),
-    _log_queue(args.log_msg_count),
+    _slots(std::bit_ceil(std::max<size_t>(args.log_msg_count, 2))),
+    _mask(_slots.size() - 1),
     _time_stamp(args.timed_log),
     _synchronous(args.sync_log)
 {
+    // Initially, the sequence number of each slot is its index: free for a producer at that position.
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
     // Start the logging thread
     start();
 }
@@ -43,9 +49,13 @@ ts::AsyncReport::~AsyncReport()
 void ts::AsyncReport::terminate()
 {
     if (!_terminated) {
-        // Insert an "end of report" message in the queue.
-        // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage {true, 0, UString()});
+        // Tell the logging thread to terminate after logging all queued messages.
+        _terminate = true;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _not_empty.notify_one();
+            _not_full.notify_all();
+        }
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -54,6 +64,53 @@ void ts::AsyncReport::terminate()
 }
 
 
+//----------------------------------------------------------------------------
+// Lock-free access to the ring buffer.
+//----------------------------------------------------------------------------
+
+bool ts::AsyncReport::tryEnqueue(int severity, const UString& msg)
+{
+    // Reserve a slot at the current enqueue position.
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &_slots[pos & _mask];
+        const size_t seq = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0) {
+            // The slot is free, try to get it.
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The slot still contains a message from the previous round: the queue is full.
+            return false;
+        }
+        else {
+            // Another producer got the slot, retry with the new position.
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The slot is reserved, copy the message into the preallocated string and publish it.
+    slot->severity = severity;
+    slot->message.assign(msg);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void ts::AsyncReport::wakeUpConsumer()
+{
+    // Paired with the fence in the logging thread, before checking for new messages.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_consumer_waiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _not_empty.notify_one();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Message logging method.
 //----------------------------------------------------------------------------
@@ -70,14 +127,23 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 #endif
 
     if (!_terminated) {
-        LogMessage* p = new LogMessage {false, severity, msg};
-        if (_synchronous) {
-            // Synchronous mode, wait infinitely until the message is queued.
-            _log_queue.enqueue(p);
+        bool queued = tryEnqueue(severity, msg);
+        if (!queued && _synchronous) {
+            // Synchronous mode, wait until the message is queued. The timeout is a safety net
+            // in case the notification from the logging thread is missed.
+            std::unique_lock<std::mutex> lock(_mutex);
+            _producers_waiting++;
+            while (!(queued = tryEnqueue(severity, msg)) && !_terminate) {
+                _not_full.wait_for(lock, cn::milliseconds(10));
+            }
+            _producers_waiting--;
+        }
+        if (queued) {
+            wakeUpConsumer();
         }
         else {
-            // Enqueue the message immediately (timeout = 0), drop message on overflow.
-            _log_queue.enqueue(p, cn::milliseconds::zero());
+            // Drop the message on overflow.
+            _dropped++;
         }
     }
 }
@@ -89,27 +155,53 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
+    uint64_t reported_drops = 0;
 
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
 
     for (;;) {
-        // Dequeue next message (infinite wait).
-        _log_queue.dequeue(msg);
+        Slot& slot(_slots[_dequeue_pos & _mask]);
+        if (slot.sequence.load(std::memory_order_acquire) == _dequeue_pos + 1) {
+            // Notify subclass of message (or log it on standard error).
+            const int severity = slot.severity;
+            asyncThreadLog(severity, slot.message);
+
+            // Abort application on fatal error
+            if (severity == Severity::Fatal) {
+                std::exit(EXIT_FAILURE);
+            }
+
+            // Release the slot for the next round of producers.
+            slot.sequence.store(_dequeue_pos + _mask + 1, std::memory_order_release);
+            _dequeue_pos++;
+            if (_producers_waiting > 0) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _not_full.notify_all();
+            }
+            continue;
+        }
 
-        // Exit when received a termination message.
-        if (msg->terminate) {
-            break;
+        // The queue is empty. Report dropped messages, if any.
+        const uint64_t drops = _dropped;
+        if (drops > reported_drops && maxSeverity() >= Severity::Warning) {
+            asyncThreadLog(Severity::Warning, UString::Format(u"%'d log messages dropped, queue overflow", drops - reported_drops));
         }
+        reported_drops = drops;
 
-        // Notify subclass of message (or log it on standard error).
-        asyncThreadLog(msg->severity, msg->message);
+        // Exit when termination was requested and all messages are logged.
+        if (_terminate) {
+            break;
+        }
 
-        // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
-            std::exit(EXIT_FAILURE);
+        // Wait for new messages. Check the queue again after announcing that we wait.
+        std::unique_lock<std::mutex> lock(_mutex);
+        _consumer_waiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_slots[_dequeue_pos & _mask].sequence.load(std::memory_order_acquire) != _dequeue_pos + 1 && !_terminate) {
+            _not_empty.wait(lock);
         }
+        _consumer_waiting = false;
     }
 
     if (maxSeverity() >= Severity::Debug) {
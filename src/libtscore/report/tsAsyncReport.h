@@ -14,7 +14,6 @@
 #pragma once
 #include "tsReport.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
 #include "tsThread.h"
 
 namespace ts {
@@ -27,11 +26,16 @@ namespace ts {
     //! to the caller without waiting. The messages are logged later in one single
     //! low-priority thread.
     //!
-    //! In case of a huge amount of errors, there is no avalanche effect. If a caller
-    //! cannot immediately enqueue a message or if the internal queue of messages is
-    //! full, the message is dropped. In other words, reporting messages is guaranteed
-    //! to never block, slow down or crash the application. Messages are dropped when
-    //! necessary to avoid that kind of problem.
+    //! In case of a huge amount of errors, there is no avalanche effect. If the internal
+    //! queue of messages is full, the message is dropped and counted. In other words,
+    //! reporting messages is guaranteed to never block, slow down or crash the application.
+    //! Messages are dropped when necessary to avoid that kind of problem. In synchronous
+    //! mode, the caller waits for some free space in the queue instead.
+    //!
+    //! The internal queue is a lock-free ring buffer. Application threads never contend
+    //! on a mutex to log a message, unless the queue is full in synchronous mode. The text
+    //! of a message is copied in a preallocated slot of the ring, without heap allocation
+    //! after the first messages.
     //!
     //! Messages are displayed on the standard error device by default.
     //!
@@ -78,6 +82,12 @@ namespace ts {
         //!
         bool getSynchronous() const { return _synchronous; }
 
+        //!
+        //! Get the number of dropped messages, when the queue was full in asynchronous mode.
+        //! @return The number of dropped messages since the creation of the report.
+        //!
+        uint64_t droppedMessages() const { return _dropped; }
+
         //!
         //! Synchronously terminate the report thread.
         //! Automatically performed in destructor.
@@ -112,20 +122,36 @@ namespace ts {
         // This hook is invoked in the context of the logging thread.
         virtual void main() override;
 
-        // The application threads send that type of message to the logging thread
-        struct LogMessage
+        // A slot in the ring buffer of messages. The sequence number indicates if the slot
+        // is free for a producer or ready for the consumer (bounded MPMC queue from D. Vyukov,
+        // used here with one single consumer). The message string keeps its allocated memory.
+        struct Slot
         {
-            bool    terminate;
-            int     severity;
-            UString message;
+            std::atomic<size_t> sequence {0};
+            int                 severity = 0;
+            UString             message {};
         };
-        using LogMessageQueue = MessageQueue<LogMessage>;
-        using LogMessagePtr = LogMessageQueue::MessagePtr;
+
+        // Try to enqueue a message, without blocking. Return false if the queue is full.
+        bool tryEnqueue(int severity, const UString& msg);
+
+        // Wake up the logging thread if it waits for messages.
+        void wakeUpConsumer();
 
         // Private members:
-        LogMessageQueue _log_queue {};
-        volatile bool   _time_stamp = false;
-        volatile bool   _synchronous = false;
-        volatile bool   _terminated = false;
+        std::vector<Slot>       _slots;                // Ring buffer, size is a power of 2.
+        const size_t            _mask;                 // Index mask in the ring buffer.
+        std::atomic<size_t>     _enqueue_pos {0};      // Next position to write (producers).
+        size_t                  _dequeue_pos = 0;      // Next position to read (logging thread only).
+        std::atomic<uint64_t>   _dropped {0};          // Number of dropped messages.
+        std::atomic_bool        _consumer_waiting {false};
+        std::atomic_int         _producers_waiting {0};
+        std::atomic_bool        _terminate {false};    // Request termination of the logging thread.
+        std::mutex              _mutex {};             // Only used to wait for messages or free space.
+        std::condition_variable _not_empty {};
+        std::condition_variable _not_full {};
+        volatile bool           _time_stamp = false;
+        volatile bool           _synchronous = false;
+        volatile bool           _terminated = false;
     };
 }
@@ -23,7 +23,8 @@ void ts::AsyncReportArgs::defineArgs(Args& args)
               u"the maximum number of buffered log messages in memory, before being "
               u"displayed. When too many messages are logged in a short period of time, "
               u"while plugins use all CPU power, extra messages are dropped. Increase "
-              u"this value if you think that too many messages are dropped. The default "
+              u"this value if you think that too many messages are dropped. The number of "
+              u"dropped messages is reported as a warning. The default "
               u"is " + UString::Decimal(MAX_LOG_MESSAGES) + u" messages.");
 
     args.option(u"synchronous-log", 's');
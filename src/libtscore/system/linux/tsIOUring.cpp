@@ -0,0 +1,236 @@
+//-----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//-----------------------------------------------------------------------------
+//
+//  Minimal io_uring instance for asynchronous file I/O. Linux-specific.
+//
+//-----------------------------------------------------------------------------
+
+#include "tsIOUring.h"
+#include "tsSysUtils.h"
+#include "tsMemory.h"
+
+#include "tsBeforeStandardHeaders.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+#endif
+#include "tsAfterStandardHeaders.h"
+
+// The io_uring system calls are available in kernel headers 5.1 and higher.
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_OFF_SQ_RING)
+    #define TS_IO_URING 1
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Destructor.
+//-----------------------------------------------------------------------------
+
+ts::IOUring::~IOUring()
+{
+    close();
+}
+
+
+//-----------------------------------------------------------------------------
+// Create the io_uring instance.
+//-----------------------------------------------------------------------------
+
+bool ts::IOUring::open(size_t entries, Report& report)
+{
+    if (_fd >= 0) {
+        report.error(u"io_uring already open");
+        return false;
+    }
+
+#if defined(TS_IO_URING)
+
+    ::io_uring_params params;
+    TS_ZERO(params);
+    _fd = int(::syscall(__NR_io_uring_setup, unsigned(entries), &params));
+    if (_fd < 0) {
+        report.debug(u"io_uring not available: %s", SysErrorCodeMessage());
+        return false;
+    }
+
+    // Map the submission and completion rings, in one single area with recent kernels.
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+
+    _sq_ring = ::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+    }
+    else if (single_mmap) {
+        _cq_ring = _sq_ring;
+    }
+    else {
+        _cq_ring = ::mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+        if (_cq_ring == MAP_FAILED) {
+            _cq_ring = nullptr;
+        }
+    }
+    if (_sq_ring != nullptr && _cq_ring != nullptr) {
+        _sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+        if (_sqes == MAP_FAILED) {
+            _sqes = nullptr;
+        }
+    }
+    if (_sqes == nullptr) {
+        report.error(u"error mapping io_uring: %s", SysErrorCodeMessage());
+        close();
+        return false;
+    }
+
+    // Get the addresses of the ring fields.
+    uint8_t* const sq = reinterpret_cast<uint8_t*>(_sq_ring);
+    uint8_t* const cq = reinterpret_cast<uint8_t*>(_cq_ring);
+    _sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    _sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    _cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    _cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+    return true;
+
+#else
+
+    report.debug(u"io_uring not supported in this version of TSDuck");
+    return false;
+
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Close the io_uring instance.
+//-----------------------------------------------------------------------------
+
+void ts::IOUring::close()
+{
+    if (_sqes != nullptr) {
+        ::munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        ::munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        ::munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+    _fd = -1;
+    _sq_ring = _cq_ring = _sqes = _cqes = nullptr;
+    _sq_tail = _sq_array = _cq_head = _cq_tail = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// Submit operations.
+//-----------------------------------------------------------------------------
+
+bool ts::IOUring::submitRead(int fd, void* addr, size_t size, uint64_t offset, uint64_t user_data, Report& report)
+{
+#if defined(TS_IO_URING)
+    return submit(IORING_OP_READ, fd, addr, size, offset, user_data, report);
+#else
+    return false;
+#endif
+}
+
+bool ts::IOUring::submitWrite(int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data, Report& report)
+{
+#if defined(TS_IO_URING)
+    return submit(IORING_OP_WRITE, fd, addr, size, offset, user_data, report);
+#else
+    return false;
+#endif
+}
+
+bool ts::IOUring::submit(uint8_t opcode, int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data, Report& report)
+{
+#if defined(TS_IO_URING)
+
+    if (_fd < 0) {
+        report.error(u"io_uring not open");
+        return false;
+    }
+
+    // The submission queue tail is only written by the application.
+    const uint32_t tail = *_sq_tail;
+    const uint32_t index = tail & _sq_mask;
+    ::io_uring_sqe* const sqe = reinterpret_cast<::io_uring_sqe*>(_sqes) + index;
+    TS_ZERO(*sqe);
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = uint64_t(uintptr_t(addr));
+    sqe->len = uint32_t(size);
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    _sq_array[index] = index;
+    std::atomic_ref<uint32_t>(*_sq_tail).store(tail + 1, std::memory_order_release);
+
+    // Without submission polling, the kernel consumes the entry during the call.
+    for (;;) {
+        if (::syscall(__NR_io_uring_enter, _fd, 1, 0, 0, nullptr, 0) >= 0) {
+            return true;
+        }
+        else if (errno != EINTR) {
+            report.error(u"io_uring submission error: %s", SysErrorCodeMessage());
+            return false;
+        }
+    }
+
+#else
+    return false;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Wait for the completion of the next operation.
+//-----------------------------------------------------------------------------
+
+bool ts::IOUring::waitCompletion(uint64_t& user_data, int32_t& result, Report& report)
+{
+#if defined(TS_IO_URING)
+
+    if (_fd < 0) {
+        report.error(u"io_uring not open");
+        return false;
+    }
+
+    for (;;) {
+        // The completion queue head is only written by the application.
+        const uint32_t head = *_cq_head;
+        if (head != std::atomic_ref<uint32_t>(*_cq_tail).load(std::memory_order_acquire)) {
+            const ::io_uring_cqe* const cqe = reinterpret_cast<const ::io_uring_cqe*>(_cqes) + (head & _cq_mask);
+            user_data = cqe->user_data;
+            result = cqe->res;
+            std::atomic_ref<uint32_t>(*_cq_head).store(head + 1, std::memory_order_release);
+            return true;
+        }
+        if (::syscall(__NR_io_uring_enter, _fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+            report.error(u"io_uring completion error: %s", SysErrorCodeMessage());
+            return false;
+        }
+    }
+
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//-----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Minimal io_uring instance for asynchronous file I/O (Linux-specific).
+//!
+//-----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Minimal io_uring instance for asynchronous file I/O (Linux-specific).
+    //! @ingroup libtscore unix
+    //!
+    //! Only read and write operations at explicit file offsets are supported. The io_uring
+    //! system calls are directly used, there is no dependency on liburing. An instance must
+    //! be used from one thread only.
+    //!
+    //! When io_uring is not available (old kernel, or system calls filtered in a container),
+    //! open() fails and the application shall revert to synchronous I/O.
+    //!
+    class TSCOREDLL IOUring
+    {
+        TS_NOCOPY(IOUring);
+    public:
+        //!
+        //! Constructor.
+        //!
+        IOUring() = default;
+
+        //!
+        //! Destructor.
+        //! Pending operations are cancelled by the kernel.
+        //!
+        ~IOUring();
+
+        //!
+        //! Create the io_uring instance.
+        //! @param [in] entries Maximum number of simultaneous operations.
+        //! @param [in,out] report Where to report errors. Since an unavailable io_uring is not
+        //! considered as an error, the failure of the creation is reported at debug level.
+        //! @return True on success, false on error.
+        //!
+        bool open(size_t entries, Report& report);
+
+        //!
+        //! Close the io_uring instance.
+        //!
+        void close();
+
+        //!
+        //! Check if the io_uring instance is open.
+        //! @return True if the io_uring instance is open.
+        //!
+        bool isOpen() const { return _fd >= 0; }
+
+        //!
+        //! Submit a read operation.
+        //! @param [in] fd File descriptor to read.
+        //! @param [out] addr Address of the buffer to read. Must remain valid until completion.
+        //! @param [in] size Size of the buffer.
+        //! @param [in] offset Offset in the file.
+        //! @param [in] user_data Application value which is returned with the completion.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool submitRead(int fd, void* addr, size_t size, uint64_t offset, uint64_t user_data, Report& report);
+
+        //!
+        //! Submit a write operation.
+        //! @param [in] fd File descriptor to write.
+        //! @param [in] addr Address of the data to write. Must remain valid until completion.
+        //! @param [in] size Size of the data.
+        //! @param [in] offset Offset in the file.
+        //! @param [in] user_data Application value which is returned with the completion.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool submitWrite(int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data, Report& report);
+
+        //!
+        //! Wait for the completion of the next operation, in any order.
+        //! @param [out] user_data Application value of the completed operation.
+        //! @param [out] result Result of the operation: transferred size or negative @c errno value.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool waitCompletion(uint64_t& user_data, int32_t& result, Report& report);
+
+    private:
+        int       _fd = -1;
+        void*     _sq_ring = nullptr;
+        void*     _cq_ring = nullptr;
+        void*     _sqes = nullptr;
+        size_t    _sq_ring_size = 0;
+        size_t    _cq_ring_size = 0;
+        size_t    _sqes_size = 0;
+        uint32_t* _sq_tail = nullptr;
+        uint32_t  _sq_mask = 0;
+        uint32_t* _sq_array = nullptr;
+        uint32_t* _cq_head = nullptr;
+        uint32_t* _cq_tail = nullptr;
+        uint32_t  _cq_mask = 0;
+        void*     _cqes = nullptr;
+
+        // Queue and submit one operation.
+        bool submit(uint8_t opcode, int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data, Report& report);
+    };
+}
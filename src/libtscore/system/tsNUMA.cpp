@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsNUMA.h"
+#include "tsUString.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include "tsAfterStandardHeaders.h"
+    // Memory policies, see <linux/mempolicy.h>. The numactl library is not used.
+    #define TS_MPOL_PREFERRED 1
+    #define TS_MPOL_BIND      2
+    #define TS_MPOL_MF_MOVE   (1 << 1)
+#endif
+
+// Location of NUMA nodes description on Linux.
+#define TS_NUMA_SYSFS u"/sys/devices/system/node/node"
+
+
+//----------------------------------------------------------------------------
+// Get the number of NUMA nodes in the system.
+//----------------------------------------------------------------------------
+
+size_t ts::NUMANodeCount()
+{
+#if defined(TS_LINUX)
+    size_t count = 0;
+    std::error_code error;
+    while (fs::is_directory(UString::Format(u"%s%d", TS_NUMA_SYSFS, count), error)) {
+        count++;
+    }
+    return std::max<size_t>(1, count);
+#elif defined(TS_WINDOWS)
+    ::ULONG highest = 0;
+    return ::GetNumaHighestNodeNumber(&highest) ? size_t(highest) + 1 : 1;
+#else
+    return 1;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the set of CPU's which belong to a NUMA node.
+//----------------------------------------------------------------------------
+
+bool ts::GetNUMANodeCPUs(size_t node, std::set<size_t>& cpus)
+{
+    cpus.clear();
+
+#if defined(TS_LINUX)
+
+    // The file contains a list of CPU ranges, for instance "0-3,8-11".
+    UStringList lines;
+    if (!UString::Load(lines, UString::Format(u"%s%d/cpulist", TS_NUMA_SYSFS, node)) || lines.empty()) {
+        return false;
+    }
+    UStringVector ranges;
+    lines.front().split(ranges, u',', true, true);
+    for (const auto& range : ranges) {
+        size_t first = 0, last = 0;
+        const size_t dash = range.find(u'-');
+        const bool valid = dash == NPOS ?
+            range.toInteger(first) && range.toInteger(last) :
+            range.substr(0, dash).toInteger(first) && range.substr(dash + 1).toInteger(last);
+        if (!valid) {
+            return false;
+        }
+        for (size_t cpu = first; cpu <= last; ++cpu) {
+            cpus.insert(cpu);
+        }
+    }
+    return !cpus.empty();
+
+#elif defined(TS_WINDOWS)
+
+    ::ULONGLONG mask = 0;
+    if (node > 0xFF || !::GetNumaNodeProcessorMask(::UCHAR(node), &mask)) {
+        return false;
+    }
+    for (size_t cpu = 0; cpu < 64; ++cpu) {
+        if ((mask & (1ULL << cpu)) != 0) {
+            cpus.insert(cpu);
+        }
+    }
+    return !cpus.empty();
+
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Bind an area of memory to a NUMA node.
+//----------------------------------------------------------------------------
+
+bool ts::BindMemoryToNUMANode(void* addr, size_t size, size_t node)
+{
+#if defined(TS_LINUX) && defined(__NR_mbind)
+    constexpr size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / bits + 1, 0);
+    mask[node / bits] = 1UL << (node % bits);
+    return ::syscall(__NR_mbind, addr, size, TS_MPOL_BIND, mask.data(), mask.size() * bits + 1, TS_MPOL_MF_MOVE) == 0;
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Set the CPU affinity and the preferred NUMA node of the calling thread.
+//----------------------------------------------------------------------------
+
+bool ts::SetCurrentThreadPlacement(const std::set<size_t>& cpus, size_t node)
+{
+    // Compute the final set of CPU's.
+    std::set<size_t> affinity(cpus);
+    std::set<size_t> node_cpus;
+    if (node != NPOS && GetNUMANodeCPUs(node, node_cpus)) {
+        if (cpus.empty()) {
+            affinity = node_cpus;
+        }
+        else {
+            // Use the CPU's of the node which were explicitly specified, if any.
+            std::set<size_t> common;
+            std::set_intersection(cpus.begin(), cpus.end(), node_cpus.begin(), node_cpus.end(), std::inserter(common, common.begin()));
+            if (!common.empty()) {
+                affinity = common;
+            }
+        }
+    }
+    bool success = true;
+
+#if defined(TS_LINUX)
+
+    if (!affinity.empty()) {
+        ::cpu_set_t set;
+        CPU_ZERO(&set);
+        for (size_t cpu : affinity) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        success = ::sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+#if defined(__NR_set_mempolicy)
+    if (node != NPOS) {
+        constexpr size_t bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> mask(node / bits + 1, 0);
+        mask[node / bits] = 1UL << (node % bits);
+        success = ::syscall(__NR_set_mempolicy, TS_MPOL_PREFERRED, mask.data(), mask.size() * bits + 1) == 0 && success;
+    }
+#endif
+
+#elif defined(TS_WINDOWS)
+
+    if (!affinity.empty()) {
+        ::DWORD_PTR mask = 0;
+        for (size_t cpu : affinity) {
+            if (cpu < 8 * sizeof(mask)) {
+                mask |= ::DWORD_PTR(1) << cpu;
+            }
+        }
+        success = mask != 0 && ::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0;
+    }
+
+#else
+    success = affinity.empty() && node == NPOS;
+#endif
+
+    return success;
+}
@@ -0,0 +1,55 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Utilities for CPU affinity and NUMA (Non-Uniform Memory Access) placement.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Get the number of NUMA nodes in the system.
+    //! @ingroup libtscore system
+    //! @return The number of NUMA nodes. On systems without NUMA support, return 1.
+    //!
+    TSCOREDLL size_t NUMANodeCount();
+
+    //!
+    //! Get the set of CPU's which belong to a NUMA node.
+    //! @ingroup libtscore system
+    //! @param [in] node NUMA node index.
+    //! @param [out] cpus Set of CPU indexes in @a node.
+    //! @return True on success, false if the node does not exist or NUMA is not supported.
+    //!
+    TSCOREDLL bool GetNUMANodeCPUs(size_t node, std::set<size_t>& cpus);
+
+    //!
+    //! Bind an area of memory to a NUMA node.
+    //! Memory pages which were not yet accessed are physically allocated on the specified
+    //! NUMA node when they are first accessed. Existing pages are moved when possible.
+    //! @ingroup libtscore system
+    //! @param [in] addr Address of the memory area. Must be aligned on a memory page.
+    //! @param [in] size Size in bytes of the memory area.
+    //! @param [in] node NUMA node index.
+    //! @return True on success, false on error or if NUMA is not supported.
+    //!
+    TSCOREDLL bool BindMemoryToNUMANode(void* addr, size_t size, size_t node);
+
+    //!
+    //! Set the CPU affinity and the preferred NUMA node of the calling thread.
+    //! @ingroup libtscore system
+    //! @param [in] cpus Set of CPU's on which the thread may run. Ignored if empty.
+    //! @param [in] node NUMA node. When not NPOS, the thread runs on the CPU's of this node
+    //! (restricted to @a cpus if they intersect) and allocates memory from this node.
+    //! @return True on success, false on error or if not supported on this operating system.
+    //!
+    TSCOREDLL bool SetCurrentThreadPlacement(const std::set<size_t>& cpus, size_t node);
+}
@@ -15,6 +15,7 @@
 #include "tsSysUtils.h"
 #include "tsIntegerUtils.h"
 #include "tsSysInfo.h"
+#include "tsNUMA.h"
 
 namespace ts {
     //!
@@ -40,8 +41,9 @@ namespace ts {
         //! page faults.
         //!
         //! @param [in] elem_count Number of @a T elements.
+        //! @param [in] numa_node When not NPOS, try to allocate the physical memory on this NUMA node.
         //!
-        ResidentBuffer(size_t elem_count);
+        ResidentBuffer(size_t elem_count, size_t numa_node = NPOS);
 
         //!
         //! Destructor.
@@ -91,7 +93,7 @@ namespace ts {
 
 // Constructor, based on required amount of T elements.
 template <typename T>
-ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
+ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count, size_t numa_node) :
     _elem_count(elem_count)
 {
     const size_t requested_size = elem_count * sizeof(T);
@@ -108,6 +110,12 @@ ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
     assert(sizeof(size_t) == sizeof(char_ptr));
     _locked_base = char_ptr(round_up(size_t(_allocated_base), page_size));
     _locked_size = round_up(requested_size, page_size);
+
+    // Bind to a NUMA node before any access to the memory pages. Failure is not an error.
+    if (numa_node != NPOS) {
+        BindMemoryToNUMANode(_locked_base, _locked_size, numa_node);
+    }
+
     _base = new (_locked_base) T[elem_count];
 
     // Integrity checks
@@ -288,11 +288,23 @@ ts::SysInfo::SysInfo() :
     // Can be globally disabled using environment variables.
     //
     if (GetEnvironment(u"TS_NO_HARDWARE_ACCELERATION").empty()) {
+        #if defined(TS_X86_64) && (defined(TS_GCC) || defined(TS_LLVM))
+            __builtin_cpu_init();
+        #endif
         if (GetEnvironment(u"TS_NO_CRC32_INSTRUCTIONS").empty()) {
             #if defined(TS_LINUX) && defined(HWCAP_CRC32)
                 _crcInstructions = tsCRC32IsAccelerated && (::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
-            #elif defined(TS_MAC)
+            #elif defined(TS_MAC) && defined(TS_ARM64)
                 _crcInstructions = tsCRC32IsAccelerated && SysCtrlBool("hw.optional.armv8_crc32");
+            #elif defined(TS_X86_64) && (defined(TS_GCC) || defined(TS_LLVM))
+                // On Intel, CRC32 is computed using carry-less multiplications.
+                _crcInstructions = tsCRC32IsAccelerated && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+            #endif
+        }
+        if (GetEnvironment(u"TS_NO_AVX_INSTRUCTIONS").empty()) {
+            #if defined(TS_X86_64) && (defined(TS_GCC) || defined(TS_LLVM))
+                _avx2Instructions = __builtin_cpu_supports("avx2");
+                _avx512Instructions = __builtin_cpu_supports("avx512f");
             #endif
         }
     }
@@ -335,7 +347,11 @@ TS_REGISTER_FEATURE(u"acceleration", u"Acceleration", ALWAYS, ts::SysInfo::GetAc
 
 ts::UString ts::SysInfo::GetAccelerations()
 {
-    return UString::Format(u"CRC32: %s", UString::YesNo(Instance().crcInstructions()));
+    UString str(UString::Format(u"CRC32: %s", UString::YesNo(Instance().crcInstructions())));
+    if (Instance().arch() == INTEL64) {
+        str.format(u", AVX2: %s, AVX-512: %s", UString::YesNo(Instance().avx2Instructions()), UString::YesNo(Instance().avx512Instructions()));
+    }
+    return str;
 }
 
 
@@ -90,6 +90,16 @@ namespace ts {
         //!
         bool crcInstructions() const { return _crcInstructions; }
         //!
+        //! Check if the CPU supports AVX2 instructions (Intel x86-64 only).
+        //! @return True if the CPU supports AVX2 instructions.
+        //!
+        bool avx2Instructions() const { return _avx2Instructions; }
+        //!
+        //! Check if the CPU supports AVX-512 foundation instructions (Intel x86-64 only).
+        //! @return True if the CPU supports AVX-512F instructions.
+        //!
+        bool avx512Instructions() const { return _avx512Instructions; }
+        //!
         //! Get the operating system version.
         //! @return The operating system version.
         //!
@@ -145,6 +155,8 @@ namespace ts {
         SysOS     _osFamily;
         SysFlavor _osFlavor = UNKNOWN;
         bool      _crcInstructions = false;
+        bool      _avx2Instructions = false;
+        bool      _avx512Instructions = false;
         int       _systemMajorVersion = -1;
         UString   _systemVersion {};
         UString   _systemName {};
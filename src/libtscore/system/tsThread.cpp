@@ -11,6 +11,7 @@
 #include "tsSysUtils.h"
 #include "tsSysInfo.h"
 #include "tsIntegerUtils.h"
+#include "tsNUMA.h"
 
 #if defined(TS_LINUX)
     #include "tsBeforeStandardHeaders.h"
@@ -321,8 +322,12 @@ void ts::Thread::mainWrapper()
 {
     // Set thread name. For debug or trace purpose only.
     UString name;
+    std::set<size_t> cpus;
+    size_t numa_node = NPOS;
     {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
+        cpus = _attributes.getCPUs();
+        numa_node = _attributes.getNUMANode();
         name = _attributes.getName();
         if (name.empty()) {
             name = _typename;
@@ -345,6 +350,12 @@ void ts::Thread::mainWrapper()
 #endif
     }
 
+    // Set CPU affinity and NUMA node, from within the thread, before allocating anything.
+    // This is a best effort, the thread runs anyway.
+    if (!cpus.empty() || numa_node != NPOS) {
+        SetCurrentThreadPlacement(cpus, numa_node);
+    }
+
     try {
         main();
     }
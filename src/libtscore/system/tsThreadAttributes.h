@@ -215,6 +215,61 @@ namespace ts {
             return _priority;
         }
 
+        //!
+        //! Set the CPU affinity of the thread.
+        //!
+        //! When the set is not empty, the thread only runs on the specified CPU's.
+        //! This is ignored on operating systems which do not support CPU affinity.
+        //!
+        //! @param [in] cpus Set of CPU indexes, starting at zero. When empty, the thread can run on any CPU.
+        //! @return A reference to this object.
+        //!
+        ThreadAttributes& setCPUs(const std::set<size_t>& cpus)
+        {
+            _cpus = cpus;
+            return *this;
+        }
+
+        //!
+        //! Get the CPU affinity of the thread.
+        //!
+        //! @return The set of CPU indexes. When empty, the thread can run on any CPU.
+        //! @see setCPUs()
+        //!
+        const std::set<size_t>& getCPUs() const
+        {
+            return _cpus;
+        }
+
+        //!
+        //! Set the NUMA node of the thread.
+        //!
+        //! The thread runs on the CPU's of the specified NUMA node and preferably allocates memory
+        //! from this node. If CPU's are also specified using setCPUs(), the thread runs on the CPU's
+        //! of the node which are in that set. This is ignored on operating systems which do not support
+        //! NUMA placement.
+        //!
+        //! @param [in] node NUMA node index, starting at zero. When NPOS, the thread is not bound to any node.
+        //! @return A reference to this object.
+        //! @see setCPUs()
+        //!
+        ThreadAttributes& setNUMANode(size_t node)
+        {
+            _numaNode = node;
+            return *this;
+        }
+
+        //!
+        //! Get the NUMA node of the thread.
+        //!
+        //! @return The NUMA node index or NPOS when the thread is not bound to any node.
+        //! @see setNUMANode()
+        //!
+        size_t getNUMANode() const
+        {
+            return _numaNode;
+        }
+
         //!
         //! Get the minimum priority for a thread in this context of the operating system.
         //! @return The minimum priority for a thread.
@@ -274,6 +329,8 @@ namespace ts {
         bool    _exitOnException = false;
         int     _priority = 0;
         UString _name {};
+        std::set<size_t> _cpus {};
+        size_t  _numaNode = NPOS;
 
         //
         // These fields describe the operating system priority range.
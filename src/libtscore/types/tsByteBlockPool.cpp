@@ -0,0 +1,161 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsByteBlockPool.h"
+
+
+//----------------------------------------------------------------------------
+// Shared state of the pool.
+//----------------------------------------------------------------------------
+
+class ts::ByteBlockPool::Slabs
+{
+    TS_NOBUILD_NOCOPY(Slabs);
+public:
+    // Number of size classes, from MIN_BLOCK_SIZE to MAX_BLOCK_SIZE, by powers of 2.
+    static constexpr size_t CLASS_COUNT = 7;
+    static_assert(MIN_BLOCK_SIZE << (CLASS_COUNT - 1) == MAX_BLOCK_SIZE);
+
+    // Constructor and destructor.
+    explicit Slabs(size_t max_free) : _max_free(max_free) {}
+    ~Slabs();
+
+    // Get a block of the specified size, allocate a new one if necessary.
+    ByteBlock* get(size_t size);
+
+    // Return a block to the pool.
+    void release(ByteBlock* block);
+
+    // Allocation statistics, protected by the mutex.
+    mutable std::mutex mutex {};
+    Statistics stats {};
+
+private:
+    const size_t _max_free;
+    std::array<std::vector<ByteBlock*>, CLASS_COUNT> _free {};
+
+    // Smallest class which can contain a given size.
+    static size_t ClassOf(size_t size)
+    {
+        size_t index = 0;
+        while ((MIN_BLOCK_SIZE << index) < size) {
+            index++;
+        }
+        return index;
+    }
+};
+
+ts::ByteBlockPool::Slabs::~Slabs()
+{
+    for (auto& list : _free) {
+        for (auto block : list) {
+            delete block;
+        }
+    }
+}
+
+ts::ByteBlock* ts::ByteBlockPool::Slabs::get(size_t size)
+{
+    const size_t index = ClassOf(size);
+    ByteBlock* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.allocations++;
+        if (!_free[index].empty()) {
+            stats.reused++;
+            block = _free[index].back();
+            _free[index].pop_back();
+        }
+        else {
+            stats.heap_allocations++;
+        }
+    }
+    if (block == nullptr) {
+        // Allocate the full class size, the block is reused later for any size in the same class.
+        block = new ByteBlock;
+        block->reserve(MIN_BLOCK_SIZE << index);
+    }
+    block->resize(size);
+    return block;
+}
+
+void ts::ByteBlockPool::Slabs::release(ByteBlock* block)
+{
+    // The block returns in the largest class which fits in its capacity.
+    // Its capacity may have changed if the application resized it.
+    const size_t capacity = block->capacity();
+    block->clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (capacity >= MIN_BLOCK_SIZE) {
+            size_t index = std::min(ClassOf(capacity), CLASS_COUNT - 1);
+            if ((MIN_BLOCK_SIZE << index) > capacity) {
+                index--;
+            }
+            if (_free[index].size() < _max_free) {
+                _free[index].push_back(block);
+                return;
+            }
+        }
+        // The class is full or the block was shrunk below the smallest class.
+        stats.deallocations++;
+    }
+    delete block;
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockPool::ByteBlockPool(size_t max_free) :
+    _slabs(std::make_shared<Slabs>(max_free))
+{
+}
+
+ts::ByteBlockPool::~ByteBlockPool()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate a byte block.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockPtr ts::ByteBlockPool::allocate(size_t size)
+{
+    if (size > MAX_BLOCK_SIZE) {
+        std::lock_guard<std::mutex> lock(_slabs->mutex);
+        _slabs->stats.allocations++;
+        _slabs->stats.oversized++;
+        return std::make_shared<ByteBlock>(size);
+    }
+    else {
+        // The deleter keeps the pool state alive until the block is released.
+        std::shared_ptr<Slabs> slabs(_slabs);
+        return ByteBlockPtr(slabs->get(size), [slabs](ByteBlock* block) { slabs->release(block); });
+    }
+}
+
+ts::ByteBlockPtr ts::ByteBlockPool::allocate(const void* data, size_t size)
+{
+    ByteBlockPtr block(allocate(size));
+    MemCopy(block->data(), data, size);
+    return block;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the allocation statistics.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockPool::Statistics ts::ByteBlockPool::statistics() const
+{
+    std::lock_guard<std::mutex> lock(_slabs->mutex);
+    return _slabs->stats;
+}
@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Pool of reusable byte blocks.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+
+namespace ts {
+
+    class ByteBlockPool;
+
+    //!
+    //! Safe pointer for ByteBlockPool.
+    //!
+    using ByteBlockPoolPtr = std::shared_ptr<ByteBlockPool>;
+
+    //!
+    //! Pool of reusable byte blocks, for applications which allocate many small blocks.
+    //! @ingroup libtscore cpp
+    //!
+    //! Byte blocks which are allocated from the pool are returned as ByteBlockPtr.
+    //! When the last safe pointer to a block is released, the block returns to the pool,
+    //! with its allocated memory, and is reused by subsequent allocations of similar size.
+    //!
+    //! Blocks are managed in size classes, by powers of 2, from MIN_BLOCK_SIZE to MAX_BLOCK_SIZE
+    //! bytes. Larger blocks are normally allocated, outside the pool. The maximum size is the
+    //! maximum size of a private section. The typical usage is the allocation of sections in
+    //! a demux.
+    //!
+    //! Blocks may be released from any thread. They may also be released after the destruction
+    //! of the ByteBlockPool object. The free blocks of the pool are deallocated when the pool
+    //! object and all its allocated blocks are released.
+    //!
+    class TSCOREDLL ByteBlockPool
+    {
+        TS_NOCOPY(ByteBlockPool);
+    public:
+        //!
+        //! Size of the smallest class of blocks in the pool.
+        //!
+        static constexpr size_t MIN_BLOCK_SIZE = 64;
+        //!
+        //! Size of the largest class of blocks in the pool.
+        //!
+        static constexpr size_t MAX_BLOCK_SIZE = 4096;
+
+        //!
+        //! Constructor.
+        //! @param [in] max_free Maximum number of free blocks to keep in each size class.
+        //! Blocks which are released when the class is full are deallocated.
+        //!
+        explicit ByteBlockPool(size_t max_free = 1024);
+
+        //!
+        //! Destructor.
+        //!
+        ~ByteBlockPool();
+
+        //!
+        //! Allocate a byte block.
+        //! @param [in] size Size of the block. The content is unspecified.
+        //! @return A safe pointer to the new block.
+        //!
+        ByteBlockPtr allocate(size_t size);
+
+        //!
+        //! Allocate a byte block, initialized from a data area.
+        //! @param [in] data Address of area to copy.
+        //! @param [in] size Size of the area to copy.
+        //! @return A safe pointer to the new block.
+        //!
+        ByteBlockPtr allocate(const void* data, size_t size);
+
+        //!
+        //! Allocation statistics.
+        //!
+        class TSCOREDLL Statistics
+        {
+        public:
+            uint64_t allocations = 0;       //!< Total number of allocated blocks.
+            uint64_t reused = 0;            //!< Number of allocations which reused a free block.
+            uint64_t heap_allocations = 0;  //!< Number of allocations of new blocks in the pool.
+            uint64_t oversized = 0;         //!< Number of allocations which were too large for the pool.
+            uint64_t deallocations = 0;     //!< Number of released blocks which were deallocated, when a class is full or the block was shrunk.
+        };
+
+        //!
+        //! Get the allocation statistics.
+        //! @return Current statistics of the pool.
+        //!
+        Statistics statistics() const;
+
+    private:
+        // Shared state of the pool, kept alive by allocated blocks.
+        class Slabs;
+        std::shared_ptr<Slabs> _slabs;
+    };
+}
@@ -18,6 +18,12 @@
 #include "tsIntegerUtils.h"
 #include "tsNames.h"
 
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
 
 //----------------------------------------------------------------------------
 // A static empty string.
@@ -86,6 +92,30 @@ void ts::UString::ConvertUTF16ToUTF8(const UChar*& in_start, const UChar* in_end
 
     while (in_start < in_end && out_start < out_end) {
 
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        // Vectorized fast path: 16 ASCII characters at a time, each of them producing one byte.
+        // It is only tried on an ASCII character to avoid useless checks on non-Latin text.
+        if (*in_start < 0x0080 && in_end - in_start >= 16 && out_end - out_start >= 16) {
+            const uint16_t* const in = reinterpret_cast<const uint16_t*>(in_start);
+        #if defined(__SSE2__)
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+            const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(int16_t(0xFF80)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_start), _mm_packus_epi16(a, b));
+        #else
+            const uint16x8_t a = vld1q_u16(in);
+            const uint16x8_t b = vld1q_u16(in + 8);
+            if (vmaxvq_u16(vorrq_u16(a, b)) < 0x0080) {
+                vst1q_u8(reinterpret_cast<uint8_t*>(out_start), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+        #endif
+                in_start += 16;
+                out_start += 16;
+                continue;
+            }
+        }
+#endif
+
         // Get current code point as 16-bit value.
         code = *in_start++;
 
@@ -197,6 +227,29 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& in_start, const char* in_end,
 
     while (in_start < in_end && out_start < out_end) {
 
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        // Vectorized fast path: 16 ASCII bytes at a time, each of them producing one UTF-16 value.
+        // It is only tried on an ASCII byte to avoid useless checks on non-Latin text.
+        if ((*in_start & 0x80) == 0 && in_end - in_start >= 16 && out_end - out_start >= 16) {
+            uint16_t* const out = reinterpret_cast<uint16_t*>(out_start);
+        #if defined(__SSE2__)
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_start));
+            if (_mm_movemask_epi8(v) == 0) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+        #else
+            const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(in_start));
+            if (vmaxvq_u8(v) < 0x80) {
+                vst1q_u16(out, vmovl_u8(vget_low_u8(v)));
+                vst1q_u16(out + 8, vmovl_u8(vget_high_u8(v)));
+        #endif
+                in_start += 16;
+                out_start += 16;
+                continue;
+            }
+        }
+#endif
+
         // Get current code point at 8-bit value.
         code = *in_start++ & 0xFF;
 
@@ -30,11 +30,13 @@ namespace ts::xml {
     //!
     class TSCOREDLL Element: public Node
     {
-    private:
-        // Attributes are stored indexed by case-(in)sensitive name.
+    public:
+        //!
+        //! Map of attributes, indexed by case-(in)sensitive name.
+        //! With case-insensitive attribute names, the index is the lower-case name.
+        //!
         using AttributeMap = std::map<UString, Attribute>;
 
-    public:
         //!
         //! Constructor.
         //! @param [in,out] report Where to report errors.
@@ -886,6 +888,14 @@ namespace ts::xml {
         //!
         size_t getAttributesCount() const { return _attributes.size(); }
 
+        //!
+        //! Get a read-only access to all attributes of the element, without copy.
+        //! The index in the map is the same as in getAttributes().
+        //! @return A constant reference to the map of attributes.
+        //! The reference is valid as long as the Element object is not modified.
+        //!
+        const AttributeMap& attributes() const { return _attributes; }
+
         //!
         //! Recursively merge another element into this one.
         //! @param [in,out] other Another element to merge. The @a other object is destroyed,
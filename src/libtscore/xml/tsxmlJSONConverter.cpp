@@ -205,6 +205,213 @@ ts::json::ValuePtr ts::xml::JSONConverter::convertChildrenToJSON(const Element*
 }
 
 
+//----------------------------------------------------------------------------
+// Convert an XML document into one-line JSON text, without JSON values.
+// The structure of the following methods is the same as the methods which
+// build JSON values above. Keep them consistent.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::convertToJSON(const Document& source, json::TextWriter& output, bool force_root) const
+{
+    const xml::Element* docRoot = source.rootElement();
+
+    if (docRoot == nullptr) {
+        report().error(u"invalid XML document, no root element");
+        output.nullValue();
+    }
+    else {
+        // Ignore the model if the model root has a different name from the source root.
+        const Element* modelRoot = rootElement();
+        if (modelRoot != nullptr && !modelRoot->name().similar(docRoot->name())) {
+            modelRoot = nullptr;
+        }
+        if (tweaks().x2jIncludeRoot || force_root) {
+            writeElementJSON(modelRoot, docRoot, tweaks(), output);
+        }
+        else {
+            writeChildrenJSON(modelRoot, docRoot, tweaks(), output);
+        }
+    }
+}
+
+void ts::xml::JSONConverter::convertToJSON(const Element* source, json::TextWriter& output) const
+{
+    if (source == nullptr) {
+        output.nullValue();
+        return;
+    }
+
+    // Path of elements from the document root to the source element.
+    std::vector<const Element*> path;
+    for (const Node* node = source; node != nullptr; node = node->parent()) {
+        const Element* elem = dynamic_cast<const Element*>(node);
+        if (elem != nullptr) {
+            path.push_back(elem);
+        }
+    }
+
+    // Follow the same path in the model, starting with the root.
+    const Element* model = rootElement();
+    if (model != nullptr && !model->name().similar(path.back()->name())) {
+        model = nullptr;
+    }
+    for (size_t i = path.size() - 1; model != nullptr && i > 0; --i) {
+        model = findModelElement(model, path[i - 1]->name());
+    }
+
+    writeElementJSON(model, source, tweaks(), output);
+}
+
+
+//----------------------------------------------------------------------------
+// Direct serialization of an XML tree of elements.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Check if a model description starts with a type name, ignoring leading spaces and case, without copy.
+    bool DescriptionStartsWith(const ts::UString& description, const ts::UChar* prefix)
+    {
+        size_t i = 0;
+        while (i < description.size() && ts::IsSpace(description[i])) {
+            i++;
+        }
+        for (; *prefix != 0; ++prefix, ++i) {
+            if (i >= description.size() || ts::ToLower(description[i]) != ts::ToLower(*prefix)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void ts::xml::JSONConverter::writeElementJSON(const Element* model, const Element* source, const Tweaks& xml_tweaks, json::TextWriter& output) const
+{
+    output.beginObject();
+
+    // The JSON object is sorted by field names. Since "#" sorts before all valid XML attribute
+    // names, the name and the children come first, then all attributes in the order of the map.
+    output.key(HashName);
+    output.stringValue(source->name());
+    if (source->hasChildren()) {
+        output.key(HashNodes);
+        writeChildrenJSON(model, source, xml_tweaks, output);
+    }
+
+    for (const auto& it : source->attributes()) {
+
+        const UString& value(it.second.value());
+        int64_t intValue = 0;
+        bool boolValue = false;
+        bool done = false;
+
+        // Get description of this attribute in the model, without copying it.
+        bool intModel = false;
+        bool boolModel = false;
+        if (model != nullptr) {
+            const UString& description(model->attribute(it.first, true).value());
+            intModel = DescriptionStartsWith(description, u"uint") || DescriptionStartsWith(description, u"int");
+            boolModel = DescriptionStartsWith(description, u"bool");
+        }
+
+        output.key(it.first);
+
+        // Try to convert as an integer or boolean if defined as such by the model.
+        if (intModel) {
+            if (value.toInteger(intValue, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
+                // A "very negative" value is left as a string, see convertElementToJSON().
+                if (intValue < -0xFFFFFFFFLL) {
+                    output.stringValue(value);
+                }
+                else {
+                    output.integerValue(intValue);
+                }
+                done = true;
+            }
+            else {
+                source->report().warning(u"attribute '%s' in <%s> line %d is '%s' but should be an integer", it.first, source->name(), source->lineNumber(), value);
+            }
+        }
+        else if (boolModel) {
+            if (value.toBool(boolValue)) {
+                output.boolValue(boolValue);
+                done = true;
+            }
+            else {
+                source->report().warning(u"attribute '%s' in <%s> line %d is '%s' but should be a boolean", it.first, source->name(), source->lineNumber(), value);
+            }
+        }
+
+        // Try to enforce integer of boolean value if specified on command line.
+        if (!done && xml_tweaks.x2jEnforceInteger && !intModel && value.toInteger(intValue, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
+            output.integerValue(intValue);
+            done = true;
+        }
+        if (!done && xml_tweaks.x2jEnforceBoolean && !boolModel && value.toBool(boolValue)) {
+            output.boolValue(boolValue);
+            done = true;
+        }
+
+        // Use a string value by default.
+        if (!done) {
+            output.stringValue(value);
+        }
+    }
+
+    output.endObject();
+}
+
+
+//----------------------------------------------------------------------------
+// Direct serialization of all children of an element as a JSON array.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::writeChildrenJSON(const Element* model, const Element* parent, const Tweaks& xml_tweaks, json::TextWriter& output) const
+{
+    output.beginArray();
+
+    // Content of the text children in the model.
+    bool getTextModel = model != nullptr;
+    bool hexaModel = false;
+
+    // Loop on all children nodes.
+    bool lastNode = false;
+    for (const Node* child = parent->firstChild(); child != nullptr && !lastNode; child = child->nextSibling()) {
+        lastNode = child == parent->lastChild();
+
+        // Interpret the child either as an Element or a Text node.
+        // Other types of nodes are ignored.
+        const Element* elem = dynamic_cast<const Element*>(child);
+        const Text* text = dynamic_cast<const Text*>(child);
+
+        if (elem != nullptr) {
+            writeElementJSON(findModelElement(model, elem->name()), elem, xml_tweaks, output);
+        }
+        else if (text != nullptr) {
+            // Get the model description once only.
+            if (getTextModel) {
+                getTextModel = false;
+                UString textModel;
+                model->getText(textModel, true);
+                hexaModel = textModel.starts_with(u"hexa", CASE_INSENSITIVE);
+            }
+            // Trim the text content according to model and command line options.
+            const bool trim = hexaModel || xml_tweaks.x2jTrimText;
+            const bool collapse = hexaModel || xml_tweaks.x2jCollapseText;
+            if (trim || collapse) {
+                UString content(text->value());
+                content.trim(trim, trim, collapse);
+                output.stringValue(content);
+            }
+            else {
+                output.stringValue(text->value());
+            }
+        }
+    }
+
+    output.endArray();
+}
+
+
 //----------------------------------------------------------------------------
 // Build a valid XML element name from a JSON string.
 //----------------------------------------------------------------------------
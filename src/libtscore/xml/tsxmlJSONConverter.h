@@ -15,6 +15,7 @@
 #include "tsxmlDocument.h"
 #include "tsxmlModelDocument.h"
 #include "tsjson.h"
+#include "tsjsonTextWriter.h"
 #include "tsReport.h"
 
 namespace ts::xml {
@@ -75,6 +76,25 @@ namespace ts::xml {
         //!
         json::ValuePtr convertToJSON(const Document& source, bool force_root = false) const;
 
+        //!
+        //! Convert an XML document into one-line JSON text, without building JSON values.
+        //! The produced text is identical to convertToJSON(source, force_root)->oneLiner().
+        //! @param [in] source The source XML document to convert.
+        //! @param [in,out] output Where to serialize the JSON text.
+        //! @param [in] force_root If true, force the option -\-x2j-include-root.
+        //!
+        void convertToJSON(const Document& source, json::TextWriter& output, bool force_root = false) const;
+
+        //!
+        //! Convert one XML element into one-line JSON text, without building JSON values.
+        //! The model of the element is located using the path of the element in its document.
+        //! When @a source is the first element in the root of a document (typically a table),
+        //! the produced text is identical to convertToJSON(document, true)->query(u"#nodes[0]").oneLiner().
+        //! @param [in] source The source XML element to convert.
+        //! @param [in,out] output Where to serialize the JSON text.
+        //!
+        void convertToJSON(const Element* source, json::TextWriter& output) const;
+
         //!
         //! Convert a JSON object into an XML document.
         //! Not all JSON values can be converted. Basically, only JSON objects which were previously
@@ -111,6 +131,9 @@ namespace ts::xml {
         // Convert all children of an element as a JSON array. Null pointer on error or if not convertible.
         json::ValuePtr convertChildrenToJSON(const Element* model, const Element* parent, const Tweaks&) const;
 
+        // Direct serialization of an XML tree of elements or all children of an element.
+        void writeElementJSON(const Element* model, const Element* source, const Tweaks&, json::TextWriter& output) const;
+        void writeChildrenJSON(const Element* model, const Element* parent, const Tweaks&, json::TextWriter& output) const;
         // Build a valid XML element name from a JSON string.
         static UString ToElementName(const UString& str);
 
@@ -0,0 +1,28 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Bitsliced DVB-CSA2 engine on 512 lanes, using AVX-512 instructions.
+// This module is compiled with special options to use optional instructions
+// for the target architecture. It may fail when these instructions are not
+// implemented in the current CPU. Consequently, this module shall not be
+// called when these instructions are not implemented.
+//
+//----------------------------------------------------------------------------
+
+#define TS_DVBCSA2_SLICE_IMPLEMENTATION 1
+#include "tsDVBCSA2Slice.h"
+
+// "Hidden" exported bool to inform the DVBCSA2 class that we have compiled accelerated instructions.
+extern const bool tsDVBCSA2AVX512IsAccelerated =
+#if defined(__AVX512F__)
+    true;
+#else
+    false;
+#endif
+
+TS_DVBCSA2_SLICE_ENGINE(DVBCSA2Slice512, Word512);
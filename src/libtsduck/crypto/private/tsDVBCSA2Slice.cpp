@@ -0,0 +1,19 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Bitsliced DVB-CSA2 engine, portable implementations.
+// The 128-lane version uses SSE2 on x86-64 and Neon on Arm64, which are
+// always available on these architectures.
+//
+//----------------------------------------------------------------------------
+
+#define TS_DVBCSA2_SLICE_IMPLEMENTATION 1
+#include "tsDVBCSA2Slice.h"
+
+TS_DVBCSA2_SLICE_ENGINE(DVBCSA2Slice64, uint64_t);
+TS_DVBCSA2_SLICE_ENGINE(DVBCSA2Slice128, Word128);
@@ -0,0 +1,687 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bitsliced implementation of the DVB-CSA2 stream cipher (private header).
+//!
+//!  In a bitsliced implementation, each bit of the cipher state is stored in
+//!  one bit of a large machine word and the word contains the same state bit
+//!  for many independent packets ("lanes"). All packets are processed with
+//!  the same sequence of bitwise instructions. The width of the machine word
+//!  gives the number of packets which are processed at the same time: 64 with
+//!  a plain 64-bit integer, 128 with SSE2 or Neon, 256 with AVX2, 512 with
+//!  AVX-512.
+//!
+//!  This header contains the template implementation. It is included by
+//!  several modules which are compiled with distinct instruction sets. All
+//!  definitions are in an anonymous namespace to make sure that no function
+//!  which is compiled with an optional instruction set can be shared with
+//!  another module.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+// "Hidden" exported bools to inform the DVBCSA2 class that we have compiled accelerated instructions.
+extern const bool tsDVBCSA2AVX2IsAccelerated;
+extern const bool tsDVBCSA2AVX512IsAccelerated;
+
+namespace ts {
+    //!
+    //! A bitsliced DVB-CSA2 engine, for a given machine word size.
+    //! All functions process a set of independent data blocks in parallel, using the same control word.
+    //!
+    struct DVBCSA2SliceEngine
+    {
+        //!
+        //! Max number of data blocks which are processed in parallel by the stream cipher.
+        //!
+        size_t stream_lanes;
+        //!
+        //! Max number of data blocks which are processed in parallel by the block cipher.
+        //!
+        size_t block_lanes;
+        //!
+        //! Apply the stream cipher on up to @a stream_lanes data blocks.
+        //! Each data block is a TS packet payload, from 8 to 184 bytes. For each data block, the stream cipher
+        //! is initialized with the control word and the first 8 bytes of the data block. Then, the key stream
+        //! is applied (exclusive or) on the rest of the data block.
+        //! @param [in] cw Control word, 8 bytes, after optional entropy reduction.
+        //! @param [in,out] data Array of @a count data blocks.
+        //! @param [in] sizes Array of @a count data block sizes.
+        //! @param [in] count Number of data blocks.
+        //!
+        void (*stream)(const uint8_t* cw, uint8_t* const data[], const size_t sizes[], size_t count);
+        //!
+        //! Encipher up to @a block_lanes data blocks in reverse CBC mode with a zero IV, in place.
+        //! @param [in] kk Scheduled key, index 1 to 56.
+        //! @param [in,out] data Array of @a count data blocks.
+        //! @param [in] nblocks Array of @a count numbers of 8-byte blocks in each data block.
+        //! @param [in] count Number of data blocks.
+        //!
+        void (*encipher)(const int* kk, uint8_t* const data[], const size_t nblocks[], size_t count);
+        //!
+        //! Decipher up to @a block_lanes independent 8-byte blocks.
+        //! @param [in] kk Scheduled key, index 1 to 56.
+        //! @param [in] in Array of @a count input 8-byte blocks.
+        //! @param [out] out Array of @a count output 8-byte blocks.
+        //! @param [in] count Number of blocks.
+        //!
+        void (*decipher)(const int* kk, const uint8_t* const in[], uint8_t* const out[], size_t count);
+    };
+
+    extern const DVBCSA2SliceEngine DVBCSA2Slice64;   //!< Bitsliced engine on 64-bit words, portable implementation.
+    extern const DVBCSA2SliceEngine DVBCSA2Slice128;  //!< Bitsliced engine on 128-bit words, using SSE2 or Neon when available.
+    extern const DVBCSA2SliceEngine DVBCSA2Slice256;  //!< Bitsliced engine on 256-bit words, using AVX2. Never use if not accelerated.
+    extern const DVBCSA2SliceEngine DVBCSA2Slice512;  //!< Bitsliced engine on 512-bit words, using AVX-512. Never use if not accelerated.
+}
+
+// Template implementation, only when compiling the engine modules.
+#if defined(TS_DVBCSA2_SLICE_IMPLEMENTATION)
+
+namespace {
+
+    //------------------------------------------------------------------------
+    // Machine words. Use the compiler vector extensions when available.
+    //------------------------------------------------------------------------
+
+#if defined(TS_GCC) || defined(TS_LLVM)
+    typedef uint64_t Word128 __attribute__((vector_size(16)));
+    typedef uint64_t Word256 __attribute__((vector_size(32)));
+    typedef uint64_t Word512 __attribute__((vector_size(64)));
+#else
+    // Without vector extensions, rely on the compiler auto-vectorization.
+    template <size_t N>
+    struct WordArray
+    {
+        uint64_t v[N] {};
+        WordArray operator~() const { WordArray r; for (size_t i = 0; i < N; ++i) { r.v[i] = ~v[i]; } return r; }
+        WordArray operator&(const WordArray& w) const { WordArray r; for (size_t i = 0; i < N; ++i) { r.v[i] = v[i] & w.v[i]; } return r; }
+        WordArray operator|(const WordArray& w) const { WordArray r; for (size_t i = 0; i < N; ++i) { r.v[i] = v[i] | w.v[i]; } return r; }
+        WordArray operator^(const WordArray& w) const { WordArray r; for (size_t i = 0; i < N; ++i) { r.v[i] = v[i] ^ w.v[i]; } return r; }
+        WordArray operator<<(int n) const { WordArray r; for (size_t i = 0; i < N; ++i) { r.v[i] = v[i] << n; } return r; }
+        WordArray operator>>(int n) const { WordArray r; for (size_t i = 0; i < N; ++i) { r.v[i] = v[i] >> n; } return r; }
+        uint64_t& operator[](size_t i) { return v[i]; }
+    };
+    using Word128 = WordArray<2>;
+    using Word256 = WordArray<4>;
+    using Word512 = WordArray<8>;
+#endif
+
+    // Access byte g of a word, holding lanes 8*g to 8*g+7 in the stream cipher, or lane g in the block cipher.
+    // Since all operations are bitwise, the mapping of lanes is independent of the endianness.
+    template <class WORD>
+    inline uint8_t& WordByte(WORD& w, size_t g) { return reinterpret_cast<uint8_t*>(&w)[g]; }
+
+    // A word with the same 64-bit value in all elements.
+    template <class WORD>
+    inline WORD Splat(uint64_t value)
+    {
+        if constexpr (sizeof(WORD) == sizeof(uint64_t)) {
+            return value;
+        }
+        else {
+            WORD w {};
+            for (size_t i = 0; i < sizeof(WORD) / sizeof(uint64_t); ++i) {
+                w[i] = value;
+            }
+            return w;
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // Transpose an 8x8 bit matrix (row r in byte r, column c in bit c).
+    // See "Hacker's Delight", section 7-3.
+    //------------------------------------------------------------------------
+
+    inline uint64_t Transpose8x8(uint64_t x)
+    {
+        uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AA;
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCC;
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0;
+        return x ^ t ^ (t << 28);
+    }
+
+    //------------------------------------------------------------------------
+    // Stream cipher S-boxes: 5 input bits, 2 output bits.
+    // Same content as in tsDVBCSA2.cpp.
+    //------------------------------------------------------------------------
+
+    constexpr uint8_t slice_sbox[7][32] = {
+        {2,0,1,1,2,3,3,0, 3,2,2,0,1,1,0,3, 0,3,3,0,2,2,1,1, 2,2,0,3,1,1,3,0},
+        {3,1,0,2,2,3,3,0, 1,3,2,1,0,0,1,2, 3,1,0,3,3,2,0,2, 0,0,1,2,2,1,3,1},
+        {2,0,1,2,2,3,3,1, 1,1,0,3,3,0,2,0, 1,3,0,1,3,0,2,2, 2,0,1,2,0,3,3,1},
+        {3,1,2,3,0,2,1,2, 1,2,0,1,3,0,0,3, 1,0,3,1,2,3,0,3, 0,3,2,0,1,2,2,1},
+        {2,0,0,1,3,2,3,2, 0,1,3,3,1,0,2,1, 2,3,2,0,0,3,1,1, 1,0,3,2,3,1,0,2},
+        {0,1,2,3,1,2,2,0, 0,1,3,0,2,3,1,3, 2,3,0,2,3,0,1,1, 2,1,1,2,0,3,3,0},
+        {0,3,2,2,3,0,0,1, 3,0,1,3,1,2,2,1, 1,0,3,3,0,1,1,2, 2,3,1,0,2,3,0,2},
+    };
+
+    // Truth table of one output bit of one S-box: bit x of the result is the output for input x.
+    constexpr uint64_t TruthTable(size_t sbox, size_t bit)
+    {
+        uint64_t tt = 0;
+        for (size_t x = 0; x < 32; ++x) {
+            tt |= uint64_t((slice_sbox[sbox][x] >> bit) & 1) << x;
+        }
+        return tt;
+    }
+
+    // Mask of a truth table with N input variables.
+    constexpr uint64_t TruthMask(size_t n) { return n >= 6 ? ~uint64_t(0) : (uint64_t(1) << (size_t(1) << n)) - 1; }
+
+    // Evaluate a boolean function of N variables, given by its truth table, on bitsliced words.
+    // The truth table is known at compile time. We use a Shannon expansion on the highest variable,
+    // simplifying constant and duplicated cofactors. The compiler reduces each S-box to a short
+    // sequence of bitwise operations.
+    template <class WORD, uint64_t TT, size_t N>
+    inline WORD Eval(const WORD* in)
+    {
+        if constexpr (TT == 0) {
+            return WORD{};
+        }
+        else if constexpr (TT == TruthMask(N)) {
+            return ~WORD{};
+        }
+        else if constexpr (N == 1) {
+            // Only remaining cases: identity (0b10) or complement (0b01).
+            if constexpr (TT == 2) {
+                return in[0];
+            }
+            else {
+                return ~in[0];
+            }
+        }
+        else {
+            constexpr uint64_t lo = TT & TruthMask(N - 1);
+            constexpr uint64_t hi = (TT >> (size_t(1) << (N - 1))) & TruthMask(N - 1);
+            if constexpr (lo == hi) {
+                return Eval<WORD, lo, N - 1>(in);
+            }
+            else if constexpr (hi == (~lo & TruthMask(N - 1))) {
+                return Eval<WORD, lo, N - 1>(in) ^ in[N - 1];
+            }
+            else {
+                const WORD l = Eval<WORD, lo, N - 1>(in);
+                return l ^ ((l ^ Eval<WORD, hi, N - 1>(in)) & in[N - 1]);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // Bitsliced stream cipher. Same structure as DVBCSA2::DVBStreamCipher,
+    // where each bit of each register is replaced by a word of lanes.
+    //------------------------------------------------------------------------
+
+    template <class WORD>
+    class StreamSlice
+    {
+    public:
+        // Number of lanes in a word.
+        static constexpr size_t LANES = 8 * sizeof(WORD);
+
+        // Number of cipher clocks per 8-byte block.
+        static constexpr size_t CLOCKS = 32;
+
+        // Initialize the state with the same control word in all lanes.
+        void init(const uint8_t* cw);
+
+        // Initialize the state with 8 input bytes per lane. in[i][b] is bit b of input byte i.
+        void initInput(const WORD in[8][8]);
+
+        // Generate 8 bytes of key stream per lane. out[i][b] is bit b of output byte i.
+        void generate(WORD out[8][8]);
+
+    private:
+        // Registers A and B are shift registers of 10 nibbles. They are stored in a larger area
+        // to avoid shifting the registers at each clock. A[i] is _a[_pos + i - 1], 1 <= i <= 10.
+        WORD   _a[10 + CLOCKS][4];
+        WORD   _b[10 + CLOCKS][4];
+        size_t _pos;
+        WORD   _x[4], _y[4], _z[4], _d[4], _e[4], _f[4];
+        WORD   _p, _q, _r;
+
+        // Move registers A and B at the end of their area, before a sequence of 32 clocks.
+        void rewind();
+
+        // One cipher clock. With INIT, in1 and in2 are the two nibbles of the input byte.
+        // Return the two output bits in hi and lo.
+        template <bool INIT>
+        void clock(const WORD* in1, const WORD* in2, bool odd, WORD& hi, WORD& lo);
+    };
+
+    template <class WORD>
+    void StreamSlice<WORD>::init(const uint8_t* cw)
+    {
+        const WORD zero {};
+        for (auto& nibble : _a) {
+            for (auto& w : nibble) {
+                w = zero;
+            }
+        }
+        for (auto& nibble : _b) {
+            for (auto& w : nibble) {
+                w = zero;
+            }
+        }
+        _pos = CLOCKS;
+
+        // Load first 32 bits of key into A[1]..A[8], last 32 bits of key into B[1]..B[8].
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t k = 0; k < 4; ++k) {
+                // A[2n+1] is the high nibble of key[n], A[2n+2] the low nibble.
+                const int nibble_a = (cw[i / 2] >> ((i % 2) ? 0 : 4)) & 0x0F;
+                const int nibble_b = (cw[4 + i / 2] >> ((i % 2) ? 0 : 4)) & 0x0F;
+                _a[_pos + i][k] = ((nibble_a >> k) & 1) ? ~zero : zero;
+                _b[_pos + i][k] = ((nibble_b >> k) & 1) ? ~zero : zero;
+            }
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            _x[k] = _y[k] = _z[k] = _d[k] = _e[k] = _f[k] = zero;
+        }
+        _p = _q = _r = zero;
+    }
+
+    template <class WORD>
+    void StreamSlice<WORD>::rewind()
+    {
+        if (_pos != CLOCKS) {
+            for (size_t i = 10; i-- > 0; ) {
+                for (size_t k = 0; k < 4; ++k) {
+                    _a[CLOCKS + i][k] = _a[_pos + i][k];
+                    _b[CLOCKS + i][k] = _b[_pos + i][k];
+                }
+            }
+            _pos = CLOCKS;
+        }
+    }
+
+    template <class WORD>
+    void StreamSlice<WORD>::initInput(const WORD in[8][8])
+    {
+        rewind();
+        WORD hi, lo;
+        for (size_t i = 0; i < 8; ++i) {
+            // in1 = most significant nibble of input byte, in2 = least significant nibble.
+            const WORD* in1 = in[i] + 4;
+            const WORD* in2 = in[i];
+            for (size_t j = 0; j < 4; ++j) {
+                clock<true>(in1, in2, (j % 2) != 0, hi, lo);
+            }
+        }
+    }
+
+    template <class WORD>
+    void StreamSlice<WORD>::generate(WORD out[8][8])
+    {
+        rewind();
+        for (size_t i = 0; i < 8; ++i) {
+            // 2 output bits per clock, most significant first.
+            for (size_t j = 0; j < 4; ++j) {
+                clock<false>(nullptr, nullptr, false, out[i][7 - 2 * j], out[i][6 - 2 * j]);
+            }
+        }
+    }
+
+    template <class WORD>
+    template <bool INIT>
+    inline void StreamSlice<WORD>::clock(const WORD* in1, const WORD* in2, bool odd, WORD& hi, WORD& lo)
+    {
+        // Current A and B registers, 1 to 10.
+        WORD (*A)[4] = _a + _pos - 1;
+        WORD (*B)[4] = _b + _pos - 1;
+
+        // From A[1]..A[10], 35 bits are selected as inputs to 7 s-boxes.
+        // Input bits are listed from least significant to most significant.
+        const WORD in_s1[5] = {A[9][0], A[7][3], A[6][1], A[1][2], A[4][0]};
+        const WORD in_s2[5] = {A[9][1], A[7][0], A[6][3], A[3][2], A[2][1]};
+        const WORD in_s3[5] = {A[6][2], A[5][3], A[5][1], A[2][0], A[1][3]};
+        const WORD in_s4[5] = {A[8][0], A[4][2], A[2][3], A[1][1], A[3][3]};
+        const WORD in_s5[5] = {A[9][2], A[8][1], A[6][0], A[4][3], A[5][2]};
+        const WORD in_s6[5] = {A[9][3], A[7][2], A[5][0], A[4][1], A[3][1]};
+        const WORD in_s7[5] = {A[8][3], A[8][2], A[7][1], A[3][0], A[2][2]};
+
+        const WORD s1_0 = Eval<WORD, TruthTable(0, 0), 5>(in_s1);
+        const WORD s1_1 = Eval<WORD, TruthTable(0, 1), 5>(in_s1);
+        const WORD s2_0 = Eval<WORD, TruthTable(1, 0), 5>(in_s2);
+        const WORD s2_1 = Eval<WORD, TruthTable(1, 1), 5>(in_s2);
+        const WORD s3_0 = Eval<WORD, TruthTable(2, 0), 5>(in_s3);
+        const WORD s3_1 = Eval<WORD, TruthTable(2, 1), 5>(in_s3);
+        const WORD s4_0 = Eval<WORD, TruthTable(3, 0), 5>(in_s4);
+        const WORD s4_1 = Eval<WORD, TruthTable(3, 1), 5>(in_s4);
+        const WORD s5_0 = Eval<WORD, TruthTable(4, 0), 5>(in_s5);
+        const WORD s5_1 = Eval<WORD, TruthTable(4, 1), 5>(in_s5);
+        const WORD s6_0 = Eval<WORD, TruthTable(5, 0), 5>(in_s6);
+        const WORD s6_1 = Eval<WORD, TruthTable(5, 1), 5>(in_s6);
+        const WORD s7_0 = Eval<WORD, TruthTable(6, 0), 5>(in_s7);
+        const WORD s7_1 = Eval<WORD, TruthTable(6, 1), 5>(in_s7);
+
+        // Use 4x4 xor to produce extra nibble for T3.
+        const WORD extra_b[4] = {
+            B[9][2] ^ B[6][3] ^ B[3][1] ^ B[8][0],
+            B[5][3] ^ B[8][2] ^ B[4][0] ^ B[5][1],
+            B[6][0] ^ B[8][1] ^ B[3][3] ^ B[4][2],
+            B[3][0] ^ B[6][1] ^ B[7][2] ^ B[9][3],
+        };
+
+        // T1 and T2, next values of A[1] and B[1].
+        WORD next_a1[4], next_b1[4];
+        for (size_t k = 0; k < 4; ++k) {
+            next_a1[k] = A[10][k] ^ _x[k];
+            next_b1[k] = B[7][k] ^ B[10][k] ^ _y[k];
+            if constexpr (INIT) {
+                next_a1[k] = next_a1[k] ^ _d[k] ^ (odd ? in2[k] : in1[k]);
+                next_b1[k] = next_b1[k] ^ (odd ? in1[k] : in2[k]);
+            }
+        }
+
+        // If p=1, rotate next B[1] left.
+        const WORD rot_b1[4] = {
+            next_b1[0] ^ (_p & (next_b1[0] ^ next_b1[3])),
+            next_b1[1] ^ (_p & (next_b1[1] ^ next_b1[0])),
+            next_b1[2] ^ (_p & (next_b1[2] ^ next_b1[1])),
+            next_b1[3] ^ (_p & (next_b1[3] ^ next_b1[2])),
+        };
+
+        // T3 = xor all inputs. T4 = sum, carry of Z + E + r when q=1, E otherwise.
+        WORD carry = _r;
+        for (size_t k = 0; k < 4; ++k) {
+            const WORD ze = _z[k] ^ _e[k];
+            const WORD sum = ze ^ carry;
+            carry = (_z[k] & _e[k]) | (carry & ze);
+            _d[k] = _e[k] ^ _z[k] ^ extra_b[k];
+            const WORD next_f = _e[k] ^ (_q & (sum ^ _e[k]));
+            _e[k] = _f[k];
+            _f[k] = next_f;
+        }
+        _r = _r ^ (_q & (carry ^ _r));
+
+        // Shift registers A and B.
+        --_pos;
+        for (size_t k = 0; k < 4; ++k) {
+            _a[_pos][k] = next_a1[k];
+            _b[_pos][k] = rot_b1[k];
+        }
+
+        // New values of X, Y, Z, p, q from the s-boxes outputs.
+        _x[3] = s4_0; _x[2] = s3_0; _x[1] = s2_1; _x[0] = s1_1;
+        _y[3] = s6_0; _y[2] = s5_0; _y[1] = s4_1; _y[0] = s3_1;
+        _z[3] = s2_0; _z[2] = s1_0; _z[1] = s6_1; _z[0] = s5_1;
+        _p = s7_1;
+        _q = s7_0;
+
+        // 2 output bits are a function of the 4 bits of D, xor 2 by 2.
+        hi = _d[2] ^ _d[3];
+        lo = _d[0] ^ _d[1];
+    }
+
+    //------------------------------------------------------------------------
+    // Apply the bitsliced stream cipher on a set of data blocks.
+    //------------------------------------------------------------------------
+
+    template <class WORD>
+    void StreamSliceProcess(const uint8_t* cw, uint8_t* const data[], const size_t sizes[], size_t count)
+    {
+        using Slice = StreamSlice<WORD>;
+        assert(count <= Slice::LANES);
+
+        // Number of 8-lane groups and largest block.
+        const size_t groups = (count + 7) / 8;
+        size_t max_size = 0;
+        for (size_t l = 0; l < count; ++l) {
+            assert(sizes[l] >= 8);
+            max_size = sizes[l] > max_size ? sizes[l] : max_size;
+        }
+
+        // Transpose the first block of each lane into bitsliced words.
+        WORD in[8][8];
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t b = 0; b < 8; ++b) {
+                in[i][b] = WORD{};
+            }
+        }
+        for (size_t g = 0; g < groups; ++g) {
+            const size_t lanes = count - 8 * g < 8 ? count - 8 * g : 8;
+            for (size_t i = 0; i < 8; ++i) {
+                uint64_t x = 0;
+                for (size_t m = 0; m < lanes; ++m) {
+                    x |= uint64_t(data[8 * g + m][i]) << (8 * m);
+                }
+                x = Transpose8x8(x);
+                for (size_t b = 0; b < 8; ++b) {
+                    WordByte(in[i][b], g) = uint8_t(x >> (8 * b));
+                }
+            }
+        }
+
+        Slice stream;
+        stream.init(cw);
+        stream.initInput(in);
+
+        // Generate the key stream, 8 bytes at a time, and apply it on all lanes.
+        WORD out[8][8];
+        for (size_t offset = 8; offset < max_size; offset += 8) {
+            stream.generate(out);
+            for (size_t g = 0; g < groups; ++g) {
+                const size_t lanes = count - 8 * g < 8 ? count - 8 * g : 8;
+                for (size_t i = 0; i < 8; ++i) {
+                    uint64_t x = 0;
+                    for (size_t b = 0; b < 8; ++b) {
+                        x |= uint64_t(WordByte(out[i][b], g)) << (8 * b);
+                    }
+                    x = Transpose8x8(x);
+                    for (size_t m = 0; m < lanes; ++m) {
+                        const size_t l = 8 * g + m;
+                        if (offset + i < sizes[l]) {
+                            data[l][offset + i] ^= uint8_t(x >> (8 * m));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // Bytesliced block cipher. Same structure as DVBCSA2::DVBBlockCipher.
+    // Each byte of the state is replaced by a word where each byte is one
+    // lane. The S-box is a per-lane table lookup. The bit permutation and
+    // all other operations are performed on all lanes at the same time.
+    //------------------------------------------------------------------------
+
+    // Block cipher S-box. Same content as in tsDVBCSA2.cpp.
+    constexpr uint8_t slice_block_sbox[256] = {
+        0x3A, 0xEA, 0x68, 0xFE, 0x33, 0xE9, 0x88, 0x1A, 0x83, 0xCF, 0xE1, 0x7F, 0xBA, 0xE2, 0x38, 0x12,
+        0xE8, 0x27, 0x61, 0x95, 0x0C, 0x36, 0xE5, 0x70, 0xA2, 0x06, 0x82, 0x7C, 0x17, 0xA3, 0x26, 0x49,
+        0xBE, 0x7A, 0x6D, 0x47, 0xC1, 0x51, 0x8F, 0xF3, 0xCC, 0x5B, 0x67, 0xBD, 0xCD, 0x18, 0x08, 0xC9,
+        0xFF, 0x69, 0xEF, 0x03, 0x4E, 0x48, 0x4A, 0x84, 0x3F, 0xB4, 0x10, 0x04, 0xDC, 0xF5, 0x5C, 0xC6,
+        0x16, 0xAB, 0xAC, 0x4C, 0xF1, 0x6A, 0x2F, 0x3C, 0x3B, 0xD4, 0xD5, 0x94, 0xD0, 0xC4, 0x63, 0x62,
+        0x71, 0xA1, 0xF9, 0x4F, 0x2E, 0xAA, 0xC5, 0x56, 0xE3, 0x39, 0x93, 0xCE, 0x65, 0x64, 0xE4, 0x58,
+        0x6C, 0x19, 0x42, 0x79, 0xDD, 0xEE, 0x96, 0xF6, 0x8A, 0xEC, 0x1E, 0x85, 0x53, 0x45, 0xDE, 0xBB,
+        0x7E, 0x0A, 0x9A, 0x13, 0x2A, 0x9D, 0xC2, 0x5E, 0x5A, 0x1F, 0x32, 0x35, 0x9C, 0xA8, 0x73, 0x30,
+        0x29, 0x3D, 0xE7, 0x92, 0x87, 0x1B, 0x2B, 0x4B, 0xA5, 0x57, 0x97, 0x40, 0x15, 0xE6, 0xBC, 0x0E,
+        0xEB, 0xC3, 0x34, 0x2D, 0xB8, 0x44, 0x25, 0xA4, 0x1C, 0xC7, 0x23, 0xED, 0x90, 0x6E, 0x50, 0x00,
+        0x99, 0x9E, 0x4D, 0xD9, 0xDA, 0x8D, 0x6F, 0x5F, 0x3E, 0xD7, 0x21, 0x74, 0x86, 0xDF, 0x6B, 0x05,
+        0x8E, 0x5D, 0x37, 0x11, 0xD2, 0x28, 0x75, 0xD6, 0xA7, 0x77, 0x24, 0xBF, 0xF0, 0xB0, 0x02, 0xB7,
+        0xF8, 0xFC, 0x81, 0x09, 0xB1, 0x01, 0x76, 0x91, 0x7D, 0x0F, 0xC8, 0xA0, 0xF2, 0xCB, 0x78, 0x60,
+        0xD1, 0xF7, 0xE0, 0xB5, 0x98, 0x22, 0xB3, 0x20, 0x1D, 0xA6, 0xDB, 0x7B, 0x59, 0x9F, 0xAE, 0x31,
+        0xFB, 0xD3, 0xB6, 0xCA, 0x43, 0x72, 0x07, 0xF4, 0xD8, 0x41, 0x14, 0x55, 0x0D, 0x54, 0x8B, 0xB9,
+        0xAD, 0x46, 0x0B, 0xAF, 0x80, 0x52, 0x2C, 0xFA, 0x8C, 0x89, 0x66, 0xFD, 0xB2, 0xA9, 0x9B, 0xC0,
+    };
+
+    template <class WORD>
+    class BlockSlice
+    {
+    public:
+        // Number of lanes in a word.
+        static constexpr size_t LANES = sizeof(WORD);
+
+        // Constructor, with scheduled key (index 1 to 56).
+        BlockSlice(const int* kk);
+
+        // Encipher or decipher the current state, in R[0..7].
+        void encipher();
+        void decipher();
+
+        // State, bytesliced. R[0] is R1 in DVBCSA2::DVBBlockCipher.
+        WORD R[8];
+
+    private:
+        WORD _kk[57];
+
+        // Apply the S-box on all lanes.
+        static WORD SBox(WORD in)
+        {
+            WORD out;
+            for (size_t l = 0; l < LANES; ++l) {
+                WordByte(out, l) = slice_block_sbox[WordByte(in, l)];
+            }
+            return out;
+        }
+
+        // Apply the bit permutation on all lanes.
+        // Bit mapping: 0->1, 1->7, 2->5, 3->4, 4->2, 5->6, 6->0, 7->3.
+        static WORD Perm(WORD x)
+        {
+            return ((x & Splat<WORD>(0x2929292929292929)) << 1) |
+                   ((x & Splat<WORD>(0x0202020202020202)) << 6) |
+                   ((x & Splat<WORD>(0x0404040404040404)) << 3) |
+                   ((x & Splat<WORD>(0x1010101010101010)) >> 2) |
+                   ((x & Splat<WORD>(0x4040404040404040)) >> 6) |
+                   ((x & Splat<WORD>(0x8080808080808080)) >> 4);
+        }
+    };
+
+    template <class WORD>
+    BlockSlice<WORD>::BlockSlice(const int* kk)
+    {
+        _kk[0] = WORD{};
+        for (size_t i = 1; i <= 56; ++i) {
+            _kk[i] = Splat<WORD>(0x0101010101010101 * uint8_t(kk[i]));
+        }
+    }
+
+    template <class WORD>
+    void BlockSlice<WORD>::encipher()
+    {
+        // Loop over kk[1]..kk[56]
+        for (size_t i = 1; i <= 56; ++i) {
+            const WORD sbox_out = SBox(_kk[i] ^ R[7]);
+            const WORD perm_out = Perm(sbox_out);
+            const WORD next_r1 = R[1];
+            R[1] = R[2] ^ R[0];
+            R[2] = R[3] ^ R[0];
+            R[3] = R[4] ^ R[0];
+            R[4] = R[5];
+            R[5] = R[6] ^ perm_out;
+            R[6] = R[7];
+            R[7] = R[0] ^ sbox_out;
+            R[0] = next_r1;
+        }
+    }
+
+    template <class WORD>
+    void BlockSlice<WORD>::decipher()
+    {
+        // Loop over kk[56]..kk[1]
+        for (size_t i = 56; i > 0; --i) {
+            const WORD sbox_out = SBox(_kk[i] ^ R[6]);
+            const WORD perm_out = Perm(sbox_out);
+            const WORD r8 = R[7] ^ sbox_out;
+            const WORD next_r8 = R[6];
+            R[6] = R[5] ^ perm_out;
+            R[5] = R[4];
+            R[4] = R[3] ^ r8;
+            R[3] = R[2] ^ r8;
+            R[2] = R[1] ^ r8;
+            R[1] = R[0];
+            R[0] = r8;
+            R[7] = next_r8;
+        }
+    }
+
+    // Encipher data blocks in reverse CBC mode, one lane per data block.
+    template <class WORD>
+    void BlockSliceEncipher(const int* kk, uint8_t* const data[], const size_t nblocks[], size_t count)
+    {
+        using Slice = BlockSlice<WORD>;
+        assert(count <= Slice::LANES);
+
+        size_t max_blocks = 0;
+        for (size_t l = 0; l < count; ++l) {
+            max_blocks = nblocks[l] > max_blocks ? nblocks[l] : max_blocks;
+        }
+
+        // The last block of each data block is xor'ed with the IV, zero in DVB-CSA.
+        // Then each block is xor'ed with the output of the next block.
+        // Data blocks are aligned on their last block.
+        Slice slice(kk);
+        WORD ib[8];
+        for (size_t k = 0; k < 8; ++k) {
+            ib[k] = WORD{};
+        }
+        for (size_t step = 0; step < max_blocks; ++step) {
+            for (size_t k = 0; k < 8; ++k) {
+                slice.R[k] = ib[k];
+            }
+            for (size_t l = 0; l < count; ++l) {
+                if (step < nblocks[l]) {
+                    const uint8_t* const block = data[l] + 8 * (nblocks[l] - 1 - step);
+                    for (size_t k = 0; k < 8; ++k) {
+                        WordByte(slice.R[k], l) ^= block[k];
+                    }
+                }
+            }
+            slice.encipher();
+            for (size_t l = 0; l < count; ++l) {
+                if (step < nblocks[l]) {
+                    uint8_t* const block = data[l] + 8 * (nblocks[l] - 1 - step);
+                    for (size_t k = 0; k < 8; ++k) {
+                        block[k] = WordByte(slice.R[k], l);
+                    }
+                }
+            }
+            for (size_t k = 0; k < 8; ++k) {
+                ib[k] = slice.R[k];
+            }
+        }
+    }
+
+    // Decipher independent 8-byte blocks, one lane per block.
+    template <class WORD>
+    void BlockSliceDecipher(const int* kk, const uint8_t* const in[], uint8_t* const out[], size_t count)
+    {
+        using Slice = BlockSlice<WORD>;
+        assert(count <= Slice::LANES);
+
+        Slice slice(kk);
+        for (size_t k = 0; k < 8; ++k) {
+            slice.R[k] = WORD{};
+            for (size_t l = 0; l < count; ++l) {
+                WordByte(slice.R[k], l) = in[l][k];
+            }
+        }
+        slice.decipher();
+        for (size_t l = 0; l < count; ++l) {
+            for (size_t k = 0; k < 8; ++k) {
+                out[l][k] = WordByte(slice.R[k], l);
+            }
+        }
+    }
+}
+
+// Define a bitsliced engine for a given word type.
+#define TS_DVBCSA2_SLICE_ENGINE(name, word)                                         \
+    const ts::DVBCSA2SliceEngine ts::name = {                                       \
+        8 * sizeof(word), sizeof(word),                                             \
+        StreamSliceProcess<word>, BlockSliceEncipher<word>, BlockSliceDecipher<word> \
+    }
+
+#endif // TS_DVBCSA2_SLICE_IMPLEMENTATION
@@ -10,6 +10,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsDVBCSA2Slice.h"
+#include "tsSysInfo.h"
 
 // Operations on 64-bit areas.
 
@@ -740,3 +742,158 @@ bool ts::DVBCSA2::decryptImpl(const void* input, size_t input_length, void* outp
 
     return true;
 }
+
+
+//----------------------------------------------------------------------------
+// Bitsliced engines for batch operations.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Description of a bitsliced engine.
+    struct SliceEngine
+    {
+        const ts::DVBCSA2SliceEngine* engine;
+        const ts::UChar*              name;
+    };
+
+    // All engines, in increasing order of number of lanes.
+    const SliceEngine slice_engines[] = {
+        {&ts::DVBCSA2Slice64,  u"64-bit"},
+        {&ts::DVBCSA2Slice128, u"128-bit"},
+        {&ts::DVBCSA2Slice256, u"AVX2"},
+        {&ts::DVBCSA2Slice512, u"AVX-512"},
+    };
+
+    // Number of engines which can be used on this CPU. Checked once.
+    size_t SliceEngineCount()
+    {
+        static const size_t count =
+            tsDVBCSA2AVX512IsAccelerated && ts::SysInfo::Instance().avx512Instructions() ? 4 :
+            tsDVBCSA2AVX2IsAccelerated && ts::SysInfo::Instance().avx2Instructions() ? 3 : 2;
+        return count;
+    }
+
+    // Select the smallest engine which has at least the specified number of lanes, or the largest one.
+    template <size_t ts::DVBCSA2SliceEngine::* LANES>
+    const ts::DVBCSA2SliceEngine& SelectEngine(size_t count)
+    {
+        const size_t engine_count = SliceEngineCount();
+        size_t index = 0;
+        while (index + 1 < engine_count && slice_engines[index].engine->*LANES < count) {
+            index++;
+        }
+        return *slice_engines[index].engine;
+    }
+}
+
+ts::UString ts::DVBCSA2::BatchEngineName()
+{
+    return slice_engines[SliceEngineCount() - 1].name;
+}
+
+size_t ts::DVBCSA2::BatchEngineLanes()
+{
+    return slice_engines[SliceEngineCount() - 1].engine->stream_lanes;
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several data blocks in place.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCSA2::encryptBatch(uint8_t* const data[], const size_t sizes[], size_t count)
+{
+    return processBatch(true, data, sizes, count);
+}
+
+bool ts::DVBCSA2::decryptBatch(uint8_t* const data[], const size_t sizes[], size_t count)
+{
+    return processBatch(false, data, sizes, count);
+}
+
+bool ts::DVBCSA2::processBatch(bool encrypt, uint8_t* const data[], const size_t sizes[], size_t count)
+{
+    // Filter invalid parameters. The whole batch is one operation with the same key.
+    if (!_init || data == nullptr || sizes == nullptr || !(encrypt ? allowEncrypt() : allowDecrypt())) {
+        return false;
+    }
+
+    // Collect data blocks to process. Packets smaller than 8 bytes are left unscrambled.
+    _batch_data.clear();
+    _batch_sizes.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if ((data[i] == nullptr && sizes[i] > 0) || sizes[i] > MAX_NBLOCKS * 8) {
+            return false;
+        }
+        if (sizes[i] >= 8) {
+            _batch_data.push_back(data[i]);
+            _batch_sizes.push_back(sizes[i]);
+        }
+    }
+    const size_t total = _batch_data.size();
+    const int* const kk = _block.schedule();
+
+    // When encrypting, perform block cipher in reverse CBC mode on each data block. The initialization
+    // vector is zero in DVB-CSA. Each block is replaced by the block cipher output ("ib" in encryptImpl()).
+    // Each lane of the bytesliced block cipher processes the chain of blocks of one data block.
+    if (encrypt) {
+        std::vector<size_t> nblocks(total);
+        for (size_t i = 0; i < total; ++i) {
+            nblocks[i] = _batch_sizes[i] / 8;
+        }
+        for (size_t first = 0; first < total; ) {
+            const DVBCSA2SliceEngine& engine(SelectEngine<&DVBCSA2SliceEngine::block_lanes>(total - first));
+            const size_t n = std::min(total - first, engine.block_lanes);
+            engine.encipher(kk, &_batch_data[first], &nblocks[first], n);
+            first += n;
+        }
+    }
+
+    // Apply the stream cipher on all data blocks.
+    for (size_t first = 0; first < total; ) {
+        const DVBCSA2SliceEngine& engine(SelectEngine<&DVBCSA2SliceEngine::stream_lanes>(total - first));
+        const size_t n = std::min(total - first, engine.stream_lanes);
+        engine.stream(_key, &_batch_data[first], &_batch_sizes[first], n);
+        first += n;
+    }
+
+    // When decrypting, perform the block cipher on the stream cipher output.
+    // In CBC decryption, all blocks can be deciphered independently.
+    if (!encrypt) {
+        // Build the list of all 8-byte blocks and their deciphered output in _batch_work.
+        std::vector<const uint8_t*> in;
+        std::vector<uint8_t*> out;
+        _batch_work.resize(8 * MAX_NBLOCKS * total);
+        for (size_t i = 0; i < total; ++i) {
+            for (size_t b = 0; b < _batch_sizes[i] / 8; ++b) {
+                out.push_back(_batch_work.data() + 8 * in.size());
+                in.push_back(_batch_data[i] + 8*b);
+            }
+        }
+        for (size_t first = 0; first < in.size(); ) {
+            const DVBCSA2SliceEngine& engine(SelectEngine<&DVBCSA2SliceEngine::block_lanes>(in.size() - first));
+            const size_t n = std::min(in.size() - first, engine.block_lanes);
+            engine.decipher(kk, &in[first], &out[first], n);
+            first += n;
+        }
+        // Chain the deciphered blocks. Block b is xor'ed with the scrambled block b+1,
+        // which is read before being overwritten.
+        size_t index = 0;
+        for (size_t i = 0; i < total; ++i) {
+            uint8_t* const blocks = _batch_data[i];
+            const size_t nblocks = _batch_sizes[i] / 8;
+            for (size_t b = 0; b < nblocks; ++b, ++index) {
+                if (b + 1 < nblocks) {
+                    xor_8(blocks + 8*b, blocks + 8*(b+1), out[index]);
+                }
+                else {
+                    // Last block - sb[nblocks+1] = IV = 0
+                    memcpy_8(blocks + 8*b, out[index]);
+                }
+            }
+        }
+    }
+
+    return true;
+}
@@ -68,6 +68,46 @@ namespace ts {
         //!
         static bool IsReducedCW(const uint8_t *cw);
 
+        //!
+        //! Encrypt several data blocks in place with the current control word.
+        //!
+        //! This is typically used to scramble the payloads of many TS packets using the same control word.
+        //! The stream cipher is computed on all data blocks at the same time using a bitsliced implementation,
+        //! based on the largest vector instructions which are available on the CPU (see BatchEngineName()).
+        //! The result is identical to calling encrypt() on each data block. The batch counts as one
+        //! encryption in the key usage limits of the block cipher (see BlockCipher::encryptionCount()).
+        //!
+        //! @param [in] data Array of @a count addresses of data blocks, encrypted in place.
+        //! @param [in] sizes Array of @a count sizes of data blocks. Each size must not exceed 184 bytes,
+        //! the maximum payload size of a TS packet. Data blocks shorter than 8 bytes are left unmodified.
+        //! @param [in] count Number of data blocks.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBatch(uint8_t* const data[], const size_t sizes[], size_t count);
+
+        //!
+        //! Decrypt several data blocks in place with the current control word.
+        //! @param [in] data Array of @a count addresses of data blocks, decrypted in place.
+        //! @param [in] sizes Array of @a count sizes of data blocks. Each size must not exceed 184 bytes.
+        //! Data blocks shorter than 8 bytes are left unmodified.
+        //! @param [in] count Number of data blocks.
+        //! @return True on success, false on error.
+        //! @see encryptBatch()
+        //!
+        bool decryptBatch(uint8_t* const data[], const size_t sizes[], size_t count);
+
+        //!
+        //! Get the name of the bitsliced engine which is used by batch operations on this CPU.
+        //! @return The name of the largest bitsliced engine, for instance "AVX2".
+        //!
+        static UString BatchEngineName();
+
+        //!
+        //! Get the number of data blocks which are processed at the same time by batch operations on this CPU.
+        //! @return The number of lanes of the largest bitsliced engine.
+        //!
+        static size_t BatchEngineLanes();
+
     protected:
         //! Properties of this algorithm.
         //! @return A constant reference to the properties.
@@ -88,6 +128,7 @@ namespace ts {
             void init(const uint8_t *cw);
             void encipher(const uint8_t *bd, uint8_t *ib);
             void decipher(const uint8_t *ib, uint8_t *bd);
+            const int* schedule() const { return _kk; }
         };
 
         // Stream cipher data
@@ -116,5 +157,13 @@ namespace ts {
         uint8_t         _key[KEY_SIZE] {};
         DVBBlockCipher  _block {};
         DVBStreamCipher _stream {};
+
+        // Work areas for batch operations, the data blocks to process with the stream cipher.
+        std::vector<uint8_t*> _batch_data {};
+        std::vector<size_t>   _batch_sizes {};
+        std::vector<uint8_t>  _batch_work {};
+
+        // Common code for encryptBatch() and decryptBatch().
+        bool processBatch(bool encrypt, uint8_t* const data[], const size_t sizes[], size_t count);
     };
 }
@@ -96,12 +96,14 @@ void ts::TSAnalyzer::reset()
     _scrambled_services_cnt = 0;
     _tid_present.reset();
     _pids.clear();
+    _pid_index.fill(nullptr);
     _services.clear();
     _ts_bitrate_sum = 0;
     _ts_bitrate_cnt = 0;
     _preceding_errors = 0;
     _preceding_suspects = 0;
     _pes_demux.reset();
+    _pes_demux.setPIDFilter(NoPID());
     _t2mi_demux.reset();
     _lcn.clear();
     _dct.invalidate();
@@ -266,18 +268,26 @@ ts::TSAnalyzer::XTIDContextPtr ts::TSAnalyzer::getXTID(const Section& section)
 
 ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& description)
 {
-    const PIDContextPtr p(_pids[pid]);
-    if (p == nullptr) {
-        // The PID was not yet used, map entry just created.
-        return _pids[pid] = std::make_shared<PIDContext>(pid, description);
-    }
-    else {
+    getPIDContext(pid, description);
+    return _pids[pid];
+}
+
+ts::TSAnalyzer::PIDContext& ts::TSAnalyzer::getPIDContext(PID pid, const UString& description)
+{
+    // PID's are always 13-bit values, the context is directly indexed.
+    assert(pid < PID_MAX);
+    PIDContext* pc = _pid_index[pid];
+    if (pc == nullptr) {
+        // The PID was not yet used, create the context.
+        const PIDContextPtr p(std::make_shared<PIDContext>(pid, description));
+        _pids[pid] = p;
+        pc = _pid_index[pid] = p.get();
+    }
+    else if (pc->description == UNREFERENCED && description != UNREFERENCED) {
         // If the PID was marked as unreferenced, now use actual description.
-        if (p->description == UNREFERENCED && description != UNREFERENCED) {
-            p->description = description;
-        }
-        return p;
+        pc->description = description;
     }
+    return *pc;
 }
 
 
@@ -339,7 +349,9 @@ void ts::TSAnalyzer::PIDContext::addDescriptionOrAttribute(const UString& desc)
 
 void ts::TSAnalyzer::handleInvalidSection(SectionDemux&, const DemuxedData& data, Section::Status status)
 {
-    getPID(data.sourcePID())->inv_sections++;
+    if (!_preceding) {
+        getPID(data.sourcePID())->inv_sections++;
+    }
 }
 
 
@@ -350,6 +362,11 @@ void ts::TSAnalyzer::handleInvalidSection(SectionDemux&, const DemuxedData& data
 
 void ts::TSAnalyzer::handleSection(SectionDemux&, const Section& section)
 {
+    // Sections before the analyzed chunk are counted in the previous chunk.
+    if (_preceding) {
+        return;
+    }
+
     XTIDContextPtr etc(getXTID(section));
     const uint8_t version = section.version();
 
@@ -454,14 +471,14 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
         }
         case TID_TDT: {
             const TDT tdt(_duck, table);
-            if (tdt.isValid()) {
+            if (tdt.isValid() && !_preceding) {
                 analyzeTDT(tdt);
             }
             break;
         }
         case TID_TOT: {
             const TOT tot(_duck, table);
-            if (tot.isValid()) {
+            if (tot.isValid() && !_preceding) {
                 analyzeTOT(tot);
             }
             break;
@@ -566,7 +583,9 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
 {
     // Count the number of PMT's on this PID
     PIDContextPtr ps(getPID(pid));
-    ps->pmt_cnt++;
+    if (!_preceding) {
+        ps->pmt_cnt++;
+    }
 
     // Get service description
     ServiceContextPtr svp(getService(pmt.service_id));
@@ -606,6 +625,9 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
         ps->carry_audio = ps->carry_audio || StreamTypeIsAudio(stream.stream_type, pmt.descs) || StreamTypeIsAudio(stream.stream_type, stream.descs);
         ps->carry_video = ps->carry_video || StreamTypeIsVideo(stream.stream_type);
         ps->carry_pes = ps->carry_pes || StreamTypeIsPES(stream.stream_type);
+        if (ps->carry_pes) {
+            _pes_demux.addPID(es_pid);
+        }
         if (!ps->carry_section && !ps->carry_t2mi && StreamTypeIsSection(stream.stream_type)) {
             ps->carry_section = true;
             _demux.addPID(es_pid);
@@ -1291,7 +1313,9 @@ void ts::TSAnalyzer::handleNewMPEG2AudioAttributes(PESDemux&, const PESPacket& p
 
 void ts::TSAnalyzer::handleInvalidPESPacket(PESDemux&, const DemuxedData& data)
 {
-    getPID(data.sourcePID())->inv_pes++;
+    if (!_preceding) {
+        getPID(data.sourcePID())->inv_pes++;
+    }
 }
 
 
@@ -1371,6 +1395,10 @@ void ts::TSAnalyzer::handleT2MINewPID(T2MIDemux& demux, const PMT& pmt, PID pid,
 
 void ts::TSAnalyzer::handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt)
 {
+    if (_preceding) {
+        return;
+    }
+
     PIDContextPtr pc(getPID(pkt.sourcePID(), u"T2-MI"));
 
     // Count T2-MI packets.
@@ -1394,6 +1422,10 @@ void ts::TSAnalyzer::handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt)
 
 void ts::TSAnalyzer::handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts)
 {
+    if (_preceding) {
+        return;
+    }
+
     PIDContextPtr pc(getPID(t2mi.sourcePID(), u"T2-MI"));
 
     // Count demux'ed TS packets from this PLP.
@@ -1453,15 +1485,24 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     _preceding_errors = 0;
     _preceding_suspects = 0;
 
-    // Feed packets into the various demux
+    // Feed packets into the various demux.
+    // The PES demux is fed later, after checking if the packet starts a PES packet.
     _demux.feedPacket(pkt);
-    _pes_demux.feedPacket(pkt);
     _t2mi_demux.feedPacket(pkt);
 
-    // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
+    // Get PID context. Use a plain pointer, no need to copy safe pointers on each packet.
+    PIDContext* const ps = &getPIDContext(pkt.getPID());
     ps->ts_pkt_cnt++;
 
+    // Keep the characteristics of the first packet, for merging with a previous analysis.
+    if (ps->ts_pkt_cnt == 1) {
+        ps->first_pkt = packet_index;
+        ps->first_ts_sc = pkt.getScrambling();
+        ps->first_continuity = pkt.getCC();
+        ps->first_discontinuity = pkt.getDiscontinuityIndicator();
+        ps->first_payload = pkt.hasPayload();
+    }
+
     // Accumulate stat from packet
     if (pkt.hasAF()) {
         ps->ts_af_cnt++;
@@ -1496,6 +1537,10 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
             if (ps->cryptop_cnt > 1) {
                 ps->cryptop_ts_cnt += packet_index - ps->cur_ts_sc_pkt;
             }
+            else {
+                ps->first_cryptop_pkt = ps->cur_ts_sc_pkt;
+                ps->first_cryptop_ts = packet_index - ps->cur_ts_sc_pkt;
+            }
         }
         ps->cur_ts_sc = pkt.getScrambling();
         ps->cur_ts_sc_pkt = packet_index;
@@ -1549,6 +1594,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     if (broken_rate) {
         // Suspected packet loss, forget the last PCR with use to compute bitrate.
         ps->br_last_pcr = INVALID_PCR;
+        ps->broken_before_pcr = ps->broken_before_pcr || ps->pcr_cnt == 0;
     }
     if (pcr != INVALID_PCR) {
         // Count PID's with PCR
@@ -1577,6 +1623,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
         // Save first and last PCR outside of bitrate computation.
         if (ps->first_pcr == INVALID_PCR) {
             ps->first_pcr = pcr;
+            ps->first_pcr_pkt = packet_index;
         }
         ps->last_pcr = pcr;
     }
@@ -1643,9 +1690,18 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
                 // Got different values of stream_id in PES packets
                 ps->same_stream_id = false;
             }
+            // Start analyzing PES packets on this PID, if not yet done.
+            // PID's which are declared as carrying PES in a PMT are also added when the PMT is analyzed.
+            // The costly PES and codec analysis is never done on other PID's.
+            if (!_pes_demux.hasPID(ps->pid)) {
+                _pes_demux.addPID(ps->pid);
+            }
         }
     }
 
+    // Now feed the PES demux.
+    _pes_demux.feedPacket(pkt);
+
     // Check "ISDB-T information" in extended 16-byte trailer. The 16-byte trailer is only available when
     // analyzing transport streams with 204-byte packets. In that case, the trailer is in the packet
     // metadata. At this point, we don't always know if the stream is an ISDB one or not. We collect
@@ -1660,6 +1716,49 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
 }
 
 
+//----------------------------------------------------------------------------
+// Feed the analyzer with a TS packet which precedes the analyzed chunk.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::feedPrecedingPacket(const TSPacket& pkt)
+{
+    // Invalid and suspect packets are ignored, as in feedPacket(). Keep track of them
+    // since the detection of suspect packets continues at the start of the chunk.
+    if (!pkt.hasValidSync() || pkt.getTEI()) {
+        _preceding_errors++;
+        _preceding_suspects = 0;
+    }
+    else if (_min_error_before_suspect > 0 && _max_consecutive_suspects > 0 && !pidExists(pkt.getPID()) &&
+             (_preceding_errors >= _min_error_before_suspect || (_preceding_suspects > 0 && _preceding_suspects < _max_consecutive_suspects)))
+    {
+        _preceding_suspects++;
+        _preceding_errors = 0;
+    }
+    else {
+        _preceding_errors = 0;
+        _preceding_suspects = 0;
+
+        // Make the PID known for the detection of suspect packets.
+        getPIDContext(pkt.getPID());
+
+        // Start analyzing PES packets on unreferenced PID's, as in feedPacket().
+        const size_t header_size = pkt.getHeaderSize();
+        if (pkt.getPUSI() && pkt.getScrambling() == SC_CLEAR && header_size <= PKT_SIZE - 4 && pkt.getPID() != PID_PAT &&
+            pkt.b[header_size] == 0x00 && pkt.b[header_size + 1] == 0x00 && pkt.b[header_size + 2] == 0x01 && !_pes_demux.hasPID(pkt.getPID()))
+        {
+            _pes_demux.addPID(pkt.getPID());
+        }
+
+        // Collect tables, start of sections, PES and T2-MI packets. The handlers don't count anything.
+        _preceding = true;
+        _demux.feedPacket(pkt);
+        _t2mi_demux.feedPacket(pkt);
+        _pes_demux.feedPacket(pkt);
+        _preceding = false;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Specify a "bitrate hint" for the analysis. It is the user-specified
 // bitrate in bits/seconds, based on 188-byte packets. The bitrate is
@@ -1941,3 +2040,381 @@ void ts::TSAnalyzer::getPIDsWithPES(std::vector<PID>& list)
         }
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Get the global statistics of the analyzed transport stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::getStatistics(Statistics& stats)
+{
+    recomputeStatistics();
+
+    stats.packets = _ts_pkt_cnt;
+    stats.invalid_sync = _invalid_sync;
+    stats.transport_errors = _transport_errors;
+    stats.suspect_ignored = _suspect_ignored;
+    stats.unexp_discont = stats.duplicated = 0;
+    for (const auto& pid : _pids) {
+        stats.unexp_discont += pid.second->unexp_discont;
+        stats.duplicated += pid.second->duplicated;
+    }
+    stats.services = _services.size();
+    stats.pids = _pid_cnt;
+    stats.bitrate = _ts_bitrate;
+    stats.duration = _duration;
+}
+
+
+//----------------------------------------------------------------------------
+// Merge the analysis of the next chunk of the same stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::merge(const TSAnalyzer& next)
+{
+    // Packet indexes in the next chunk are shifted by the number of packets in this one.
+    const uint64_t offset = _ts_pkt_cnt;
+    _modified = true;
+
+    // Global counters.
+    _duck.addStandards(next._duck.standards());
+    if (!_ts_id.has_value()) {
+        _ts_id = next._ts_id;
+    }
+    _ts_pkt_cnt += next._ts_pkt_cnt;
+    _invalid_sync += next._invalid_sync;
+    _transport_errors += next._transport_errors;
+    _suspect_ignored += next._suspect_ignored;
+    _preceding_errors = next._preceding_errors;
+    _preceding_suspects = next._preceding_suspects;
+    _ts_bitrate_sum += next._ts_bitrate_sum;
+    _ts_bitrate_cnt += next._ts_bitrate_cnt;
+    _tid_present |= next._tid_present;
+    _lcn.addLCNs(next._lcn);
+
+    // First and last time stamps.
+    if (_first_utc == Time::Epoch) {
+        _first_utc = next._first_utc;
+        _first_local = next._first_local;
+    }
+    if (_first_tdt == Time::Epoch) {
+        _first_tdt = next._first_tdt;
+    }
+    if (next._last_tdt != Time::Epoch) {
+        _last_tdt = next._last_tdt;
+    }
+    if (_first_tot == Time::Epoch) {
+        _first_tot = next._first_tot;
+        _country_code = next._country_code;
+    }
+    if (next._last_tot != Time::Epoch) {
+        _last_tot = next._last_tot;
+    }
+    if (_first_stt == Time::Epoch) {
+        _first_stt = next._first_stt;
+    }
+    if (next._last_stt != Time::Epoch) {
+        _last_stt = next._last_stt;
+    }
+
+    // Merge services.
+    for (const auto& it : next._services) {
+        const ServiceContext& nsv(*it.second);
+        ServiceContext& sv(*getService(it.first));
+        if (nsv.orig_netw_id.has_value()) {
+            sv.orig_netw_id = nsv.orig_netw_id;
+        }
+        if (nsv.lcn.has_value()) {
+            sv.lcn = nsv.lcn;
+        }
+        if (nsv.service_type != 0) {
+            sv.service_type = nsv.service_type;
+        }
+        if (!nsv.name.empty()) {
+            sv.name = nsv.name;
+        }
+        if (!nsv.provider.empty()) {
+            sv.provider = nsv.provider;
+        }
+        if (nsv.pmt_pid != 0) {
+            sv.pmt_pid = nsv.pmt_pid;
+        }
+        if (nsv.pcr_pid != 0) {
+            sv.pcr_pid = nsv.pcr_pid;
+        }
+        sv.hidden = sv.hidden || nsv.hidden;
+        sv.carry_ssu = sv.carry_ssu || nsv.carry_ssu;
+        sv.carry_t2mi = sv.carry_t2mi || nsv.carry_t2mi;
+    }
+
+    // Merge PID's.
+    for (const auto& it : next._pids) {
+        mergePID(getPIDContext(it.first), *it.second, offset);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Merge the analysis of a PID from the next chunk of the same stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::mergePID(PIDContext& pc, const PIDContext& next, uint64_t offset)
+{
+    // Check the continuity between the last packet of this chunk and the first packet of the next one.
+    // Same as in feedPacket(). The continuity counter of null packets is undefined.
+    bool broken_rate = false;
+    if (pc.ts_pkt_cnt > 0 && next.ts_pkt_cnt > 0 && pc.pid != PID_NULL) {
+        if (next.first_discontinuity) {
+            pc.exp_discont++;
+            broken_rate = true;
+        }
+        else if (next.first_payload) {
+            if (next.first_continuity == pc.cur_continuity) {
+                pc.duplicated++;
+            }
+            else if (next.first_continuity != (pc.cur_continuity + 1) % CC_MAX) {
+                pc.unexp_discont++;
+                broken_rate = true;
+            }
+        }
+        else if (next.first_continuity != pc.cur_continuity) {
+            pc.unexp_discont++;
+            broken_rate = true;
+        }
+    }
+
+    // Check the clocks across the boundary, same as in feedPacket().
+    if (next.first_pcr != INVALID_PCR) {
+        if (pc.br_last_pcr != INVALID_PCR && !broken_rate && !next.broken_before_pcr && pc.br_last_pcr < next.first_pcr) {
+            const BitRate ts_bitrate = BitRate((offset + next.first_pcr_pkt - pc.br_last_pcr_pkt) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / (next.first_pcr - pc.br_last_pcr);
+            pc.ts_bitrate_sum += ts_bitrate;
+            pc.ts_bitrate_cnt++;
+            _ts_bitrate_sum += ts_bitrate;
+            _ts_bitrate_cnt++;
+        }
+        if (pc.last_pcr != INVALID_PCR && (pc.last_pcr > next.first_pcr || (next.first_pcr - pc.last_pcr) > SYSTEM_CLOCK_FREQ)) {
+            pc.pcr_leap_cnt++;
+        }
+    }
+    if (next.first_pts != INVALID_PTS && pc.last_pts != INVALID_PTS) {
+        const uint64_t diff = next.first_pts > pc.last_pts ? next.first_pts - pc.last_pts : pc.last_pts - next.first_pts;
+        if (diff > 3 * SYSTEM_CLOCK_SUBFREQ) {
+            pc.pts_leap_cnt++;
+        }
+    }
+    if (next.first_dts != INVALID_DTS && pc.last_dts != INVALID_DTS && (pc.last_dts > next.first_dts || (next.first_dts - pc.last_dts) > 3 * SYSTEM_CLOCK_SUBFREQ)) {
+        pc.dts_leap_cnt++;
+    }
+
+    // Bitrate evaluation state at the end of the next chunk.
+    if (next.pcr_cnt > 0) {
+        pc.br_last_pcr = next.br_last_pcr;
+        pc.br_last_pcr_pkt = next.br_last_pcr_pkt + offset;
+    }
+    else if (broken_rate || next.broken_before_pcr) {
+        pc.br_last_pcr = INVALID_PCR;
+    }
+
+    // Crypto-periods. When the scrambling control is unchanged across the boundary, the last crypto-period
+    // of this chunk continues in the next chunk. Otherwise, the last crypto-period of this chunk ends.
+    if (next.ts_pkt_cnt > 0) {
+        const uint64_t first_index = offset + next.first_pkt;
+        const bool joined = pc.cur_ts_sc == next.first_ts_sc;
+        const bool ended = !joined && pc.cur_ts_sc != SC_CLEAR;
+        const bool next_first_is_joined = joined && next.first_ts_sc != SC_CLEAR && next.cryptop_cnt > 0 && next.first_cryptop_pkt == next.first_pkt;
+
+        // Complete crypto-periods in sequence: this chunk, ended at boundary, next chunk.
+        const uint64_t this_sum = pc.cryptop_cnt > 0 ? pc.first_cryptop_ts + pc.cryptop_ts_cnt : 0;
+        const uint64_t ended_ts = ended ? first_index - pc.cur_ts_sc_pkt : 0;
+        const uint64_t next_first_ts = next.first_cryptop_ts + (next_first_is_joined ? first_index - pc.cur_ts_sc_pkt : 0);
+        const uint64_t next_sum = next.cryptop_cnt > 0 ? next_first_ts + next.cryptop_ts_cnt : 0;
+
+        // Like in feedPacket(), the first crypto-period is ignored in the evaluation of the duration.
+        if (pc.cryptop_cnt == 0) {
+            if (ended) {
+                pc.first_cryptop_pkt = pc.cur_ts_sc_pkt;
+                pc.first_cryptop_ts = ended_ts;
+            }
+            else if (next.cryptop_cnt > 0) {
+                pc.first_cryptop_pkt = next_first_is_joined ? pc.cur_ts_sc_pkt : next.first_cryptop_pkt + offset;
+                pc.first_cryptop_ts = next_first_ts;
+            }
+        }
+        pc.cryptop_cnt += (ended ? 1 : 0) + next.cryptop_cnt;
+        pc.cryptop_ts_cnt = this_sum + ended_ts + next_sum - pc.first_cryptop_ts;
+
+        // Current crypto-period at the end of the next chunk.
+        if (next.cur_ts_sc_pkt > next.first_pkt) {
+            pc.cur_ts_sc_pkt = next.cur_ts_sc_pkt + offset;
+        }
+        else if (!joined) {
+            pc.cur_ts_sc_pkt = first_index;
+        }
+        pc.cur_ts_sc = next.cur_ts_sc;
+        pc.cur_continuity = next.cur_continuity;
+    }
+
+    // Global counters which are incrementally computed in feedPacket().
+    if (next.scrambled && !pc.scrambled) {
+        _scrambled_pid_cnt++;
+    }
+    if (next.pcr_cnt > 0 && pc.pcr_cnt == 0) {
+        _pcr_pid_cnt++;
+    }
+
+    // Description of the PID, the latest one applies.
+    if (!next.description.empty() && next.description != UNREFERENCED) {
+        pc.description = next.description;
+    }
+    if (!next.comment.empty()) {
+        pc.comment = next.comment;
+    }
+    for (const auto& lang : next.languages) {
+        AppendUnique(pc.languages, lang);
+    }
+    for (const auto& attr : next.attributes) {
+        AppendUnique(pc.attributes, attr);
+    }
+    pc.services.insert(next.services.begin(), next.services.end());
+    pc.is_pmt_pid = pc.is_pmt_pid || next.is_pmt_pid;
+    pc.is_pcr_pid = pc.is_pcr_pid || next.is_pcr_pid;
+    pc.referenced = pc.referenced || next.referenced;
+    pc.carry_pes = pc.carry_pes || next.carry_pes;
+    pc.carry_section = pc.carry_section || next.carry_section;
+    pc.carry_ecm = pc.carry_ecm || next.carry_ecm;
+    pc.carry_emm = pc.carry_emm || next.carry_emm;
+    pc.carry_audio = pc.carry_audio || next.carry_audio;
+    pc.carry_video = pc.carry_video || next.carry_video;
+    pc.carry_t2mi = pc.carry_t2mi || next.carry_t2mi;
+    pc.carry_iip = pc.carry_iip || next.carry_iip;
+    pc.scrambled = pc.scrambled || next.scrambled;
+    if (pc.pes_stream_id == 0) {
+        pc.pes_stream_id = next.pes_stream_id;
+        pc.same_stream_id = next.same_stream_id;
+    }
+    else if (next.pes_stream_id != 0) {
+        pc.same_stream_id = pc.same_stream_id && next.same_stream_id && pc.pes_stream_id == next.pes_stream_id;
+    }
+    if (next.stream_type != 0) {
+        pc.stream_type = next.stream_type;
+    }
+    if (next.cas_id != 0) {
+        pc.cas_id = next.cas_id;
+    }
+    if (next.audio2.isValid()) {
+        pc.audio2 = next.audio2;
+    }
+    pc.cas_operators.insert(next.cas_operators.begin(), next.cas_operators.end());
+    pc.ssu_oui.insert(next.ssu_oui.begin(), next.ssu_oui.end());
+    pc.t2mi_plp_ts.accumulate(next.t2mi_plp_ts);
+    pc.isdb_layers.accumulate(next.isdb_layers);
+
+    // Counters.
+    pc.ts_pkt_cnt += next.ts_pkt_cnt;
+    pc.ts_af_cnt += next.ts_af_cnt;
+    pc.unit_start_cnt += next.unit_start_cnt;
+    pc.pl_start_cnt += next.pl_start_cnt;
+    pc.pmt_cnt += next.pmt_cnt;
+    pc.unexp_discont += next.unexp_discont;
+    pc.exp_discont += next.exp_discont;
+    pc.duplicated += next.duplicated;
+    pc.ts_sc_cnt += next.ts_sc_cnt;
+    pc.inv_ts_sc_cnt += next.inv_ts_sc_cnt;
+    pc.inv_sections += next.inv_sections;
+    pc.inv_pes += next.inv_pes;
+    pc.inv_pes_start += next.inv_pes_start;
+    pc.t2mi_cnt += next.t2mi_cnt;
+    pc.pcr_cnt += next.pcr_cnt;
+    pc.pts_cnt += next.pts_cnt;
+    pc.dts_cnt += next.dts_cnt;
+    pc.pcr_leap_cnt += next.pcr_leap_cnt;
+    pc.pts_leap_cnt += next.pts_leap_cnt;
+    pc.dts_leap_cnt += next.dts_leap_cnt;
+    pc.ts_bitrate_sum += next.ts_bitrate_sum;
+    pc.ts_bitrate_cnt += next.ts_bitrate_cnt;
+
+    // First and last clock values.
+    if (pc.first_pcr == INVALID_PCR && next.first_pcr != INVALID_PCR) {
+        pc.first_pcr = next.first_pcr;
+        pc.first_pcr_pkt = next.first_pcr_pkt + offset;
+    }
+    if (next.last_pcr != INVALID_PCR) {
+        pc.last_pcr = next.last_pcr;
+    }
+    if (pc.first_pts == INVALID_PTS) {
+        pc.first_pts = next.first_pts;
+    }
+    if (next.last_pts != INVALID_PTS) {
+        pc.last_pts = next.last_pts;
+    }
+    if (pc.first_dts == INVALID_DTS) {
+        pc.first_dts = next.first_dts;
+    }
+    if (next.last_dts != INVALID_DTS) {
+        pc.last_dts = next.last_dts;
+    }
+
+    // Characteristics of the first packet, when there was none in this chunk.
+    if (pc.ts_pkt_cnt == next.ts_pkt_cnt && next.ts_pkt_cnt > 0) {
+        pc.first_pkt = next.first_pkt + offset;
+        pc.first_ts_sc = next.first_ts_sc;
+        pc.first_continuity = next.first_continuity;
+        pc.first_discontinuity = next.first_discontinuity;
+        pc.first_payload = next.first_payload;
+    }
+    if (pc.pcr_cnt == next.pcr_cnt) {
+        pc.broken_before_pcr = pc.broken_before_pcr || broken_rate || next.broken_before_pcr;
+    }
+
+    // Merge sections.
+    for (const auto& it : next.sections) {
+        XTIDContextPtr& etc(pc.sections[it.first]);
+        if (etc == nullptr) {
+            etc = std::make_shared<XTIDContext>(it.first);
+            etc->first_version = it.second->first_version;
+        }
+        MergeXTID(*etc, *it.second, offset);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Merge the analysis of a table from the next chunk of the same stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::MergeXTID(XTIDContext& etc, const XTIDContext& next, uint64_t offset)
+{
+    etc.section_count += next.section_count;
+
+    if (next.table_count > 0) {
+        if (etc.table_count == 0) {
+            // First occurence of table in the next chunk.
+            etc.first_pkt = next.first_pkt + offset;
+            etc.first_version = next.first_version;
+            etc.repetition_ts = next.repetition_ts;
+            etc.min_repetition_ts = next.min_repetition_ts;
+            etc.max_repetition_ts = next.max_repetition_ts;
+        }
+        else {
+            // Repetition interval across the boundary, then combine with intervals in the next chunk.
+            const uint64_t rep = next.first_pkt + offset - etc.last_pkt;
+            if (etc.table_count == 1) {
+                etc.min_repetition_ts = etc.max_repetition_ts = rep;
+            }
+            else {
+                etc.min_repetition_ts = std::min(etc.min_repetition_ts, rep);
+                etc.max_repetition_ts = std::max(etc.max_repetition_ts, rep);
+            }
+            if (next.table_count > 1) {
+                etc.min_repetition_ts = std::min(etc.min_repetition_ts, next.min_repetition_ts);
+                etc.max_repetition_ts = std::max(etc.max_repetition_ts, next.max_repetition_ts);
+            }
+            const uint64_t count = etc.table_count + next.table_count;
+            etc.repetition_ts = (next.last_pkt + offset - etc.first_pkt + (count - 1) / 2) / (count - 1);
+        }
+        etc.table_count += next.table_count;
+        etc.last_pkt = next.last_pkt + offset;
+        etc.last_version = next.last_version;
+    }
+    etc.versions |= next.versions;
+}
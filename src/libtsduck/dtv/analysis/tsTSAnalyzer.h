@@ -70,6 +70,30 @@ namespace ts {
         //!
         void feedPacket(const TSPacket& packet, const TSPacketMetadata& mdata);
 
+        //!
+        //! Feed the analyzer with a TS packet which precedes the analyzed part of the stream.
+        //! When a large stream is analyzed in independent chunks, the analysis of a chunk starts
+        //! with some packets which precede the chunk. These packets are only used to collect the
+        //! context which applies at the start of the chunk: PSI/SI tables, partial sections, PES
+        //! and T2-MI packets. They are not counted in the analysis. All preceding packets shall
+        //! be fed before the first packet of the chunk.
+        //! @param [in] packet One TS packet from the stream, before the analyzed chunk.
+        //! @see merge()
+        //!
+        void feedPrecedingPacket(const TSPacket& packet);
+
+        //!
+        //! Merge the analysis of the next chunk of the same stream.
+        //! The analysis of @a next shall start with the packet immediately following the last
+        //! packet which was fed into this object. Continuity counters, PCR's, time stamps and
+        //! crypto-periods are checked across the boundary between the two chunks, as if all
+        //! packets had been fed into this object. After merging, the analysis can be reported
+        //! but no more packet should be fed into this object.
+        //! @param [in] next Analysis of the next chunk of the stream.
+        //! @see feedPrecedingPacket()
+        //!
+        void merge(const TSAnalyzer& next);
+
         //!
         //! Reset the analysis context.
         //!
@@ -145,6 +169,31 @@ namespace ts {
         //!
         void getPIDsWithPES(std::vector<PID>& list);
 
+        //!
+        //! Global statistics of the analyzed transport stream.
+        //! Typically used to aggregate the results of several analyses.
+        //!
+        class TSDUCKDLL Statistics
+        {
+        public:
+            uint64_t         packets = 0;           //!< Number of TS packets.
+            uint64_t         invalid_sync = 0;      //!< Number of packets with invalid sync byte.
+            uint64_t         transport_errors = 0;  //!< Number of packets with transport error.
+            uint64_t         suspect_ignored = 0;   //!< Number of suspect packets, ignored.
+            uint64_t         unexp_discont = 0;     //!< Number of unexpected discontinuities in all PID's.
+            uint64_t         duplicated = 0;        //!< Number of duplicated packets in all PID's.
+            size_t           services = 0;          //!< Number of services.
+            size_t           pids = 0;              //!< Number of PID's with actual packets.
+            BitRate          bitrate = 0;           //!< TS bitrate, zero if unknown.
+            cn::milliseconds duration {};           //!< Total broadcast duration.
+        };
+
+        //!
+        //! Get the global statistics of the analyzed transport stream.
+        //! @param [out] stats The returned statistics.
+        //!
+        void getStatistics(Statistics& stats);
+
     protected:
 
         // -------------------
@@ -366,6 +415,17 @@ namespace ts {
             BitRate       ts_bitrate_sum = 0;        //!< Sum of all computed TS bitrates.
             uint64_t      ts_bitrate_cnt = 0;        //!< Number of computed TS bitrates.
 
+            // Public members - Analysis data: Merging with the analysis of the previous chunk of stream.
+            uint64_t      first_pkt = 0;             //!< Index of first packet in the PID.
+            uint8_t       first_ts_sc = 0;           //!< Scrambling control of first packet.
+            uint8_t       first_continuity = 0;      //!< Continuity counter of first packet.
+            bool          first_discontinuity = false; //!< First packet has the discontinuity indicator.
+            bool          first_payload = false;     //!< First packet has a payload.
+            bool          broken_before_pcr = false; //!< A discontinuity was found before (or with) the first PCR.
+            uint64_t      first_pcr_pkt = 0;         //!< Index of packet with first PCR.
+            uint64_t      first_cryptop_pkt = 0;     //!< First packet index of first complete crypto-period.
+            uint64_t      first_cryptop_ts = 0;      //!< Number of TS packets in first complete crypto-period.
+
             //!
             //! Default constructor.
             //! @param [in] pid PID value.
@@ -437,7 +497,7 @@ namespace ts {
         //! @param [in] pid PID to search.
         //! @return True if the PID exists, false otherwise.
         //!
-        bool pidExists(PID pid) const { return _pids.contains(pid); }
+        bool pidExists(PID pid) const { return pid < PID_MAX && _pid_index[pid] != nullptr; }
 
         //!
         //! Get a PID context.
@@ -509,12 +569,21 @@ namespace ts {
         ServiceContextMap    _services {};            //!< Description of services, map key: service id.
 
     private:
+        friend class TSChunkAnalyzer;
+
         // Constant string "Unreferenced"
         static const UString UNREFERENCED;
 
         // Reset the section demux.
         void resetSectionDemux();
 
+        // Get a PID context, allocate a new entry if PID not found (same as getPID() without safe pointer).
+        PIDContext& getPIDContext(PID pid, const UString& description = UNREFERENCED);
+
+        // Merge the analysis of a PID or a table from the next chunk. The offset is the number of packets in this object.
+        void mergePID(PIDContext& pc, const PIDContext& next, uint64_t offset);
+        static void MergeXTID(XTIDContext& etc, const XTIDContext& next, uint64_t offset);
+
         // Analyze the various PSI tables
         void analyzePAT(const PAT&);
         void analyzeCAT(const CAT&);
@@ -569,10 +638,12 @@ namespace ts {
         uint64_t     _preceding_suspects = 0;        // Number of contiguous suspects packets before current packet
         uint64_t     _min_error_before_suspect = 1;  // Required number of invalid packets before starting suspect
         uint64_t     _max_consecutive_suspects = 1;  // Max number of consecutive suspect packets before clearing suspect
+        bool         _preceding = false;             // Feeding packets which precede the analyzed chunk, collect context only
         SectionDemux _demux {_duck, this, this};     // PSI tables analysis
-        PESDemux     _pes_demux {_duck, this};       // Audio/video analysis
+        PESDemux     _pes_demux {_duck, this, NoPID()}; // Audio/video analysis, only on PID's which are known to carry PES
         T2MIDemux    _t2mi_demux {_duck, this};      // T2-MI analysis
         LogicalChannelNumbers _lcn {_duck};          // Accumulate LCN and visible flags
         DCT          _dct {};                        // Last ISDB CDT waiting to be analyzed, waiting for TS id
+        std::array<PIDContext*, PID_MAX> _pid_index {}; // Direct access to PID contexts, owned by _pids
     };
 }
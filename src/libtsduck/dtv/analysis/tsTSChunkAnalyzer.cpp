@@ -0,0 +1,206 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSChunkAnalyzer.h"
+#include "tsTSFile.h"
+#include "tsThread.h"
+#include "tsAsyncReport.h"
+
+// Number of packets per read operation.
+#define PKT_BUFFER_COUNT 1024
+
+// Minimum number of packets per chunk. Smaller files use less chunks.
+#define MIN_CHUNK_PACKETS 1000
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::TSChunkAnalyzer::TSChunkAnalyzer(size_t chunk_count)
+{
+    setChunkCount(chunk_count);
+}
+
+void ts::TSChunkAnalyzer::setChunkCount(size_t chunk_count)
+{
+    _chunk_count = chunk_count > 0 ? chunk_count : std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a range of packets in a file, starting with context packets.
+// The file is read until end of file when end_packet is zero.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool AnalyzeRange(ts::TSAnalyzer& analyzer, const fs::path& filename, ts::TSPacketFormat format, size_t packet_size,
+                      ts::PacketCounter context_packet, ts::PacketCounter start_packet, ts::PacketCounter end_packet, ts::Report& report)
+    {
+        ts::TSFile file;
+        if (!file.openRead(filename, 1, context_packet * packet_size, report, format)) {
+            return false;
+        }
+
+        ts::TSPacketVector pkt(PKT_BUFFER_COUNT);
+        ts::TSPacketMetadataVector mdata(PKT_BUFFER_COUNT);
+        ts::PacketCounter index = context_packet;
+        size_t count = 0;
+        while ((end_packet == 0 || index < end_packet) &&
+               (count = file.readPackets(pkt.data(), mdata.data(), end_packet == 0 ? pkt.size() : size_t(std::min<ts::PacketCounter>(pkt.size(), end_packet - index)), report)) > 0)
+        {
+            for (size_t i = 0; i < count; ++i, ++index) {
+                if (index < start_packet) {
+                    analyzer.feedPrecedingPacket(pkt[i]);
+                }
+                else {
+                    analyzer.feedPacket(pkt[i], mdata[i]);
+                }
+            }
+        }
+        return file.close(report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Analysis of one chunk in a separate thread.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ChunkThread: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(ChunkThread);
+    public:
+        ChunkThread(ts::TSAnalyzer& analyzer, const fs::path& filename, ts::TSPacketFormat format, size_t packet_size,
+                    ts::PacketCounter context_packet, ts::PacketCounter start_packet, ts::PacketCounter end_packet, ts::Report& report) :
+            _analyzer(analyzer), _filename(filename), _format(format), _packet_size(packet_size),
+            _context_packet(context_packet), _start_packet(start_packet), _end_packet(end_packet), _report(report) {}
+        virtual ~ChunkThread() override { waitForTermination(); }
+        bool success() const { return _success; }
+        // Analyze the chunk in the calling thread, when the thread cannot be started.
+        void analyze() { _success = AnalyzeRange(_analyzer, _filename, _format, _packet_size, _context_packet, _start_packet, _end_packet, _report); }
+    private:
+        ts::TSAnalyzer&          _analyzer;
+        const fs::path           _filename;
+        const ts::TSPacketFormat _format;
+        const size_t             _packet_size;
+        const ts::PacketCounter  _context_packet;
+        const ts::PacketCounter  _start_packet;
+        const ts::PacketCounter  _end_packet;
+        ts::Report&              _report;
+        bool                     _success = false;
+        virtual void main() override { analyze(); }
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Serialize the messages from all chunks to the user's report.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ChunkReport: public ts::AsyncReport
+    {
+        TS_NOBUILD_NOCOPY(ChunkReport);
+    public:
+        ChunkReport(ts::Report& report) : ts::AsyncReport(report.maxSeverity()), _report(report) {}
+        virtual ~ChunkReport() override { terminate(); }
+    private:
+        ts::Report& _report;
+        virtual void asyncThreadLog(int severity, const ts::UString& message) override { _report.log(severity, message); }
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a TS file.
+//----------------------------------------------------------------------------
+
+bool ts::TSChunkAnalyzer::analyzeFile(TSAnalyzer& analyzer, const fs::path& filename, TSPacketFormat format, Report& report)
+{
+    // Parallel analysis is only possible on regular files.
+    size_t chunk_count = _chunk_count;
+    PacketCounter total_packets = 0;
+    size_t packet_size = PKT_SIZE;
+    std::error_code error;
+    if (chunk_count > 1 && !filename.empty() && filename != u"-" && fs::is_regular_file(filename, error)) {
+
+        // Read the first packet to get the actual file format.
+        TSFile file;
+        TSPacket pkt;
+        TSPacketMetadata mdata;
+        if (!file.openRead(filename, 1, 0, report, format)) {
+            return false;
+        }
+        if (file.readPackets(&pkt, &mdata, 1, report) == 1 && pkt.hasValidSync()) {
+            format = file.packetFormat();
+            packet_size = PKT_SIZE + file.packetHeaderSize() + file.packetTrailerSize();
+            total_packets = fs::file_size(filename, error) / packet_size;
+        }
+        file.close(report);
+        chunk_count = size_t(std::min<PacketCounter>(chunk_count, total_packets / MIN_CHUNK_PACKETS));
+    }
+
+    // Sequential analysis.
+    if (chunk_count <= 1) {
+        return AnalyzeRange(analyzer, filename, format, packet_size, 0, 0, 0, report);
+    }
+    report.debug(u"analyzing %s in %d chunks of %'d packets", filename, chunk_count, total_packets / chunk_count);
+
+    // All chunks, including the first one in the target analyzer, log through the same asynchronous
+    // report. Thus, the user's report is used from one single thread.
+    ChunkReport log(report);
+    Report& duck_report(analyzer._duck.report());
+    analyzer._duck.setReport(&log);
+
+    // Each chunk uses the same options as the main analyzer.
+    DuckContext::SavedArgs duck_args;
+    analyzer._duck.saveArgs(duck_args);
+    std::vector<std::unique_ptr<DuckContext>> ducks(chunk_count);
+    std::vector<std::unique_ptr<TSAnalyzer>> chunks(chunk_count);
+    std::vector<std::unique_ptr<ChunkThread>> threads(chunk_count);
+    std::vector<bool> started(chunk_count, false);
+
+    // Start the analysis of all chunks but the first one.
+    for (size_t i = 1; i < chunk_count; ++i) {
+        const PacketCounter start = total_packets * i / chunk_count;
+        const PacketCounter end = i + 1 < chunk_count ? total_packets * (i + 1) / chunk_count : 0;
+        const PacketCounter context = start - std::min(start, _context_packets);
+        ducks[i] = std::make_unique<DuckContext>(&log);
+        ducks[i]->restoreArgs(duck_args);
+        chunks[i] = std::make_unique<TSAnalyzer>(*ducks[i], analyzer._ts_user_bitrate, analyzer._ts_user_br_confidence);
+        chunks[i]->setMinErrorCountBeforeSuspect(analyzer._min_error_before_suspect);
+        chunks[i]->setMaxConsecutiveSuspectCount(analyzer._max_consecutive_suspects);
+        threads[i] = std::make_unique<ChunkThread>(*chunks[i], filename, format, packet_size, context, start, end, log);
+        started[i] = threads[i]->start();
+        if (!started[i]) {
+            log.debug(u"cannot start thread for chunk %d, will be analyzed later", i);
+        }
+    }
+
+    // Analyze the first chunk in the current thread, directly into the target analyzer.
+    bool success = AnalyzeRange(analyzer, filename, format, packet_size, 0, 0, total_packets / chunk_count, log);
+
+    // Wait for the completion of all chunks and merge them in order.
+    // The chunks which could not be started in a thread are analyzed here.
+    for (size_t i = 1; i < chunk_count; ++i) {
+        if (started[i]) {
+            threads[i]->waitForTermination();
+        }
+        else if (success) {
+            threads[i]->analyze();
+        }
+        success = success && threads[i]->success();
+        if (success) {
+            analyzer.merge(*chunks[i]);
+        }
+    }
+    analyzer._duck.setReport(&duck_report);
+    return success;
+}
@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Parallel analysis of a transport stream file in several chunks.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSAnalyzer.h"
+#include "tsTSPacketFormat.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Parallel analysis of a transport stream file in several chunks.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! A large seekable TS file is split in contiguous chunks of packets which are analyzed
+    //! in parallel threads. The analysis of each chunk starts with some "context" packets
+    //! which precede the chunk in the file. They are used to collect the PSI/SI tables which
+    //! apply at the start of the chunk, without being counted. The analyses of all chunks
+    //! are finally merged, in order, into the target analyzer.
+    //!
+    //! The number of context packets shall be large enough to include a complete
+    //! repetition cycle of the PAT, PMT's and other signalization tables. Otherwise,
+    //! the first packets of some PID's in a chunk may be analyzed without knowing their
+    //! type and the merged analysis may slightly differ from a sequential analysis.
+    //!
+    //! The chunks are located at multiples of the packet size from the beginning of the file.
+    //! Therefore, the file must contain packets of constant size, starting at byte 0. When the
+    //! first packet of the file does not start with a sync byte, the file is sequentially analyzed.
+    //!
+    class TSDUCKDLL TSChunkAnalyzer
+    {
+        TS_NOCOPY(TSChunkAnalyzer);
+    public:
+        //!
+        //! Default number of context packets before each chunk.
+        //!
+        static constexpr PacketCounter DEFAULT_CONTEXT_PACKETS = 100'000;
+
+        //!
+        //! Constructor.
+        //! @param [in] chunk_count Number of chunks to analyze in parallel.
+        //! When zero, use the number of CPU cores.
+        //!
+        explicit TSChunkAnalyzer(size_t chunk_count = 0);
+
+        //!
+        //! Set the number of chunks to analyze in parallel.
+        //! @param [in] chunk_count Number of chunks to analyze in parallel.
+        //! When zero, use the number of CPU cores.
+        //!
+        void setChunkCount(size_t chunk_count);
+
+        //!
+        //! Set the number of context packets which are read before each chunk.
+        //! @param [in] count Number of context packets before each chunk.
+        //!
+        void setContextPacketCount(PacketCounter count) { _context_packets = count; }
+
+        //!
+        //! Analyze a TS file.
+        //! If the file is not seekable, too small, or does not start with a TS packet, it is sequentially analyzed.
+        //! @param [in,out] analyzer The analyzer to feed. It should be freshly reset.
+        //! The analysis of each chunk uses the same options (bitrate hint, suspect packets
+        //! thresholds, standards) as this analyzer.
+        //! @param [in] filename Name of the TS file.
+        //! @param [in] format Format of the TS file.
+        //! @param [in,out] report Where to report errors. During a parallel analysis, all messages are
+        //! serialized through an asynchronous report and this report does not need to be thread-safe.
+        //! @return True on success, false on error.
+        //!
+        bool analyzeFile(TSAnalyzer& analyzer, const fs::path& filename, TSPacketFormat format, Report& report);
+
+    private:
+        size_t        _chunk_count = 1;
+        PacketCounter _context_packets = DEFAULT_CONTEXT_PACKETS;
+    };
+}
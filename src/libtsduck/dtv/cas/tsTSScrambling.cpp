@@ -530,3 +530,112 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several TS packets.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encryptBatch(TSPacket* const pkts[], size_t count)
+{
+    _batch_packets.clear();
+    for (size_t i = 0; i < count; ++i) {
+        TSPacket* const pkt = pkts[i];
+        if (pkt == nullptr) {
+            continue;
+        }
+        // Filter out encrypted packets, silently pass packets without payload.
+        if (pkt->isScrambled()) {
+            _report.error(u"try to scramble an already scrambled packet");
+            return false;
+        }
+        if (pkt->hasPayload()) {
+            _batch_packets.push_back(pkt);
+        }
+    }
+    if (_batch_packets.empty()) {
+        return true;
+    }
+
+    // If no current parity is set, start with even by default.
+    if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+        return false;
+    }
+    assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
+
+    if (_scrambler[_encrypt_scv & 1] == &_dvbcsa[_encrypt_scv & 1]) {
+        return flushBatch(true, _encrypt_scv);
+    }
+    else {
+        // Not DVB-CSA2, encrypt packets one by one.
+        for (auto pkt : _batch_packets) {
+            if (!encrypt(*pkt)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool ts::TSScrambling::decryptBatch(TSPacket* const pkts[], size_t count)
+{
+    _batch_packets.clear();
+    for (size_t i = 0; i < count; ++i) {
+        TSPacket* const pkt = pkts[i];
+        if (pkt == nullptr) {
+            continue;
+        }
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = pkt->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+        if (scv == _decrypt_scv && _scrambler[scv & 1] == &_dvbcsa[scv & 1]) {
+            // Same parity as previous packet with DVB-CSA2, add to batch.
+            _batch_packets.push_back(pkt);
+        }
+        else if (!flushBatch(false, _decrypt_scv) || !decrypt(*pkt)) {
+            // Parity change or not DVB-CSA2: process the batch of previous packets,
+            // then let decrypt() handle the new parity (fixed control word rotation).
+            return false;
+        }
+    }
+    return flushBatch(false, _decrypt_scv);
+}
+
+bool ts::TSScrambling::flushBatch(bool encrypt, uint8_t scv)
+{
+    if (_batch_packets.empty()) {
+        return true;
+    }
+
+    // DVB-CSA2 accepts residues, the complete payloads are processed.
+    _batch_data.clear();
+    _batch_sizes.clear();
+    for (auto pkt : _batch_packets) {
+        _batch_data.push_back(pkt->getPayload());
+        _batch_sizes.push_back(pkt->getPayloadSize());
+    }
+
+    DVBCSA2& algo(_dvbcsa[scv & 1]);
+    bool ok = false;
+    if (encrypt) {
+        ok = algo.encryptBatch(_batch_data.data(), _batch_sizes.data(), _batch_data.size());
+        if (!ok) {
+            _report.error(u"packet encryption error using %s", algo.name());
+        }
+    }
+    else {
+        ok = algo.decryptBatch(_batch_data.data(), _batch_sizes.data(), _batch_data.size());
+        if (!ok) {
+            _report.error(u"packet decryption error using %s", algo.name());
+        }
+    }
+    if (ok) {
+        for (auto pkt : _batch_packets) {
+            pkt->setScrambling(encrypt ? scv : uint8_t(SC_CLEAR));
+        }
+    }
+    _batch_packets.clear();
+    return ok;
+}
@@ -191,6 +191,27 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt several TS packets with the current parity and corresponding CW.
+        //! This is equivalent to calling encrypt() on each packet but, with DVB-CSA2,
+        //! all packets are processed in parallel using a bitsliced implementation.
+        //! @param [in,out] pkts Array of @a count addresses of packets. Null pointers are ignored.
+        //! @param [in] count Number of packets.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encryptBatch(TSPacket* const pkts[], size_t count);
+
+        //!
+        //! Decrypt several TS packets with the CW corresponding to the parity in each packet.
+        //! This is equivalent to calling decrypt() on each packet but, with DVB-CSA2,
+        //! consecutive packets with the same parity are processed in parallel using a
+        //! bitsliced implementation.
+        //! @param [in,out] pkts Array of @a count addresses of packets. Null pointers are ignored.
+        //! @param [in] count Number of packets.
+        //! @return True on success, false on error. Clear packets are not an error.
+        //!
+        bool decryptBatch(TSPacket* const pkts[], size_t count);
+
     private:
         // List of control words
         using CWList = std::list<ByteBlock>;
@@ -210,10 +231,16 @@ namespace ts {
         CBC<AES128>      _aescbc[2] {};
         CTR<AES128>      _aesctr[2] {};
         BlockCipher*     _scrambler[2] {nullptr, nullptr};
+        std::vector<TSPacket*> _batch_packets {};  // Packets to process in next DVB-CSA2 batch.
+        std::vector<uint8_t*>  _batch_data {};     // Payloads of these packets.
+        std::vector<size_t>    _batch_sizes {};    // Payload sizes.
 
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Process the pending DVB-CSA2 batch of packets with the given parity.
+        bool flushBatch(bool encrypt, uint8_t scv);
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
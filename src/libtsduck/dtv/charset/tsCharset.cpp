@@ -153,6 +153,19 @@ ts::UString ts::Charset::decodedWithByteLength(const uint8_t*& data, size_t& siz
 }
 
 
+//----------------------------------------------------------------------------
+// Decode a string directly into UTF-8, default implementation.
+//----------------------------------------------------------------------------
+
+bool ts::Charset::decodeUTF8(std::string& utf8, const uint8_t* data, size_t size) const
+{
+    UString str;
+    const bool status = decode(str, data, size);
+    str.toUTF8(utf8);
+    return status;
+}
+
+
 //----------------------------------------------------------------------------
 // Encode a C++ Unicode string preceded by its one-byte length.
 //----------------------------------------------------------------------------
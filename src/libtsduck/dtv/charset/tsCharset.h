@@ -94,6 +94,21 @@ namespace ts {
         //!
         UString decodedWithByteLength(const uint8_t*& data, size_t& size) const;
 
+        //!
+        //! Decode a string from the specified byte buffer directly into UTF-8.
+        //!
+        //! This is faster than decode() followed by UString::toUTF8() when the character set
+        //! can produce UTF-8 without intermediate UTF-16 representation. This is typically
+        //! the case of text in ASCII or UTF-8, which is the most common case when tables are
+        //! formatted in XML, JSON or text. The default implementation uses decode().
+        //!
+        //! @param [out] utf8 Returned decoded string in UTF-8 format.
+        //! @param [in] data Address of an encoded string.
+        //! @param [in] size Size in bytes of the encoded string.
+        //! @return True on success, false on error (truncated, unsupported format, etc.)
+        //!
+        virtual bool decodeUTF8(std::string& utf8, const uint8_t* data, size_t size) const;
+
         //!
         //! Check if a string can be encoded using the charset (ie all characters can be represented).
         //! @param [in] str The string to encode.
@@ -9,6 +9,12 @@
 #include "tsDVBCharTableSingleByte.h"
 #include "tsUString.h"
 
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
 // Static instances of corresponding DVB charsets.
 // The charset tables register themselves during initialization.
 const ts::DVBCharset ts::DVBCharTableSingleByte::DVB_ISO_6937(u"ISO-6937", &RAW_ISO_6937);
@@ -44,27 +50,99 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
 
     // Code point to byte mapping for ASCII range
     for (size_t i = 0x20; i <= 0x7E; i++) {
+        _codePoints[i] = UChar(i);
         _bytesMap.insert(std::make_pair(UChar(i), uint8_t(i)));
     }
 
     // Control codes
+    _codePoints[DVB_SINGLE_BYTE_CRLF] = LINE_FEED;
     _bytesMap.insert(std::make_pair(LINE_FEED, DVB_SINGLE_BYTE_CRLF));
 
     // Code point to byte mapping for 0xA0-0xFF range
     for (size_t i = 0; i < _upperCodePoints.size(); i++) {
         if (_upperCodePoints[i] != 0) {
+            _codePoints[0xA0 + i] = UChar(_upperCodePoints[i]);
             _bytesMap.insert(std::make_pair(UChar(_upperCodePoints[i]), uint8_t(0xA0 + i)));
+            _diacritical.set(0xA0 + i, IsCombiningDiacritical(UChar(_upperCodePoints[i])));
         }
     }
 
     // Combining diacritical marks which precede their base letter (and must be reversed from Unicode).
     for (auto it : revDiac) {
         if (it >= 0xA0) {
-            _reversedDiacritical.set(it - 0xA0);
+            _reversedDiacritical.set(it);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Vectorized fast path on 16 printable ASCII characters (0x20-0x7E), which
+// are identical in all single-byte tables. These functions return false
+// when the 16 input bytes are not all printable ASCII characters.
+//----------------------------------------------------------------------------
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+namespace {
+    #if defined(__SSE2__)
+    // Printable ASCII characters are the signed bytes which are greater than 0x1F and less than 0x7F.
+    inline bool LoadPrintableASCII16(__m128i& v, const uint8_t* in)
+    {
+        v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        return _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)), _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)))) == 0xFFFF;
+    }
+    #else
+    inline bool LoadPrintableASCII16(uint8x16_t& v, const uint8_t* in)
+    {
+        v = vld1q_u8(in);
+        return vminvq_u8(v) >= 0x20 && vmaxvq_u8(v) <= 0x7E;
+    }
+    #endif
+
+    // Decode 16 printable ASCII characters into UTF-16.
+    inline bool DecodePrintableASCII16(ts::UChar* out, const uint8_t* in)
+    {
+    #if defined(__SSE2__)
+        __m128i v;
+        if (LoadPrintableASCII16(v, in)) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+            return true;
+        }
+    #else
+        uint8x16_t v;
+        if (LoadPrintableASCII16(v, in)) {
+            vst1q_u16(reinterpret_cast<uint16_t*>(out), vmovl_u8(vget_low_u8(v)));
+            vst1q_u16(reinterpret_cast<uint16_t*>(out + 8), vmovl_u8(vget_high_u8(v)));
+            return true;
+        }
+    #endif
+        return false;
+    }
+
+    // Decode 16 printable ASCII characters into UTF-8.
+    inline bool DecodePrintableASCII16(char* out, const uint8_t* in)
+    {
+    #if defined(__SSE2__)
+        __m128i v;
+        if (LoadPrintableASCII16(v, in)) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+            return true;
+        }
+    #else
+        uint8x16_t v;
+        if (LoadPrintableASCII16(v, in)) {
+            vst1q_u8(reinterpret_cast<uint8_t*>(out), v);
+            return true;
         }
+    #endif
+        return false;
     }
 }
 
+#endif
+
 
 //----------------------------------------------------------------------------
 // Decode a DVB string from the specified byte buffer.
@@ -72,46 +150,52 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
 
 bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t dvbSize) const
 {
-    str.clear();
-    str.reserve(dvbSize);
+    // There is at most one character per byte, the string is directly built in its buffer.
+    if (dvb == nullptr) {
+        dvbSize = 0;
+    }
+    str.resize(dvbSize);
+    UChar* const out = str.data();
+    size_t len = 0;
     bool status = true;
     bool reverseNext = false;  // after decoding next character, it shall be swapped with previous one.
     bool hasDiacritical = false;
 
-    for (; dvb != nullptr && dvbSize > 0; --dvbSize) {
-        // Get next byte
-        const uint8_t b = *dvb++;
-        // Convert it to a code point
-        uint16_t cp = 0;
-        if (b >= 0x20 && b <= 0x7E) {
-            cp = b; // ASCII range = identity
-        }
-        else if (b >= 0xA0) {
-            cp = _upperCodePoints[b - 0xA0];
-        }
-        else if (b == DVB_SINGLE_BYTE_CRLF) {
-            cp = LINE_FEED;
+    for (size_t i = 0; i < dvbSize; ) {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        // Try a block of ASCII characters, only when starting on an ASCII character.
+        if (!reverseNext && dvb[i] >= 0x20 && dvb[i] <= 0x7E && dvbSize - i >= 16 && DecodePrintableASCII16(out + len, dvb + i)) {
+            i += 16;
+            len += 16;
+            continue;
         }
+#endif
+        // Get next byte and convert it to a code point.
+        const uint8_t b = dvb[i++];
+        const UChar cp = _codePoints[b];
         // Add in result if no error.
-        if (cp == 0) {
+        if (cp == CHAR_NULL) {
             // Untranslatable character.
             status = false;
         }
-        else if (reverseNext && !str.empty()) {
+        else if (reverseNext && len > 0) {
             // Insert decoded character before the previous one.
             // This is typically a letter coming after a reversable diacritical mark.
             // In Unicode, the letter must preceed the diacritical mark.
-            str.insert(str.length() - 1, 1, UChar(cp));
+            out[len] = out[len - 1];
+            out[len - 1] = cp;
+            len++;
         }
         else {
             // Simply add the decoded character.
-            str.push_back(UChar(cp));
+            out[len++] = cp;
         }
         // Try the presence of diacritical, reversable or not.
-        hasDiacritical = hasDiacritical || IsCombiningDiacritical(UChar(cp));
+        hasDiacritical = hasDiacritical || _diacritical.test(b);
         // Shall we perform mark/letter swap next time?
-        reverseNext = b >= 0xA0 && _reversedDiacritical.test(b - 0xA0);
+        reverseNext = _reversedDiacritical.test(b);
     }
+    str.resize(len);
 
     // If some diacritical mark was found, try to combine them.
     if (hasDiacritical) {
@@ -122,6 +206,61 @@ bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t
 }
 
 
+//----------------------------------------------------------------------------
+// Decode a DVB string directly into UTF-8.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCharTableSingleByte::decodeUTF8(std::string& utf8, const uint8_t* dvb, size_t dvbSize) const
+{
+    // All code points are in the BMP, there are at most 3 UTF-8 bytes per input byte.
+    if (dvb == nullptr) {
+        dvbSize = 0;
+    }
+    utf8.resize(3 * dvbSize);
+    char* const out = utf8.data();
+    size_t len = 0;
+    bool status = true;
+
+    for (size_t i = 0; i < dvbSize; ) {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        // Try a block of ASCII characters, only when starting on an ASCII character.
+        if (dvb[i] >= 0x20 && dvb[i] <= 0x7E && dvbSize - i >= 16 && DecodePrintableASCII16(out + len, dvb + i)) {
+            i += 16;
+            len += 16;
+            continue;
+        }
+#endif
+        const uint8_t b = dvb[i++];
+        if (_diacritical.test(b) || _reversedDiacritical.test(b)) {
+            // Diacritical marks must be reordered and combined in UTF-16.
+            return DVBCharTable::decodeUTF8(utf8, dvb, dvbSize);
+        }
+        uint32_t cp = _codePoints[b];
+        if (cp == 0) {
+            // Untranslatable character.
+            status = false;
+        }
+        else if (cp < 0x80) {
+            out[len++] = char(cp);
+        }
+        else if (cp < 0x800) {
+            out[len + 1] = char(0x80 | (cp & 0x3F));
+            out[len] = char(0xC0 | (cp >> 6));
+            len += 2;
+        }
+        else {
+            out[len + 2] = char(0x80 | (cp & 0x3F));
+            cp >>= 6;
+            out[len + 1] = char(0x80 | (cp & 0x3F));
+            out[len] = char(0xE0 | (cp >> 6));
+            len += 3;
+        }
+    }
+    utf8.resize(len);
+    return status;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a string can be encoded using the charset.
 //----------------------------------------------------------------------------
@@ -157,7 +296,7 @@ size_t ts::DVBCharTableSingleByte::encode(uint8_t*& buffer, size_t& size, const
             *buffer = it->second;
             size--;
             // Reverse letter and diacritical mark when necessary.
-            if (buffer > base && *buffer >= 0xA0 && _reversedDiacritical.test(*buffer - 0xA0)) {
+            if (buffer > base && *buffer >= 0xA0 && _reversedDiacritical.test(*buffer)) {
                 // Reverse order of letter/mark into mark/letter.
                 std::swap(buffer[-1], buffer[0]);
             }
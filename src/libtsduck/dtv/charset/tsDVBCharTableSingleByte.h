@@ -70,6 +70,7 @@ namespace ts {
 
         // Inherited methods.
         virtual bool decode(UString& str, const uint8_t* dvb, size_t dvbSize) const override;
+        virtual bool decodeUTF8(std::string& utf8, const uint8_t* dvb, size_t dvbSize) const override;
         virtual bool canEncode(const UString& str, size_t start = 0, size_t count = NPOS) const override;
         virtual size_t encode(uint8_t*& buffer, size_t& size, const UString& str, size_t start = 0, size_t count = NPOS) const override;
 
@@ -87,12 +88,18 @@ namespace ts {
         // List of code points for byte values 0xA0-0xFF. Always contain 96 values.
         const std::vector<uint16_t> _upperCodePoints {};
 
+        // Decoded code point for all byte values, zero means unused.
+        std::array<UChar, 256> _codePoints {};
+
         // Reverse mapping for complete character set (key = code point, value = byte rep).
         std::map<UChar, uint8_t> _bytesMap {};
 
+        // Bitmap of byte values which are decoded as combining diacritical marks.
+        std::bitset<256> _diacritical {};
+
         // Bitmap of combining diacritical marks which precede their base letter (and must be reversed from Unicode).
-        // This only applies to byte values 0xA0-0xFF (96 values).
-        std::bitset<96> _reversedDiacritical {};
+        // This only applies to byte values 0xA0-0xFF.
+        std::bitset<256> _reversedDiacritical {};
     };
 }
 
@@ -36,6 +36,72 @@ bool ts::DVBCharTableUTF8::decode(UString& str, const uint8_t* dvb, size_t dvbSi
 }
 
 
+//----------------------------------------------------------------------------
+// Decode a DVB string directly into UTF-8.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Check if a byte sequence is strictly valid UTF-8 (no overlong form, no surrogate,
+    // no code point above 0x10FFFF). Such a sequence is unchanged after a round trip
+    // through UTF-16.
+    bool IsStrictUTF8(const uint8_t* data, size_t size)
+    {
+        const uint8_t* const end = data + size;
+        while (data < end) {
+            const uint8_t b = *data++;
+            if (b < 0x80) {
+                continue;
+            }
+            // Number of continuation bytes and allowed range of the first one.
+            size_t count = 0;
+            uint8_t low = 0x80, high = 0xBF;
+            if (b >= 0xC2 && b <= 0xDF) {
+                count = 1;
+            }
+            else if (b >= 0xE0 && b <= 0xEF) {
+                count = 2;
+                low = b == 0xE0 ? 0xA0 : 0x80;   // overlong
+                high = b == 0xED ? 0x9F : 0xBF;  // surrogates
+            }
+            else if (b >= 0xF0 && b <= 0xF4) {
+                count = 3;
+                low = b == 0xF0 ? 0x90 : 0x80;   // overlong
+                high = b == 0xF4 ? 0x8F : 0xBF;  // above 0x10FFFF
+            }
+            else {
+                return false;
+            }
+            if (size_t(end - data) < count || *data < low || *data > high) {
+                return false;
+            }
+            for (size_t i = 1; i < count; ++i) {
+                if ((data[i] & 0xC0) != 0x80) {
+                    return false;
+                }
+            }
+            data += count;
+        }
+        return true;
+    }
+}
+
+bool ts::DVBCharTableUTF8::decodeUTF8(std::string& utf8, const uint8_t* dvb, size_t dvbSize) const
+{
+    if (dvb == nullptr || dvbSize == 0) {
+        utf8.clear();
+    }
+    else if (IsStrictUTF8(dvb, dvbSize)) {
+        // Valid UTF-8, no need to transcode.
+        utf8.assign(reinterpret_cast<const char*>(dvb), dvbSize);
+    }
+    else {
+        // Invalid sequences are dropped, as when decoding in a UString.
+        UString::FromUTF8(reinterpret_cast<const char*>(dvb), dvbSize).toUTF8(utf8);
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a string can be encoded using the charset.
 //----------------------------------------------------------------------------
@@ -39,6 +39,30 @@ bool ts::DVBCharset::canEncode(const UString& str, size_t start, size_t count) c
 }
 
 
+//----------------------------------------------------------------------------
+// Get the character table of a DVB string and skip the table code.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCharset::getTable(const DVBCharTable*& table, const uint8_t*& data, size_t& size) const
+{
+    // Get the DVB character set code from the beginning of the string.
+    uint32_t code = 0;
+    size_t codeSize = 0;
+    if (!DVBCharTable::DecodeTableCode(code, codeSize, data, size)) {
+        return false;
+    }
+
+    // Skip the character code.
+    assert(codeSize <= size);
+    data += codeSize;
+    size -= codeSize;
+
+    // Get the character set for this DVB string.
+    table = code == 0 ? _default_table : DVBCharTable::GetTableFromLeadingCode(code);
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Decode a DVB string from the specified byte buffer.
 //----------------------------------------------------------------------------
@@ -54,30 +78,55 @@ bool ts::DVBCharset::decode(UString& str, const uint8_t* data, size_t size) cons
         return true;
     }
 
-    // Get the DVB character set code from the beginning of the string.
-    uint32_t code = 0;
-    size_t codeSize = 0;
-    if (!DVBCharTable::DecodeTableCode(code, codeSize, data, size)) {
+    // Get the character set for this DVB string.
+    const DVBCharTable* table = nullptr;
+    if (!getTable(table, data, size)) {
         return false;
     }
+    else if (table == nullptr) {
+        // Unsupported character table. Collect all ANSI characters, replace others by '.'.
+        for (size_t i = 0; i < size; i++) {
+            str.push_back(data[i] >= 0x20 && data[i] <= 0x7E ? UChar(data[i]) : FULL_STOP);
+        }
+        return false;
+    }
+    else {
+        // Convert the DVB string using the character table.
+        table->decode(str, data, size);
+        return true;
+    }
+}
 
-    // Skip the character code.
-    assert(codeSize <= size);
-    data += codeSize;
-    size -= codeSize;
+
+//----------------------------------------------------------------------------
+// Decode a DVB string directly into UTF-8.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCharset::decodeUTF8(std::string& utf8, const uint8_t* data, size_t size) const
+{
+    utf8.clear();
+
+    // Null or empty buffer is a valid empty string.
+    if (data == nullptr || size == 0) {
+        return true;
+    }
 
     // Get the character set for this DVB string.
-    const DVBCharTable* table = code == 0 ? _default_table : DVBCharTable::GetTableFromLeadingCode(code);
-    if (table == nullptr) {
+    const DVBCharTable* table = nullptr;
+    if (!getTable(table, data, size)) {
+        return false;
+    }
+    else if (table == nullptr) {
         // Unsupported character table. Collect all ANSI characters, replace others by '.'.
+        utf8.reserve(size);
         for (size_t i = 0; i < size; i++) {
-            str.push_back(data[i] >= 0x20 && data[i] <= 0x7E ? UChar(data[i]) : FULL_STOP);
+            utf8.push_back(data[i] >= 0x20 && data[i] <= 0x7E ? char(data[i]) : '.');
         }
         return false;
     }
     else {
         // Convert the DVB string using the character table.
-        table->decode(str, data, size);
+        table->decodeUTF8(utf8, data, size);
         return true;
     }
 }
@@ -59,10 +59,15 @@ namespace ts {
 
         // Inherited methods.
         virtual bool decode(UString& str, const uint8_t* data, size_t size) const override;
+        virtual bool decodeUTF8(std::string& utf8, const uint8_t* data, size_t size) const override;
         virtual bool canEncode(const UString& str, size_t start = 0, size_t count = NPOS) const override;
         virtual size_t encode(uint8_t*& buffer, size_t& size, const UString& str, size_t start = 0, size_t count = NPOS) const override;
 
     private:
         const DVBCharTable* const _default_table; // Default character table, never null.
+
+        // Get the character table of a DVB string and skip the table code.
+        // Return false on invalid table code. The returned table is null when unsupported.
+        bool getTable(const DVBCharTable*& table, const uint8_t*& data, size_t& size) const;
     };
 }
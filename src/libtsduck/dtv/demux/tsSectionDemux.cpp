@@ -160,6 +160,78 @@ void ts::SectionDemux::XTIDContext::notify(SectionDemux& demux, bool pack, bool
 }
 
 
+//----------------------------------------------------------------------------
+// Hash table of XTID contexts.
+//----------------------------------------------------------------------------
+
+// Index of the first entry to probe for a XTID.
+size_t ts::SectionDemux::XTIDTable::firstIndex(const XTID& xtid) const
+{
+    // Fibonacci hashing of the 25 significant bits of the XTID.
+    const uint32_t key = (xtid.isLongSection() ? 0x01000000 : 0) | (uint32_t(xtid.tid()) << 16) | xtid.tidExt();
+    return size_t((key * 0x9E3779B1) >> 8) & (_entries.size() - 1);
+}
+
+// Get the context for a XTID, create it if it did not exist.
+ts::SectionDemux::XTIDContext& ts::SectionDemux::XTIDTable::operator[](const XTID& xtid)
+{
+    // Look for an existing entry.
+    if (!_entries.empty()) {
+        const size_t mask = _entries.size() - 1;
+        for (size_t i = firstIndex(xtid); _entries[i].used; i = (i + 1) & mask) {
+            if (_entries[i].xtid == xtid) {
+                return _entries[i].context;
+            }
+        }
+    }
+
+    // Not found, keep the load factor below 1/2 before creating the new entry.
+    if (2 * (_count + 1) > _entries.size()) {
+        std::vector<Entry> old(std::max<size_t>(8, 2 * _entries.size()));
+        old.swap(_entries);
+        const size_t mask = _entries.size() - 1;
+        for (auto& e : old) {
+            if (e.used) {
+                size_t i = firstIndex(e.xtid);
+                while (_entries[i].used) {
+                    i = (i + 1) & mask;
+                }
+                _entries[i] = std::move(e);
+            }
+        }
+    }
+
+    // Create the new entry in the first free slot.
+    const size_t mask = _entries.size() - 1;
+    size_t i = firstIndex(xtid);
+    while (_entries[i].used) {
+        i = (i + 1) & mask;
+    }
+    _entries[i].used = true;
+    _entries[i].xtid = xtid;
+    _count++;
+    return _entries[i].context;
+}
+
+// Get pointers to all contexts, sorted by XTID.
+void ts::SectionDemux::XTIDTable::getSorted(std::vector<XTIDContext*>& contexts)
+{
+    std::vector<Entry*> entries;
+    entries.reserve(_count);
+    for (auto& e : _entries) {
+        if (e.used) {
+            entries.push_back(&e);
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry* e1, const Entry* e2) { return e1->xtid < e2->xtid; });
+    contexts.clear();
+    contexts.reserve(entries.size());
+    for (auto e : entries) {
+        contexts.push_back(&e->context);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Analysis context for one PID.
 // Called when packet synchronization is lost on the pid.
@@ -179,7 +251,8 @@ void ts::SectionDemux::PIDContext::syncLost()
 ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_handler, SectionHandlerInterface* section_handler, const PIDSet& pid_filter) :
     SuperClass(duck, pid_filter),
     _table_handler(table_handler),
-    _section_handler(section_handler)
+    _section_handler(section_handler),
+    _pids(PID_MAX)
 {
 }
 
@@ -191,13 +264,31 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
 void ts::SectionDemux::immediateReset()
 {
     SuperClass::immediateReset();
-    _pids.clear();
+    for (auto& pc : _pids) {
+        pc.reset();
+    }
 }
 
 void ts::SectionDemux::immediateResetPID(PID pid)
 {
     SuperClass::immediateResetPID(pid);
-    _pids.erase(pid);
+    if (pid < _pids.size()) {
+        _pids[pid].reset();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the context of a PID, create it if it did not exist.
+//----------------------------------------------------------------------------
+
+ts::SectionDemux::PIDContext& ts::SectionDemux::getPIDContext(PID pid)
+{
+    auto& pc(_pids[pid & (PID_MAX - 1)]);
+    if (pc == nullptr) {
+        pc = std::make_unique<PIDContext>();
+    }
+    return *pc;
 }
 
 
@@ -224,7 +315,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
     // Get PID and reference to the PID context.
     // The PID context is created if did not exist.
     const PID pid = pkt.getPID();
-    PIDContext& pc(_pids[pid]);
+    PIDContext& pc(getPIDContext(pid));
 
     // If TS packet is scrambled, we cannot decode it and we loose synchronization
     // on this PID (usually, PID's carrying sections are not scrambled).
@@ -494,7 +585,12 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             SectionPtr sect_ptr;
 
             if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number] == nullptr))) {
-                sect_ptr = std::make_shared<Section>(ts_start, section_length, pid, CRC32::CHECK);
+                if (_block_pool == nullptr) {
+                    sect_ptr = std::make_shared<Section>(ts_start, section_length, pid, CRC32::CHECK);
+                }
+                else {
+                    sect_ptr = std::make_shared<Section>(_block_pool->allocate(ts_start, section_length), pid, CRC32::CHECK);
+                }
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
                 if (!sect_ptr->isValid()) {
@@ -564,19 +660,23 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
 void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
 {
     // Loop on all PID's.
-    for (auto& it1 : _pids) {
-        const PID pid = it1.first;
-        PIDContext& pc(it1.second);
+    std::vector<XTIDContext*> contexts;
+    for (PID pid = 0; pid < _pids.size(); ++pid) {
+        if (_pids[pid] == nullptr) {
+            continue;
+        }
+        PIDContext& pc(*_pids[pid]);
 
         // Mark that we are in the context of a table or section handler.
         // This is used to prevent the destruction of PID contexts during
         // the execution of a handler.
         beforeCallingHandler(pid);
         try {
-            // Loop on all TID's currently found in the PID.
-            for (auto& it2 : pc.tids) {
+            // Loop on all TID's currently found in the PID, in XTID order.
+            pc.tids.getSorted(contexts);
+            for (auto tc : contexts) {
                 // Force a notification of the partial table, if any.
-                it2.second.notify(*this, pack, fill_eit);
+                tc->notify(*this, pack, fill_eit);
             }
         }
         catch (...) {
@@ -596,7 +696,7 @@ bool ts::SectionDemux::notifyInvalid(PID pid, Section::Status status, const uint
 {
     if (_invalid_handler != nullptr) {
         // Build a demuxed data from the TS payload buffer.
-        PIDContext& pc(_pids[pid]);
+        PIDContext& pc(getPIDContext(pid));
         if (ts_start >= pc.ts.data() && ts_start < pc.ts.dataEnd()) {
             DemuxedData data(ts_start, std::min<size_t>(ts_size, pc.ts.dataEnd() - ts_start), pid);
             data.setFirstTSPacketIndex(pc.pusi_pkt_index);
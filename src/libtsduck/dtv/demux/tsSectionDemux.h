@@ -18,6 +18,7 @@
 #include "tsSectionHandlerInterface.h"
 #include "tsInvalidSectionHandlerInterface.h"
 #include "tsXTID.h"
+#include "tsByteBlockPool.h"
 
 namespace ts {
     //!
@@ -141,6 +142,18 @@ namespace ts {
             _track_invalid_version = on;
         }
 
+        //!
+        //! Use a pool of byte blocks to allocate the content of the demuxed sections.
+        //! On streams with many sections, such as EIT, this avoids the allocation and deallocation
+        //! of the content of each section. Released sections return their content to the pool.
+        //! The same pool can be shared by several demux.
+        //! @param [in] pool The pool to use. If null, sections are individually allocated (the default).
+        //!
+        void setBlockPool(const ByteBlockPoolPtr& pool)
+        {
+            _block_pool = pool;
+        }
+
         //!
         //! Set the log level for messages reporting transport stream errors in demux.
         //! By default, the log level is Severity::Debug.
@@ -252,6 +265,36 @@ namespace ts {
             void notify(SectionDemux& demux, bool pack, bool fill_eit);
         };
 
+        // Open-addressed hash table of XTID contexts, using linear probing.
+        // On EIT PID's, there can be thousands of XTID's, one per service and table id.
+        // There is no individual removal, the table is cleared with the PID context.
+        class XTIDTable
+        {
+        public:
+            // Get the context for a XTID, create it if it did not exist.
+            // Previously returned references are invalidated when a new XTID is created.
+            XTIDContext& operator[](const XTID& xtid);
+
+            // Get pointers to all contexts, sorted by XTID.
+            void getSorted(std::vector<XTIDContext*>& contexts);
+
+            // Number of XTID contexts in the table.
+            size_t size() const { return _count; }
+
+        private:
+            struct Entry
+            {
+                bool        used = false;
+                XTID        xtid {};
+                XTIDContext context {};
+            };
+            std::vector<Entry> _entries {};  // Size is zero or a power of 2.
+            size_t             _count = 0;   // Number of used entries.
+
+            // Index of the first entry to probe for a XTID.
+            size_t firstIndex(const XTID& xtid) const;
+        };
+
         // This internal structure contains the analysis context for one PID.
         struct PIDContext
         {
@@ -259,7 +302,7 @@ namespace ts {
             uint8_t       continuity = 0;        // Last continuity counter
             bool          sync = false;          // We are synchronous in this PID
             ByteBlock     ts {};                 // TS payload buffer
-            std::map<XTID,XTIDContext> tids {};  // TID analysis contexts
+            XTIDTable     tids {};               // TID analysis contexts
 
             // Default constructor.
             PIDContext() = default;
@@ -268,6 +311,9 @@ namespace ts {
             void syncLost();
         };
 
+        // Get the context of a PID, create it if it did not exist.
+        PIDContext& getPIDContext(PID pid);
+
         // Notify the application if the table is complete.
         // Do not notify twice the same table.
         // If pack is true, build a packed version of the table and report it.
@@ -282,7 +328,8 @@ namespace ts {
         TableHandlerInterface*          _table_handler = nullptr;
         SectionHandlerInterface*        _section_handler = nullptr;
         InvalidSectionHandlerInterface* _invalid_handler = nullptr;
-        std::map<PID,PIDContext>        _pids {};
+        std::vector<std::unique_ptr<PIDContext>> _pids;  // Directly indexed by PID, PID_MAX entries.
+        ByteBlockPoolPtr                _block_pool {};  // Optional pool for section contents.
         Status _status {};
         bool   _get_current = true;
         bool   _get_next = false;
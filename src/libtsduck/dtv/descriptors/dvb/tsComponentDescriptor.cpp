@@ -14,6 +14,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 
 #define MY_XML_NAME u"component_descriptor"
 #define MY_CLASS    ts::ComponentDescriptor
@@ -219,6 +220,30 @@ void ts::ComponentDescriptor::buildXML(DuckContext& duck, xml::Element* root) co
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::ComponentDescriptor::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    beginJSON(output, false, first_node);
+    output.key(u"component_tag");
+    output.integerValue(component_tag);
+    output.key(u"component_type");
+    output.integerValue(component_type);
+    output.key(u"language_code");
+    output.stringValue(language_code);
+    output.key(u"stream_content");
+    output.integerValue(stream_content);
+    output.key(u"stream_content_ext");
+    output.integerValue(stream_content_ext);
+    output.key(u"text");
+    output.stringValue(text);
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 #include "tsDVB.h"
 
 #define MY_XML_NAME u"content_descriptor"
@@ -98,6 +99,30 @@ void ts::ContentDescriptor::buildXML(DuckContext& duck, xml::Element* root) cons
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::ContentDescriptor::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    if (beginJSON(output, !entries.empty(), first_node)) {
+        for (const auto& it : entries) {
+            BeginJSON(output, u"content", false);
+            output.key(u"content_nibble_level_1");
+            output.integerValue(it.content_nibble_level_1);
+            output.key(u"content_nibble_level_2");
+            output.integerValue(it.content_nibble_level_2);
+            output.key(u"user_byte");
+            output.integerValue((it.user_nibble_1 << 4) | it.user_nibble_2);
+            output.endObject();
+        }
+        output.endArray();
+    }
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
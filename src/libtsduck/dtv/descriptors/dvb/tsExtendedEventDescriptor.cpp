@@ -13,6 +13,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 
 #define MY_XML_NAME u"extended_event_descriptor"
 #define MY_CLASS    ts::ExtendedEventDescriptor
@@ -265,6 +266,33 @@ void ts::ExtendedEventDescriptor::buildXML(DuckContext& duck, xml::Element* root
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::ExtendedEventDescriptor::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    beginJSON(output, true, first_node);
+    TextJSON(output, u"text", text);
+    for (const auto& it : entries) {
+        BeginJSON(output, u"item", true);
+        TextJSON(output, u"description", it.item_description);
+        TextJSON(output, u"name", it.item);
+        output.endArray();
+        output.endObject();
+    }
+    output.endArray();
+    output.key(u"descriptor_number");
+    output.integerValue(descriptor_number);
+    output.key(u"language_code");
+    output.stringValue(language_code);
+    output.key(u"last_descriptor_number");
+    output.integerValue(last_descriptor_number);
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 
 #define MY_XML_NAME u"parental_rating_descriptor"
 #define MY_CLASS    ts::ParentalRatingDescriptor
@@ -127,6 +128,28 @@ void ts::ParentalRatingDescriptor::buildXML(DuckContext& duck, xml::Element* roo
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::ParentalRatingDescriptor::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    if (beginJSON(output, !entries.empty(), first_node)) {
+        for (const auto& it : entries) {
+            BeginJSON(output, u"country", false);
+            output.key(u"country_code");
+            output.stringValue(it.country_code);
+            output.key(u"rating");
+            output.integerValue(it.rating);
+            output.endObject();
+        }
+        output.endArray();
+    }
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
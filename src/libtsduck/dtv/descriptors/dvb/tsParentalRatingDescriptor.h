@@ -88,6 +88,7 @@ namespace ts {
         virtual void serializePayload(PSIBuffer&) const override;
         virtual void deserializePayload(PSIBuffer&) override;
         virtual void buildXML(DuckContext&, xml::Element*) const override;
+        virtual bool buildJSON(DuckContext&, json::TextWriter&, const json::TextWriter*) const override;
         virtual bool analyzeXML(DuckContext&, const xml::Element*) override;
     };
 }
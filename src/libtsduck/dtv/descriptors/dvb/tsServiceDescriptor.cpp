@@ -13,6 +13,7 @@
 #include "tsPSIRepository.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 #include "tsDVB.h"
 
 #define MY_XML_NAME u"service_descriptor"
@@ -98,6 +99,24 @@ void ts::ServiceDescriptor::buildXML(DuckContext& duck, xml::Element* root) cons
     root->setAttribute(u"service_name", service_name);
 }
 
+
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::ServiceDescriptor::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    beginJSON(output, false, first_node);
+    output.key(u"service_name");
+    output.stringValue(service_name);
+    output.key(u"service_provider_name");
+    output.stringValue(provider_name);
+    output.key(u"service_type");
+    output.integerValue(service_type);
+    output.endObject();
+    return true;
+}
+
 bool ts::ServiceDescriptor::analyzeXML(DuckContext& duck, const xml::Element* element)
 {
     return element->getIntAttribute(service_type, u"service_type", true) &&
@@ -13,6 +13,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 
 #define MY_XML_NAME u"short_event_descriptor"
 #define MY_CLASS    ts::ShortEventDescriptor
@@ -156,6 +157,23 @@ void ts::ShortEventDescriptor::buildXML(DuckContext& duck, xml::Element* root) c
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::ShortEventDescriptor::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    beginJSON(output, true, first_node);
+    TextJSON(output, u"event_name", event_name);
+    TextJSON(output, u"text", text);
+    output.endArray();
+    output.key(u"language_code");
+    output.stringValue(language_code);
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
@@ -52,6 +52,7 @@ void ts::EITGenerator::reset(PID pid)
     _max_bitrate = 0;
     _ts_bitrate = 0;
     _ref_time.clear();
+    _next_update.clear();
     _ref_time_pkt = 0;
     _eit_inter_pkt = 0;
     _last_eit_pkt = 0;
@@ -220,41 +221,34 @@ bool ts::EITGenerator::deleteEvent(const ServiceIdTriplet& service, uint16_t eve
 {
     bool success = false;  // becomes true when the event is successfully located and removed.
 
-    // Locate the service.
+    // Locate the service and the event in this service.
     const auto isrv = _services.find(service);
-    if (isrv != _services.end() && isrv->second.event_ids.contains(event_id)) {
-        // The event is known in the service.
+    ESegmentList::iterator iseg;
+    EventMap::iterator iev;
+    if (isrv != _services.end() && FindEvent(isrv->second, event_id, iseg, iev)) {
+        // Found the event with same id.
         auto& srv(isrv->second);
+        success = true;
+        _duck.report().log(2, u"delete event id %n, %s, starting %s", event_id, service, iev->second->start_time);
 
-        // Look for the event in this service.
-        for (auto iseg = srv.segments.begin(); !success && iseg != srv.segments.end(); ++iseg) {
-            auto& events((*iseg)->events);
-            for (auto iev = events.begin(); !success && iev != events.end(); ++iev) {
-                if ((*iev)->event_id == event_id) {
-                    // Found the event with same id.
-                    success = true;
-                    _duck.report().log(2, u"delete event id %n, %s, starting %s", event_id, service, (*iev)->start_time);
-
-                    // Remove event from segment and service.
-                    events.erase(iev);
-                    srv.event_ids.erase(event_id);
-
-                    // Mark all EIT schedule in this segment as to be regenerated.
-                    _regenerate = srv.regenerate = (*iseg)->regenerate = true;
-
-                    // Check if that event is in the EIT p/f for the sevice.
-                    for (const auto& sec : srv.pf) {
-                        if (sec != nullptr &&
-                            sec->section != nullptr &&
-                            sec->section->size() >= LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE + EIT::EIT_EVENT_FIXED_SIZE + SECTION_CRC32_SIZE &&
-                            GetUInt16(sec->section->content() + LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE) == event_id)
-                        {
-                            // The event is in an EIT p/f. Regenerate them.
-                            regeneratePresentFollowing(service, srv, getCurrentTime());
-                            break;
-                        }
-                    }
-                }
+        // Remove event from segment and service.
+        (*iseg)->events.erase(iev);
+        srv.event_ids.erase(event_id);
+
+        // Mark all EIT schedule in this segment as to be regenerated.
+        _regenerate = srv.regenerate = (*iseg)->regenerate = true;
+        forceTimeUpdate(srv);
+
+        // Check if that event is in the EIT p/f for the sevice.
+        for (const auto& sec : srv.pf) {
+            if (sec != nullptr &&
+                sec->section != nullptr &&
+                sec->section->size() >= LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE + EIT::EIT_EVENT_FIXED_SIZE + SECTION_CRC32_SIZE &&
+                GetUInt16(sec->section->content() + LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE) == event_id)
+            {
+                // The event is in an EIT p/f. Regenerate them.
+                regeneratePresentFollowing(service, srv, getCurrentTime());
+                break;
             }
         }
     }
@@ -262,6 +256,40 @@ bool ts::EITGenerator::deleteEvent(const ServiceIdTriplet& service, uint16_t eve
 }
 
 
+//----------------------------------------------------------------------------
+// Locate an existing event in a service, using the index of event ids.
+//----------------------------------------------------------------------------
+
+bool ts::EITGenerator::FindEvent(EService& srv, uint16_t event_id, ESegmentList::iterator& seg_iter, EventMap::iterator& ev_iter)
+{
+    // The index gives the start time of the event, hence its segment.
+    const auto id_iter = srv.event_ids.find(event_id);
+    if (id_iter == srv.event_ids.end()) {
+        return false;
+    }
+    const Time start_time(id_iter->second);
+    const Time seg_start_time(EIT::SegmentStartTime(start_time));
+
+    // Locate the segment. There are at most a few tens of segments per service.
+    seg_iter = srv.segments.begin();
+    while (seg_iter != srv.segments.end() && (*seg_iter)->start_time < seg_start_time) {
+        ++seg_iter;
+    }
+    if (seg_iter == srv.segments.end() || (*seg_iter)->start_time != seg_start_time) {
+        return false;
+    }
+
+    // Look for the event among the events with the same start time in the segment.
+    auto& events((*seg_iter)->events);
+    for (ev_iter = events.lower_bound(start_time); ev_iter != events.end() && ev_iter->first == start_time; ++ev_iter) {
+        if (ev_iter->second->event_id == event_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 //----------------------------------------------------------------------------
 // Delete events from binary events descriptions.
 //----------------------------------------------------------------------------
@@ -328,34 +356,20 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
         }
 
         // Check if the same event id already existed in the service.
-        if (srv->event_ids.contains(ev->event_id)) {
-            // Look for existing event in this service with same id. Remove it if not an exact duplicate.
-            bool found = false;
-            bool duplicate = false;
-            for (auto iseg = srv->segments.begin(); !found && iseg != srv->segments.end(); ++iseg) {
-                auto& events((*iseg)->events);
-                for (auto iev = events.begin(); !found && iev != events.end(); ++iev) {
-                    if ((*iev)->event_id == ev->event_id) {
-                        // Found the event with same id.
-                        found = true;
-                        duplicate = (*iev)->event_data == ev->event_data;
-                        // Remove event if not a duplicate.
-                        if (!duplicate) {
-                            _duck.report().log(2, u"discard modified event id %n, %s, previously starting %s", (*iev)->event_id, service_id, (*iev)->start_time);
-                            // Remove event from segment and service.
-                            events.erase(iev);
-                            srv->event_ids.erase(ev->event_id);
-                            // Mark all EIT schedule in this segment as to be regenerated.
-                            _regenerate = srv->regenerate = (*iseg)->regenerate = true;
-                            break;
-                        }
-                    }
-                }
-            }
-            // If the event is an exact duplicate, no need to do anything with that event.
-            if (duplicate) {
+        // Remove the existing event if not an exact duplicate.
+        ESegmentList::iterator iseg;
+        EventMap::iterator iev;
+        if (FindEvent(*srv, ev->event_id, iseg, iev)) {
+            if (iev->second->event_data == ev->event_data) {
+                // The event is an exact duplicate, no need to do anything with that event.
                 continue;
             }
+            _duck.report().log(2, u"discard modified event id %n, %s, previously starting %s", ev->event_id, service_id, iev->second->start_time);
+            // Remove event from segment and service.
+            (*iseg)->events.erase(iev);
+            srv->event_ids.erase(ev->event_id);
+            // Mark all EIT schedule in this segment as to be regenerated.
+            _regenerate = srv->regenerate = (*iseg)->regenerate = true;
         }
 
         // Locate or allocate the segment for that event. At this stage, we only create this
@@ -375,14 +389,10 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
         }
         ESegment& seg(**seg_iter);
 
-        // Insert the binary event in the list of events for that segment.
-        auto ev_iter = seg.events.begin();
-        while (ev_iter != seg.events.end() && (*ev_iter)->start_time < ev->start_time) {
-            ++ev_iter;
-        }
+        // Insert the binary event in the events of that segment, before other events with the same start time.
         _duck.report().log(2, u"load event id %n, %s, starting %s", ev->event_id, service_id, ev->start_time);
-        seg.events.insert(ev_iter, ev);
-        srv->event_ids.insert(ev->event_id);
+        seg.events.emplace_hint(seg.events.lower_bound(ev->start_time), ev->start_time, ev);
+        srv->event_ids[ev->event_id] = ev->start_time;
         ev_count++;
 
         // Mark all EIT schedule in this segment as to be regenerated.
@@ -392,6 +402,7 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
     // If some events were added, it may be necessary to regenerate the EIT p/f in this service.
     if (ev_count > 0) {
         assert(srv != nullptr);
+        forceTimeUpdate(*srv);
         regeneratePresentFollowing(service_id, *srv, now);
     }
     return success;
@@ -467,7 +478,7 @@ void ts::EITGenerator::saveEITs(SectionPtrVector& sections)
             // Get first event of first non-empty segment in the service.
             for (const auto& it2 : it1.second.segments) {
                 if (!it2->events.empty()) {
-                    const Time& start_time(it2->events.front()->start_time);
+                    const Time& start_time(it2->events.begin()->first);
                     if (_ref_time == Time::Epoch || start_time < _ref_time) {
                         _ref_time = start_time;
                         _ref_time_pkt = _packet_index;
@@ -532,6 +543,7 @@ void ts::EITGenerator::setTransportStreamId(uint16_t new_ts_id)
 
     // No longer need the PAT when the TS id is known.
     _demux.removePID(PID_PAT);
+    forceTimeUpdate();
 
     // Current time according to the transport stream. Can be "Epoch" (undefined).
     const Time now(getCurrentTime());
@@ -618,6 +630,7 @@ void ts::EITGenerator::setOptions(EITOptions options)
     // Update the options.
     const EITOptions old_options = _options;
     _options = options;
+    forceTimeUpdate();
 
     // If the new options request to load events from input EIT's, demux the EIT PID.
     if (bool(options & EITOptions::LOAD_INPUT)) {
@@ -728,6 +741,11 @@ ts::Time ts::EITGenerator::getCurrentTime()
 
 void ts::EITGenerator::setCurrentTime(const Time& current_utc)
 {
+    // All services must be checked again if the time moves backward.
+    if (current_utc < getCurrentTime()) {
+        forceTimeUpdate();
+    }
+
     // Store the current time.
     _ref_time = current_utc;
     _ref_time_pkt = _packet_index;
@@ -846,7 +864,7 @@ void ts::EITGenerator::regeneratePresentFollowing(const ServiceIdTriplet& servic
         for (auto seg_iter = srv.segments.begin(); next_event < events.size() && seg_iter != srv.segments.end(); ++seg_iter) {
             const ESegment& seg(**seg_iter);
             for (auto ev_iter = seg.events.begin(); next_event < events.size() && ev_iter != seg.events.end(); ++ev_iter) {
-                events[next_event++] = *ev_iter;
+                events[next_event++] = ev_iter->second;
             }
         }
 
@@ -972,6 +990,10 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
 
             // Remove initial segments before last midnight.
             while (!srv.segments.empty() && srv.segments.front()->start_time < last_midnight) {
+                // Events in progress may be removed, the EIT p/f must be checked again.
+                if (!srv.segments.front()->events.empty()) {
+                    forceTimeUpdate(srv);
+                }
                 markObsoleteSegment(*srv.segments.front());
                 srv.segments.pop_front();
             }
@@ -980,7 +1002,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
             while (!srv.segments.empty() && srv.segments.back()->events.empty() && srv.segments.back()->start_time > last_midnight) {
                 // Remove all event ids of this segment from the service.
                 for (const auto& ev : srv.segments.back()->events) {
-                    srv.event_ids.erase(ev->event_id);
+                    srv.event_ids.erase(ev.second->event_id);
                 }
                 // Remove segment from service
                 markObsoleteSegment(*srv.segments.back());
@@ -1035,8 +1057,8 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         size_t pl_size = section_still_valid ? (*sec_iter)->section->payloadSize() - EIT::EIT_PAYLOAD_FIXED_SIZE : 0;
 
                         while (section_still_valid && pl_size > 0 && ev_iter != seg.events.end()) {
-                            const uint8_t* ev = (*ev_iter)->event_data.data();
-                            const size_t ev_size = (*ev_iter)->event_data.size();
+                            const uint8_t* ev = ev_iter->second->event_data.data();
+                            const size_t ev_size = ev_iter->second->event_data.size();
                             section_still_valid = pl_size >= ev_size && MemEqual(pl, ev, ev_size);
                             if (section_still_valid) {
                                 ++ev_iter;
@@ -1047,7 +1069,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         if (section_still_valid) {
                             // If the next event exists and could fit in the section, then the section is no longer valid.
                             section_still_valid = ev_iter == seg.events.end() ||
-                                (*sec_iter)->section->payloadSize() + (*ev_iter)->event_data.size() > MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE;
+                                (*sec_iter)->section->payloadSize() + ev_iter->second->event_data.size() > MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE;
                         }
 
                         // If the current section is still valid, skip those events and move to next section.
@@ -1078,9 +1100,9 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         ev_iter = saved_ev_iter;
 
                         // Insert events in the section, as long as they fit.
-                        while (ev_iter != seg.events.end() && sec->section->payloadSize() + (*ev_iter)->event_data.size() <= MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE) {
+                        while (ev_iter != seg.events.end() && sec->section->payloadSize() + ev_iter->second->event_data.size() <= MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE) {
                             // Append the event to the section payload.
-                            sec->section->appendPayload((*ev_iter)->event_data, false);
+                            sec->section->appendPayload(ev_iter->second->event_data, false);
                             ++ev_iter;
                         }
 
@@ -1224,8 +1246,15 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         return;
     }
 
+    // Nothing can change in any service before the next computed update time.
+    if (now < _next_update) {
+        return;
+    }
+
     // Reference time for EIT schedule.
     const Time last_midnight(now.thisDay());
+    const Time next_midnight(last_midnight + cn::days(1));
+    _next_update = Time::Apocalypse;
 
     // Loop on all services.
     for (auto& srv_iter : _services) {
@@ -1234,6 +1263,12 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         EService& srv(srv_iter.second);
         assert(!srv.segments.empty());
 
+        // Skip services which do not need an update yet.
+        if (now < srv.next_update) {
+            _next_update = std::min(_next_update, srv.next_update);
+            continue;
+        }
+
         // If we changed day, mark the service as being regenerated (will remove obsolete segments or create missing ones).
         if (last_midnight != srv.segments.front()->start_time) {
             _regenerate = srv.regenerate = true;
@@ -1243,11 +1278,11 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         // Segments before current one will now have one empty section, except if events are still in progress.
         for (auto seg_iter = srv.segments.begin(); seg_iter != srv.segments.end() && (*seg_iter)->start_time <= now; ++seg_iter) {
             ESegment& seg(**seg_iter);
-            while (!seg.events.empty() && seg.events.front()->end_time <= now) {
+            while (!seg.events.empty() && seg.events.begin()->second->end_time <= now) {
                 // Remove event id from service.
-                srv.event_ids.erase(seg.events.front()->event_id);
+                srv.event_ids.erase(seg.events.begin()->second->event_id);
                 // Remove event from segment.
-                seg.events.pop_front();
+                seg.events.erase(seg.events.begin());
                 // Regenerate the segment, unless this is the current segment and we use the lazy update mode.
                 if (seg.start_time < now || !(_options & EITOptions::LAZY_SCHED_UPDATE)) {
                     _regenerate = srv.regenerate = seg.regenerate = true;
@@ -1259,7 +1294,7 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         while (!srv.segments.empty() && srv.segments.back()->start_time >= last_midnight + EIT::TOTAL_DAYS) {
             // Remove all event ids of this segment from the service.
             for (const auto& ev : srv.segments.back()->events) {
-                srv.event_ids.erase(ev->event_id);
+                srv.event_ids.erase(ev.second->event_id);
             }
             // Remove segment from service
             srv.segments.pop_back();
@@ -1267,7 +1302,42 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
 
         // Renew EIT p/f of the service when necessary.
         regeneratePresentFollowing(service_id, srv, now);
+
+        // Compute the next time when the service shall be updated: next midnight, end of the first event
+        // in any segment (only first events are removed above), start of the first event of the service
+        // (becomes the "present" one in EIT p/f).
+        srv.next_update = next_midnight;
+        bool first_event = true;
+        for (const auto& seg : srv.segments) {
+            if (!seg->events.empty()) {
+                const Event& ev(*seg->events.begin()->second);
+                if (first_event && now < ev.start_time) {
+                    srv.next_update = std::min(srv.next_update, ev.start_time);
+                }
+                first_event = false;
+                srv.next_update = std::min(srv.next_update, ev.end_time);
+            }
+        }
+        _next_update = std::min(_next_update, srv.next_update);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Force the update of services at the next call to updateForNewTime().
+//----------------------------------------------------------------------------
+
+void ts::EITGenerator::forceTimeUpdate(EService& srv)
+{
+    srv.next_update = _next_update = Time::Epoch;
+}
+
+void ts::EITGenerator::forceTimeUpdate()
+{
+    for (auto& srv_iter : _services) {
+        srv_iter.second.next_update = Time::Epoch;
     }
+    _next_update = Time::Epoch;
 }
 
 
@@ -1461,7 +1531,7 @@ void ts::EITGenerator::dumpInternalState(int lev) const
                 rep.log(lev, u"  - Segment %s, regenerate: %s, events: %d, sections: %d", seg.start_time, seg.regenerate, seg.events.size(), seg.sections.size());
                 rep.log(lev, u"    Events:");
                 for (const auto& it3 : it2->events) {
-                    const Event& ev(*it3);
+                    const Event& ev(*it3.second);
                     rep.log(lev, u"    - Event id: 0x%X, start: %s, end: %s, %d bytes", ev.event_id, ev.start_time, ev.end_time, ev.event_data.size());
                 }
                 rep.log(lev, u"    Sections:");
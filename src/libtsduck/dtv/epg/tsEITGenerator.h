@@ -418,7 +418,7 @@ namespace ts {
         };
 
         using EventPtr = std::shared_ptr<Event>;
-        using EventList = std::list<EventPtr>;
+        using EventMap = std::multimap<Time, EventPtr>;  // events, indexed by start time
 
         // -----------------------------
         // Description of an EIT section
@@ -462,7 +462,7 @@ namespace ts {
             const Time   start_time;         // Segment start time (a multiple of 3 hours). Never change.
             bool         regenerate = true;  // Regenerate all EIT schedule sections in the segment.
                                              // Initially true since all segments must have at least one section.
-            EventList    events {};          // List of events in the segment, sorted by start time.
+            EventMap     events {};          // Events in the segment, indexed and sorted by start time.
             ESectionList sections {};        // Current list of sections in the segment, sorted by start time.
 
             // Constructor.
@@ -480,10 +480,11 @@ namespace ts {
         {
             TS_NOCOPY(EService);
         public:
-            bool               regenerate = false;  // Some segments must be regenerated in the service.
-            ESectionPair       pf {};               // EIT p/f sections (0: present, 1: following).
-            ESegmentList       segments {};         // List of 3-hour segments (EPG events and EIT schedule sections).
-            std::set<uint16_t> event_ids {};        // Existing event ids in that service, used as fast lookup of event presence.
+            bool                    regenerate = false;  // Some segments must be regenerated in the service.
+            Time                    next_update {};      // Next time when the service must be updated by updateForNewTime().
+            ESectionPair            pf {};               // EIT p/f sections (0: present, 1: following).
+            ESegmentList            segments {};         // List of 3-hour segments (EPG events and EIT schedule sections).
+            std::map<uint16_t,Time> event_ids {};        // Existing event ids in that service -> start time, used to locate events.
 
             // Constructor.
             EService() = default;
@@ -521,6 +522,7 @@ namespace ts {
         BitRate              _max_bitrate = 0;           // Max EIT bitrate.
         BitRate              _ts_bitrate = 0;            // Declared TS bitrate.
         Time                 _ref_time {};               // Last reference time.
+        Time                 _next_update {};            // Next time when some service must be updated by updateForNewTime().
         PacketCounter        _ref_time_pkt = 0;          // Packet index at last reference time.
         PacketCounter        _eit_inter_pkt = 0;         // Inter-packet distance in the EIT PID (zero if unbound).
         PacketCounter        _last_eit_pkt = 0;          // Packet index at last EIT insertion.
@@ -545,8 +547,16 @@ namespace ts {
         // Update the EIT database according to the current time.
         // Obsolete events, sections and segments are discarded.
         // Segments which must be regenerated are marked as such (will be actually regenerated later, when used).
+        // Services are updated only when the time reaches their next_update field.
         void updateForNewTime(const Time& now);
 
+        // Force the update of one service or all services at the next call to updateForNewTime().
+        void forceTimeUpdate(EService& srv);
+        void forceTimeUpdate();
+
+        // Locate an existing event in a service, using the index of event ids. Return false if not found.
+        static bool FindEvent(EService& srv, uint16_t event_id, ESegmentList::iterator& seg_iter, EventMap::iterator& ev_iter);
+
         // Regenerate, if necessary, EIT p/f in a service. Return true if section is modified.
         void regeneratePresentFollowing(const ServiceIdTriplet& service_id, EService& srv, const Time& now);
         bool regeneratePresentFollowingSection(const ServiceIdTriplet& service_id, ESectionPtr& sec, TID tid, uint8_t section_number, const EventPtr& event, const Time&inject_time);
@@ -43,7 +43,11 @@ ts::PESDemux::~PESDemux()
 void ts::PESDemux::immediateReset()
 {
     SuperClass::immediateReset();
+    for (auto& it : _pids) {
+        releaseBuffer(it.second.ts);
+    }
     _pids.clear();
+    _pid_index.fill(nullptr);
     _pid_types.clear();
 
     // Reset the section demux back to initial state (intercepting the PAT).
@@ -54,11 +58,61 @@ void ts::PESDemux::immediateReset()
 void ts::PESDemux::immediateResetPID(PID pid)
 {
     SuperClass::immediateResetPID(pid);
-    _pids.erase(pid);
+    releaseContext(pid);
     _pid_types.erase(pid);
 }
 
 
+//----------------------------------------------------------------------------
+// Create or release the context of a PID.
+//----------------------------------------------------------------------------
+
+ts::PESDemux::PIDContext& ts::PESDemux::createContext(PID pid)
+{
+    if (_pid_index[pid] == nullptr) {
+        _pid_index[pid] = &_pids.try_emplace(pid, allocateBuffer()).first->second;
+    }
+    return *_pid_index[pid];
+}
+
+void ts::PESDemux::releaseContext(PID pid)
+{
+    const auto it = _pids.find(pid);
+    if (it != _pids.end()) {
+        releaseBuffer(it->second.ts);
+        _pids.erase(it);
+    }
+    _pid_index[pid] = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Pool of PES buffers.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockPtr ts::PESDemux::allocateBuffer()
+{
+    if (_free_buffers.empty()) {
+        return std::make_shared<ByteBlock>();
+    }
+    else {
+        ByteBlockPtr buffer(std::move(_free_buffers.back()));
+        _free_buffers.pop_back();
+        return buffer;
+    }
+}
+
+void ts::PESDemux::releaseBuffer(ByteBlockPtr& buffer)
+{
+    // The buffer is reused with its allocated memory, unless some PES packet still references it.
+    if (buffer != nullptr && buffer.use_count() == 1 && _free_buffers.size() < MAX_FREE_BUFFERS) {
+        buffer->clear();
+        _free_buffers.push_back(std::move(buffer));
+    }
+    buffer.reset();
+}
+
+
 //----------------------------------------------------------------------------
 // Set/get the default audio or video codec for one specific PES PID's.
 //----------------------------------------------------------------------------
@@ -168,30 +222,28 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
     }
 
     // Get PID and check if context exists
-    PID pid = pkt.getPID();
-    auto pci = _pids.find(pid);
-    bool pc_exists = pci != _pids.end();
+    const PID pid = pkt.getPID();
+    PIDContext* pci = _pid_index[pid];
 
     // If no context established and not at a unit start, ignore packet
-    if (!pc_exists && !pkt.getPUSI()) {
+    if (pci == nullptr && !pkt.getPUSI()) {
         return;
     }
 
     // If at a unit start and the context exists, process previous PES packet in context
-    if (pc_exists && pkt.getPUSI() && pci->second.sync && pci->second.ts != nullptr && !pci->second.ts->empty()) {
+    if (pci != nullptr && pkt.getPUSI() && pci->sync && pci->ts != nullptr && !pci->ts->empty()) {
         // Process packet, invoke all handlers
-        processPESPacket(pid, pci->second);
+        processPESPacket(pid, *pci);
         // Recheck PID context in case it was reset by a handler
-        pci = _pids.find(pid);
-        pc_exists = pci != _pids.end();
+        pci = _pid_index[pid];
     }
 
     // If the packet is scrambled, we cannot get PES content.
     // Usually, if the PID becomes scrambled, it will remain scrambled
     // for a while => release context.
     if (pkt.getScrambling() != SC_CLEAR) {
-        if (pc_exists) {
-            _pids.erase(pid);
+        if (pci != nullptr) {
+            releaseContext(pid);
         }
         return;
     }
@@ -206,7 +258,7 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
         // (it is not possible to have 00 00 01 in a PUSI packet containing sections).
         if (pl_size >= 3 && pl[0] == 0 && pl[1] == 0 && pl[2] == 1) {
             // We are at the beginning of a PES packet. Create context if non existent.
-            PIDContext& pc(_pids[pid]);
+            PIDContext& pc(createContext(pid));
             pc.continuity = pkt.getCC();
             pc.sync = true;
             pc.ts->copy(pl, pl_size);
@@ -217,9 +269,9 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
             // Check if the complete PES packet is now present (without waiting for the next PUSI).
             processPESPacketIfComplete(pid, pc);
         }
-        else if (pc_exists) {
+        else if (pci != nullptr) {
             // This PID does not contain PES packet, reset context
-            _pids.erase(pid);
+            releaseContext(pid);
         }
         // PUSI packet processing done.
         return;
@@ -227,10 +279,10 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
 
     // At this point, the TS packet contains part of a PES packet, but not beginning.
     // Check that PID context is valid.
-    if (!pc_exists || !pci->second.sync) {
+    if (pci == nullptr || !pci->sync) {
         return;
     }
-    PIDContext& pc(pci->second);
+    PIDContext& pc(*pci);
 
     // Ignore duplicate packets (same CC)
     if (pkt.getCC() == pc.continuity) {
@@ -417,10 +469,16 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
         afterCallingHandler(false);
         throw;
     }
-    afterCallingHandler(true);
+
+    // If a handler kept a reference to the PES content, continue on another buffer.
+    if (pc.ts.use_count() > 1) {
+        pc.ts = allocateBuffer();
+    }
 
     // Consider that we lose sync in case there are additional TS packets on that PID before next PUSI.
+    // Must be done before executing the delayed operations, which may destroy the PID context.
     pc.syncLost();
+    afterCallingHandler(true);
 }
 
 
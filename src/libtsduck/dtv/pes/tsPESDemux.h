@@ -27,6 +27,12 @@ namespace ts {
     //! This class extracts PES packets from TS packets.
     //! @ingroup libtsduck mpeg
     //!
+    //! The PES packets which are passed to the handlers are read-only views over the internal
+    //! reassembly buffer of the PID, the PES data are not copied. A handler may keep a shared
+    //! reference to the PES content (using ShareMode::SHARE). In that case, the demux continues
+    //! on another buffer and never modifies the retained content. Otherwise, the buffer and its
+    //! allocated memory are reused for the next PES packets, on the same PID or on another one.
+    //!
     class TSDUCKDLL PESDemux: public TimeTrackerDemux, private TableHandlerInterface
     {
         TS_NOBUILD_NOCOPY(PESDemux);
@@ -187,8 +193,8 @@ namespace ts {
             AC3Attributes        ac3 {};         // Current AC-3 attributes
             PacketCounter        ac3_count = 0;   // Number of PES packets with contents which looks like AC-3
 
-            // Default constructor:
-            PIDContext() : ts(new ByteBlock()) {}
+            // Constructor, using a buffer from the pool.
+            explicit PIDContext(const ByteBlockPtr& buffer) : ts(buffer) {}
 
             // Called when packet synchronization is lost on the PID.
             void syncLost() { sync = false; ts->clear(); }
@@ -212,9 +218,20 @@ namespace ts {
         // All known PID's are referenced here, not only demuxed PES PID's.
         using PIDTypeMap = std::map<PID,PIDType>;
 
+        // Maximum number of free PES buffers to keep for reuse.
+        static constexpr size_t MAX_FREE_BUFFERS = 8;
+
         // Feed the demux with a TS packet (PID already filtered).
         void processPacket(const TSPacket&);
 
+        // Create or release the context of a PID.
+        PIDContext& createContext(PID);
+        void releaseContext(PID);
+
+        // Get a PES buffer from the pool, return a buffer into the pool.
+        ByteBlockPtr allocateBuffer();
+        void releaseBuffer(ByteBlockPtr&);
+
         // If a PID context contains a complete PES packet with specified length, process it.
         void processPESPacketIfComplete(PID, PIDContext&);
 
@@ -231,6 +248,8 @@ namespace ts {
         PESHandlerInterface* _pes_handler = nullptr;
         CodecType            _default_codec {CodecType::UNDEFINED};
         PIDContextMap        _pids {};
+        std::array<PIDContext*, PID_MAX> _pid_index {};  // Direct access to PID contexts, owned by _pids
+        std::vector<ByteBlockPtr> _free_buffers {};      // Pool of free PES buffers
         PIDTypeMap           _pid_types {};
         SectionDemux         _section_demux;
     };
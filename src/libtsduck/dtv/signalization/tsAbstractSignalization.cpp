@@ -9,6 +9,8 @@
 #include "tsAbstractSignalization.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsxmlJSONConverter.h"
+#include "tsjsonTextWriter.h"
 
 
 //----------------------------------------------------------------------------
@@ -113,6 +115,51 @@ void ts::AbstractSignalization::fromXML(DuckContext& duck, const xml::Element* e
 }
 
 
+//----------------------------------------------------------------------------
+// Direct JSON serialization (default implementation: not supported).
+//----------------------------------------------------------------------------
+
+bool ts::AbstractSignalization::toJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    return _is_valid && buildJSON(duck, output, first_node);
+}
+
+bool ts::AbstractSignalization::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    return false;
+}
+
+bool ts::AbstractSignalization::beginJSON(json::TextWriter& output, bool has_children, const json::TextWriter* first_node) const
+{
+    return BeginJSON(output, _xml_name, has_children, first_node);
+}
+
+bool ts::AbstractSignalization::BeginJSON(json::TextWriter& output, const UChar* name, bool has_children, const json::TextWriter* first_node)
+{
+    // The JSON object is sorted by field names: "#name" and "#nodes" come before all attributes.
+    output.beginObject();
+    output.key(xml::JSONConverter::HashName);
+    output.stringValue(name);
+    if (has_children || first_node != nullptr) {
+        output.key(xml::JSONConverter::HashNodes);
+        output.beginArray();
+        if (first_node != nullptr) {
+            output.value(*first_node);
+        }
+        return true;
+    }
+    return false;
+}
+
+void ts::AbstractSignalization::TextJSON(json::TextWriter& output, const UChar* name, const UString& text)
+{
+    BeginJSON(output, name, true);
+    output.stringValue(text);
+    output.endArray();
+    output.endObject();
+}
+
+
 //----------------------------------------------------------------------------
 // Check that an XML element has the right name for this table.
 //----------------------------------------------------------------------------
@@ -21,6 +21,9 @@ namespace ts {
     class DuckContext;
     class ByteBlock;
     class TablesDisplay;
+    namespace json {
+        class TextWriter;
+    }
 
     //!
     //! Abstract base class for MPEG PSI/SI tables and descriptors.
@@ -92,6 +95,23 @@ namespace ts {
         //!
         virtual void fromXML(DuckContext& duck, const xml::Element* element);
 
+        //!
+        //! This method converts this object to one-line JSON text, without intermediate XML document.
+        //!
+        //! The JSON text is identical to the conversion of the XML structure from toXML(), using
+        //! the XML model of the tables and the default XML-to-JSON conversion options. This is an
+        //! optional fast path for a few frequent tables and descriptors, see buildJSON().
+        //!
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] output Where to write the JSON text.
+        //! @param [in] first_node If not null, a complete JSON object to insert first in the "#nodes"
+        //! array, typically the metadata of a table.
+        //! @return True on success. False when this object is invalid or when this object or one of
+        //! its descriptors cannot be directly converted to JSON. In that case, @a output may contain
+        //! an incomplete JSON text which shall be discarded.
+        //!
+        bool toJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node = nullptr) const;
+
         // Implementation of AbstractDefinedByStandards
         virtual Standards definingStandards() const override;
 
@@ -222,6 +242,52 @@ namespace ts {
         //!
         virtual bool analyzeXML(DuckContext& duck, const xml::Element* element) = 0;
 
+        //!
+        //! Helper method to convert this object to one-line JSON text, without XML document.
+        //!
+        //! It is called by toJSON() only when the object is valid. The default implementation
+        //! returns false, meaning that the object shall be converted to XML first. A subclass
+        //! which overrides this method shall write one complete JSON object, with the same fields
+        //! as the XML-to-JSON conversion of the element from buildXML(): "#name", "#nodes" when
+        //! the element has children, and then all attributes in lower case, sorted by name, typed
+        //! according to the XML model. Use beginJSON() to write the first fields.
+        //!
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] output Where to write the JSON text.
+        //! @param [in] first_node If not null, a complete JSON object to insert first in the "#nodes" array.
+        //! @return True on success, false if the object cannot be directly converted to JSON.
+        //!
+        virtual bool buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const;
+
+        //!
+        //! Start the JSON object of this table or descriptor in buildJSON().
+        //! @param [in,out] output Where to write the JSON text.
+        //! @param [in] has_children True if the XML element has children.
+        //! @param [in] first_node If not null, a complete JSON object to insert first in the "#nodes" array.
+        //! @return True if the "#nodes" array was started. In that case, the caller shall write
+        //! the JSON objects of the children and then call @a output.endArray().
+        //!
+        bool beginJSON(json::TextWriter& output, bool has_children, const json::TextWriter* first_node) const;
+
+        //!
+        //! Start the JSON object of a child XML element in buildJSON().
+        //! @param [in,out] output Where to write the JSON text.
+        //! @param [in] name Name of the XML element.
+        //! @param [in] has_children True if the XML element has children.
+        //! @param [in] first_node If not null, a complete JSON object to insert first in the "#nodes" array.
+        //! @return True if the "#nodes" array was started. In that case, the caller shall write
+        //! the JSON objects of the children and then call @a output.endArray().
+        //!
+        static bool BeginJSON(json::TextWriter& output, const UChar* name, bool has_children, const json::TextWriter* first_node = nullptr);
+
+        //!
+        //! Write the JSON object of a child XML element containing only a text node in buildJSON().
+        //! @param [in,out] output Where to write the JSON text.
+        //! @param [in] name Name of the XML element.
+        //! @param [in] text Content of the text node.
+        //!
+        static void TextJSON(json::TextWriter& output, const UChar* name, const UString& text);
+
     private:
         bool               _is_valid = true;  // This object is valid.
         const UChar* const _xml_name;         // XML table or descriptor name.
@@ -12,6 +12,8 @@
 #include "tsDuckContext.h"
 #include "tsSection.h"
 #include "tsxmlElement.h"
+#include "tsxmlJSONConverter.h"
+#include "tsjsonTextWriter.h"
 
 
 //----------------------------------------------------------------------------
@@ -555,6 +557,56 @@ ts::xml::Element* ts::BinaryTable::toXML(DuckContext& duck, xml::Element* parent
 }
 
 
+//----------------------------------------------------------------------------
+// This method converts the table to one-line JSON text, without XML.
+//----------------------------------------------------------------------------
+
+bool ts::BinaryTable::toJSON(DuckContext& duck, json::TextWriter& output, const XMLOptions& opt) const
+{
+    // Filter invalid tables and options which are not supported in the direct conversion.
+    if (!_is_valid || _sections.size() == 0 || _sections[0] == nullptr || opt.forceGeneric || opt.setSections) {
+        return false;
+    }
+
+    // Deserialize the table. There is no direct conversion for generic tables.
+    const PSIRepository::TableFactory fac = PSIRepository::Instance().getTable(_tid, SectionContext(_source_pid, duck.standards())).factory;
+    const AbstractTablePtr tp(fac == nullptr ? nullptr : fac());
+    if (tp == nullptr) {
+        return false;
+    }
+    tp->deserialize(duck, *this);
+    if (!tp->isValid() || !tp->attribute().empty()) {
+        return false;
+    }
+
+    // Same <metadata> element as in toXML(), as first child of the table.
+    const bool set_pid = opt.setPID && _source_pid != PID_NULL;
+    if (!set_pid && !opt.setLocalTime && !opt.setPackets) {
+        return tp->toJSON(duck, output);
+    }
+    json::TextWriter meta;
+    meta.beginObject();
+    meta.key(xml::JSONConverter::HashName);
+    meta.stringValue(u"metadata");
+    if (opt.setPackets) {
+        meta.key(u"first_ts_packet");
+        meta.integerValue(int64_t(firstTSPacketIndex()));
+        meta.key(u"last_ts_packet");
+        meta.integerValue(int64_t(lastTSPacketIndex()));
+    }
+    if (set_pid) {
+        meta.key(u"pid");
+        meta.integerValue(_source_pid);
+    }
+    if (opt.setLocalTime) {
+        meta.key(u"time");
+        meta.stringValue(xml::Attribute::DateTimeToString(Time::CurrentLocalTime()));
+    }
+    meta.endObject();
+    return tp->toJSON(duck, output, &meta);
+}
+
+
 
 
 //----------------------------------------------------------------------------
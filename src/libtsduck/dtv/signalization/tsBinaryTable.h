@@ -20,6 +20,9 @@
 namespace ts {
 
     class DuckContext;
+    namespace json {
+        class TextWriter;
+    }
 
     //!
     //! Representation of MPEG PSI/SI tables in binary form (ie. list of sections).
@@ -330,6 +333,20 @@ namespace ts {
         //!
         xml::Element* toXML(DuckContext& duck, xml::Element* parent, const XMLOptions& opt = XMLOptions()) const;
 
+        //!
+        //! This method converts the table to one-line JSON text, without intermediate XML document.
+        //! The JSON text is identical to the conversion of the XML element from toXML(), using the
+        //! XML model of the tables and the default XML-to-JSON conversion options. This is possible
+        //! only when the table class and all its descriptors implement a direct JSON conversion.
+        //! @param [in,out] duck TSDuck execution environment.
+        //! @param [in,out] output Where to write the JSON text.
+        //! @param [in] opt Conversion options. Hexadecimal dumps of sections are not supported.
+        //! @return True on success. False when the table cannot be directly converted to JSON.
+        //! In that case, @a output may contain an incomplete JSON text which shall be discarded
+        //! and the table shall be converted using toXML().
+        //!
+        bool toJSON(DuckContext& duck, json::TextWriter& output, const XMLOptions& opt = XMLOptions()) const;
+
         //!
         //! This method converts an XML node as a binary table.
         //! @param [in,out] duck TSDuck execution environment.
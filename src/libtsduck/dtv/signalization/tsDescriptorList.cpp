@@ -863,6 +863,27 @@ bool ts::DescriptorList::toXML(DuckContext& duck, xml::Element* parent) const
 }
 
 
+//----------------------------------------------------------------------------
+// This method converts a descriptor list to one-line JSON text, without XML.
+//----------------------------------------------------------------------------
+
+bool ts::DescriptorList::toJSON(DuckContext& duck, json::TextWriter& output) const
+{
+    for (size_t index = 0; index < _list.size(); ++index) {
+        if (_list[index] == nullptr || !_list[index]->isValid()) {
+            return false;
+        }
+        // Same typed descriptor as in Descriptor::toXML(). There is no direct conversion for generic descriptors.
+        DescriptorContext context(duck, *this, index);
+        const AbstractDescriptorPtr dp(_list[index]->deserialize(duck, context));
+        if (dp == nullptr || !dp->toJSON(duck, output)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // These methods decode an XML list of descriptors.
 //----------------------------------------------------------------------------
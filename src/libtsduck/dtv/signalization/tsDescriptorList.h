@@ -21,6 +21,9 @@ namespace ts {
     class AbstractTable;
     class AbstractDescriptor;
     class DuckContext;
+    namespace json {
+        class TextWriter;
+    }
 
     //!
     //! List of MPEG PSI/SI descriptors.
@@ -410,6 +413,17 @@ namespace ts {
         //!
         bool toXML(DuckContext& duck, xml::Element* parent) const;
 
+        //!
+        //! This method converts a descriptor list to one-line JSON text, without intermediate XML document.
+        //! The JSON objects of the descriptors are written in the current JSON array.
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] output Where to write the JSON text.
+        //! @return True on success, false if one descriptor cannot be directly converted to JSON.
+        //! In that case, @a output may contain an incomplete JSON text which shall be discarded.
+        //! @see AbstractSignalization::toJSON()
+        //!
+        bool toJSON(DuckContext& duck, json::TextWriter& output) const;
+
         //!
         //! This method decodes an XML list of descriptors.
         //! @param [in,out] duck TSDuck execution context.
@@ -48,6 +48,18 @@ void ts::LogicalChannelNumbers::addLCN(uint16_t lcn, uint16_t srv_id, uint16_t t
 }
 
 
+//----------------------------------------------------------------------------
+// Add all logical channel numbers from another store.
+//----------------------------------------------------------------------------
+
+void ts::LogicalChannelNumbers::addLCNs(const LogicalChannelNumbers& other)
+{
+    for (const auto& it : other._lcn_map) {
+        addLCN(it.second.lcn, it.first, it.second.ts_id, it.second.onet_id, it.second.visible);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Collect all LCN which are declared in a list of descriptors.
 //----------------------------------------------------------------------------
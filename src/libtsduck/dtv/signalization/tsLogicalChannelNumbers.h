@@ -66,6 +66,13 @@ namespace ts {
         //!
         void addLCN(uint16_t lcn, uint16_t srv_id, uint16_t ts_id, uint16_t onet_id, bool visible = true);
 
+        //!
+        //! Add all logical channel numbers from another store.
+        //! Existing entries for the same services are updated.
+        //! @param [in] other Another store of LCN values.
+        //!
+        void addLCNs(const LogicalChannelNumbers& other);
+
         //!
         //! Collect all LCN which are declared in a NIT.
         //! @param [in] nit The NIT to analyze.
@@ -536,12 +536,10 @@ void ts::PSILogger::displayTable(const BinaryTable& table)
 
             // Log the JSON line.
             if (_log_json_line) {
-                // Convert the XML document into JSON.
-                // Force "tsduck" root to appear so that the path to the first table is always the same.
-                const json::ValuePtr root(_x2j_conv.convertToJSON(doc, true));
-
-                // Query the first (and only) converted table and log it as one line.
-                _report.info(_log_json_prefix + root->query(u"#nodes[0]").oneLiner(_report));
+                // Directly serialize the table as one line, without intermediate JSON values.
+                _json_line.clear();
+                _x2j_conv.convertToJSON(elem, _json_line);
+                _report.info(_log_json_prefix + _json_line.toString());
             }
         }
     }
@@ -146,6 +146,7 @@ namespace ts {
         xml::RunningDocument     _xml_doc {_report};         // XML document, built on-the-fly.
         xml::JSONConverter       _x2j_conv {_report};        // XML-to-JSON converter.
         json::RunningDocument    _json_doc {_report};        // JSON document, built on-the-fly.
+        json::TextWriter         _json_line {};              // JSON one-liner, buffer reused for each table.
         bool                     _abort = false;
         bool                     _pat_ok = false;            // Got a PAT
         bool                     _cat_ok = false;            // Got a CAT or not interested in CAT
@@ -11,6 +11,7 @@
 #include "tsDuckContext.h"
 #include "tsCRC32.h"
 #include "tsSHA1.h"
+#include "tsFingerprintCache.h"
 #include "tsMemory.h"
 #include "tsFatal.h"
 
@@ -348,6 +349,11 @@ ts::ByteBlock ts::Section::hash() const
     return result;
 }
 
+uint64_t ts::Section::fingerprint() const
+{
+    return isValid() ? FingerprintCache::Fingerprint(content(), size()) : 0;
+}
+
 
 //----------------------------------------------------------------------------
 // Implementation of AbstractDefinedByStandards.
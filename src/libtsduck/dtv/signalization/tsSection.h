@@ -385,6 +385,13 @@ namespace ts {
         //!
         ByteBlock hash() const;
 
+        //!
+        //! Get a 64-bit fingerprint of the section content.
+        //! This is a fast non-cryptographic hash, see FingerprintCache::Fingerprint().
+        //! @return 64-bit fingerprint of the section content or zero if the section is invalid.
+        //!
+        uint64_t fingerprint() const;
+
         //!
         //! Minimum number of TS packets required to transport the section.
         //! @return The minimum number of TS packets required to transport the section.
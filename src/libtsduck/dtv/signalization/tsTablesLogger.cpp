@@ -16,6 +16,7 @@
 #include "tsSimulCryptDate.h"
 #include "tsjsonArray.h"
 #include "tsjsonObject.h"
+#include "tsxmlElement.h"
 #include "tsMJD.h"
 
 
@@ -147,6 +148,12 @@ void ts::TablesLogger::defineArgs(Args& args)
               u"The optional string parameter specifies a prefix to prepend on the log "
               u"line before the hexadecimal text to locate the appropriate line in the logs.");
 
+    args.option(u"max-duplicate-memory", 0, Args::POSITIVE);
+    args.help(u"max-duplicate-memory", u"bytes",
+              u"Maximum memory size of each table which tracks duplicate sections with --no-deep-duplicate and --all-once. "
+              u"When a table is full, the least recently seen sections are evicted. "
+              u"The default is " + UString::Decimal(FingerprintCache::DEFAULT_MAX_MEMORY) + u" bytes.");
+
     args.option(u"max-tables", 'x', Args::POSITIVE);
     args.help(u"max-tables", u"Maximum number of tables to dump. Stop logging tables when this limit is reached.");
 
@@ -165,9 +172,9 @@ void ts::TablesLogger::defineArgs(Args& args)
     args.option(u"no-deep-duplicate");
     args.help(u"no-deep-duplicate",
               u"Do not report identical sections in the same PID, even when non-consecutive. "
-              u"A hash of each section is kept for each PID and later identical sections are not reported.\n"
-              u"Warning: This option accumulates memory for hash values of all sections since the beginning. "
-              u"Do not use that option for commands running too long or the process may crash with insufficient memory.");
+              u"A fingerprint of each section is kept for each PID and later identical sections are not reported. "
+              u"The memory of the fingerprints is bounded, see option --max-duplicate-memory. "
+              u"When it is exhausted, the least recently seen sections are forgotten and reported again if they reappear.");
 
     args.option(u"no-duplicate");
     args.help(u"no-duplicate",
@@ -324,6 +331,7 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(_log_size, u"log-size", DEFAULT_LOG_SIZE);
     _no_duplicate = args.present(u"no-duplicate");
     _no_deep_duplicate = args.present(u"no-deep-duplicate");
+    args.getIntValue(_duplicate_memory, u"max-duplicate-memory", FingerprintCache::DEFAULT_MAX_MEMORY);
     _udp_raw = args.present(u"no-encapsulation");
     _use_current = !args.present(u"exclude-current");
     _use_next = args.present(u"include-next");
@@ -373,8 +381,8 @@ bool ts::TablesLogger::open()
     _json_doc.close();
     _short_sections.clear();
     _last_sections.clear();
-    _deep_hashes.clear();
-    _sections_once.clear();
+    _deep_sections.setMaxMemory(_duplicate_memory);
+    _sections_once.setMaxMemory(_duplicate_memory);
     _x2j_conv.clear();
 
     if (_bin_file.is_open()) {
@@ -425,6 +433,9 @@ bool ts::TablesLogger::open()
     _xml_doc.setTweaks(_xml_tweaks);
     _x2j_conv.setTweaks(_xml_tweaks);
 
+    // The direct JSON serialization of tables produces the default XML-to-JSON conversion only.
+    _direct_json = !_xml_tweaks.x2jEnforceInteger && !_xml_tweaks.x2jEnforceBoolean && !_xml_tweaks.x2jTrimText && !_xml_tweaks.x2jCollapseText;
+
     // Open/create the XML output.
     if (_use_xml && !_rewrite_xml && _xml_doc.open(u"tsduck", u"", _xml_destination, std::cout) == nullptr) {
         _abort = true;
@@ -497,6 +508,14 @@ void ts::TablesLogger::close()
             _sock.close(_report);
         }
 
+        // Report lost duplicate tracking, if any.
+        if (_deep_sections.evictions() > 0) {
+            _report.verbose(u"%'d section fingerprints evicted from deep duplicate tracking, max %'d bytes", _deep_sections.evictions(), _deep_sections.memorySize());
+        }
+        if (_sections_once.evictions() > 0) {
+            _report.verbose(u"%'d section identifiers evicted from --all-once tracking, max %'d bytes", _sections_once.evictions(), _sections_once.memorySize());
+        }
+
         // Now completed.
         _exit = true;
     }
@@ -521,18 +540,18 @@ void ts::TablesLogger::feedPacket(const TSPacket& pkt)
 // Detect and track duplicate section by PID.
 //----------------------------------------------------------------------------
 
-bool ts::TablesLogger::isDuplicate(PID pid, const Section& section, std::map<PID,ByteBlock> TablesLogger::* tracker)
+bool ts::TablesLogger::isDuplicate(PID pid, const Section& section, std::map<PID,uint64_t> TablesLogger::* tracker)
 {
-    // Get a SHA-1 for the section.
-    const ByteBlock hash(section.hash());
-    ByteBlock& last((this->*tracker)[pid]);
-    if (last.empty() || last != hash) {
-        // Not the same section, keep the hash for next time.
-        last = hash;
+    // Get a 64-bit fingerprint for the section. A valid section never has a zero fingerprint in practice.
+    const uint64_t fingerprint = section.fingerprint();
+    uint64_t& last((this->*tracker)[pid]);
+    if (last == 0 || last != fingerprint) {
+        // Not the same section, keep the fingerprint for next time.
+        last = fingerprint;
         return false;
     }
     else {
-        // Same section (same hash) as previously.
+        // Same section (same fingerprint) as previously.
         return true;
     }
 }
@@ -544,18 +563,10 @@ bool ts::TablesLogger::isDuplicate(PID pid, const Section& section, std::map<PID
 
 bool ts::TablesLogger::isDeepDuplicate(PID pid, const Section& section)
 {
-    // Get a SHA-1 for the section.
-    const ByteBlock hash(section.hash());
-    auto& set(_deep_hashes[pid]);
-    if (set.find(hash) == set.end()) {
-        // Section not yet found on that PID, keep the hash for next time.
-        set.insert(hash);
-        return false;
-    }
-    else {
-        // Section already found.
-        return true;
-    }
+    // Get a 64-bit fingerprint for the section, combined with the PID: the same section on distinct PID's is not a duplicate.
+    // If the section was already found, it becomes the most recently seen one and is less likely to be evicted.
+    const uint64_t fingerprint = section.fingerprint() ^ (uint64_t(pid) * 0x9E3779B97F4A7C15);
+    return !_deep_sections.insert(fingerprint);
 }
 
 
@@ -724,14 +735,10 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& section
             (uint64_t(section.tableIdExtension()) << 16) |
             (uint64_t(section.sectionNumber()) << 8) |
             uint64_t(section.version());
-        if (_sections_once.count(id) != 0) {
+        if (!_sections_once.insert(id)) {
             // Already found this one, give up.
             return;
         }
-        else {
-            // Remember this combination.
-            _sections_once.insert(id);
-        }
     }
 
     // With option --pack-all-sections, force the processing of a complete table.
@@ -862,17 +869,31 @@ bool ts::TablesLogger::buildXML(xml::Document& doc, const BinaryTable& table)
 
 
 //----------------------------------------------------------------------------
-// Build a JSON one-liner from an XML document containing one table.
+// Build a JSON one-liner from a table.
 //----------------------------------------------------------------------------
 
-ts::UString ts::TablesLogger::buildJSON(const xml::Document& doc)
+bool ts::TablesLogger::buildJSON(xml::Document& doc, const BinaryTable& table)
 {
-    // Convert the XML document into JSON.
-    // Force "tsduck" root to appear so that the path to the first table is always the same.
-    const json::ValuePtr root(_x2j_conv.convertToJSON(doc, true));
+    // First, try to serialize the table without XML document (only a few frequent tables support it).
+    _json_line.clear();
+    if (_direct_json && table.toJSON(_duck, _json_line, _xml_options)) {
+        return true;
+    }
+    _json_line.clear();
 
-    // Query the first (and only) converted table and serialize it as one line.
-    return root->query(u"#nodes[0]").oneLiner(_report);
+    // Otherwise, serialize the first (and only) table in the XML document as one line, without
+    // intermediate JSON values. Same result as converting the document with a forced "tsduck"
+    // root and querying "#nodes[0]".
+    if (doc.rootElement() == nullptr) {
+        buildXML(doc, table);
+    }
+    const xml::Element* root = doc.rootElement();
+    const xml::Element* elem = root == nullptr ? nullptr : root->firstChildElement();
+    if (elem == nullptr) {
+        return false;
+    }
+    _x2j_conv.convertToJSON(elem, _json_line);
+    return true;
 }
 
 
@@ -883,13 +904,14 @@ ts::UString ts::TablesLogger::buildJSON(const xml::Document& doc)
 void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
 {
     xml::Document doc(_report);
-    if (buildXML(doc, table)) {
-        if (_log_xml_line) {
-            _report.info(_log_xml_prefix + doc.oneLiner());
-        }
-        if (_log_json_line) {
-            _report.info(_log_json_prefix + buildJSON(doc));
-        }
+    if (_log_xml_line && buildXML(doc, table)) {
+        _report.info(_log_xml_prefix + doc.oneLiner());
+    }
+    if (_log_json_line && buildJSON(doc, table)) {
+        // The JSON text is pure ASCII, the characters are directly widened, without intermediate string.
+        _json_log.assign(_log_json_prefix);
+        _json_log.append(_json_line.text().begin(), _json_line.text().end());
+        _report.info(_json_log);
     }
 }
 
@@ -900,16 +922,21 @@ void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
 
 void ts::TablesLogger::sendUDP(const ts::BinaryTable& table)
 {
-    if (_udp_format == SectionFormat::XML || _udp_format == SectionFormat::JSON) {
-        // Build an XML or JSON one liner. In both cases, it starts with an XML structure.
+    if (_udp_format == SectionFormat::XML) {
+        // Build an XML one liner.
         xml::Document doc(_report);
         if (buildXML(doc, table)) {
-            const UString line(_udp_format == SectionFormat::XML ? doc.oneLiner() : buildJSON(doc));
-            std::string utf8;
-            line.toUTF8(utf8);
+            const std::string utf8(doc.oneLiner().toUTF8());
             _sock.send(utf8.data(), utf8.size(), _report);
         }
     }
+    else if (_udp_format == SectionFormat::JSON) {
+        // The JSON text is directly serialized in UTF-8.
+        xml::Document doc(_report);
+        if (buildJSON(doc, table)) {
+            _sock.send(_json_line.text().data(), _json_line.text().size(), _report);
+        }
+    }
     else if (_udp_raw) {
         // Send a binary table in raw format.
         ByteBlock bin;
@@ -16,6 +16,7 @@
 #include "tsTablesLoggerFilterInterface.h"
 #include "tsTime.h"
 #include "tsTSPacket.h"
+#include "tsFingerprintCache.h"
 #include "tsSectionDemux.h"
 #include "tsSectionFormat.h"
 #include "tsUDPSocket.h"
@@ -132,6 +133,23 @@ namespace ts {
         //!
         void reportDemuxErrors(Report& report, int level = Severity::Info);
 
+        //!
+        //! Get the number of evicted section fingerprints with option -\-no-deep-duplicate.
+        //! When the memory of the duplicate tracking table is exhausted, the least recently seen sections are
+        //! evicted from the table. If an evicted section is found again later, it is reported again.
+        //! @return The number of evicted section fingerprints since open().
+        //!
+        uint64_t deepDuplicateEvictions() const { return _deep_sections.evictions(); }
+
+        //!
+        //! Get the number of evicted section identifiers with option -\-all-once.
+        //! When the memory of the tracking table is exhausted, the least recently seen section identifiers
+        //! (PID/TID/TIDext/secnum/version) are evicted from the table. If an evicted section is found again
+        //! later, it is reported again.
+        //! @return The number of evicted section identifiers since open().
+        //!
+        uint64_t allOnceEvictions() const { return _sections_once.evictions(); }
+
         //!
         //! Static routine to analyze UDP messages as sent by the table logger (option --ip-udp).
         //! @param [in] protocol Instance of TLV protocol to analyze UDP message.
@@ -193,6 +211,7 @@ namespace ts {
         size_t                   _log_size = DEFAULT_LOG_SIZE;  // Size of table to log.
         bool                     _no_duplicate = false;      // Exclude consecutive duplicated short sections on a PID.
         bool                     _no_deep_duplicate = false; // Exclude duplicated sections on a PID, even non-consecutive.
+        size_t                   _duplicate_memory = FingerprintCache::DEFAULT_MAX_MEMORY; // Max memory of each duplicate tracking table.
         bool                     _pack_all_sections = false; // Pack all sections as if they were one table.
         bool                     _pack_and_flush = false;    // Pack and flush incomplete tables before exiting.
         bool                     _fill_eit = false;          // Add missing empty sections to incomplete EIT's before exiting.
@@ -217,12 +236,15 @@ namespace ts {
         xml::RunningDocument     _xml_doc {_report};         // XML document, built on-the-fly.
         xml::JSONConverter       _x2j_conv {_report};        // XML-to-JSON converter.
         json::RunningDocument    _json_doc {_report};        // JSON document, built on-the-fly.
+        json::TextWriter         _json_line {};              // JSON one-liner, buffer reused for each table.
+        UString                  _json_log {};               // Logged JSON one-liner, buffer reused for each table.
+        bool                     _direct_json = false;       // Directly serialize JSON one-liners when the table supports it.
         std::ofstream            _bin_file {};               // Binary output file.
         UDPSocket                _sock {false, IP::Any, _report}; // Output socket.
-        std::map<PID,ByteBlock>  _short_sections {};         // Tracking duplicate short sections by PID with a section hash.
-        std::map<PID,ByteBlock>  _last_sections {};          // Tracking duplicate sections by PID with a section hash (with --all-sections).
-        std::map<PID,std::set<ByteBlock>> _deep_hashes {};   // Tracking of deep duplicate sections.
-        std::set<uint64_t>       _sections_once {};          // Tracking sets of PID/TID/TDIext/secnum/version with --all-once.
+        std::map<PID,uint64_t>   _short_sections {};         // Tracking duplicate short sections by PID with a section fingerprint.
+        std::map<PID,uint64_t>   _last_sections {};          // Tracking duplicate sections by PID with a section fingerprint (with --all-sections).
+        FingerprintCache         _deep_sections {};          // Tracking of deep duplicate sections, fingerprints of PID and section.
+        FingerprintCache         _sections_once {};          // Tracking sets of PID/TID/TDIext/secnum/version with --all-once.
         TablesLoggerFilterVector _section_filters {};        // All registered section filters.
         duck::Protocol           _duck_protocol {};          // To generate UDP messages.
 
@@ -235,8 +257,9 @@ namespace ts {
         // Build an XML document with one table.
         bool buildXML(xml::Document& doc, const BinaryTable& table);
 
-        // Build a JSON one-liner from an XML document containing one table.
-        UString buildJSON(const xml::Document& doc);
+        // Build a JSON one-liner in _json_line. The table is directly serialized when possible.
+        // Otherwise, the XML document is used. It is built from the table if still empty.
+        bool buildJSON(xml::Document& doc, const BinaryTable& table);
 
         // Log XML and/or JSON one-liners.
         void logXMLJSON(const BinaryTable& table);
@@ -258,7 +281,7 @@ namespace ts {
         void logInvalid(const DemuxedData&, const UString&);
 
         // Detect and track duplicate section by PID.
-        bool isDuplicate(PID pid, const Section& section, std::map<PID,ByteBlock> TablesLogger::* tracker);
+        bool isDuplicate(PID pid, const Section& section, std::map<PID,uint64_t> TablesLogger::* tracker);
         bool isDeepDuplicate(PID pid, const Section& section);
     };
 
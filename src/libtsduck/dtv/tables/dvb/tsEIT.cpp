@@ -17,6 +17,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 #include "tsFatal.h"
 
 #define MY_XML_NAME u"EIT"
@@ -502,6 +503,62 @@ void ts::EIT::buildXML(DuckContext& duck, xml::Element* root) const
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::EIT::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    if (beginJSON(output, !events.empty(), first_node)) {
+        for (const auto& it : events) {
+            const bool has_descs = !it.second.descs.empty();
+            if (BeginJSON(output, u"event", has_descs)) {
+                if (!it.second.descs.toJSON(duck, output)) {
+                    return false;
+                }
+                output.endArray();
+            }
+            output.key(u"ca_mode");
+            output.boolValue(it.second.CA_controlled);
+            output.key(u"duration");
+            output.stringValue(xml::Attribute::TimeToString(it.second.duration));
+            output.key(u"event_id");
+            output.integerValue(it.second.event_id);
+            output.key(u"running_status");
+            output.stringValue(RunningStatusEnum().name(it.second.running_status, true, 2 * sizeof(it.second.running_status)));
+            output.key(u"start_time");
+            output.stringValue(xml::Attribute::DateTimeToString(it.second.start_time));
+            output.endObject();
+        }
+        output.endArray();
+    }
+    output.key(u"actual");
+    output.boolValue(isActual());
+    output.key(u"current");
+    output.boolValue(is_current);
+    output.key(u"last_table_id");
+    output.integerValue(last_table_id);
+    output.key(u"original_network_id");
+    output.integerValue(onetw_id);
+    output.key(u"service_id");
+    output.integerValue(service_id);
+    output.key(u"transport_stream_id");
+    output.integerValue(ts_id);
+    output.key(u"type");
+    if (isPresentFollowing()) {
+        output.stringValue(u"pf");
+    }
+    else {
+        // Not an integer in the XML model ("pf|uint4").
+        output.stringValue(UString::Decimal(_table_id - (isActual() ? TID_EIT_S_ACT_MIN : TID_EIT_S_OTH_MIN)));
+    }
+    output.key(u"version");
+    output.integerValue(version);
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsjsonTextWriter.h"
 #include "tsFatal.h"
 
 #define MY_XML_NAME u"SDT"
@@ -399,6 +400,49 @@ void ts::SDT::buildXML(DuckContext& duck, xml::Element* root) const
 }
 
 
+//----------------------------------------------------------------------------
+// JSON serialization, without intermediate XML document.
+//----------------------------------------------------------------------------
+
+bool ts::SDT::buildJSON(DuckContext& duck, json::TextWriter& output, const json::TextWriter* first_node) const
+{
+    if (beginJSON(output, !services.empty(), first_node)) {
+        for (const auto& it : services) {
+            if (BeginJSON(output, u"service", !it.second.descs.empty())) {
+                if (!it.second.descs.toJSON(duck, output)) {
+                    return false;
+                }
+                output.endArray();
+            }
+            output.key(u"ca_mode");
+            output.boolValue(it.second.CA_controlled);
+            output.key(u"eit_present_following");
+            output.boolValue(it.second.EITpf_present);
+            output.key(u"eit_schedule");
+            output.boolValue(it.second.EITs_present);
+            output.key(u"running_status");
+            output.stringValue(RunningStatusEnum().name(it.second.running_status, true, 2 * sizeof(it.second.running_status)));
+            output.key(u"service_id");
+            output.integerValue(it.first);
+            output.endObject();
+        }
+        output.endArray();
+    }
+    output.key(u"actual");
+    output.boolValue(isActual());
+    output.key(u"current");
+    output.boolValue(is_current);
+    output.key(u"original_network_id");
+    output.integerValue(onetw_id);
+    output.key(u"transport_stream_id");
+    output.integerValue(ts_id);
+    output.key(u"version");
+    output.integerValue(version);
+    output.endObject();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // XML deserialization
 //----------------------------------------------------------------------------
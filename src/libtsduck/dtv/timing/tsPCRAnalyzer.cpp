@@ -83,8 +83,6 @@ void ts::PCRAnalyzer::reset()
             _pid[i] = nullptr;
         }
     }
-
-    _packet_pcr_index_map.clear();
 }
 
 
@@ -122,9 +120,34 @@ void ts::PCRAnalyzer::processDiscontinuity()
     for (size_t i = 0; i < PID_MAX; ++i) {
         if (_pid[i] != nullptr) {
             _pid[i]->last_pcr_value = INVALID_PCR;
+            if (_pid[i]->window != nullptr) {
+                _pid[i]->window->clear();
+            }
         }
     }
-    _packet_pcr_index_map.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Difference between two PCR or DTS values, in PCR units.
+//----------------------------------------------------------------------------
+
+uint64_t ts::PCRAnalyzer::diffClock(uint64_t from, uint64_t to) const
+{
+    return _use_dts ? DiffPTS(from, to) * SYSTEM_CLOCK_SUBFACTOR : DiffPCR(from, to);
+}
+
+
+//----------------------------------------------------------------------------
+// Add a PCR/DTS value in a sliding window, drop the oldest one when full.
+//----------------------------------------------------------------------------
+
+void ts::PCRAnalyzer::PCRWindow::push(uint64_t pcr_dts, uint64_t packet)
+{
+    if (_count == CAPACITY) {
+        pop();
+    }
+    _samples[(_first + _count++) & (CAPACITY - 1)] = {pcr_dts, packet};
 }
 
 
@@ -276,33 +299,13 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
         if (ps->last_pcr_value != INVALID_PCR && ps->last_pcr_value != pcr_dts) {
 
             // Compute transport rate in b/s since last PCR/DTS
-            uint64_t diff_values = _use_dts ?
-                DiffPTS(ps->last_pcr_value, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                DiffPCR(ps->last_pcr_value, pcr_dts);
+            const uint64_t diff_values = diffClock(ps->last_pcr_value, pcr_dts);
 
             BitRate ts_bitrate_188 = diff_values == 0 ? 0 :
                 BitRate((_ts_pkt_cnt - ps->last_pcr_packet) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / diff_values;
             BitRate ts_bitrate_204 = diff_values == 0 ? 0 :
                 BitRate((_ts_pkt_cnt - ps->last_pcr_packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
 
-            // Clear out values older than 1 second from _packet_pcr_index_map.
-            // Note that this is a map that covers PCR/DTS packets across all PIDs
-            // as long as the clocks used to generate the PCR/DTS values for different
-            // programs is the same clock, there should be no issue, but if the PCR/DTS values
-            // across the two programs are wildly different, then the following approach won't work.
-            while (!_packet_pcr_index_map.empty()) {
-                const uint64_t earliestPCR_DTS = _packet_pcr_index_map.begin()->first;
-                diff_values = _use_dts ?
-                    DiffPTS(earliestPCR_DTS, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(earliestPCR_DTS, pcr_dts);
-                if (diff_values > SYSTEM_CLOCK_FREQ) {
-                    _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
-                }
-                else {
-                    break;
-                }
-            }
-
             // Per-PID statistics:
             ps->ts_bitrate_188 += ts_bitrate_188;
             ps->ts_bitrate_204 += ts_bitrate_204;
@@ -317,16 +320,19 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
             _ts_bitrate_204 += ts_bitrate_204;
             _ts_bitrate_cnt++;
 
-            // Transport stream instantaneous statistics.
+            // Transport stream instantaneous statistics, on the last second of this PID.
+            // Each PID uses its own window because distinct programs may use distinct clocks.
             // For instantaneous bit rates, these are the actual bit rates, and it doesn't use the "count" approach.
-            if (!_packet_pcr_index_map.empty()) {
-                diff_values = _use_dts ?
-                    DiffPTS(_packet_pcr_index_map.begin()->first, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(_packet_pcr_index_map.begin()->first, pcr_dts);
-                _inst_ts_bitrate_188 = diff_values == 0 ? 0 :
-                    BitRate((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / diff_values;
-                _inst_ts_bitrate_204 = diff_values == 0 ? 0 :
-                    BitRate((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
+            assert(ps->window != nullptr);
+            PCRWindow& win(*ps->window);
+            while (!win.empty() && diffClock(win.oldest().pcr_dts, pcr_dts) > SYSTEM_CLOCK_FREQ) {
+                win.pop();
+            }
+            if (!win.empty()) {
+                const uint64_t win_values = diffClock(win.oldest().pcr_dts, pcr_dts);
+                const uint64_t win_packets = _ts_pkt_cnt - win.oldest().packet;
+                _inst_ts_bitrate_188 = win_values == 0 ? 0 : BitRate(win_packets * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / win_values;
+                _inst_ts_bitrate_204 = win_values == 0 ? 0 : BitRate(win_packets * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / win_values;
             }
 
             // Check if we got enough values for this PID
@@ -341,14 +347,11 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
             ps->last_pcr_value = pcr_dts;
             ps->last_pcr_packet = _ts_pkt_cnt;
 
-            // Also add PCR (or DTS)/packet index combo to map for use in instantaneous bit rate calculations.
-            _packet_pcr_index_map[pcr_dts] = _ts_pkt_cnt;
-
-            // Make sure that some crazy TS does not accumulate thousands of PCR values in the same second range.
-            while (_packet_pcr_index_map.size() > FOOLPROOF_MAP_LIMIT) {
-                // Erase older entries.
-                _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
+            // Also add PCR (or DTS)/packet index combo to the window for use in instantaneous bit rate calculations.
+            if (ps->window == nullptr) {
+                ps->window = std::make_unique<PCRWindow>();
             }
+            ps->window->push(pcr_dts, _ts_pkt_cnt);
         }
     }
 
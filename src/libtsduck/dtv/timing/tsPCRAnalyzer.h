@@ -178,6 +178,35 @@ namespace ts {
         // Process a discontinuity in the transport stream
         void processDiscontinuity();
 
+        // Difference between two PCR or DTS values, in PCR units.
+        uint64_t diffClock(uint64_t from, uint64_t to) const;
+
+        // Sliding window of the PCR/DTS values in the last second of one PID.
+        // This is a fixed-capacity circular buffer. When a PID carries more PCR/DTS than
+        // the capacity in one second, the oldest values are dropped and the window is shorter.
+        class PCRWindow
+        {
+        public:
+            // One PCR/DTS value and the index of the packet containing it in the TS.
+            struct Sample
+            {
+                uint64_t pcr_dts = 0;
+                uint64_t packet = 0;
+            };
+            static constexpr size_t CAPACITY = 512;  // must be a power of 2
+
+            bool empty() const { return _count == 0; }
+            void clear() { _first = _count = 0; }
+            const Sample& oldest() const { return _samples[_first]; }
+            void pop() { _first = (_first + 1) & (CAPACITY - 1); _count--; }
+            void push(uint64_t pcr_dts, uint64_t packet);
+
+        private:
+            size_t _first = 0;  // Index of oldest sample.
+            size_t _count = 0;  // Number of samples in the window.
+            std::array<Sample, CAPACITY> _samples {};
+        };
+
         // Analysis of one PID
         struct PIDAnalysis
         {
@@ -188,6 +217,7 @@ namespace ts {
             BitRate  ts_bitrate_188 = 0;   // Sum of all computed TS bitrates (188-byte)
             BitRate  ts_bitrate_204 = 0;   // Sum of all computed TS bitrates (204-byte)
             uint64_t ts_bitrate_cnt = 0;   // Count of computed TS bitrates
+            std::unique_ptr<PCRWindow> window {}; // Last second of PCR/DTS, allocated on first PCR/DTS
         };
 
         // Private members:
@@ -200,13 +230,11 @@ namespace ts {
         BitRate  _ts_bitrate_188 = 0;      // Sum of all computed TS bitrates (188-byte)
         BitRate  _ts_bitrate_204 = 0;      // Sum of all computed TS bitrates (204-byte)
         uint64_t _ts_bitrate_cnt = 0;      // Count of computed bitrates
-        BitRate  _inst_ts_bitrate_188 = 0; // Sum of all computed TS bitrates (188-byte) for last second
-        BitRate  _inst_ts_bitrate_204 = 0; // Sum of all computed TS bitrates (204-byte) for last second
+        BitRate  _inst_ts_bitrate_188 = 0; // Last computed TS bitrates (188-byte) for last second
+        BitRate  _inst_ts_bitrate_204 = 0; // Last computed TS bitrates (204-byte) for last second
         size_t   _completed_pids = 0;      // Number of PIDs with enough PCRs
         size_t   _pcr_pids = 0;            // Number of PIDs with PCRs
         size_t   _discontinuities = 0;     // Number of discontinuities
         PIDAnalysis* _pid[PID_MAX] {};     // Per-PID stats
-        std::map<uint64_t, uint64_t> _packet_pcr_index_map {}; // Map of PCR/DTS to packet index across entire TS
-        static constexpr size_t FOOLPROOF_MAP_LIMIT = 1000;    // Max number of entries in the PCR map
     };
 }
@@ -123,6 +123,31 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"Specify the local UDP source port for outgoing packets. "
                   u"By default, a random source port is used.");
 
+        args.option(u"gso");
+        args.help(u"gso",
+                  u"With --send-batch, use UDP segmentation offload (GSO) when possible: a batch of datagrams is "
+                  u"passed to the kernel as one single large buffer which is split by the kernel or the network interface. "
+                  u"This option requires --send-batch with a value greater than 1. "
+                  u"Currently, this option is supported on Linux only. It is ignored on other systems.");
+
+        // Incomplete batches are kept between calls only with KEEP_BATCH.
+        if (bool(_flags & TSDatagramOutputOptions::KEEP_BATCH)) {
+            args.option<cn::milliseconds>(u"max-batch-delay");
+            args.help(u"max-batch-delay",
+                      u"With --send-batch, specify the maximum time to keep an incomplete batch of UDP datagrams. "
+                      u"When the first datagram of the batch is older than this delay, the batch is sent with the "
+                      u"next TS packet, even if it is not full. This bounds the added latency at low bitrates. "
+                      u"The default is " + UString::Chrono(DEFAULT_MAX_BATCH_DELAY, true) + u".");
+        }
+
+        args.option(u"send-batch", 0, Args::INTEGER, 0, 1, 1, MAX_SEND_BATCH);
+        args.help(u"send-batch",
+                  u"Specify the maximum number of UDP datagrams to send in one system call. "
+                  u"On Linux, several datagrams are sent using sendmmsg(), reducing the system call overhead at high bitrates. "
+                  u"The datagrams are sent when the batch is full or when all packets which were passed together to the "
+                  u"output are processed. The content and RTP headers of the datagrams are unchanged. "
+                  u"The default is 1, the maximum is " + UString::Decimal(MAX_SEND_BATCH) + u".");
+
         args.option(u"tos", 's', Args::INTEGER, 0, 1, 1, 255);
         args.help(u"tos",
                   u"Specifies the TOS (Type-Of-Service) socket option. Setting this value "
@@ -166,6 +191,15 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         args.getIntValue(_send_bufsize, u"buffer-size", 0);
         _mc_loopback = !args.present(u"disable-multicast-loop");
         _force_mc_local = args.present(u"force-local-multicast-outgoing");
+        args.getIntValue(_send_batch, u"send-batch", 1);
+        if (bool(_flags & TSDatagramOutputOptions::KEEP_BATCH)) {
+            args.getChronoValue(_max_batch_delay, u"max-batch-delay", DEFAULT_MAX_BATCH_DELAY);
+        }
+        _send_gso = args.present(u"gso");
+        if (_send_gso && _send_batch <= 1) {
+            args.error(u"option --gso requires --send-batch with a value greater than 1");
+            return false;
+        }
     }
 
     if (bool(_flags & TSDatagramOutputOptions::ALLOW_RS204)) {
@@ -229,7 +263,8 @@ bool ts::TSDatagramOutput::open(Report& report)
             (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr, report)) ||
             (_send_bufsize > 0 && !_sock.setSendBufferSize(_send_bufsize, report)) ||
             (_tos >= 0 && !_sock.setTOS(_tos, report)) ||
-            (_ttl > 0 && !_sock.setTTL(_ttl, report)))
+            (_ttl > 0 && !_sock.setTTL(_ttl, report)) ||
+            (_send_gso && !_sock.setSendSegmentation(true, report)))
         {
             _sock.close(report);
             return false;
@@ -243,6 +278,12 @@ bool ts::TSDatagramOutput::open(Report& report)
     _last_rtp_pcr_pkt = 0;
     _rtp_pcr_offset = 0;
     _pkt_count = 0;
+    _batch_buffer.clear();
+    _batch_sizes.clear();
+    if (_raw_udp && _send_batch > 1) {
+        _batch_buffer.reserve(_send_batch * (RTP_HEADER_SIZE + maxPayloadSize()));
+        _batch_sizes.reserve(_send_batch);
+    }
 
     _is_open = true;
     return true;
@@ -262,6 +303,12 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, bool abort, Report& rep
             success = sendPackets(_out_buffer.data(), _out_buffer_rs.data(), _out_count, bitrate, report);
             _out_count = 0;
         }
+        // Flush pending datagrams, if any.
+        if (!abort) {
+            success = flushBatch(report) && success;
+        }
+        _batch_buffer.clear();
+        _batch_sizes.clear();
         if (_raw_udp) {
             _sock.close(report);
         }
@@ -370,7 +417,52 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, const TSPacketMetadata* met
     if (packet_count > 0) {
         bufferPackets(pkt, metadata, packet_count);
     }
-    return true;
+
+    // Send all complete datagrams, unless batches shall be kept across calls.
+    // Even then, an incomplete batch is not kept longer than the maximum delay.
+    if (!(_flags & TSDatagramOutputOptions::KEEP_BATCH)) {
+        return flushBatch(report);
+    }
+    else if (!_batch_sizes.empty() && monotonic_time::clock::now() - _batch_time >= _max_batch_delay) {
+        return flushBatch(report);
+    }
+    else {
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Send one datagram, either immediately or in the next batch.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::sendOrBatch(const void* address, size_t size, Report& report)
+{
+    // Batches are only supported with raw UDP.
+    if (!_raw_udp || _send_batch <= 1) {
+        return _output->sendDatagram(address, size, report);
+    }
+
+    // Append the datagram in the batch. Send the batch when full.
+    if (_batch_sizes.empty() && bool(_flags & TSDatagramOutputOptions::KEEP_BATCH)) {
+        _batch_time = monotonic_time::clock::now();
+    }
+    _batch_buffer.append(address, size);
+    _batch_sizes.push_back(size);
+    return _batch_sizes.size() < _send_batch || flushBatch(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Send all datagrams in current batch, if any.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::flushBatch(Report& report)
+{
+    const bool status = _sock.sendMultiple(_batch_buffer.data(), _batch_sizes, report);
+    _batch_buffer.clear();
+    _batch_sizes.clear();
+    return status;
 }
 
 
@@ -476,17 +568,17 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
             MemCopy(buf, pkt, packet_count * PKT_SIZE);
             buffer.resize(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
         }
-        status = _output->sendDatagram(buffer.data(), buffer.size(), report);
+        status = sendOrBatch(buffer.data(), buffer.size(), report);
     }
     else if (_rs204_format) {
         // No RTP header, add TS trailer after each packet.
         ByteBlock buffer(packet_count * PKT_RS_SIZE);
         serialize(buffer.data(), buffer.size(), pkt, metadata, packet_count);
-        status = _output->sendDatagram(buffer.data(), buffer.size(), report);
+        status = sendOrBatch(buffer.data(), buffer.size(), report);
     }
     else {
         // No RTP, no trailer, send TS packets directly as datagram.
-        status = _output->sendDatagram(pkt, packet_count * PKT_SIZE, report);
+        status = sendOrBatch(pkt, packet_count * PKT_SIZE, report);
     }
 
     // Count packets datagram per datagram.
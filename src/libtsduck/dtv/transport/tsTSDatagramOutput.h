@@ -29,6 +29,7 @@ namespace ts {
         ALLOW_RTP    = 0x0001,  //!< Allow RTP options to build an RTP datagram.
         ALWAYS_BURST = 0x0002,  //!< Do not define option --enforce-burst, always enforce burst.
         ALLOW_RS204  = 0x0004,  //!< Allow option --rs204 to send 204-byte packets.
+        KEEP_BATCH   = 0x0008,  //!< With --send-batch, keep incomplete batches of datagrams between calls to send().
     };
 }
 TS_ENABLE_BITMASK_OPERATORS(ts::TSDatagramOutputOptions);
@@ -60,6 +61,17 @@ namespace ts {
         //!
         static constexpr size_t MAX_PACKET_BURST = 128;
 
+        //!
+        //! Maximum number of UDP datagrams which are sent in one system call (option --send-batch).
+        //!
+        static constexpr size_t MAX_SEND_BATCH = 64;
+
+        //!
+        //! Default maximum time to keep an incomplete batch of datagrams (option --max-batch-delay).
+        //! Used with flag KEEP_BATCH only.
+        //!
+        static constexpr cn::milliseconds DEFAULT_MAX_BATCH_DELAY = cn::milliseconds(10);
+
         //!
         //! Constructor.
         //! @param [in] flags List of options.
@@ -91,7 +103,7 @@ namespace ts {
 
         //!
         //! Close the TS packet output.
-        //! Flush pending packets, if any.
+        //! Flush pending packets and datagrams, if any.
         //! @param [in] bitrate Current of last bitrate to compute timestamps for buffered packets. Ignored if zero.
         //! @param [in] abort If true, do not flush pending packets.
         //! @param [in,out] report Where to report errors.
@@ -102,6 +114,9 @@ namespace ts {
         //!
         //! Send TS packets.
         //! Some of them can be buffered and sent later.
+        //! With option --send-batch, all complete datagrams are sent before returning,
+        //! unless the flag KEEP_BATCH was specified in the constructor. In that case, an
+        //! incomplete batch is sent when its first datagram is older than the maximum batch delay.
         //! @param [in] packets Address of first packet.
         //! @param [in] metadata Address of first packet metadata (can be null).
         //! @param [in] packet_count Number of packets to send.
@@ -144,6 +159,9 @@ namespace ts {
         bool            _mc_loopback = true;         // Multicast loopback option
         bool            _force_mc_local = false;     // Force multicast outgoing local interface
         size_t          _send_bufsize = 0;           // Socket send buffer size.
+        size_t          _send_batch = 1;             // Max number of datagrams per system call.
+        bool            _send_gso = false;           // Use UDP segmentation offload.
+        cn::milliseconds _max_batch_delay = DEFAULT_MAX_BATCH_DELAY; // Max time to keep an incomplete batch with KEEP_BATCH.
 
         // Working data.
         bool            _is_open = false;            // Currently in progress
@@ -159,6 +177,9 @@ namespace ts {
         TSPacketVector  _out_buffer {};              // Buffered packets for output with --enforce-burst
         TSPacketMetadataVector _out_buffer_rs {};    // Buffered RS trailers with --enforce-burst --rs204
         UDPSocket       _sock {};                    // Outgoing socket for raw UDP
+        ByteBlock       _batch_buffer {};            // Consecutive datagrams waiting to be sent with --send-batch
+        std::vector<size_t> _batch_sizes {};         // Sizes of datagrams in _batch_buffer
+        monotonic_time  _batch_time {};              // Time of the first datagram in _batch_buffer
 
         // Implementation of TSDatagramOutputHandlerInterface.
         // The object is its own handler in case of raw UDP output.
@@ -170,6 +191,12 @@ namespace ts {
         // Serialize a set of packets and RS trailers in a buffer.
         void serialize(uint8_t* buffer, size_t buffer_size, const TSPacket* packet, const TSPacketMetadata* metadata, size_t count);
 
+        // Send one datagram, either immediately or in the next batch with --send-batch.
+        bool sendOrBatch(const void* address, size_t size, Report& report);
+
+        // Send all datagrams in current batch, if any.
+        bool flushBatch(Report& report);
+
         // Send contiguous packets in one single datagram.
         bool sendPackets(const TSPacket* packet, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate, Report& report);
     };
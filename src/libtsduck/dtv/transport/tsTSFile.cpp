@@ -19,10 +19,334 @@
     #include "tsBeforeStandardHeaders.h"
     #include <sys/types.h>
     #include <sys/stat.h>
+    #include <sys/mman.h>
     #include <unistd.h>
     #include "tsAfterStandardHeaders.h"
 #endif
 
+#if defined(TS_LINUX)
+    #include "tsIOUring.h"
+    #include "tsByteBlock.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Asynchronous I/O engine, using io_uring on Linux.
+//----------------------------------------------------------------------------
+
+#if defined(TS_LINUX)
+
+class ts::TSFile::AsyncIO
+{
+    TS_NOBUILD_NOCOPY(AsyncIO);
+public:
+    // Constructor and destructor. The file is either read or written.
+    AsyncIO(int fd, bool write, size_t requests, const UString& name, int severity);
+    ~AsyncIO();
+
+    // Start the I/O at the specified offset in the file.
+    bool start(uint64_t offset, Report& report);
+
+    // Read data, as with readStreamPartial(). Set eof at end of file.
+    bool read(void* addr, size_t size, size_t& ret_size, bool& eof, Report& report);
+
+    // Write data. The data are copied in the buffers and written later.
+    bool write(const void* addr, size_t size, Report& report);
+
+    // Write all buffered data and wait for the completion of all writes.
+    bool flush(Report& report);
+
+    // Restart reading or writing at a new offset.
+    bool seek(uint64_t offset, Report& report);
+
+    // Check if the first read failed because the kernel does not support read operations in io_uring.
+    // In that case, nothing was read and the application shall revert to synchronous I/O.
+    bool unsupported() const { return _unsupported; }
+
+    // File offset of the next data to read.
+    uint64_t readOffset() const { return _blocks[_current].offset + _blocks[_current].pos; }
+
+private:
+    // Description of a request. Requests are used in sequence, as a circular buffer.
+    struct Block {
+        ByteBlock data {};        // Data buffer, ASYNC_BLOCK_SIZE bytes.
+        uint64_t  offset = 0;     // Offset in file.
+        size_t    size = 0;       // Read: size of request. Write: size of data in buffer.
+        size_t    pos = 0;        // Read: size of data which were already returned.
+        int32_t   result = 0;     // Result of the completed request.
+        bool      busy = false;   // Request in progress.
+        bool      pending = false; // Write: submitted and not yet checked.
+    };
+
+    IOUring            _uring {};
+    const int          _fd;
+    const bool         _write;
+    const UString      _name;
+    const int          _severity;
+    std::vector<Block> _blocks;
+    size_t             _current = 0;  // Index of current block.
+    uint64_t           _offset = 0;   // File offset of next block to submit.
+    bool               _supported = false;    // At least one read request completed.
+    bool               _unsupported = false;  // The first read request failed with EINVAL.
+
+    // Submit the read of the next block in the file.
+    bool submitRead(size_t index, Report& report);
+
+    // Submit the write of a block.
+    bool submitWrite(size_t index, Report& report);
+
+    // Wait for the completion of a block.
+    bool waitBlock(size_t index, Report& report);
+
+    // Check the completion of a written block and make it free again.
+    bool completeWrite(size_t index, Report& report);
+
+    // Wait for all requests and restart reading from the specified offset.
+    bool restartRead(uint64_t offset, Report& report);
+
+    // Wait for the completion of all requests.
+    bool drain(Report& report);
+};
+
+ts::TSFile::AsyncIO::AsyncIO(int fd, bool write, size_t requests, const UString& name, int severity) :
+    _fd(fd),
+    _write(write),
+    _name(name),
+    _severity(severity),
+    _blocks(std::max<size_t>(requests, 2))
+{
+    for (auto& b : _blocks) {
+        b.data.resize(ASYNC_BLOCK_SIZE);
+    }
+}
+
+ts::TSFile::AsyncIO::~AsyncIO()
+{
+    // The buffers must not be freed while the kernel may still access them.
+    drain(NULLREP);
+}
+
+bool ts::TSFile::AsyncIO::start(uint64_t offset, Report& report)
+{
+    if (!_uring.open(_blocks.size(), report)) {
+        return false;
+    }
+    else if (_write) {
+        _offset = offset;
+        _current = 0;
+        return true;
+    }
+    else {
+        return restartRead(offset, report);
+    }
+}
+
+bool ts::TSFile::AsyncIO::submitRead(size_t index, Report& report)
+{
+    Block& b(_blocks[index]);
+    b.offset = _offset;
+    b.size = b.data.size();
+    b.pos = 0;
+    b.result = 0;
+    b.busy = _uring.submitRead(_fd, b.data.data(), b.size, b.offset, index, report);
+    _offset += b.size;
+    return b.busy;
+}
+
+bool ts::TSFile::AsyncIO::submitWrite(size_t index, Report& report)
+{
+    Block& b(_blocks[index]);
+    b.offset = _offset;
+    b.result = 0;
+    b.busy = b.pending = _uring.submitWrite(_fd, b.data.data(), b.size, b.offset, index, report);
+    _offset += b.size;
+    return b.busy;
+}
+
+bool ts::TSFile::AsyncIO::waitBlock(size_t index, Report& report)
+{
+    // Completions may come in any order, keep the results of other blocks.
+    while (_blocks[index].busy) {
+        uint64_t id = 0;
+        int32_t result = 0;
+        if (!_uring.waitCompletion(id, result, report)) {
+            return false;
+        }
+        if (id < _blocks.size()) {
+            _blocks[id].busy = false;
+            _blocks[id].result = result;
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::AsyncIO::drain(Report& report)
+{
+    bool ok = true;
+    for (size_t i = 0; i < _blocks.size(); ++i) {
+        ok = waitBlock(i, report) && ok;
+    }
+    return ok;
+}
+
+bool ts::TSFile::AsyncIO::restartRead(uint64_t offset, Report& report)
+{
+    if (!drain(report)) {
+        return false;
+    }
+    _offset = offset;
+    _current = 0;
+    for (size_t i = 0; i < _blocks.size(); ++i) {
+        if (!submitRead(i, report)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::AsyncIO::read(void* addr, size_t size, size_t& ret_size, bool& eof, Report& report)
+{
+    ret_size = 0;
+    eof = false;
+
+    Block& b(_blocks[_current]);
+    for (;;) {
+        if (!waitBlock(_current, report)) {
+            return false;
+        }
+        else if (b.result >= 0) {
+            _supported = true;
+            break;
+        }
+        else if (b.result == -EINVAL && !_supported) {
+            // IORING_OP_READ is only supported since Linux 5.6, older kernels fail all reads with EINVAL.
+            report.debug(u"io_uring read not supported on %s", _name);
+            _unsupported = true;
+            return false;
+        }
+        else if (b.result != -EINTR && b.result != -EAGAIN) {
+            report.log(_severity, u"error reading %s: %s", _name, SysErrorCodeMessage(-b.result));
+            return false;
+        }
+        // Interrupted request, submit it again.
+        b.busy = _uring.submitRead(_fd, b.data.data(), b.size, b.offset, _current, report);
+        if (!b.busy) {
+            return false;
+        }
+    }
+
+    // No data at the current offset means end of file.
+    if (b.result == 0) {
+        eof = true;
+        return false;
+    }
+
+    // Return data from the current block.
+    const size_t available = size_t(b.result);
+    ret_size = std::min(size, available - b.pos);
+    MemCopy(addr, b.data.data() + b.pos, ret_size);
+    b.pos += ret_size;
+
+    if (b.pos >= available) {
+        if (available < b.size) {
+            // Short read, typically at end of file. Subsequent requests are invalid.
+            // Restart all requests after the returned data, in case the file grows.
+            return restartRead(b.offset + available, report);
+        }
+        else {
+            // Reuse the block for the next request in the file.
+            const bool ok = submitRead(_current, report);
+            _current = (_current + 1) % _blocks.size();
+            return ok;
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::AsyncIO::completeWrite(size_t index, Report& report)
+{
+    Block& b(_blocks[index]);
+    if (!b.pending) {
+        return true;
+    }
+    if (!waitBlock(index, report)) {
+        return false;
+    }
+    b.pending = false;
+    if (b.result < 0 && b.result != -EINTR && b.result != -EAGAIN) {
+        report.log(_severity, u"error writing %s: %s", _name, SysErrorCodeMessage(-b.result));
+        return false;
+    }
+
+    // Complete short or interrupted writes synchronously.
+    size_t done = size_t(std::max<int32_t>(b.result, 0));
+    while (done < b.size) {
+        const ssize_t outsize = ::pwrite(_fd, b.data.data() + done, b.size - done, off_t(b.offset + done));
+        if (outsize > 0) {
+            done += size_t(outsize);
+        }
+        else if (errno != EINTR) {
+            report.log(_severity, u"error writing %s: %s", _name, SysErrorCodeMessage());
+            return false;
+        }
+    }
+    b.size = 0;
+    return true;
+}
+
+bool ts::TSFile::AsyncIO::write(const void* addr, size_t size, Report& report)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(addr);
+    while (size > 0) {
+        // Make sure the current block is free, if it was previously submitted.
+        if (!completeWrite(_current, report)) {
+            return false;
+        }
+        Block& b(_blocks[_current]);
+        const size_t count = std::min(size, b.data.size() - b.size);
+        MemCopy(b.data.data() + b.size, data, count);
+        b.size += count;
+        data += count;
+        size -= count;
+        // Submit the block when it is full.
+        if (b.size == b.data.size()) {
+            if (!submitWrite(_current, report)) {
+                return false;
+            }
+            _current = (_current + 1) % _blocks.size();
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::AsyncIO::flush(Report& report)
+{
+    bool ok = true;
+    Block& b(_blocks[_current]);
+    if (b.size > 0 && !b.pending) {
+        ok = submitWrite(_current, report);
+        _current = (_current + 1) % _blocks.size();
+    }
+    for (size_t i = 0; i < _blocks.size(); ++i) {
+        ok = completeWrite(i, report) && ok;
+    }
+    return ok;
+}
+
+bool ts::TSFile::AsyncIO::seek(uint64_t offset, Report& report)
+{
+    if (_write) {
+        const bool ok = flush(report);
+        _offset = offset;
+        return ok;
+    }
+    else {
+        return restartRead(offset, report);
+    }
+}
+
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -51,18 +375,31 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     _rewindable(other._rewindable),
     _regular(other._regular),
     _std_inout(other._std_inout),
+    _io_mode(other._io_mode),
+    _active_mode(other._active_mode),
+    _async_requests(other._async_requests),
 #if defined(TS_WINDOWS)
     _handle(other._handle)
 #else
-    _fd(other._fd)
+    _fd(other._fd),
+    _map_base(other._map_base),
+    _map_size(other._map_size),
+    _map_pos(other._map_pos),
+    _map_released(other._map_released)
+#endif
+#if defined(TS_LINUX)
+    , _async(std::move(other._async))
 #endif
 {
     // Mark other object as closed, just in case.
     other._is_open = false;
+    other._active_mode = IOMode::STANDARD;
 #if defined(TS_WINDOWS)
     other._handle = INVALID_HANDLE_VALUE;
 #else
     other._fd = -1;
+    other._map_base = nullptr;
+    other._map_size = 0;
 #endif
 }
 
@@ -106,6 +443,149 @@ void ts::TSFile::setStuffing(size_t initial, size_t final)
 }
 
 
+//----------------------------------------------------------------------------
+// Set the I/O mode of the file.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::setIOMode(IOMode mode, size_t async_requests)
+{
+    _io_mode = mode;
+    _async_requests = async_requests;
+}
+
+
+//----------------------------------------------------------------------------
+// Start and stop the I/O mode of the open file.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::startIOMode(Report& report)
+{
+    _active_mode = IOMode::STANDARD;
+    [[maybe_unused]] const bool read_only = (_flags & (READ | WRITE)) == READ;
+    [[maybe_unused]] const bool write_only = (_flags & (READ | WRITE)) == WRITE;
+
+    if (_io_mode == IOMode::STANDARD) {
+        return;
+    }
+    else if (!_regular) {
+        report.debug(u"%s is not a regular file, using standard I/O", getDisplayFileName());
+    }
+#if !defined(TS_WINDOWS)
+    else if (_io_mode == IOMode::MMAP && read_only) {
+        _map_pos = _start_offset;
+        _map_released = _start_offset - _start_offset % MAP_RELEASE_SIZE;
+        if (mapFile(report)) {
+            _active_mode = IOMode::MMAP;
+        }
+    }
+#endif
+#if defined(TS_LINUX)
+    else if (_io_mode == IOMode::ASYNC && (read_only || write_only)) {
+        // Start at the current position, after initial offset or at end of file in append mode.
+        const off_t offset = ::lseek(_fd, 0, SEEK_CUR);
+        _async = std::make_unique<AsyncIO>(_fd, write_only, _async_requests, getDisplayFileName(), _severity);
+        if (offset >= 0 && _async->start(uint64_t(offset), report)) {
+            _active_mode = IOMode::ASYNC;
+        }
+        else {
+            _async.reset();
+        }
+    }
+#endif
+
+    if (_active_mode == IOMode::STANDARD) {
+        report.debug(u"using standard I/O on %s", getDisplayFileName());
+    }
+}
+
+bool ts::TSFile::stopIOMode(Report& report)
+{
+    bool ok = true;
+#if !defined(TS_WINDOWS)
+    unmapFile();
+#endif
+#if defined(TS_LINUX)
+    if (_async != nullptr && (_flags & WRITE) != 0 && !_aborted) {
+        ok = _async->flush(report);
+    }
+    _async.reset();
+#endif
+    _active_mode = IOMode::STANDARD;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-mapped input file.
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+// Map or remap the complete file, if its size has changed.
+bool ts::TSFile::mapFile(Report& report)
+{
+    struct stat st {};
+    if (::fstat(_fd, &st) < 0) {
+        report.debug(u"cannot stat %s: %s", getDisplayFileName(), SysErrorCodeMessage());
+        return false;
+    }
+    const uint64_t size = uint64_t(st.st_size);
+    if (size == _map_size) {
+        return true;
+    }
+    else if (size > uint64_t(std::numeric_limits<size_t>::max())) {
+        report.debug(u"%s is too large to be mapped", getDisplayFileName());
+        return false;
+    }
+
+    void* addr = nullptr;
+    if (size > 0) {
+        addr = ::mmap(nullptr, size_t(size), PROT_READ, MAP_SHARED, _fd, 0);
+        if (addr == MAP_FAILED) {
+            report.debug(u"cannot map %s: %s", getDisplayFileName(), SysErrorCodeMessage());
+            return false;
+        }
+        // Aggressive read-ahead, the pages are read only once.
+        ::madvise(addr, size_t(size), MADV_SEQUENTIAL);
+    }
+    unmapFile();
+    _map_base = reinterpret_cast<uint8_t*>(addr);
+    _map_size = size;
+    return true;
+}
+
+void ts::TSFile::unmapFile()
+{
+    if (_map_base != nullptr) {
+        ::munmap(_map_base, size_t(_map_size));
+    }
+    _map_base = nullptr;
+    _map_size = 0;
+}
+
+bool ts::TSFile::readMapped(void* buffer, size_t request_size, size_t& read_size, Report& report)
+{
+    // At end of mapped area, check if the file has grown.
+    if (_map_pos >= _map_size && (!mapFile(report) || _map_pos >= _map_size)) {
+        _at_eof = true;
+        return false;
+    }
+
+    read_size = size_t(std::min<uint64_t>(request_size, _map_size - _map_pos));
+    MemCopy(buffer, _map_base + _map_pos, read_size);
+    _map_pos += read_size;
+
+    // Release the memory of the pages which were read long ago, they are not reused.
+    if (_map_pos >= _map_released + 2 * MAP_RELEASE_SIZE) {
+        ::madvise(_map_base + _map_released, size_t(MAP_RELEASE_SIZE), MADV_DONTNEED);
+        _map_released += MAP_RELEASE_SIZE;
+    }
+    return true;
+}
+
+#endif
+
+
 //----------------------------------------------------------------------------
 // Open file for read in a rewindable mode.
 //----------------------------------------------------------------------------
@@ -308,6 +788,7 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
 
     // Close first if this is a reopen.
     if (reopen) {
+        stopIOMode(report);
         ::close(_fd);
         _fd = -1;
     }
@@ -381,6 +862,9 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
 
 #endif
 
+    // Setup memory-mapped or asynchronous I/O on regular files.
+    startIOMode(report);
+
     // Reset counters only if not a reopen.
     if (!reopen) {
         _total_read = _total_write = 0;
@@ -439,6 +923,21 @@ bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 
     report.debug(u"seeking %s at offset %'d", _filename, _start_offset + index);
 
+#if !defined(TS_WINDOWS)
+    if (_active_mode == IOMode::MMAP) {
+        _map_pos = _start_offset + index;
+        _map_released = _map_pos - _map_pos % MAP_RELEASE_SIZE;
+        _at_eof = false;
+        return true;
+    }
+#endif
+#if defined(TS_LINUX)
+    if (_active_mode == IOMode::ASYNC) {
+        _at_eof = false;
+        return _async->seek(_start_offset + index, report);
+    }
+#endif
+
 #if defined(TS_WINDOWS)
     // In Win32, LARGE_INTEGER is a 64-bit structure, not an integer type
     uint64_t where = _start_offset + index;
@@ -493,6 +992,9 @@ bool ts::TSFile::close(Report& report)
         writeStuffing(_close_null, report);
     }
 
+    // Complete pending asynchronous writes, unmap file.
+    const bool ok = stopIOMode(report);
+
     if (!_std_inout) {
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -508,7 +1010,7 @@ bool ts::TSFile::close(Report& report)
     _filename.clear();
     _std_inout = false;
 
-    return true;
+    return ok;
 }
 
 
@@ -538,6 +1040,31 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
         return true;
     }
 
+#if !defined(TS_WINDOWS)
+    if (_active_mode == IOMode::MMAP) {
+        return readMapped(buffer, request_size, read_size, report);
+    }
+#endif
+#if defined(TS_LINUX)
+    if (_active_mode == IOMode::ASYNC) {
+        bool eof = false;
+        const bool ok = _async->read(buffer, request_size, read_size, eof, report);
+        if (!_async->unsupported()) {
+            _at_eof = _at_eof || eof;
+            return ok;
+        }
+        // Nothing was read, revert to standard I/O from the same position, as when io_uring cannot be created.
+        const off_t offset = off_t(_async->readOffset());
+        _async.reset();
+        _active_mode = IOMode::STANDARD;
+        if (::lseek(_fd, offset, SEEK_SET) < 0) {
+            report.log(_severity, u"error seeking file %s: %s", getDisplayFileName(), SysErrorCodeMessage());
+            return false;
+        }
+        report.debug(u"using standard I/O on %s", getDisplayFileName());
+    }
+#endif
+
 #if defined(TS_WINDOWS)
 
     // Windows implementation
@@ -656,6 +1183,14 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 {
     written_size = 0;
 
+#if defined(TS_LINUX)
+    if (_active_mode == IOMode::ASYNC) {
+        const bool ok = _async->write(buffer, data_size, report);
+        written_size = ok ? data_size : 0;
+        return ok;
+    }
+#endif
+
 #if defined(TS_WINDOWS)
 
     // Windows implementation
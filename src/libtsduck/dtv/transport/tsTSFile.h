@@ -151,6 +151,49 @@ namespace ts {
         //!
         void setStuffing(size_t initial, size_t final);
 
+        //!
+        //! I/O modes of a file.
+        //!
+        enum class IOMode {
+            STANDARD,  //!< Standard read and write system calls.
+            MMAP,      //!< Memory-mapped input file with sequential read-ahead (UNIX systems only).
+            ASYNC,     //!< Asynchronous read or write with several in-flight requests (Linux io_uring only).
+        };
+
+        //!
+        //! Default number of in-flight requests with IOMode::ASYNC.
+        //!
+        static constexpr size_t DEFAULT_ASYNC_REQUESTS = 8;
+
+        //!
+        //! Size in bytes of each request with IOMode::ASYNC.
+        //!
+        static constexpr size_t ASYNC_BLOCK_SIZE = 1024 * 1024;
+
+        //!
+        //! Set the I/O mode of the file.
+        //! This method shall be called before opening the file.
+        //!
+        //! The modes IOMode::MMAP and IOMode::ASYNC apply to regular files only. IOMode::MMAP is
+        //! only used on files which are open for read only. A memory-mapped file must not be
+        //! truncated while it is read. IOMode::ASYNC is used on files which are open for read
+        //! or write, but not both. In all other cases, or when the mode is not supported by the
+        //! operating system, the file reverts to IOMode::STANDARD. Some kernels support io_uring
+        //! but not its read operation. In that case, a file which is read with IOMode::ASYNC
+        //! reverts to IOMode::STANDARD on the first read.
+        //!
+        //! @param [in] mode I/O mode.
+        //! @param [in] async_requests Number of in-flight requests with IOMode::ASYNC.
+        //! @see actualIOMode()
+        //!
+        void setIOMode(IOMode mode, size_t async_requests = DEFAULT_ASYNC_REQUESTS);
+
+        //!
+        //! Get the I/O mode which is actually used by the open file.
+        //! @return The actual I/O mode, can be different from the one which was set by setIOMode().
+        //!
+        IOMode actualIOMode() const { return _active_mode; }
+
         //!
         //! Abort any currenly read/write operation in progress.
         //! The file is left in a broken state and can be only closed.
@@ -197,10 +240,21 @@ namespace ts {
         bool          _rewindable = false;   //!< Opened in rewindable mode
         bool          _regular = false;      //!< Is a regular file (ie. not a pipe or special device)
         bool          _std_inout = false;    //!< File is standard input or output.
+        IOMode        _io_mode = IOMode::STANDARD;      //!< Requested I/O mode.
+        IOMode        _active_mode = IOMode::STANDARD;  //!< Actual I/O mode of the open file.
+        size_t        _async_requests = DEFAULT_ASYNC_REQUESTS;  //!< Number of in-flight requests with IOMode::ASYNC.
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle = INVALID_HANDLE_VALUE;
 #else
         int           _fd = -1;
+        uint8_t*      _map_base = nullptr;   //!< Base address of memory-mapped file.
+        uint64_t      _map_size = 0;         //!< Size of memory-mapped file.
+        uint64_t      _map_pos = 0;          //!< Current read offset in memory-mapped file.
+        uint64_t      _map_released = 0;     //!< Memory pages before this offset were released after read.
+#endif
+#if defined(TS_LINUX)
+        class AsyncIO;
+        std::unique_ptr<AsyncIO> _async {};  //!< Asynchronous I/O engine.
 #endif
 
         // Implementation of AbstractReadStreamInterface
@@ -219,6 +273,18 @@ namespace ts {
         bool seekCheck(Report& report);
         bool seekInternal(uint64_t index, Report& report);
 
+        // Start and stop the I/O mode of the open file.
+        void startIOMode(Report& report);
+        bool stopIOMode(Report& report);
+
+#if !defined(TS_WINDOWS)
+        // Memory-mapped input file.
+        static constexpr uint64_t MAP_RELEASE_SIZE = 16 * 1024 * 1024;  // Size of released chunks after read.
+        bool mapFile(Report& report);
+        void unmapFile();
+        bool readMapped(void* addr, size_t max_size, size_t& ret_size, Report& report);
+#endif
+
         // Inaccessible operations. Same as TS_NOCOPY() except that we keep the move constructor (required for vectors).
         TSFile(const TSFile&) = delete;
         TSFile& operator=(const TSFile&) = delete;
@@ -38,6 +38,11 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"If several input files are specified, several options --add-stop-stuffing are allowed. "
               u"If there are less options than input files, the last value is used for subsequent files.");
 
+    args.option(u"async-io");
+    args.help(u"async-io",
+              u"Read regular files using asynchronous I/O with several requests in progress (Linux io_uring only). "
+              u"When asynchronous I/O is not supported, the files are read as usual.");
+
     args.option(u"byte-offset", 'b', Args::UNSIGNED);
     args.help(u"byte-offset",
               u"Start reading each file at the specified byte offset (default: 0). "
@@ -70,6 +75,13 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"For a given file, if the computed label is above the maximum (" +
               UString::Decimal(TSPacketLabelSet::MAX) + u"), its packets are not labelled.");
 
+    args.option(u"mmap");
+    args.help(u"mmap",
+              u"Read regular files by mapping them in memory, with sequential read-ahead (UNIX systems only). "
+              u"This reduces the number of system calls when reading large files. "
+              u"The files must not be truncated while they are read. "
+              u"On other types of files, or when memory mapping is not supported, the files are read as usual.");
+
     args.option(u"packet-offset", 'p', Args::UNSIGNED);
     args.help(u"packet-offset",
               u"Start reading each file at the specified TS packet (default: 0). "
@@ -98,6 +110,7 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValues(_start_stuffing, u"add-start-stuffing");
     args.getIntValues(_stop_stuffing, u"add-stop-stuffing");
     _file_format = LoadTSPacketFormatInputOption(args);
+    _io_mode = args.present(u"mmap") ? TSFile::IOMode::MMAP : (args.present(u"async-io") ? TSFile::IOMode::ASYNC : TSFile::IOMode::STANDARD);
 
     // If there is no file, then this is the standard input, an empty file name.
     if (_filenames.empty()) {
@@ -116,6 +129,10 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"specifying --infinite is meaningless with more than one file");
         return false;
     }
+    if (args.present(u"mmap") && args.present(u"async-io")) {
+        args.error(u"--mmap and --async-io are mutually exclusive");
+        return false;
+    }
 
     // Make sure start and stop stuffing vectors have the same size as the file vector.
     // If the vectors must be enlarged, repeat the last value in the array.
@@ -142,8 +159,9 @@ bool ts::TSFileInputArgs::openFile(size_t name_index, size_t file_index, Report&
         report.verbose(u"reading file %s", name.empty() ? u"'stdin'" : name);
     }
 
-    // Preset artificial stuffing.
+    // Preset artificial stuffing and I/O mode.
     _files[file_index].setStuffing(_start_stuffing[name_index], _stop_stuffing[name_index]);
+    _files[file_index].setIOMode(_io_mode);
 
     // Actually open the file.
     return _files[file_index].openRead(name, _repeat_count, _start_offset, report, _file_format);
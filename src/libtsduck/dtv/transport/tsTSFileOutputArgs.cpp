@@ -48,6 +48,11 @@ void ts::TSFileOutputArgs::defineArgs(Args& args)
     args.option(u"append", 'a');
     args.help(u"append", u"If the file already exists, append to the end of the file. By default, existing files are overwritten.");
 
+    args.option(u"async-io");
+    args.help(u"async-io",
+              u"Write regular files using asynchronous I/O with several requests in progress (Linux io_uring only). "
+              u"When asynchronous I/O is not supported, the files are written as usual.");
+
     args.option(u"keep", 'k');
     args.help(u"keep", u"Keep existing file (abort if the specified file already exists). By default, existing files are overwritten.");
 
@@ -111,6 +116,7 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(_max_size, u"max-size", 0);
     args.getChronoValue(_max_duration, u"max-duration", 0);
     _file_format = LoadTSPacketFormatOutputOption(args);
+    _io_mode = args.present(u"async-io") ? TSFile::IOMode::ASYNC : TSFile::IOMode::STANDARD;
     _multiple_files = _max_size > 0 || _max_duration > cn::seconds::zero();
 
     _flags = TSFile::WRITE | TSFile::SHARED;
@@ -152,6 +158,7 @@ bool ts::TSFileOutputArgs::open(Report& report, AbortInterface* abort)
     _next_open_time = Time::CurrentUTC();
     _current_files.clear();
     _file.setStuffing(_start_stuffing, _stop_stuffing);
+    _file.setIOMode(_io_mode);
     size_t retry_allowed = _retry_max == 0 ? std::numeric_limits<size_t>::max() : _retry_max;
     return openAndRetry(false, retry_allowed, report, abort);
 }
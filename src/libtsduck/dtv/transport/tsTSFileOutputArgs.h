@@ -89,6 +89,7 @@ namespace ts {
         fs::path          _name {};
         TSFile::OpenFlags _flags = TSFile::NONE;
         TSPacketFormat    _file_format = TSPacketFormat::TS;
+        TSFile::IOMode    _io_mode = TSFile::IOMode::STANDARD;
         bool              _reopen = false;
         cn::milliseconds  _retry_interval = DEFAULT_RETRY_INTERVAL;
         size_t            _retry_max = 0;
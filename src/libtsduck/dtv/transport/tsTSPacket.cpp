@@ -12,6 +12,12 @@
 #include "tsBuffer.h"
 #include "tsNames.h"
 
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
 
 //----------------------------------------------------------------------------
 // This constant is a null (or stuffing) packet.
@@ -974,37 +980,21 @@ bool ts::TSPacket::Locate(const uint8_t* buffer, size_t buffer_size, size_t& sta
 
     // Restart from the beginning of the message. This covers the less usual cases where the message has
     // a trailer after the set of packets and the first packet may start anywhere inside the message.
-    const uint8_t* end = nullptr;
     if (packet_size != PKT_RS_SIZE) {
-        // Maybe 188-byte packets.
-        const uint8_t* const max188 = buffer_end - PKT_SIZE; // max address for a TS packet
-        for (ptr188 = buffer; ptr188 <= max188; ptr188++) {
-            if (*ptr188 == SYNC_BYTE) {
-                // Found something that could be the start of a TS packet. Verify that we get
-                // a 0x47 sync byte every 188 bytes up to the end of message (not leaving more
-                // than one truncated TS packet at the end of the message).
-                for (end = ptr188; end <= max188 && *end == SYNC_BYTE; end += PKT_SIZE) {}
-                if (end > max188) {
-                    // End is after the start of the last possible packet.
-                    // So, there are less than 188 bytes left in buffer after last packet.
-                    // Consider that we have found a valid suite of packets.
-                    count188 = (end - ptr188) / PKT_SIZE;
-                    break;
-                }
-            }
+        // Maybe 188-byte packets. Find the first 0x47 sync byte which is repeated every 188 bytes
+        // up to the end of message (not leaving more than one truncated TS packet at the end).
+        const size_t index = FindSync(buffer, buffer_size, PKT_SIZE, 0, NPOS);
+        if (index != NPOS) {
+            ptr188 = buffer + index;
+            count188 = (buffer_size - index) / PKT_SIZE;
         }
     }
     if (packet_size != PKT_SIZE && buffer_size >= PKT_RS_SIZE) {
         // Maybe 204-byte packets. Use same method.
-        const uint8_t* const max204 = buffer_end - PKT_RS_SIZE;
-        for (ptr204 = buffer; ptr204 <= max204; ptr204++) {
-            if (*ptr204 == SYNC_BYTE) {
-                for (end = ptr204; end <= max204 && *end == SYNC_BYTE; end += PKT_RS_SIZE) {}
-                if (end > max204) {
-                    count204 = (end - ptr204) / PKT_RS_SIZE;
-                    break;
-                }
-            }
+        const size_t index = FindSync(buffer, buffer_size, PKT_RS_SIZE, 0, NPOS);
+        if (index != NPOS) {
+            ptr204 = buffer + index;
+            count204 = (buffer_size - index) / PKT_RS_SIZE;
         }
     }
 
@@ -1028,6 +1018,86 @@ bool ts::TSPacket::Locate(const uint8_t* buffer, size_t buffer_size, size_t& sta
 }
 
 
+//----------------------------------------------------------------------------
+// Find the first sequence of contiguous TS packets in a buffer.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacket::FindSync(const uint8_t* buffer, size_t buffer_size, size_t packet_size, size_t header_size, size_t min_packets)
+{
+    if (buffer == nullptr || packet_size < header_size + 1 || min_packets == 0 || buffer_size < packet_size) {
+        return NPOS;
+    }
+
+    // Check if all expected sync bytes are present from a given index.
+    // Return false if there is not enough space for the packets.
+    const auto check = [&](size_t index) -> bool {
+        const size_t count = min_packets == NPOS ? (buffer_size - index) / packet_size : min_packets;
+        if (count == 0 || index + count * packet_size > buffer_size) {
+            return false;
+        }
+        for (const uint8_t* p = buffer + index + header_size; p < buffer + index + count * packet_size; p += packet_size) {
+            if (*p != SYNC_BYTE) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Last possible index for the first packet.
+    const size_t min_size = min_packets == NPOS ? packet_size : min_packets * packet_size;
+    if (min_packets != NPOS && (min_packets > buffer_size / packet_size || min_size > buffer_size)) {
+        return NPOS;
+    }
+    const size_t last = buffer_size - min_size;
+    size_t index = 0;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    // Vectorized pre-selection of 16 candidates at a time: look for a sync byte at the first
+    // packet and, when there are at least two packets, at the second packet. Then, fully check
+    // each candidate. On random data, the probability of a false candidate is 2^-16 per byte.
+    // With min_packets == NPOS, the last candidates have only one complete packet, followed by
+    // a trailing partial one. They have no second sync byte and are left to the portable loop.
+    const size_t second = min_packets >= 2 ? packet_size : 0;
+    const size_t simd_size = min_packets == NPOS ? 2 * packet_size : min_size;
+    const size_t simd_last = buffer_size >= simd_size ? buffer_size - simd_size : 0;
+    while (buffer_size >= simd_size && index + 15 <= simd_last && index + 15 + header_size + second < buffer_size) {
+        const uint8_t* const p = buffer + index + header_size;
+    #if defined(__SSE2__)
+        const __m128i sync = _mm_set1_epi8(char(SYNC_BYTE));
+        const __m128i v = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), sync),
+                                        _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + second)), sync));
+        uint32_t mask = uint32_t(_mm_movemask_epi8(v));
+    #else
+        const uint8x16_t sync = vdupq_n_u8(SYNC_BYTE);
+        const uint8x16_t v = vandq_u8(vceqq_u8(vld1q_u8(p), sync), vceqq_u8(vld1q_u8(p + second), sync));
+        uint32_t mask = 0;
+        if (vmaxvq_u8(v) != 0) {
+            for (size_t i = 0; i < 16; ++i) {
+                mask |= p[i] == SYNC_BYTE && p[i + second] == SYNC_BYTE ? (1 << i) : 0;
+            }
+        }
+    #endif
+        while (mask != 0) {
+            const size_t i = size_t(std::countr_zero(mask));
+            if (check(index + i)) {
+                return index + i;
+            }
+            mask &= mask - 1;
+        }
+        index += 16;
+    }
+#endif
+
+    // Portable version or remaining candidates.
+    for (; index <= last; ++index) {
+        if (buffer[index + header_size] == SYNC_BYTE && check(index)) {
+            return index;
+        }
+    }
+    return NPOS;
+}
+
+
 //----------------------------------------------------------------------------
 // Error message fragment indicating the number of packets previously
 // read in a binary file
@@ -845,6 +845,25 @@ namespace ts {
         //!
         static bool Locate(const uint8_t* buffer, size_t buffer_size, size_t& start_index, size_t& packet_count, size_t& packet_size);
 
+        //!
+        //! Find the first sequence of contiguous TS packets in a buffer.
+        //!
+        //! The buffer is scanned for 0x47 sync bytes which are repeated at the expected packet interval.
+        //! When SIMD instructions are available (SSE2 on Intel, Neon on Arm), 16 candidate positions are
+        //! checked at a time. This method is typically used to resynchronize corrupted captures.
+        //!
+        //! @param [in] buffer Address of a buffer containing TS packets.
+        //! @param [in] buffer_size Size in bytes of the buffer.
+        //! @param [in] packet_size Size in bytes of each packet, including optional header and trailer.
+        //! Typical values are PKT_SIZE (188), PKT_RS_SIZE (204) and PKT_M2TS_SIZE (192).
+        //! @param [in] header_size Size in bytes of an optional header before each TS packet,
+        //! for instance M2TS_HEADER_SIZE (4) for M2TS files.
+        //! @param [in] min_packets Minimum number of contiguous complete packets to find.
+        //! If NPOS, all complete packets up to the end of the buffer must be valid.
+        //! @return Index in the buffer of the first packet (including its header) or NPOS if not found.
+        //!
+        static size_t FindSync(const uint8_t* buffer, size_t buffer_size, size_t packet_size = PKT_SIZE, size_t header_size = 0, size_t min_packets = 2);
+
         //!
         //! Sanity check routine.
         //! Ensure that the TSPacket structure can
@@ -0,0 +1,292 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tshlsSegmentPrefetcher.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::hls::SegmentPrefetcher::SegmentPrefetcher(Report& report) :
+    _report(report)
+{
+}
+
+ts::hls::SegmentPrefetcher::~SegmentPrefetcher()
+{
+    stop();
+}
+
+ts::hls::SegmentPrefetcher::WorkerThread::~WorkerThread()
+{
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Start the background downloads.
+//----------------------------------------------------------------------------
+
+bool ts::hls::SegmentPrefetcher::start(const PlayList& playlist, const WebRequestArgs& args, size_t download_count, size_t max_queued, size_t max_segments)
+{
+    if (isStarted()) {
+        _report.error(u"HLS segment prefetcher already started");
+        return false;
+    }
+    if (!playlist.isMedia()) {
+        _report.error(u"invalid HLS playlist type, expected a media playlist");
+        return false;
+    }
+
+    download_count = std::max<size_t>(1, download_count);
+    _args = args;
+    _max_queued = std::max(download_count, max_queued);
+    _max_segments = max_segments;
+    _playlist = playlist;
+
+    // Load the initial list of segments.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _aborted = false;
+        _completed = false;
+        _added_segments = 0;
+        _slots.clear();
+        addSegments();
+        _completed = !_playlist.isUpdatable() || (_max_segments > 0 && _added_segments >= _max_segments);
+    }
+    _report.debug(u"starting %d HLS segment downloads, max %d queued segments, %d initial segments", download_count, _max_queued, _slots.size());
+
+    // Start the threads: one reloader (if necessary) and the downloaders.
+    if (!_completed) {
+        _threads.push_back(std::make_unique<WorkerThread>(this, true));
+    }
+    for (size_t i = 0; i < download_count; ++i) {
+        _threads.push_back(std::make_unique<WorkerThread>(this, false));
+    }
+    bool success = true;
+    for (const auto& thread : _threads) {
+        success = thread->start() && success;
+    }
+    if (!success) {
+        _report.error(u"error starting HLS segment download threads");
+        stop();
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Abort all downloads and playlist reloads.
+//----------------------------------------------------------------------------
+
+void ts::hls::SegmentPrefetcher::abort()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _aborted = true;
+    for (auto request : _requests) {
+        request->abort();
+    }
+    _cond.notify_all();
+}
+
+
+//----------------------------------------------------------------------------
+// Abort all downloads and wait for the termination of all threads.
+//----------------------------------------------------------------------------
+
+void ts::hls::SegmentPrefetcher::stop()
+{
+    abort();
+    // The destructor of the threads waits for their termination.
+    _threads.clear();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _slots.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next media segment, in playlist order.
+//----------------------------------------------------------------------------
+
+bool ts::hls::SegmentPrefetcher::getNextSegment(ByteBlock& data, MediaSegment& segment)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Wait until the next segment is downloaded or there will be no more segment.
+    _cond.wait(lock, [this]() {
+        return _aborted || (_slots.empty() && _completed) || (!_slots.empty() && (_slots.front()->state == State::DONE || _slots.front()->state == State::FAILED));
+    });
+    if (_aborted || _slots.empty()) {
+        return false;
+    }
+
+    // Remove the segment from the queue, this frees one slot for the next downloads.
+    const SlotPtr slot(_slots.front());
+    _slots.pop_front();
+    _cond.notify_all();
+
+    segment = slot->segment;
+    data.swap(slot->data);
+    return slot->state == State::DONE;
+}
+
+
+//----------------------------------------------------------------------------
+// Move all segments from the playlist to the queue of segments to download.
+//----------------------------------------------------------------------------
+
+size_t ts::hls::SegmentPrefetcher::addSegments()
+{
+    size_t count = 0;
+    MediaSegment seg;
+    while ((_max_segments == 0 || _added_segments < _max_segments) && _playlist.popFirstSegment(seg)) {
+        _slots.push_back(std::make_shared<Slot>(seg));
+        _added_segments++;
+        count++;
+    }
+    if (count > 0) {
+        _cond.notify_all();
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the first segment to download.
+//----------------------------------------------------------------------------
+
+ts::hls::SegmentPrefetcher::SlotPtr ts::hls::SegmentPrefetcher::nextDownload() const
+{
+    // Only the first _max_queued segments can be downloaded, this bounds the memory usage.
+    for (size_t i = 0; i < _slots.size() && i < _max_queued; ++i) {
+        if (_slots[i]->state == State::WAITING) {
+            return _slots[i];
+        }
+    }
+    return nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Background threads.
+//----------------------------------------------------------------------------
+
+void ts::hls::SegmentPrefetcher::WorkerThread::main()
+{
+    if (_reloader) {
+        _parent->reloadMain();
+    }
+    else {
+        _parent->downloadMain();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Segment download thread.
+//----------------------------------------------------------------------------
+
+void ts::hls::SegmentPrefetcher::downloadMain()
+{
+    WebRequest request(_report);
+    request.setArgs(_args);
+    request.setAutoRedirect(true);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _requests.insert(&request);
+
+    for (;;) {
+        // Wait for a segment to download. Segments are downloaded in order: when the last one
+        // is no longer waiting and the playlist is completed, there is nothing more to do.
+        SlotPtr slot;
+        _cond.wait(lock, [this, &slot]() {
+            return _aborted || (slot = nextDownload()) != nullptr || (_completed && (_slots.empty() || _slots.back()->state != State::WAITING));
+        });
+        if (_aborted || slot == nullptr) {
+            // The playlist is completed and there is no more segment to download.
+            break;
+        }
+        slot->state = State::DOWNLOADING;
+
+        // Download the segment without holding the mutex.
+        ByteBlock data;
+        lock.unlock();
+        const bool success = download(request, slot->segment, data);
+        lock.lock();
+
+        slot->data.swap(data);
+        slot->state = success ? State::DONE : State::FAILED;
+        _cond.notify_all();
+    }
+
+    _requests.erase(&request);
+}
+
+
+//----------------------------------------------------------------------------
+// Download one segment in memory.
+//----------------------------------------------------------------------------
+
+bool ts::hls::SegmentPrefetcher::download(WebRequest& request, const MediaSegment& segment, ByteBlock& data)
+{
+    const UString url(segment.urlString());
+    _report.debug(u"downloading segment %s", url);
+
+    if (segment.url.isValid() && !segment.url.getScheme().similar(u"file")) {
+        request.enableCookies(_args.cookiesFile);
+        return request.downloadBinaryContent(url, data);
+    }
+    else {
+        return data.loadFromFile(segment.file_path, std::numeric_limits<size_t>::max(), &_report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Playlist reload thread.
+//----------------------------------------------------------------------------
+
+void ts::hls::SegmentPrefetcher::reloadMain()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_aborted && !_completed) {
+
+        // Wait until there is some free space in the queue of segments.
+        _cond.wait(lock, [this]() { return _aborted || _slots.size() < _max_queued; });
+        if (_aborted) {
+            break;
+        }
+
+        // Reload the playlist without holding the mutex. Errors are ignored, the reload is retried later.
+        lock.unlock();
+        const bool success = _playlist.reload(false, _args, _report);
+        lock.lock();
+
+        const size_t count = success ? addSegments() : 0;
+        if (success && (!_playlist.isUpdatable() || (_max_segments > 0 && _added_segments >= _max_segments))) {
+            _completed = true;
+        }
+        else if (count == 0) {
+            // No new segment or reload error. For live streams, new segments can be produced as late as the estimated
+            // end time of the previous playlist. When all segments are already delivered, stop after that time.
+            if (_slots.empty() && Time::CurrentUTC() > _playlist.terminationUTC()) {
+                _completed = true;
+            }
+            else {
+                // The wait between two retries is half the target duration of a segment, with a minimum of 2 seconds.
+                _cond.wait_for(lock, std::max<cn::milliseconds>(cn::seconds(2), _playlist.targetDuration() / 2), [this]() { return _aborted; });
+            }
+        }
+    }
+
+    _report.debug(u"HLS playlist reload completed, %d segments", _added_segments);
+    _completed = true;
+    _cond.notify_all();
+}
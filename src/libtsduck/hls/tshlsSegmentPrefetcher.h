@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Background download of HLS media segments.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tshlsPlayList.h"
+#include "tsWebRequestArgs.h"
+#include "tsWebRequest.h"
+#include "tsByteBlock.h"
+#include "tsThread.h"
+
+namespace ts::hls {
+    //!
+    //! Background download of HLS media segments.
+    //! @ingroup libtsduck hls
+    //!
+    //! The media segments of a media playlist are downloaded by several concurrent threads,
+    //! ahead of their use. The downloaded segments are kept in memory and delivered in
+    //! playlist order. The number of segments in memory, being downloaded or waiting to be
+    //! delivered, is bounded.
+    //!
+    //! Live playlists are reloaded by another thread, as long as new segments are produced.
+    //!
+    //! Media segments which are accessed by file path (no URL) are read from the file system.
+    //!
+    class TSDUCKDLL SegmentPrefetcher
+    {
+        TS_NOBUILD_NOCOPY(SegmentPrefetcher);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors. This object must be thread-safe.
+        //!
+        SegmentPrefetcher(Report& report);
+
+        //!
+        //! Destructor.
+        //! All background threads are stopped.
+        //!
+        ~SegmentPrefetcher();
+
+        //!
+        //! Start the background downloads.
+        //! @param [in] playlist A media playlist. The segments are downloaded starting at the first
+        //! segment in the playlist. A copy of the playlist is kept and reloaded when necessary.
+        //! @param [in] args Web request arguments for segment downloads and playlist reloads.
+        //! @param [in] download_count Number of concurrent segment downloads.
+        //! @param [in] max_queued Maximum number of segments in memory, being downloaded or
+        //! waiting to be delivered by getNextSegment(). When lower than @a download_count,
+        //! @a download_count is used.
+        //! @param [in] max_segments Maximum number of segments to deliver. Zero means unlimited.
+        //! @return True on success, false on error (already started, not a media playlist).
+        //!
+        bool start(const PlayList& playlist, const WebRequestArgs& args, size_t download_count, size_t max_queued, size_t max_segments = 0);
+
+        //!
+        //! Get the next media segment, in playlist order.
+        //! Wait until the segment is downloaded.
+        //! @param [out] data Content of the media segment.
+        //! @param [out] segment Description of the media segment.
+        //! @return True on success, false at end of playlist, on download error or after abort().
+        //!
+        bool getNextSegment(ByteBlock& data, MediaSegment& segment);
+
+        //!
+        //! Abort all downloads and playlist reloads.
+        //! Pending and future calls to getNextSegment() fail.
+        //! Can be called from another thread.
+        //!
+        void abort();
+
+        //!
+        //! Abort all downloads and wait for the termination of all background threads.
+        //! The prefetcher can be restarted after stop().
+        //!
+        void stop();
+
+        //!
+        //! Check if the background downloads are started.
+        //! @return True if the background downloads are started.
+        //!
+        bool isStarted() const { return !_threads.empty(); }
+
+    private:
+        // State of a media segment.
+        enum class State {WAITING, DOWNLOADING, DONE, FAILED};
+
+        // Description of a media segment to download.
+        class Slot
+        {
+            TS_NOCOPY(Slot);
+        public:
+            Slot(const MediaSegment& seg) : segment(seg) {}
+            MediaSegment segment;
+            State        state = State::WAITING;
+            ByteBlock    data {};
+        };
+        using SlotPtr = std::shared_ptr<Slot>;
+
+        // Background thread, either a segment downloader or the playlist reloader.
+        class WorkerThread : public Thread
+        {
+            TS_NOBUILD_NOCOPY(WorkerThread);
+        public:
+            WorkerThread(SegmentPrefetcher* parent, bool reloader) : _parent(parent), _reloader(reloader) {}
+            virtual ~WorkerThread() override;
+        private:
+            SegmentPrefetcher* _parent;
+            bool               _reloader;
+            virtual void main() override;
+        };
+        using WorkerThreadPtr = std::unique_ptr<WorkerThread>;
+
+        // Thread entry points.
+        void downloadMain();
+        void reloadMain();
+
+        // Download one segment in memory.
+        bool download(WebRequest& request, const MediaSegment& segment, ByteBlock& data);
+
+        // Move all segments from the playlist to the queue of segments to download.
+        // Must be called with the mutex held. Return the number of added segments.
+        size_t addSegments();
+
+        // Get the first segment to download, nullptr if there is none. Must be called with the mutex held.
+        SlotPtr nextDownload() const;
+
+        // Private fields.
+        Report&                      _report;
+        WebRequestArgs               _args {};
+        size_t                       _max_queued = 0;
+        size_t                       _max_segments = 0;
+        std::vector<WorkerThreadPtr> _threads {};
+        PlayList                     _playlist {};  // Only used by the reloader thread after start().
+        std::mutex                   _mutex {};
+        std::condition_variable      _cond {};      // Signaled each time the state of the prefetcher changes.
+        // -- start of protected area --
+        bool                         _aborted = false;
+        bool                         _completed = false;   // No more segment will be added.
+        size_t                       _added_segments = 0;  // Total number of segments which were added in _slots.
+        std::deque<SlotPtr>          _slots {};            // Segments in playlist order, the first one is the next to deliver.
+        std::set<WebRequest*>        _requests {};         // Active web requests, to abort.
+        // -- end of protected area --
+    };
+}
@@ -49,6 +49,7 @@ bool ts::InputSwitcher::start(const InputSwitcherArgs& args)
 
     // Keep command line options for further use.
     _args = args;
+    _mergeStats.clear();
     _args.enforceDefaults();
 
     // Debug message.
@@ -126,6 +127,16 @@ void ts::InputSwitcher::stop()
     }
 }
 
+void ts::InputSwitcher::getMergeStatistics(MergeStatisticsVector& stats)
+{
+    if (_core != nullptr) {
+        _core->getMergeStatistics(stats);
+    }
+    else {
+        stats = _mergeStats;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Internal and unconditional cleanupp of resources.
@@ -140,8 +151,9 @@ void ts::InputSwitcher::internalCleanup()
         _remote = nullptr;
     }
 
-    // Then, terminate the core.
+    // Then, terminate the core. Keep the final statistics.
     if (_core != nullptr) {
+        _core->getMergeStatistics(_mergeStats);
         delete _core;
         _core = nullptr;
     }
@@ -95,6 +95,31 @@ namespace ts {
         //!
         void stop();
 
+        //!
+        //! Statistics of one input plugin in merge mode (option @c -\-merge).
+        //!
+        class TSDUCKDLL MergeStatistics
+        {
+        public:
+            PacketCounter received = 0;    //!< Number of packets which were received from this input.
+            PacketCounter output = 0;      //!< Number of packets which were output from this input, because it delivered them first.
+            PacketCounter duplicates = 0;  //!< Number of packets which were dropped because they were already output from another input.
+            PacketCounter late = 0;        //!< Number of packets which were dropped because they were lost on other inputs and received too late.
+            PacketCounter lost = 0;        //!< Number of packets which were output from another input but never received from this one.
+        };
+
+        //!
+        //! Vector of statistics, one per input plugin.
+        //!
+        using MergeStatisticsVector = std::vector<MergeStatistics>;
+
+        //!
+        //! Get the statistics of all input plugins in merge mode (option @c -\-merge).
+        //! After the termination of the input switcher, the final statistics are returned.
+        //! @param [out] stats Statistics, one per input plugin. Empty when not in merge mode.
+        //!
+        void getMergeStatistics(MergeStatisticsVector& stats);
+
         //!
         //! Suspend the calling thread until input switcher is completed.
         //!
@@ -124,6 +149,7 @@ namespace ts {
         tsswitch::Core*            _core = nullptr;
         tsswitch::CommandListener* _remote = nullptr;
         volatile bool              _success = false;
+        MergeStatisticsVector      _mergeStats {};  // Final statistics in merge mode.
 
         // Internal and unconditional cleanupp of resources.
         void internalCleanup();
@@ -31,6 +31,9 @@ void ts::InputSwitcherArgs::enforceDefaults()
     bufferedPackets = std::max(bufferedPackets, MIN_BUFFERED_PACKETS);
     maxInputPackets = std::max(maxInputPackets, MIN_INPUT_PACKETS);
     maxOutputPackets = std::max(maxOutputPackets, MIN_OUTPUT_PACKETS);
+    if (mergeWindow == 0) {
+        mergeWindow = DEFAULT_MERGE_WINDOW;
+    }
 }
 
 
@@ -129,6 +132,26 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
               u"Specify the maximum number of TS packets to write at a time. "
               u"The default is " + UString::Decimal(DEFAULT_MAX_OUTPUT_PACKETS) + u" packets.");
 
+    args.option(u"merge", 'm');
+    args.help(u"merge",
+              u"Seamlessly merge redundant inputs. All input plugins are started at once and "
+              u"they are supposed to receive the same transport stream through distinct paths, "
+              u"with independent packet losses. The input streams are aligned using the content "
+              u"of the TS packets. Each packet is output once, from the input which delivered it "
+              u"first. A packet which is lost on one input is recovered from another input, "
+              u"without switching delay. Statistics about lost packets on each input are reported "
+              u"at the end of the processing.\n\n"
+              u"Input switching options and commands are not allowed with --merge. "
+              u"The processing terminates when all input plugins have terminated or, "
+              u"with --terminate, when one input plugin terminates.");
+
+    args.option(u"merge-window", 0, Args::POSITIVE);
+    args.help(u"merge-window", u"count",
+              u"With --merge, specify the size in TS packets of the alignment window. "
+              u"This is the maximum delay between two inputs which can be merged. "
+              u"A packet which was not received from an input within this window is counted as lost on that input. "
+              u"The default is " + UString::Decimal(DEFAULT_MERGE_WINDOW) + u" packets.");
+
     args.option(u"primary-input", 'p', Args::UNSIGNED);
     args.help(u"primary-input",
               u"Specify the index of the input plugin which is considered as primary "
@@ -150,7 +173,11 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
               u"this timeout, automatically switch to the next plugin. "
               u"By default, without --primary-input, there is no automatic switch "
               u"when the current input plugin is waiting for packets. With "
-              u"--primary-input, the default is " + UString::Chrono(DEFAULT_RECEIVE_TIMEOUT, true) + u".");
+              u"--primary-input, the default is " + UString::Chrono(DEFAULT_RECEIVE_TIMEOUT, true) + u".\n\n"
+              u"With --merge, an input plugin which has received no packet within this timeout no longer "
+              u"delays the output of the packets from the other input plugins, until it receives packets again. "
+              u"With --merge, the default is " + UString::Chrono(DEFAULT_MERGE_TIMEOUT, true) + u". "
+              u"Use --receive-timeout 0 to always wait for all input plugins, within the limit of --merge-window.");
 
     args.option(u"remote", 'r', Args::IPSOCKADDR_OA);
     args.help(u"remote",
@@ -176,17 +203,19 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
     appName = args.appName();
     fastSwitch = args.present(u"fast-switch");
     delayedSwitch = args.present(u"delayed-switch");
+    merge = args.present(u"merge");
     terminate = args.present(u"terminate");
     args.getIntValue(cycleCount, u"cycle", args.present(u"infinite") ? 0 : 1);
     args.getIntValue(bufferedPackets, u"buffer-packets", DEFAULT_BUFFERED_PACKETS);
     maxInputPackets = std::min(args.intValue<size_t>(u"max-input-packets", DEFAULT_MAX_INPUT_PACKETS), bufferedPackets / 2);
     args.getIntValue(maxOutputPackets, u"max-output-packets", DEFAULT_MAX_OUTPUT_PACKETS);
+    args.getIntValue(mergeWindow, u"merge-window", DEFAULT_MERGE_WINDOW);
     args.getSocketValue(remoteServer, u"remote");
     reusePort = !args.present(u"no-reuse-port");
     args.getIntValue(sockBuffer, u"udp-buffer-size");
     args.getIntValue(firstInput, u"first-input", 0);
     args.getIntValue(primaryInput, u"primary-input", NPOS);
-    args.getChronoValue(receiveTimeout, u"receive-timeout", primaryInput >= inputs.size() ? cn::milliseconds::zero() : DEFAULT_RECEIVE_TIMEOUT);
+    args.getChronoValue(receiveTimeout, u"receive-timeout", primaryInput < inputs.size() ? DEFAULT_RECEIVE_TIMEOUT : (merge ? DEFAULT_MERGE_TIMEOUT : cn::milliseconds::zero()));
 
     // Event reporting.
     args.getValue(eventCommand, u"event-command");
@@ -202,6 +231,11 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
     if (fastSwitch && delayedSwitch) {
         args.error(u"options --delayed-switch and --fast-switch are mutually exclusive");
     }
+    if (merge && (fastSwitch || delayedSwitch || args.present(u"cycle") || args.present(u"infinite") ||
+                  args.present(u"first-input") || args.present(u"primary-input")))
+    {
+        args.error(u"options --cycle, --delayed-switch, --fast-switch, --first-input, --infinite, --primary-input are not allowed with --merge");
+    }
 
     // Resolve all allowed remote.
     const size_t allow_count = args.count(u"allow");
@@ -234,5 +268,9 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"invalid input index for --primary-input %d", primaryInput);
     }
 
+    if (merge && inputs.size() > MAX_MERGE_INPUTS) {
+        args.error(u"too many input plugins with --merge, maximum is %d", MAX_MERGE_INPUTS);
+    }
+
     return args.valid();
 }
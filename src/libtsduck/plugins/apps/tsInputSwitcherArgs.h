@@ -30,6 +30,7 @@ namespace ts {
         UString             appName {};            //!< Application name, for help messages.
         bool                fastSwitch = false;    //!< Fast switch between input plugins.
         bool                delayedSwitch = false; //!< Delayed switch between input plugins.
+        bool                merge = false;         //!< Seamless merge of redundant input plugins.
         bool                terminate = false;     //!< Terminate when one input plugin completes.
         bool                reusePort = false;     //!< Reuse-port socket option.
         size_t              firstInput = 0;        //!< Index of first input plugin.
@@ -38,6 +39,7 @@ namespace ts {
         size_t              bufferedPackets = 0;   //!< Input buffer size in packets.
         size_t              maxInputPackets = 0;   //!< Maximum input packets to read at a time.
         size_t              maxOutputPackets = 0;  //!< Maximum output packets to send at a time.
+        size_t              mergeWindow = 0;       //!< Size in packets of the alignment window in merge mode.
         UString             eventCommand {};       //!< External shell command to run on an event.
         IPSocketAddress     eventUDP {};           //!< Remote UDP socket address for event description.
         IPAddress           eventLocalAddress {};  //!< Outgoing local interface for UDP event description.
@@ -46,7 +48,7 @@ namespace ts {
         size_t              sockBuffer = 0;        //!< Socket buffer size.
         IPSocketAddress     remoteServer {};       //!< UDP server address for remote control.
         IPAddressSet        allowedRemote {};      //!< Set of allowed remotes.
-        cn::milliseconds    receiveTimeout {};     //!< Receive timeout before switch (0=none).
+        cn::milliseconds    receiveTimeout {};     //!< Receive timeout before switch or before an input becomes idle in merge mode (0=none).
         PluginOptionsVector inputs {};             //!< Input plugins descriptions.
         PluginOptions       output {};             //!< Output plugin description.
 
@@ -56,7 +58,10 @@ namespace ts {
         static constexpr size_t MIN_OUTPUT_PACKETS = 1;           //!< Minimum input packets to send at a time.
         static constexpr size_t DEFAULT_BUFFERED_PACKETS = 512;   //!< Default input size buffer in packets.
         static constexpr size_t MIN_BUFFERED_PACKETS = 16;        //!< Minimum input size buffer in packets.
+        static constexpr size_t DEFAULT_MERGE_WINDOW = 10000;     //!< Default size in packets of the alignment window in merge mode.
+        static constexpr size_t MAX_MERGE_INPUTS = 64;            //!< Maximum number of input plugins in merge mode.
         static constexpr cn::milliseconds DEFAULT_RECEIVE_TIMEOUT = cn::milliseconds(2000); //!< Default received timeout with --primary-input.
+        static constexpr cn::milliseconds DEFAULT_MERGE_TIMEOUT = cn::milliseconds(100);    //!< Default received timeout on the command line with --merge.
 
         //!
         //! Constructor.
@@ -156,8 +156,20 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
             }
         } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
 
+        // The packet buffer is allocated on the NUMA node of the input plugin, or the first plugin with a NUMA node.
+        size_t numa_node = NPOS;
+        proc = _input;
+        do {
+            ThreadAttributes attr;
+            proc->getAttributes(attr);
+            numa_node = attr.getNUMANode();
+        } while (numa_node == NPOS && (proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
+        if (numa_node != NPOS) {
+            _report.debug(u"tsp: allocating buffer on NUMA node %d", numa_node);
+        }
+
         // Allocate a memory-resident buffer of TS packets
-        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE);
+        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE, numa_node);
         CheckNonNull(_packet_buffer);
         if (!_packet_buffer->isLocked()) {
             _report.debug(u"tsp: buffer failed to lock into physical memory (%d: %s), risk of real-time issue",
@@ -167,7 +179,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
 
         // Buffer for the packet metadata.
         // A packet and its metadata have the same index in their respective buffer.
-        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count());
+        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count(), numa_node);
         CheckNonNull(_metadata_buffer);
 
         // End of locked section.
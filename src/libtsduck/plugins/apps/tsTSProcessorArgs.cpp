@@ -114,6 +114,15 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"a valid bitrate value from the beginning. "
               u"The default initial load is half the size of the global buffer.");
 
+    args.option(u"lock-free");
+    args.help(u"lock-free",
+              u"Use a lock-free hand-off of packets between adjacent plugins. "
+              u"By default, all plugins synchronize the access to the global buffer using one single global lock. "
+              u"With this option, each plugin only synchronizes with the previous and next plugins in the chain. "
+              u"A plugin which waits for packets first polls for a short period of time before being suspended. "
+              u"This option reduces the contention on large chains of plugins at high bitrates, "
+              u"at the expense of some additional CPU usage when the stream is idle.");
+
     args.option(u"log-plugin-index");
     args.help(u"log-plugin-index",
               u"In log messages, add the plugin index to the plugin name. "
@@ -168,6 +177,7 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
 {
     app_name = args.appName();
     log_plugin_index = args.present(u"log-plugin-index");
+    lock_free = args.present(u"lock-free");
     ts_buffer_size = args.intValue<size_t>(u"buffer-size-mb", DEFAULT_BUFFER_SIZE);
     args.getValue(fixed_bitrate, u"bitrate", 0);
     args.getChronoValue(bitrate_adj, u"bitrate-adjust-interval", DEFAULT_BITRATE_INTERVAL);
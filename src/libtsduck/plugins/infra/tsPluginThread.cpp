@@ -9,6 +9,7 @@
 #include "tsPluginThread.h"
 #include "tsPluginRepository.h"
 #include "tsEnvironment.h"
+#include "tsNUMA.h"
 
 
 //----------------------------------------------------------------------------
@@ -83,6 +84,12 @@ ts::PluginThread::PluginThread(Report* report, const UString& appName, PluginTyp
     attr.setName(_name);
     attr.setStackSize(stackSize);
     attr.setExitOnException(true);
+
+    // Optional CPU affinity and NUMA node. Non-existent CPU's or nodes are ignored by the system.
+    _shlib->getThreadPlacement(attr);
+    if (attr.getNUMANode() != NPOS && attr.getNUMANode() >= NUMANodeCount()) {
+        report->warning(u"%s: NUMA node %d does not exist, there are %d nodes", _name, attr.getNUMANode(), NUMANodeCount());
+    }
     Thread::setAttributes(attr);
 }
 
@@ -195,7 +195,7 @@ namespace ts {
         BitRate           _tsp_bitrate = 0;          //!< TSP input bitrate.
         BitRateConfidence _tsp_bitrate_confidence = BitRateConfidence::LOW;  //!< TSP input bitrate confidence.
         cn::milliseconds  _tsp_timeout = cn::milliseconds(-1); //!< Timeout when waiting for packets, infinite if negative.
-        volatile bool     _tsp_aborting = false;     //!< TSP is currently aborting.
+        std::atomic<bool> _tsp_aborting {false};     //!< TSP is currently aborting, read by adjacent plugin threads.
 
         //!
         //! Constructor for subclasses.
@@ -20,13 +20,16 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
                                                              const UString& syntax,
                                                              const UString& system_time_name,
                                                              const UString& system_time_description,
-                                                             TSDatagramInputOptions options) :
+                                                             TSDatagramInputOptions options,
+                                                             size_t max_datagrams) :
     InputPlugin(tsp_, description, syntax),
     _options(options),
     // Ensure at least 7 204-byte packets.
-    _inbuf(std::max(buffer_size, 7 * PKT_RS_SIZE)),
-    // Resize metadata based on 188-byte packets (max number of packets for that buffer).
-    _mdata(_inbuf.size() / PKT_SIZE)
+    _datagram_size(std::max(buffer_size, 7 * PKT_RS_SIZE)),
+    _max_datagrams(std::max<size_t>(max_datagrams, 1)),
+    _inbuf(_datagram_size * _max_datagrams),
+    // Resize metadata based on 188-byte packets (max number of packets for one datagram).
+    _mdata(_datagram_size / PKT_SIZE)
 {
     if (bool(_options & TSDatagramInputOptions::REAL_TIME)) {
         option<cn::seconds>(u"display-interval", 'd');
@@ -109,7 +112,8 @@ bool ts::AbstractDatagramInputPlugin::getOptions()
 bool ts::AbstractDatagramInputPlugin::start()
 {
     // Initialize working data.
-    _inbuf_count = _inbuf_next = _mdata_next = 0;
+    _inbuf_count = _inbuf_next = _mdata_next = _datagram_next = 0;
+    _datagrams.clear();
     _start = _start_0 = _start_1 = _next_display = Time::Epoch;
     _packets = _packets_0 = _packets_1 = 0;
 
@@ -152,91 +156,152 @@ ts::BitRateConfidence ts::AbstractDatagramInputPlugin::getBitrateConfidence()
 
 
 //----------------------------------------------------------------------------
-// Input method
+// Receive several datagrams. Default implementation, one datagram at a time.
 //----------------------------------------------------------------------------
 
-size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+bool ts::AbstractDatagramInputPlugin::receiveDatagrams(uint8_t* buffer, size_t datagram_size, size_t max_datagrams, DatagramVector& datagrams, TimeSource& timesource)
 {
-    cn::microseconds timestamp = cn::microseconds(-1);
-    TimeSource timesource = TimeSource::UNDEFINED;
+    datagrams.resize(1);
+    Datagram& dg(datagrams.front());
+    dg.offset = 0;
+    dg.timestamp = cn::microseconds(-1);
+    if (!receiveDatagram(buffer, datagram_size, dg.size, dg.timestamp, timesource)) {
+        datagrams.clear();
+        return false;
+    }
+    return true;
+}
 
-    // Check if we receive new packets or process remain of previous buffer.
-    bool new_packets = false;
 
-    // If there is no remaining packet in the input buffer, wait for a datagram message.
-    // Loop until we get some TS packets.
-    while (_inbuf_count == 0) {
+//----------------------------------------------------------------------------
+// Process the next datagram: locate TS packets, build metadata.
+//----------------------------------------------------------------------------
 
-        // Wait for a datagram message
-        size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp, timesource)) {
-            return 0;
-        }
+bool ts::AbstractDatagramInputPlugin::nextDatagram(TimeSource timesource)
+{
+    assert(_datagram_next < _datagrams.size());
+    const Datagram& dg(_datagrams[_datagram_next++]);
+    const uint8_t* const data = _inbuf.data() + dg.offset;
+    const cn::microseconds timestamp = dg.timestamp;
+
+    // Look for TS packets in the UDP message.
+    if (!TSPacket::Locate(data, dg.size, _inbuf_next, _inbuf_count, _packet_size)) {
+        // No TS packet found in UDP message.
+        debug(u"no TS packet in message, %s bytes", dg.size);
+        _inbuf_count = 0;
+        return false;
+    }
+
+    assert(_packet_size == PKT_SIZE || _packet_size == PKT_RS_SIZE);
+
+    // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
+    // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
+    const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (data[1] & 0x7F) == RTP_PT_MP2T;
+    const ts::rtp_units rtp_timestamp = ts::rtp_units(rtp ? GetUInt32(data + 4) : 0);
+
+    // Make _inbuf_next an index in the complete input buffer.
+    _inbuf_next += dg.offset;
+
+    // Use RTP time stamp if there is one and RTP is the preferred choice.
+    bool use_rtp = false;
+    bool use_kernel = false;
+    switch (_time_priority) {
+        case RTP_SYSTEM_TSP:
+            use_rtp = rtp;
+            use_kernel = !rtp && timestamp >= cn::microseconds::zero();
+            break;
+        case SYSTEM_RTP_TSP:
+            use_kernel = timestamp >= cn::microseconds::zero();
+            use_rtp = !use_kernel && rtp;
+            break;
+        case RTP_TSP:
+            use_rtp = rtp;
+            use_kernel = false;
+            break;
+        case SYSTEM_TSP:
+            use_kernel = timestamp >= cn::microseconds::zero();
+            use_rtp = false;
+            break;
+        case TSP_ONLY:
+        default:
+            use_rtp = false;
+            use_kernel = false;
+            break;
+    }
 
-        // Look for TS packets in the UDP message.
-        new_packets = TSPacket::Locate(_inbuf.data(), insize, _inbuf_next, _inbuf_count, _packet_size);
+    // Build time stamps in packet metadata.
+    _mdata_next = 0;
+    for (size_t i = 0; i < _inbuf_count; ++i) {
+        TSPacketMetadata& md(_mdata[i]);
+        md.reset();
+        if (use_rtp) {
+            md.setInputTimeStamp(rtp_timestamp, TimeSource::RTP);
+        }
+        else if (use_kernel) {
+            md.setInputTimeStamp(timestamp, timesource);
+        }
+        // Copy 204-byte trailer in metadata.
+        if (_packet_size == PKT_RS_SIZE) {
+            md.setAuxData(_inbuf.data() + _inbuf_next + i * PKT_RS_SIZE + PKT_SIZE, RS_SIZE);
+        }
+    }
+    return true;
+}
 
-        if (new_packets) {
-            assert(_packet_size == PKT_SIZE || _packet_size == PKT_RS_SIZE);
 
-            // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
-            // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
-            const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (_inbuf[1] & 0x7F) == RTP_PT_MP2T;
-            const ts::rtp_units rtp_timestamp = ts::rtp_units(rtp ? GetUInt32(_inbuf.data() + 4) : 0);
+//----------------------------------------------------------------------------
+// Input method
+//----------------------------------------------------------------------------
 
-            // Use RTP time stamp if there is one and RTP is the preferred choice.
-            bool use_rtp = false;
-            bool use_kernel = false;
-            switch (_time_priority) {
-                case RTP_SYSTEM_TSP:
-                    use_rtp = rtp;
-                    use_kernel = !rtp && timestamp >= cn::microseconds::zero();
-                    break;
-                case SYSTEM_RTP_TSP:
-                    use_kernel = timestamp >= cn::microseconds::zero();
-                    use_rtp = !use_kernel && rtp;
-                    break;
-                case RTP_TSP:
-                    use_rtp = rtp;
-                    use_kernel = false;
-                    break;
-                case SYSTEM_TSP:
-                    use_kernel = timestamp >= cn::microseconds::zero();
-                    use_rtp = false;
-                    break;
-                case TSP_ONLY:
-                default:
-                    use_rtp = false;
-                    use_kernel = false;
+size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    // Number of returned packets and number of packets from new datagrams.
+    size_t pkt_cnt = 0;
+    size_t new_packets = 0;
+
+    // Fill the caller's buffer with packets from as many datagrams as possible.
+    // Wait for new datagrams only when nothing can be returned.
+    while (pkt_cnt < max_packets) {
+
+        // If there is no remaining packet from the current datagram, move to the next one.
+        if (_inbuf_count == 0) {
+            if (_datagram_next >= _datagrams.size()) {
+                // All received datagrams were processed.
+                if (pkt_cnt > 0) {
+                    // Don't wait for more datagrams, return what we have.
                     break;
-            }
-
-            // Build time stamps in packet metadata.
-            _mdata_next = 0;
-            for (size_t i = 0; i < _inbuf_count; ++i) {
-                TSPacketMetadata& md(_mdata[i]);
-                md.reset();
-                if (use_rtp) {
-                    md.setInputTimeStamp(rtp_timestamp, TimeSource::RTP);
                 }
-                else if (use_kernel) {
-                    md.setInputTimeStamp(timestamp, timesource);
+                // Wait for at least one datagram message.
+                _datagram_next = 0;
+                _timesource = TimeSource::UNDEFINED;
+                if (_max_datagrams > 1) {
+                    if (!receiveDatagrams(_inbuf.data(), _datagram_size, _max_datagrams, _datagrams, _timesource)) {
+                        return 0;
+                    }
                 }
-                // Copy 204-byte trailer in metadata.
-                if (_packet_size == PKT_RS_SIZE) {
-                    md.setAuxData(_inbuf.data() + _inbuf_next + i * PKT_RS_SIZE + PKT_SIZE, RS_SIZE);
+                else if (!AbstractDatagramInputPlugin::receiveDatagrams(_inbuf.data(), _datagram_size, 1, _datagrams, _timesource)) {
+                    return 0;
                 }
             }
-
-            break; // found packets.
+            // Loop until we get some TS packets.
+            if (!nextDatagram(_timesource)) {
+                continue;
+            }
+            new_packets += _inbuf_count;
         }
 
-        // No TS packet found in UDP message, wait for another one.
-        debug(u"no TS packet in message, %s bytes", insize);
+        // Return packets from the input buffer
+        const size_t count = std::min(_inbuf_count, max_packets - pkt_cnt);
+        TSPacket::Copy(buffer + pkt_cnt, _inbuf.data() + _inbuf_next, count, _packet_size);
+        TSPacketMetadata::Copy(pkt_data + pkt_cnt, &_mdata[_mdata_next], count);
+        _inbuf_count -= count;
+        _inbuf_next += count * _packet_size;
+        _mdata_next += count;
+        pkt_cnt += count;
     }
 
     // If new packets were received, we may need to re-evaluate the real-time input bitrate.
-    if (new_packets && bool(_options & TSDatagramInputOptions::REAL_TIME) && _eval_time > cn::milliseconds::zero()) {
+    if (new_packets > 0 && bool(_options & TSDatagramInputOptions::REAL_TIME) && _eval_time > cn::milliseconds::zero()) {
 
         const Time now(Time::CurrentUTC());
 
@@ -249,9 +314,9 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
         }
 
         // Count packets
-        _packets += _inbuf_count;
-        _packets_0 += _inbuf_count;
-        _packets_1 += _inbuf_count;
+        _packets += new_packets;
+        _packets_0 += new_packets;
+        _packets_1 += new_packets;
 
         // Detect new evaluation period
         if (now >= _start_1 + _eval_time) {
@@ -275,13 +340,5 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
         }
     }
 
-    // Return packets from the input buffer
-    size_t pkt_cnt = std::min(_inbuf_count, max_packets);
-    TSPacket::Copy(buffer, _inbuf.data() + _inbuf_next, pkt_cnt, _packet_size);
-    TSPacketMetadata::Copy(pkt_data, &_mdata[_mdata_next], pkt_cnt);
-    _inbuf_count -= pkt_cnt;
-    _inbuf_next += pkt_cnt * _packet_size;
-    _mdata_next += pkt_cnt;
-
     return pkt_cnt;
 }
@@ -62,6 +62,7 @@ namespace ts {
         //! which is used in option -\-timestamp-priority. When empty, there is no timestamps from the subclass.
         //! @param [in] system_time_description Description of @a system_time_name for help text.
         //! @param [in] options Bitmak of input options.
+        //! @param [in] max_datagrams Maximum number of datagrams to receive at a time, see receiveDatagrams().
         //!
         AbstractDatagramInputPlugin(TSP* tsp,
                                     size_t buffer_size,
@@ -69,7 +70,26 @@ namespace ts {
                                     const UString& syntax,
                                     const UString& system_time_name,
                                     const UString& system_time_description,
-                                    TSDatagramInputOptions options = TSDatagramInputOptions::NONE);
+                                    TSDatagramInputOptions options = TSDatagramInputOptions::NONE,
+                                    size_t max_datagrams = 1);
+
+        //!
+        //! Description of a received datagram in a batch of datagrams.
+        //! @see receiveDatagrams()
+        //!
+        class Datagram
+        {
+        public:
+            Datagram() = default;              //!< Constructor.
+            size_t           offset = 0;       //!< Offset of the datagram in the reception buffer.
+            size_t           size = 0;         //!< Size in bytes of the datagram.
+            cn::microseconds timestamp {-1};   //!< Receive timestamp in micro-seconds or -1 if not available.
+        };
+
+        //!
+        //! Vector of received datagram descriptions.
+        //!
+        using DatagramVector = std::vector<Datagram>;
 
         //!
         //! Receive a datagram message.
@@ -83,6 +103,22 @@ namespace ts {
         //!
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource) = 0;
 
+        //!
+        //! Receive several datagram messages at once.
+        //! The default implementation receives one single datagram using receiveDatagram().
+        //! Subclasses which can receive several datagrams in one system call should override this method.
+        //! It is called only when the subclass constructor specified more than one datagram at a time.
+        //! @param [out] buffer Address of the buffer for the received messages.
+        //! @param [in] datagram_size Maximum size in bytes of each datagram.
+        //! Each datagram starts at a multiple of @a datagram_size in @a buffer.
+        //! @param [in] max_datagrams Maximum number of datagrams to receive.
+        //! The size of @a buffer is @a datagram_size * @a max_datagrams bytes.
+        //! @param [out] datagrams Description of the received datagrams.
+        //! @param [out] timesource Type of timestamp.
+        //! @return True on success, false on error. On success, at least one datagram shall be returned.
+        //!
+        virtual bool receiveDatagrams(uint8_t* buffer, size_t datagram_size, size_t max_datagrams, DatagramVector& datagrams, TimeSource& timesource);
+
     private:
         // Order of priority for input timestamps. SYSTEM means lower layer from subclass (UDP, SRT, etc).
         enum TimePriority {RTP_SYSTEM_TSP, SYSTEM_RTP_TSP, RTP_TSP, SYSTEM_TSP, TSP_ONLY};
@@ -96,6 +132,9 @@ namespace ts {
         TimePriority     _default_time_priority = RTP_TSP; // Priority of time stamps sources.
         bool             _rs204_format = false;            // Input packets are always 204-byte format.
 
+        // Process the next datagram in _datagrams: locate TS packets, build metadata. Return false if no packet found.
+        bool nextDatagram(TimeSource timesource);
+
         // Working data.
         Time          _next_display {};     // Next bitrate display time
         Time          _start {};            // UTC date of first received packet
@@ -104,11 +143,16 @@ namespace ts {
         PacketCounter _packets_0 = 0;       // Number of received packets since _start_0
         Time          _start_1 {};          // Start of previous bitrate evaluation period
         PacketCounter _packets_1 = 0;       // Number of received packets since _start_1
-        size_t        _inbuf_count = 0;     // Number of remaining TS packets in inbuf
+        size_t        _inbuf_count = 0;     // Number of remaining TS packets in current datagram
         size_t        _inbuf_next = 0;      // Byte index in _inbuf of next TS packet to return
         size_t        _mdata_next = 0;      // Index in _mdata of next TS packet metadata to return
         size_t        _packet_size = 0;     // Packet size (188 or 204).
-        ByteBlock     _inbuf {};            // Input buffer
-        TSPacketMetadataVector _mdata {};   // Metadata for packets in _inbuf
+        size_t        _datagram_size = 0;   // Max size of each datagram in _inbuf.
+        size_t        _max_datagrams = 1;   // Max number of datagrams in _inbuf.
+        size_t        _datagram_next = 0;   // Index in _datagrams of next datagram to process.
+        TimeSource    _timesource = TimeSource::UNDEFINED;  // Source of timestamps in _datagrams.
+        ByteBlock     _inbuf {};            // Input buffer, can contain up to _max_datagrams datagrams.
+        DatagramVector _datagrams {};       // Description of datagrams in _inbuf.
+        TSPacketMetadataVector _mdata {};   // Metadata for packets in current datagram
     };
 }
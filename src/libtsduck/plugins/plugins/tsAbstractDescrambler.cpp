@@ -51,6 +51,13 @@ ts::AbstractDescrambler::AbstractDescrambler(TSP* tsp_, const UString& descripti
          u"mode, the packet processing continues while processing ECM's. This option "
          u"is always on in offline mode.");
 
+    option(u"packet-window", 0, UNSIGNED);
+    help(u"packet-window", u"count",
+         u"Descramble packets by groups of 'count' packets. "
+         u"All packets of a group with the same control word are descrambled at once, which is much faster with DVB-CSA2. "
+         u"The default is " + UString::Decimal(DEFAULT_PACKET_WINDOW) + u" packets in offline mode. "
+         u"In real-time mode, the default is zero, meaning one packet at a time, to avoid adding latency.");
+
     option(u"swap-cw");
     help(u"swap-cw",
         u"Swap even and odd control words from the ECM's. "
@@ -69,6 +76,7 @@ bool ts::AbstractDescrambler::getOptions()
     _service.set(value(u""));
     _synchronous = present(u"synchronous") || !tsp->realtime();
     _swap_cw = present(u"swap-cw");
+    getIntValue(_window_size, u"packet-window", tsp->realtime() ? 0 : DEFAULT_PACKET_WINDOW);
     getIntValues(_pids, u"pid");
     if (!duck.loadArgs(*this) || !_scrambling.loadArgs(duck, *this)) {
         return false;
@@ -122,6 +130,8 @@ bool ts::AbstractDescrambler::start()
     _ecm_streams.clear();
     _scrambled_streams.clear();
     _demux.reset();
+    _batch_scrambling = nullptr;
+    _batch_packets.clear();
 
     // Initialize the scrambling engine.
     if (!_scrambling.start()) {
@@ -454,7 +464,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return !_pids.test(pid) || descramble(_scrambling, pkt) ? TSP_OK : TSP_END;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -476,7 +486,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return descramble(_scrambling, pkt) ? TSP_OK : TSP_END;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
@@ -505,7 +515,11 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // Flags new_cw_even/odd are "write-protected, read-volatile", no mutex needed.
     if ((scv == SC_EVEN_KEY && pecm->new_cw_even) || (scv == SC_ODD_KEY && pecm->new_cw_odd)) {
 
-        // A new CW was deciphered.
+        // A new CW was deciphered. Previous packets must be descrambled with the previous CW.
+        if (!flushBatch()) {
+            return TSP_END;
+        }
+
         // In asynchronous mode, the CW are accessed under mutex protection.
         if (!_synchronous) {
             _mutex.lock();
@@ -529,5 +543,57 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     }
 
     // Descramble the packet payload.
-    return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+    return descramble(pecm->scrambling, pkt) ? TSP_OK : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDescrambler::getPacketWindowSize()
+{
+    return _window_size;
+}
+
+size_t ts::AbstractDescrambler::processPacketWindow(TSPacketWindow& win)
+{
+    // Process packets in sequence, as in packet mode, but accumulate the packets to descramble.
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    for (size_t i = 0; i < win.size(); ++i) {
+        if (win.get(i, pkt, pkt_data) && processPacket(*pkt, *pkt_data) == TSP_END) {
+            flushBatch();
+            return i;
+        }
+    }
+    return flushBatch() ? win.size() : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Descramble a packet, immediately in packet mode or later in packet window mode.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::descramble(TSScrambling& scrambling, TSPacket& pkt)
+{
+    if (_window_size == 0) {
+        return scrambling.decrypt(pkt);
+    }
+    else if (_batch_scrambling != &scrambling && !flushBatch()) {
+        return false;
+    }
+    else {
+        _batch_scrambling = &scrambling;
+        _batch_packets.push_back(&pkt);
+        return true;
+    }
+}
+
+bool ts::AbstractDescrambler::flushBatch()
+{
+    const bool ok = _batch_scrambling == nullptr || _batch_scrambling->decryptBatch(_batch_packets.data(), _batch_packets.size());
+    _batch_scrambling = nullptr;
+    _batch_packets.clear();
+    return ok;
 }
@@ -36,7 +36,9 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     protected:
         //!
@@ -45,6 +47,12 @@ namespace ts {
         //!
         static constexpr size_t DEFAULT_ECM_THREAD_STACK_USAGE = 128 * 1024;
 
+        //!
+        //! Default packet window size in offline mode.
+        //! Packets are descrambled by groups of packets in the same window.
+        //!
+        static constexpr size_t DEFAULT_PACKET_WINDOW = 256;
+
         //!
         //! Constructor for subclasses.
         //! @param [in] tsp Object to communicate with the Transport Stream Processor main executable.
@@ -234,6 +242,12 @@ namespace ts {
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
+        // Descramble a packet, immediately in packet mode or later in packet window mode.
+        bool descramble(TSScrambling& scrambling, TSPacket& pkt);
+
+        // Descramble the pending batch of packets in packet window mode.
+        bool flushBatch();
+
         // Abstract descrambler private data.
         bool                    _use_service = false;         // Descramble a service (ie. not a specific list of PID's).
         bool                    _need_ecm = false;            // We need to get control words from ECM's.
@@ -244,12 +258,15 @@ namespace ts {
         PIDSet                  _pids {};                     // Explicit PID's to descramble.
         ServiceDiscovery        _service {duck, this};        // Service to descramble (by name, id or none).
         size_t                  _stack_usage;                 // Stack usage for ECM deciphering.
+        size_t                  _window_size = 0;             // Packet window size, zero in packet mode.
         SectionDemux            _demux {duck, nullptr, this}; // Section demux to extract ECM's.
         ECMStreamMap            _ecm_streams {};              // ECM streams, indexed by PID.
         ScrambledStreamMap      _scrambled_streams {};        // Scrambled streams, indexed by PID.
         std::mutex              _mutex {};                    // Exclusive access to protected areas
         std::condition_variable _ecm_to_do {};                // Notify thread to process ECM.
         ECMThread               _ecm_thread {this};           // Thread which deciphers ECM's.
+        TSScrambling*           _batch_scrambling = nullptr;  // Descrambler for the pending batch of packets.
+        std::vector<TSPacket*>  _batch_packets {};            // Pending batch of packets to descramble.
         // -- start of protected area --
         bool                    _stop_thread = false;         // Terminate ECM processing thread
         // -- end of protected area --
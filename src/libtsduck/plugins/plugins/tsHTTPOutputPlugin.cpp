@@ -14,6 +14,9 @@ TS_REGISTER_OUTPUT_PLUGIN(u"http", ts::HTTPOutputPlugin);
 
 #define SERVER_BACKLOG  1  // One connection at a time
 
+// Default buffer size per client with multiple concurrent clients.
+#define DEFAULT_CLIENT_BUFFER_SIZE (1024 * 1024)
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -24,8 +27,9 @@ ts::HTTPOutputPlugin::HTTPOutputPlugin(TSP* tsp_) :
 {
     setIntro(u"The implemented HTTP server is rudimentary. "
              u"No SSL/TLS is supported, only the http: protocol is accepted.\n\n"
-             u"Only one client is accepted at a time. "
-             u"By default, tsp terminates if the client disconnects (see option --multiple-clients).\n\n"
+             u"By default, only one client is accepted at a time and "
+             u"tsp terminates if the client disconnects (see option --multiple-clients). "
+             u"With option --max-clients, the plugin serves several clients concurrently.\n\n"
              u"The request \"GET /\" returns the transport stream content. "
              u"All other requests are considered as invalid (see option --ignore-bad-request). "
              u"There is no Content-Length response header since the size of the returned TS is unknown. "
@@ -35,14 +39,35 @@ ts::HTTPOutputPlugin::HTTPOutputPlugin(TSP* tsp_) :
     help(u"buffer-size",
          u"Specifies the TCP socket send buffer size to the client connection (socket option).");
 
+    option(u"client-buffer-size", 0, UNSIGNED);
+    help(u"client-buffer-size",
+         u"With --max-clients, specifies the size in bytes of the buffer of each client. "
+         u"The default is " + UString::Decimal(DEFAULT_CLIENT_BUFFER_SIZE) + u" bytes. "
+         u"When the packets from one output operation do not fit in the free part of the buffer of a client, "
+         u"the packets which fit are queued and only the other packets are subject to the slow client policy. "
+         u"When tsp outputs large sets of packets at once, for instance when reading a file at full speed, "
+         u"the buffer size shall be larger than the output sets of packets (see the tsp option --max-output-packets).");
+
     option(u"ignore-bad-request");
     help(u"ignore-bad-request",
          u"Ignore invalid HTTP requests and unconditionally send the transport stream.");
 
+    option(u"max-clients", 0, POSITIVE);
+    help(u"max-clients",
+         u"Serve up to the specified number of clients concurrently. "
+         u"Each client receives the same stream, starting when it connects. "
+         u"Additional clients are rejected. "
+         u"In this mode, the plugin never blocks on a client connection. "
+         u"Packets are sent at the pace of tsp and there is no regulation of the flow to the slowest client. "
+         u"Each client has its own buffer (see option --client-buffer-size). "
+         u"When the buffer of a client is full, the client is disconnected (see option --skip-slow-clients). "
+         u"The tsp session continues when no client is connected.");
+
     option(u"multiple-clients", 'm');
     help(u"multiple-clients",
          u"Specifies that the server handle multiple clients, one after the other. "
-         u"By default, the plugin terminates the tsp session when the first client disconnects.");
+         u"By default, the plugin terminates the tsp session when the first client disconnects. "
+         u"This option is incompatible with --max-clients.");
 
     option(u"no-reuse-port");
     help(u"no-reuse-port",
@@ -52,9 +77,14 @@ ts::HTTPOutputPlugin::HTTPOutputPlugin(TSP* tsp_) :
     help(u"server",
          u"Specifies the local TCP port on which the plugin listens for incoming HTTP connections. "
          u"This option is mandatory. "
-         u"This plugin accepts only one HTTP connection at a time. "
+         u"By default, this plugin accepts only one HTTP connection at a time (see option --max-clients). "
          u"When present, the optional address shall specify a local IP address or host name. "
          u"By default, the server listens on all local interfaces.");
+
+    option(u"skip-slow-clients");
+    help(u"skip-slow-clients",
+         u"With --max-clients, when the buffer of a client is full, drop packets for this client instead of disconnecting it. "
+         u"The client receives an incomplete stream.");
 }
 
 
@@ -69,6 +99,14 @@ bool ts::HTTPOutputPlugin::getOptions()
     _ignore_bad_request = present(u"ignore-bad-request");
     getSocketValue(_server_address, u"server");
     getIntValue(_tcp_buffer_size, u"buffer-size");
+    getIntValue(_max_clients, u"max-clients", 0);
+    getIntValue(_client_buffer_size, u"client-buffer-size", DEFAULT_CLIENT_BUFFER_SIZE);
+    _skip_slow_clients = present(u"skip-slow-clients");
+
+    if (_multiple_clients && _max_clients > 0) {
+        error(u"options --multiple-clients and --max-clients are mutually exclusive");
+        return false;
+    }
     return true;
 }
 
@@ -79,6 +117,21 @@ bool ts::HTTPOutputPlugin::getOptions()
 
 bool ts::HTTPOutputPlugin::start()
 {
+    // Multiple concurrent clients.
+    if (_max_clients > 0) {
+        TCPFanOutServer::Options opt;
+        opt.server_address = _server_address;
+        opt.reuse_port = _reuse_port;
+        opt.send_buffer_size = _tcp_buffer_size;
+        opt.max_clients = _max_clients;
+        opt.client_buffer_size = _client_buffer_size;
+        opt.data_unit = PKT_SIZE;
+        opt.skip_slow_clients = _skip_slow_clients;
+        opt.wait_request = true;
+        return _fanout.start(opt, *this);
+    }
+
+    // One client at a time.
     if (!_server.open(IP::Any, *this)) {
         return false;
     }
@@ -100,6 +153,14 @@ bool ts::HTTPOutputPlugin::start()
 
 bool ts::HTTPOutputPlugin::stop()
 {
+    if (_fanout.isStarted()) {
+        // Report final statistics, after all clients were disconnected.
+        _fanout.stop();
+        const TCPFanOutServer::Statistics stats(_fanout.statistics());
+        verbose(u"%'d clients, %'d rejected, %'d dropped, %'d bytes sent, %'d bytes skipped",
+                stats.accepted_clients, stats.rejected_clients, stats.dropped_clients, stats.bytes_sent, stats.bytes_skipped);
+        return true;
+    }
     if (_client.isConnected()) {
         _client.disconnect(*this);
     }
@@ -117,6 +178,12 @@ bool ts::HTTPOutputPlugin::stop()
 
 bool ts::HTTPOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
 {
+    // With multiple concurrent clients, never block.
+    if (_max_clients > 0) {
+        _fanout.send(buffer, packet_count * PKT_SIZE);
+        return true;
+    }
+
     // Loop over multiple clients if necessary.
     for (;;) {
         // Establish one client connection, if none is connected.
@@ -159,19 +226,6 @@ bool ts::HTTPOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata*
 }
 
 
-//----------------------------------------------------------------------------
-// Send a response header.
-//----------------------------------------------------------------------------
-
-bool ts::HTTPOutputPlugin::sendResponseHeader(const std::string& line)
-{
-    debug(u"response header: %s", line);
-    std::string data(line);
-    data += "\r\n";
-    return _client.send(data.data(), data.size(), *this);
-}
-
-
 //----------------------------------------------------------------------------
 // Process request headers, send response headers.
 //----------------------------------------------------------------------------
@@ -210,6 +264,19 @@ bool ts::HTTPOutputPlugin::startSession()
         }
     } while (!header.empty());
 
+    // Build and send the response headers.
+    std::string response;
+    const bool valid = buildResponse(request, response);
+    return _client.send(response.data(), response.size(), *this) && valid;
+}
+
+
+//----------------------------------------------------------------------------
+// Build the response headers to a request.
+//----------------------------------------------------------------------------
+
+bool ts::HTTPOutputPlugin::buildResponse(const UString& request, std::string& response)
+{
     // Expected request: "GET / HTTP/1.1"
     UStringVector fields;
     const UString empty;
@@ -221,17 +288,37 @@ bool ts::HTTPOutputPlugin::startSession()
 
     if (!valid && !_ignore_bad_request) {
         error(u"invalid client request: %s", request);
-        sendResponseHeader(is_get ? "HTTP/1.1 404 Not Found" : "HTTP/1.1 400 Bad Request");
-        sendResponseHeader("");
+        response = is_get ? "HTTP/1.1 404 Not Found\r\n" : "HTTP/1.1 400 Bad Request\r\n";
+        response += "\r\n";
         return false;
     }
     else {
-        // Send the HTTP response headers.
-        sendResponseHeader("HTTP/1.1 200 OK");
-        sendResponseHeader("Server: TSDuck/" TS_VERSION_STRING);
-        sendResponseHeader("Content-Type: video/mp2t");
-        sendResponseHeader("Connection: close");
-        sendResponseHeader("");
+        response = "HTTP/1.1 200 OK\r\n"
+                   "Server: TSDuck/" TS_VERSION_STRING "\r\n"
+                   "Content-Type: video/mp2t\r\n"
+                   "Connection: close\r\n"
+                   "\r\n";
+        debug(u"response headers: %s", response);
         return true;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Process a client request with multiple concurrent clients.
+//----------------------------------------------------------------------------
+
+ts::HTTPOutputPlugin::FanOutServer::~FanOutServer()
+{
+    stop();
+}
+
+bool ts::HTTPOutputPlugin::FanOutServer::processRequest(const IPSocketAddress& client, const std::string& request, std::string& response)
+{
+    // The first line is the request, the other lines are headers.
+    UString line;
+    line.assignFromUTF8(request.substr(0, request.find('\n')));
+    line.trim();
+    _plugin.debug(u"request from %s: %s", client, line);
+    return _plugin.buildResponse(line, response);
+}
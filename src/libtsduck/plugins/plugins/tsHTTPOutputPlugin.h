@@ -15,6 +15,7 @@
 #include "tsOutputPlugin.h"
 #include "tsTCPServer.h"
 #include "tsTCPConnection.h"
+#include "tsTCPFanOutServer.h"
 
 namespace ts {
     //!
@@ -38,15 +39,32 @@ namespace ts {
         bool            _multiple_clients = false;
         bool            _ignore_bad_request = false;
         size_t          _tcp_buffer_size = 0;
+        size_t          _max_clients = 0;
+        size_t          _client_buffer_size = 0;
+        bool            _skip_slow_clients = false;
+
+        // Server for multiple concurrent clients.
+        class FanOutServer : public TCPFanOutServer
+        {
+            TS_NOBUILD_NOCOPY(FanOutServer);
+        public:
+            FanOutServer(HTTPOutputPlugin& plugin) : _plugin(plugin) {}
+            virtual ~FanOutServer() override;
+        protected:
+            virtual bool processRequest(const IPSocketAddress& client, const std::string& request, std::string& response) override;
+        private:
+            HTTPOutputPlugin& _plugin;
+        };
 
         // Working data:
         TCPServer     _server {};
         TCPConnection _client {};
+        FanOutServer  _fanout {*this};
 
         // Process request headers from new client, send response headers.
         bool startSession();
 
-        // Send a response header.
-        bool sendResponseHeader(const std::string& line);
+        // Build the response headers to a request. Return true if the request is valid.
+        bool buildResponse(const UString& request, std::string& response);
     };
 }
@@ -20,7 +20,8 @@ TS_REGISTER_INPUT_PLUGIN(u"ip", ts::IPInputPlugin);
 ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
     AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port",
                                 u"kernel", u"A kernel-provided time-stamp for the packet, when available (Linux only)",
-                                TSDatagramInputOptions::REAL_TIME | TSDatagramInputOptions::ALLOW_RS204)
+                                TSDatagramInputOptions::REAL_TIME | TSDatagramInputOptions::ALLOW_RS204,
+                                MAX_DATAGRAMS)
 {
     // Add UDP receiver common options.
     _sock_args.defineArgs(*this, true, true);
@@ -98,3 +99,24 @@ bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, siz
     timesource = TimeSource::KERNEL; // could be HARDWARE if generated by NIC, but no way to know
     return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *this, &timestamp);
 }
+
+
+//----------------------------------------------------------------------------
+// Multiple datagrams reception method.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::receiveDatagrams(uint8_t* buffer, size_t datagram_size, size_t max_datagrams, DatagramVector& datagrams, TimeSource& timesource)
+{
+    timesource = TimeSource::KERNEL;
+    datagrams.clear();
+    if (!_sock.receiveMultiple(buffer, datagram_size, max_datagrams, _messages, tsp, *this)) {
+        return false;
+    }
+    datagrams.resize(_messages.size());
+    for (size_t i = 0; i < _messages.size(); ++i) {
+        datagrams[i].offset = _messages[i].offset;
+        datagrams[i].size = _messages[i].size;
+        datagrams[i].timestamp = _messages[i].timestamp;
+    }
+    return true;
+}
@@ -34,9 +34,19 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource) override;
+        virtual bool receiveDatagrams(uint8_t* buffer, size_t datagram_size, size_t max_datagrams, DatagramVector& datagrams, TimeSource& timesource) override;
 
     private:
         UDPReceiverArgs _sock_args {};
         UDPReceiver     _sock {*tsp};
+        UDPReceiver::ReceivedMessageVector _messages {};
+
+        // Maximum number of datagrams to receive at a time.
+        // On Linux, they are received using one single system call.
+#if defined(TS_LINUX)
+        static constexpr size_t MAX_DATAGRAMS = 32;
+#else
+        static constexpr size_t MAX_DATAGRAMS = 1;
+#endif
     };
 }
@@ -35,6 +35,34 @@ ts::Plugin::Plugin(TSP* to_tsp, const UString& description, const UString& synta
 {
     // Force messages to go through tsp
     delegateReport(tsp);
+
+    // These options are defined in all plugins.
+    option(u"cpu", 0, INTEGER, 0, UNLIMITED_COUNT, 0, MAX_CPU);
+    help(u"cpu", u"cpu1[-cpu2]",
+         u"Run the thread of this plugin only on the specified CPU cores (starting at zero). "
+         u"Several --cpu options may be specified. "
+         u"This is a generic option which is defined in all plugins.");
+
+    option(u"numa-node", 0, INTEGER, 0, 1, 0, MAX_CPU);
+    help(u"numa-node",
+         u"Run the thread of this plugin on the CPU cores of the specified NUMA node and allocate its memory from that node. "
+         u"When --cpu is also specified, use the specified CPU cores which belong to the node. "
+         u"This is a generic option which is defined in all plugins.");
+}
+
+
+//----------------------------------------------------------------------------
+// Get the content of the --cpu and --numa-node options.
+//----------------------------------------------------------------------------
+
+void ts::Plugin::getThreadPlacement(ThreadAttributes& attributes) const
+{
+    std::set<size_t> cpus;
+    size_t node = NPOS;
+    getIntValues(cpus, u"cpu");
+    getIntValue(node, u"numa-node", NPOS);
+    attributes.setCPUs(cpus);
+    attributes.setNUMANode(node);
 }
 
 
@@ -18,6 +18,7 @@
 #include "tsTSPacketMetadata.h"
 #include "tsNames.h"
 #include "tsDuckContext.h"
+#include "tsThreadAttributes.h"
 
 namespace ts {
     //!
@@ -56,6 +57,11 @@ namespace ts {
         //!
         static constexpr size_t DEFAULT_STACK_USAGE = 128 * 1024;
 
+        //!
+        //! Maximum CPU core or NUMA node index in options --cpu and --numa-node.
+        //!
+        static constexpr size_t MAX_CPU = 1023;
+
         //!
         //! Define the maximum stack usage for the thread executing the plugin.
         //! If the method is not implemented by a subclass, the default value
@@ -166,6 +172,13 @@ namespace ts {
         //!
         void resetContext(const DuckContext::SavedArgs& state);
 
+        //!
+        //! Get the content of the generic options --cpu and --numa-node.
+        //! These options are defined in all plugins.
+        //! @param [in,out] attributes Thread attributes to update with the CPU affinity and NUMA node of the plugin.
+        //!
+        void getThreadPlacement(ThreadAttributes& attributes) const;
+
     protected:
         TSP* const  tsp;   //!< The TSP callback structure can be directly accessed by subclasses.
         DuckContext duck;  //!< The TSDuck context with various MPEG/DVB features.
@@ -101,6 +101,20 @@ ts::hls::InputPlugin::InputPlugin(TSP* tsp_) :
          u"When the URL is a master playlist, select a content the resolution of which has a "
          u"lower height than the specified maximum.");
 
+    option(u"prefetch", 0, POSITIVE);
+    help(u"prefetch", u"count",
+         u"Download up to the specified number of media segments concurrently, in background threads, "
+         u"ahead of their processing. Live playlists are also reloaded in a background thread. "
+         u"Thus, a slow segment download does not stall the processing of the previous segments. "
+         u"The segments are still passed to the next plugin in playlist order. "
+         u"By default, the media segments are downloaded one at a time, while being passed to the next plugin.");
+
+    option(u"prefetch-queue", 0, POSITIVE);
+    help(u"prefetch-queue", u"count",
+         u"With --prefetch, specify the maximum number of media segments in memory, being downloaded or "
+         u"waiting to be passed to the next plugin. "
+         u"The default is twice the --prefetch value.");
+
     option(u"save-files", 0, DIRECTORY);
     help(u"save-files",
          u"Specify a directory where all downloaded files, media segments and playlists, are saved "
@@ -146,7 +160,7 @@ bool ts::hls::InputPlugin::isRealTime()
 bool ts::hls::InputPlugin::getOptions()
 {
     _url.setURL(value(u""));
-    const UString saveDirectory(value(u"save-files"));
+    getValue(_saveDirectory, u"save-files");
     getIntValue(_maxSegmentCount, u"segment-count");
     getValue(_minRate, u"min-bitrate");
     getValue(_maxRate, u"max-bitrate");
@@ -155,6 +169,8 @@ bool ts::hls::InputPlugin::getOptions()
     getIntValue(_minHeight, u"min-height");
     getIntValue(_maxHeight, u"max-height");
     getIntValue(_startSegment, u"start-segment");
+    getIntValue(_prefetchCount, u"prefetch", 0);
+    getIntValue(_prefetchQueue, u"prefetch-queue", 2 * _prefetchCount);
     _lowestRate = present(u"lowest-bitrate");
     _highestRate = present(u"highest-bitrate");
     _lowestRes = present(u"lowest-resolution");
@@ -206,9 +222,14 @@ bool ts::hls::InputPlugin::getOptions()
         return false;
     }
 
+    if (present(u"prefetch-queue") && _prefetchQueue < _prefetchCount) {
+        error(u"--prefetch-queue must not be lower than --prefetch");
+        return false;
+    }
+
     // Automatically save media segments and playlists.
-    setAutoSaveDirectory(saveDirectory);
-    _playlist.setAutoSaveDirectory(saveDirectory);
+    setAutoSaveDirectory(_saveDirectory);
+    _playlist.setAutoSaveDirectory(_saveDirectory);
 
     return true;
 }
@@ -351,6 +372,13 @@ bool ts::hls::InputPlugin::start()
 
     _segmentCount = 0;
 
+    // With prefetch, all segments are downloaded by background threads.
+    if (_prefetchCount > 0) {
+        _segmentData.clear();
+        _segmentOffset = 0;
+        return _prefetcher.start(_playlist, webArgs, _prefetchCount, _prefetchQueue, _maxSegmentCount);
+    }
+
     // Invoke superclass.
     return AbstractHTTPInputPlugin::start();
 }
@@ -362,6 +390,10 @@ bool ts::hls::InputPlugin::start()
 
 bool ts::hls::InputPlugin::stop()
 {
+    // Stop background downloads, if any.
+    _prefetcher.stop();
+    _segmentData.clear();
+
     // Invoke superclass first.
     const bool stopped = AbstractHTTPInputPlugin::stop();
 
@@ -370,6 +402,60 @@ bool ts::hls::InputPlugin::stop()
 }
 
 
+//----------------------------------------------------------------------------
+// Input abort method
+//----------------------------------------------------------------------------
+
+bool ts::hls::InputPlugin::abortInput()
+{
+    _prefetcher.abort();
+    return AbstractHTTPInputPlugin::abortInput();
+}
+
+
+//----------------------------------------------------------------------------
+// Input method
+//----------------------------------------------------------------------------
+
+size_t ts::hls::InputPlugin::receive(TSPacket* buffer, TSPacketMetadata* metadata, size_t maxPackets)
+{
+    // Without prefetch, the superclass downloads one segment at a time.
+    if (_prefetchCount == 0) {
+        return AbstractHTTPInputPlugin::receive(buffer, metadata, maxPackets);
+    }
+
+    // Get the next prefetched segment when the current one is exhausted.
+    while (_segmentOffset + PKT_SIZE > _segmentData.size()) {
+        if (_segmentOffset < _segmentData.size()) {
+            warning(u"dropping %d trailing bytes at end of segment", _segmentData.size() - _segmentOffset);
+        }
+        _segmentData.clear();
+        _segmentOffset = 0;
+        hls::MediaSegment seg;
+        if (tsp->aborting() || !_prefetcher.getNextSegment(_segmentData, seg)) {
+            verbose(u"HLS playlist completed");
+            return 0;
+        }
+        _segmentCount++;
+        debug(u"got segment %s, %'d bytes", seg.urlString(), _segmentData.size());
+
+        // Save the segment in a file if required. Display errors but do not fail, this is just auto save.
+        const UString name(BaseName(seg.file_path));
+        if (!_saveDirectory.empty() && !name.empty()) {
+            const UString path(_saveDirectory + fs::path::preferred_separator + name);
+            verbose(u"saving input TS to %s", path);
+            _segmentData.saveToFile(path, this);
+        }
+    }
+
+    // Return as many complete packets as possible from the current segment.
+    const size_t count = std::min(maxPackets, (_segmentData.size() - _segmentOffset) / PKT_SIZE);
+    MemCopy(buffer, _segmentData.data() + _segmentOffset, count * PKT_SIZE);
+    _segmentOffset += count * PKT_SIZE;
+    return count;
+}
+
+
 //----------------------------------------------------------------------------
 // Called by AbstractHTTPInputPlugin to open an URL.
 //----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #pragma once
 #include "tsAbstractHTTPInputPlugin.h"
 #include "tshlsPlayList.h"
+#include "tshlsSegmentPrefetcher.h"
 #include "tsURL.h"
 
 namespace ts {
@@ -34,6 +35,8 @@ namespace ts {
             virtual bool start() override;
             virtual bool stop() override;
             virtual bool isRealTime() override;
+            virtual bool abortInput() override;
+            virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
 
         protected:
             // Implementation of AbstractHTTPInputPlugin
@@ -60,10 +63,16 @@ namespace ts {
             UString  _altName {};
             UString  _altGroupId {};
             UString  _altLanguage {};
+            UString  _saveDirectory {};
+            size_t   _prefetchCount = 0;
+            size_t   _prefetchQueue = 0;
 
             // Working data:
             size_t   _segmentCount = 0;
             PlayList _playlist {};
+            SegmentPrefetcher _prefetcher {*this};  // Background downloads, when _prefetchCount > 0.
+            ByteBlock _segmentData {};              // Current prefetched segment.
+            size_t   _segmentOffset = 0;            // Next packet to read in _segmentData.
         };
     }
 }
@@ -23,7 +23,8 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
                                         Report* report) :
 
     JointTermination(options, type, pl_options, attributes, global_mutex, report),
-    _handlers(handlers)
+    _handlers(handlers),
+    _lock_free(options.lock_free)
 {
     // Preset common default options.
     if (plugin() != nullptr) {
@@ -67,7 +68,33 @@ void ts::tsp::PluginExecutor::setAbort()
 {
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
     _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.notify_one();
+    ringPrevious<PluginExecutor>()->wakeUp();
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up the plugin thread, whatever synchronization mode is used.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::wakeUp()
+{
+    if (!_lock_free) {
+        // The global mutex is held by the caller.
+        _to_do.notify_one();
+    }
+    else {
+        // The caller has just modified the state of this plugin (packet count, end of input, abort).
+        // The full fence orders that modification before the load of _lf_parked. It pairs with the
+        // one in waitWorkLockFree(), between the store of _lf_parked and the check of the state:
+        // either we see the plugin thread parked, or the plugin thread sees the new state.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_lf_parked.load(std::memory_order_seq_cst)) {
+            // The plugin thread is parked or about to be parked. Acquiring the local mutex
+            // guarantees that the thread is either already waiting or will see the new state.
+            std::lock_guard<std::mutex> lock(_lf_mutex);
+            _lf_to_do.notify_one();
+        }
+    }
 }
 
 
@@ -107,6 +134,13 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
     _br_confidence = br_confidence;
     _tsp_bitrate = bitrate;
     _tsp_bitrate_confidence = br_confidence;
+
+    // Lock-free state, same initial values.
+    _lf_pkt_cnt = pkt_cnt;
+    _lf_input_end = input_end;
+    _lf_bitrate = bitrate;
+    _lf_br_confidence = br_confidence;
+    _lf_bitrate_changed = false;
 }
 
 
@@ -116,10 +150,14 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
 
 bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted)
 {
-    assert(count <= _pkt_cnt);
-
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", count, bitrate, input_end, aborted);
 
+    if (_lock_free) {
+        return passPacketsLockFree(count, bitrate, br_confidence, input_end, aborted);
+    }
+
+    assert(count <= _pkt_cnt);
+
     // We access data under the protection of the global mutex.
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
 
@@ -149,7 +187,7 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     // Wake the previous processor when we abort (propagate abort conditions backward).
     if (aborted) {
-        _tsp_aborting = true; // volatile bool in TSP superclass
+        _tsp_aborting = true;
         ringPrevious<PluginExecutor>()->_to_do.notify_one();
     }
 
@@ -158,6 +196,60 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 }
 
 
+//----------------------------------------------------------------------------
+// Signal that the specified number of packets have been processed.
+// Lock-free version: only synchronize with the next plugin.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted)
+{
+    assert(count <= _lf_pkt_cnt);
+
+    PluginExecutor* next = ringNext<PluginExecutor>();
+
+    // Propagate the bitrate to the next processor, only when modified. Must be done before passing the
+    // packets so that the next processor gets the new bitrate with these packets.
+    if (bitrate != _lf_last_bitrate || br_confidence != _lf_last_br_confidence) {
+        _lf_last_bitrate = bitrate;
+        _lf_last_br_confidence = br_confidence;
+        std::lock_guard<std::mutex> lock(next->_lf_mutex);
+        next->_lf_bitrate = bitrate;
+        next->_lf_br_confidence = br_confidence;
+        next->_lf_bitrate_changed = true;
+    }
+
+    // Remove the first 'count' packets from our slice of the buffer. Only this thread modifies _pkt_first.
+    _pkt_first = (_pkt_first + count) % _buffer->count();
+    _lf_pkt_cnt -= count;
+
+    // Add 'count' packets at the end of the next processor's slice of the buffer.
+    // The end of input is published after the packets so that the next processor sees all packets.
+    next->_lf_pkt_cnt += count;
+    if (input_end) {
+        next->_lf_input_end = true;
+    }
+
+    // Wake the next processor when there is some new input data or end of input.
+    if (count > 0 || input_end) {
+        next->wakeUp();
+    }
+
+    // Force to abort our processor when the next one is aborting (see passPackets()).
+    if (plugin()->type() != PluginType::OUTPUT) {
+        aborted = aborted || next->_tsp_aborting;
+    }
+
+    // Wake the previous processor when we abort (propagate abort conditions backward).
+    if (aborted) {
+        _tsp_aborting = true;
+        ringPrevious<PluginExecutor>()->wakeUp();
+    }
+
+    // Return false when the current processor shall stop.
+    return !input_end && !aborted;
+}
+
+
 //----------------------------------------------------------------------------
 // Wait for packets to process or some error condition.
 //----------------------------------------------------------------------------
@@ -174,6 +266,11 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         min_pkt_cnt = _buffer->count();
     }
 
+    if (_lock_free) {
+        waitWorkLockFree(min_pkt_cnt, pkt_first, pkt_cnt, bitrate, br_confidence, input_end, aborted, timeout);
+        return;
+    }
+
     // We access data under the protection of the global mutex.
     std::unique_lock<std::recursive_mutex> lock(_global_mutex);
 
@@ -226,6 +323,84 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
 }
 
 
+//----------------------------------------------------------------------------
+// Wait for packets to process or some error condition.
+// Lock-free version: spin for a while, then park the thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                               BitRate& bitrate, BitRateConfidence& br_confidence,
+                                               bool& input_end, bool& aborted, bool &timeout)
+{
+    PluginExecutor* next = ringNext<PluginExecutor>();
+    timeout = false;
+
+    // Check if there is something to do. The end of input is read before the packet count.
+    const auto ready = [this, next, min_pkt_cnt]() {
+        return _lf_input_end || _lf_pkt_cnt >= min_pkt_cnt || next->_tsp_aborting;
+    };
+
+    // First, actively poll for a short while. With a fast plugin chain, this is usually sufficient.
+    for (size_t spin = 0; !ready() && spin < LOCK_FREE_SPIN_COUNT; ++spin) {
+        if (spin >= LOCK_FREE_SPIN_COUNT / 2) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Then, park the thread until the previous or next plugin wakes us up.
+    if (!ready()) {
+        std::unique_lock<std::mutex> lock(_lf_mutex);
+        _lf_parked.store(true, std::memory_order_seq_cst);
+        // Pairs with the fence in wakeUp(): the state is checked again after publishing the parked state.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!ready() && !timeout) {
+            if (_tsp_timeout.count() < 0) {
+                _lf_to_do.wait(lock);
+            }
+            else if (_lf_to_do.wait_for(lock, _tsp_timeout) == std::cv_status::timeout) {
+                // Call the plugin handler without holding the local mutex.
+                lock.unlock();
+                timeout = !plugin()->handlePacketTimeout();
+                lock.lock();
+            }
+        }
+        _lf_parked.store(false, std::memory_order_seq_cst);
+    }
+
+    // Get the new bitrate if it was modified by the previous processor.
+    if (_lf_bitrate_changed) {
+        std::lock_guard<std::mutex> lock(_lf_mutex);
+        _lf_bitrate_changed = false;
+        _bitrate = _lf_bitrate;
+        _br_confidence = _lf_br_confidence;
+    }
+
+    // Snapshot of the state. The end of input must be read first: when set, all packets were already counted.
+    const bool end = _lf_input_end;
+    const size_t count = _lf_pkt_cnt;
+
+    // Same limitation as waitWork() on the wrap-up point of the circular buffer.
+    if (timeout) {
+        pkt_cnt = 0;
+    }
+    else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
+        pkt_cnt = std::min(count, _buffer->count() - _pkt_first);
+    }
+    else {
+        pkt_cnt = count;
+    }
+
+    pkt_first = _pkt_first;
+    bitrate = _bitrate;
+    br_confidence = _br_confidence;
+    input_end = end && pkt_cnt == count;
+    aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
+
+    log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+        min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout);
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
@@ -273,7 +448,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
         _restart = true;
 
         // Signal the plugin thread that there is something to do.
-        _to_do.notify_one();
+        wakeUp();
     }
 
     // Now wait for the restart operation to complete.
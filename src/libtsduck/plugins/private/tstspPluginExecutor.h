@@ -202,6 +202,8 @@ namespace ts {
 
             // The following private data must be accessed exclusively under the protection of the global mutex.
             // Implementation details: see the file src/docs/developing-plugins.dox.
+            // In lock-free mode (TSProcessorArgs::lock_free), the fields marked [*] are accessed by the plugin
+            // thread only, _pkt_cnt and _input_end are replaced by the "_lf" fields below.
             // [*] After initialization, these fields are read/written only in passPackets() and waitWork().
             std::condition_variable_any _to_do {}; // Notify the processor thread to do something.
             size_t            _pkt_first = 0;      // Starting index of packets area [*]
@@ -212,6 +214,36 @@ namespace ts {
             bool              _restart = false;    // Restart the plugin asap using _restart_data
             RestartDataPtr    _restart_data {};    // How to restart the plugin
 
+            // Lock-free hand-off between adjacent plugins (when TSProcessorArgs::lock_free is set).
+            // The packet window of a plugin is [_pkt_first, _pkt_first + _lf_pkt_cnt). The start index is
+            // written by this plugin only. The count is incremented by the previous plugin and decremented by this
+            // one. The bitrate is rarely modified and is passed under the protection of the local _lf_mutex.
+            // The same local mutex and condition are used to park the thread after some unsuccessful spinning.
+            const bool               _lock_free;                   // Use lock-free hand-off.
+            std::atomic<size_t>      _lf_pkt_cnt {0};              // Size of packets area.
+            std::atomic<bool>        _lf_input_end {false};        // No more packet after current ones.
+            std::atomic<bool>        _lf_bitrate_changed {false};  // _lf_bitrate or _lf_br_confidence were modified.
+            std::atomic<bool>        _lf_parked {false};           // The plugin thread is waiting on _lf_to_do.
+            std::mutex               _lf_mutex {};                 // Protect bitrate and parking of this plugin.
+            std::condition_variable  _lf_to_do {};                 // Notify the parked plugin thread to do something.
+            BitRate                  _lf_bitrate = 0;              // Input bitrate (set by previous plugin), under _lf_mutex.
+            BitRateConfidence        _lf_br_confidence = BitRateConfidence::LOW;  // Input bitrate confidence, under _lf_mutex.
+            BitRate                  _lf_last_bitrate = 0;         // Last bitrate passed to the next plugin.
+            BitRateConfidence        _lf_last_br_confidence = BitRateConfidence::LOW;  // Last bitrate confidence passed to next plugin.
+
+            // Number of polling iterations before parking the thread in lock-free mode.
+            static constexpr size_t LOCK_FREE_SPIN_COUNT = 2000;
+
+            // Wake up the plugin thread, whatever synchronization mode is used.
+            // The global mutex must be held when the lock-free mode is not used.
+            void wakeUp();
+
+            // Implementation of passPackets() and waitWork() in lock-free mode.
+            bool passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted);
+            void waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                  BitRate& bitrate, BitRateConfidence& br_confidence,
+                                  bool& input_end, bool& aborted, bool &timeout);
+
             // Description of a restart operation.
             class RestartData
             {
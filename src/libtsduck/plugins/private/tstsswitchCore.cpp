@@ -36,6 +36,11 @@ ts::tsswitch::Core::Core(const InputSwitcherArgs& opt, const PluginEventHandlerR
     // Set the asynchronous logger as report method for output as well.
     _output.delegateReport(&_log);
     _output.setMaxSeverity(_log.maxSeverity());
+
+    // In merge mode, the output packets come from the merger, not directly from the input plugins.
+    if (_opt.merge) {
+        _merger = std::make_unique<Merger>(_inputs.size(), _opt.mergeWindow, _opt.bufferedPackets, _opt.receiveTimeout);
+    }
 }
 
 ts::tsswitch::Core::~Core()
@@ -85,8 +90,8 @@ bool ts::tsswitch::Core::start()
         // If one input thread could not start, abort all started threads.
         stop(false);
     }
-    else if (_opt.fastSwitch) {
-        // Option --fast-switch, start all plugins, they continue to receive in parallel.
+    else if (_opt.fastSwitch || _opt.merge) {
+        // Options --fast-switch and --merge, start all plugins, they continue to receive in parallel.
         for (size_t i = 0; i < _inputs.size(); ++i) {
             _inputs[i]->startInput(i == _curPlugin);
         }
@@ -166,7 +171,10 @@ size_t ts::tsswitch::Core::currentInput()
 
 void ts::tsswitch::Core::setInputLocked(size_t index, bool abortCurrent)
 {
-    if (index >= _inputs.size()) {
+    if (_merger != nullptr) {
+        _log.warning(u"input switching is not allowed in merge mode");
+    }
+    else if (index >= _inputs.size()) {
         _log.warning(u"invalid input index %d", index);
     }
     else if (index != _curPlugin) {
@@ -428,6 +436,11 @@ bool ts::tsswitch::Core::getOutputArea(size_t& pluginIndex, TSPacket*& first, TS
             first = nullptr;
             count = 0;
         }
+        else if (_merger != nullptr) {
+            // When no input delivers packets, idle inputs shall not delay the merged packets.
+            _merger->checkIdleInputs();
+            _merger->getOutputArea(first, data, count);
+        }
         else {
             _inputs[_curPlugin]->getOutputArea(first, data, count);
         }
@@ -438,8 +451,13 @@ bool ts::tsswitch::Core::getOutputArea(size_t& pluginIndex, TSPacket*& first, TS
             // Return false when the application terminates.
             return !_terminate;
         }
-        // Otherwise, sleep on _gotInput condition.
-        _gotInput.wait(lock);
+        // Otherwise, sleep on _gotInput condition. In merge mode, periodically check idle inputs.
+        if (_merger != nullptr && _opt.receiveTimeout > cn::milliseconds::zero()) {
+            _gotInput.wait_for(lock, _opt.receiveTimeout / 2);
+        }
+        else {
+            _gotInput.wait(lock);
+        }
     }
 }
 
@@ -452,6 +470,14 @@ bool ts::tsswitch::Core::outputSent(size_t pluginIndex, size_t count)
 {
     assert(pluginIndex < _inputs.size());
 
+    // In merge mode, the packets came from the merger.
+    if (_merger != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _merger->freeOutput(count);
+        _gotOutputSpace.notify_all();
+        return !_terminate;
+    }
+
     // Inform the input plugin that the packets can be reused for input.
     // We notify the original input plugin from which the packets came.
     // The "current" input plugin may have changed in the meantime.
@@ -474,7 +500,8 @@ bool ts::tsswitch::Core::inputStarted(size_t pluginIndex, bool success)
     execute(Action(WAIT_STARTED, pluginIndex, success));
 
     // Start the receive timeout, if any, when the current input is started.
-    if (pluginIndex == _curPlugin) {
+    // In merge mode, the receive timeout is handled by the merger.
+    if (_merger == nullptr && pluginIndex == _curPlugin) {
         _receiveWatchDog.restart();
     }
 
@@ -489,6 +516,11 @@ bool ts::tsswitch::Core::inputStarted(size_t pluginIndex, bool success)
 
 bool ts::tsswitch::Core::inputReceived(size_t pluginIndex)
 {
+    // In merge mode, there is no current plugin, all input plugins feed the merger.
+    if (_merger != nullptr) {
+        return mergeReceived(pluginIndex);
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
     // Restart the receive timeout, if any, when the current input receives packets.
@@ -532,6 +564,43 @@ bool ts::tsswitch::Core::inputReceived(size_t pluginIndex)
 }
 
 
+//----------------------------------------------------------------------------
+// Merge the received packets of an input plugin in the output buffer.
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::Core::mergeReceived(size_t pluginIndex)
+{
+    std::unique_lock<std::recursive_mutex> lock(_mutex);
+
+    // Loop on contiguous areas of received packets in the input plugin buffer.
+    while (!_terminate) {
+        TSPacket* first = nullptr;
+        TSPacketMetadata* data = nullptr;
+        size_t count = 0;
+        _inputs[pluginIndex]->getOutputArea(first, data, count);
+        if (count == 0) {
+            break;
+        }
+
+        // Merge the packets and immediately release them in the input plugin buffer.
+        const size_t done = _merger->feed(pluginIndex, first, data, count);
+        _inputs[pluginIndex]->freeOutput(done);
+        if (_merger->outputCount() > 0) {
+            // Wake up output plugin if it is sleeping, waiting for packets to output.
+            _gotInput.notify_all();
+        }
+
+        // When the merged output buffer is full, wait for the output plugin.
+        if (done < count) {
+            _gotOutputSpace.wait(lock, [this]() { return _terminate || !_merger->outputFull(); });
+        }
+    }
+
+    // Return false when the application terminates.
+    return !_terminate;
+}
+
+
 //----------------------------------------------------------------------------
 // Report completion of input session (called by input plugins).
 //----------------------------------------------------------------------------
@@ -543,15 +612,31 @@ bool ts::tsswitch::Core::inputStopped(size_t pluginIndex, bool success)
 
     // Locked sequence.
     {
-        std::lock_guard<std::recursive_mutex> lock(_mutex);
-
-        // Count end of cycle when the last plugin terminates.
-        if (pluginIndex == _inputs.size() - 1) {
-            _curCycle++;
+        std::unique_lock<std::recursive_mutex> lock(_mutex);
+
+        if (_merger != nullptr) {
+            // In merge mode, all input plugins run in parallel and are never restarted.
+            // The terminated input plugin no longer delays the output of merged packets.
+            _merger->stopInput(pluginIndex);
+            _gotInput.notify_all();
+            stopRequest = _opt.terminate || ++_stoppedInputs >= _inputs.size();
+            if (stopRequest) {
+                // With --terminate, other inputs may be still running. Do not wait for them: the packets
+                // in the window are output now and their next packets are ignored. Then, wait for the
+                // output plugin to send all merged packets.
+                _merger->stopAllInputs();
+                _gotInput.notify_all();
+                _gotOutputSpace.wait(lock, [this]() { return _terminate || _merger->pendingCount() == 0; });
+            }
+        }
+        else {
+            // Count end of cycle when the last plugin terminates.
+            if (pluginIndex == _inputs.size() - 1) {
+                _curCycle++;
+            }
+            // Check if the complete processing is terminated.
+            stopRequest = _opt.terminate || (_opt.cycleCount > 0 && _curCycle >= _opt.cycleCount);
         }
-
-        // Check if the complete processing is terminated.
-        stopRequest = _opt.terminate || (_opt.cycleCount > 0 && _curCycle >= _opt.cycleCount);
 
         if (stopRequest) {
             // Need to stop now. Remove any further action, except waiting for termination.
@@ -559,7 +644,7 @@ bool ts::tsswitch::Core::inputStopped(size_t pluginIndex, bool success)
             // Do not trigger receive timeout while terminating.
             enqueue(Action(SUSPEND_TIMEOUT), true);
         }
-        else if (pluginIndex == _curPlugin && _actions.empty()) {
+        else if (_merger == nullptr && pluginIndex == _curPlugin && _actions.empty()) {
             // The current plugin terminates and there is nothing else to execute, move to next plugin.
             const size_t next = (_curPlugin + 1) % _inputs.size();
             enqueue(Action(SUSPEND_TIMEOUT));
@@ -603,4 +688,34 @@ void ts::tsswitch::Core::waitForTermination()
     for (size_t i = 0; i < _inputs.size(); ++i) {
         _inputs[i]->waitForTermination();
     }
+
+    // In merge mode, report the final statistics of each input plugin.
+    if (_merger != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _merger->flushWindow();
+        InputSwitcher::MergeStatisticsVector stats;
+        _merger->getStatistics(stats);
+        for (size_t i = 0; i < stats.size(); ++i) {
+            const PacketCounter total = stats[i].received + stats[i].lost;
+            _log.info(u"input %d (%s): %'d packets, %'d output, %'d duplicates, %'d late, %'d lost (%.3f%%)",
+                      i, _inputs[i]->pluginName(), stats[i].received, stats[i].output, stats[i].duplicates, stats[i].late, stats[i].lost,
+                      total == 0 ? 0.0 : (100.0 * double(stats[i].lost)) / double(total));
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the statistics of all input plugins in merge mode.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Core::getMergeStatistics(InputSwitcher::MergeStatisticsVector& stats)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (_merger != nullptr) {
+        _merger->getStatistics(stats);
+    }
+    else {
+        stats.clear();
+    }
 }
@@ -16,6 +16,7 @@
 #include "tstsswitchInputExecutor.h"
 #include "tstsswitchOutputExecutor.h"
 #include "tstsswitchEventDispatcher.h"
+#include "tstsswitchMerger.h"
 #include "tsWatchDog.h"
 
 namespace ts {
@@ -126,6 +127,12 @@ namespace ts {
             //!
             bool outputSent(size_t pluginIndex, size_t count);
 
+            //!
+            //! Get the statistics of all input plugins in merge mode.
+            //! @param [out] stats Statistics, one per input plugin. Empty when not in merge mode.
+            //!
+            void getMergeStatistics(InputSwitcher::MergeStatisticsVector& stats);
+
         private:
             // Upon reception of an event (end of input, remote command, etc), there
             // is a list of actions to execute which depends on the switch policy.
@@ -176,6 +183,9 @@ namespace ts {
             WatchDog                    _receiveWatchDog;   // Handle reception timeout.
             std::recursive_mutex        _mutex {};          // Global mutex, protect access to all subsequent fields.
             std::condition_variable_any _gotInput {};       // Signaled each time an input plugin reports new packets.
+            std::condition_variable_any _gotOutputSpace {}; // Signaled each time the output plugin frees merged packets.
+            std::unique_ptr<Merger>     _merger {};         // Merger of redundant inputs (--merge only).
+            size_t                      _stoppedInputs = 0; // Number of terminated input plugins (--merge only).
             size_t                      _curPlugin = 0;     // Index of current input plugin.
             size_t                      _curCycle = 0;      // Current input cycle number.
             volatile bool               _terminate = false; // Terminate complete processing.
@@ -194,6 +204,9 @@ namespace ts {
             // Remove all instructions with type in bitmask (with mutex already held).
             void cancelActions(int typeMask);
 
+            // Merge the received packets of an input plugin in the output buffer (--merge only).
+            bool mergeReceived(size_t pluginIndex);
+
             // Execute all commands until one needs to wait (with mutex already held).
             // The event can be used to unlock a wait action.
             void execute(const Action& event = Action());
@@ -0,0 +1,494 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstsswitchMerger.h"
+#include "tsFingerprintCache.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::tsswitch::Merger::Merger(size_t input_count, size_t window_size, size_t buffer_size, cn::milliseconds receive_timeout) :
+    _windowSize(std::max<size_t>(1, window_size)),
+    _timeout(receive_timeout),
+    _inputs(std::min(input_count, InputSwitcherArgs::MAX_MERGE_INPUTS)),
+    _stats(_inputs.size()),
+    _buffer(std::max<size_t>(1, buffer_size)),
+    _metadata(_buffer.size())
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Process packets from an input.
+//----------------------------------------------------------------------------
+
+size_t ts::tsswitch::Merger::feed(size_t input, const TSPacket* packets, const TSPacketMetadata* mdata, size_t count)
+{
+    assert(input < _inputs.size());
+    InputState& state(_inputs[input]);
+    InputSwitcher::MergeStatistics& stats(_stats[input]);
+    const uint64_t mask = uint64_t(1) << input;
+
+    // Packets from a terminated input are ignored.
+    if (state.stopped) {
+        return count;
+    }
+
+    // Time of reception, only when a receive timeout is used.
+    const monotonic_time now(_timeout > cn::milliseconds::zero() ? monotonic_time::clock::now() : monotonic_time());
+
+    size_t n = 0;
+    for (; n < count; ++n) {
+
+        // Null packets are only counted after the last delivered packet.
+        if (packets[n].getPID() == PID_NULL) {
+            state.nulls++;
+            continue;
+        }
+        state.idle = false;
+        state.last_time = now;
+
+        const uint64_t fingerprint = FingerprintCache::Fingerprint(packets[n].b, PKT_SIZE);
+        uint64_t position = 0;
+        if (find(fingerprint, state.synchronized ? state.next : _windowStart, mask, position) ||
+            (state.synchronized && findSkipped(input, fingerprint, position)))
+        {
+            // Already received from another input, drop the duplicate.
+            entry(position).inputs |= mask;
+            stats.duplicates++;
+        }
+        else if (state.synchronized && (state.next < _release || (state.next == _release && _releaseStep > 0))) {
+            // Lost on other inputs but the next packets are already output, drop it.
+            // The alignment point of the input is unchanged.
+            stats.late++;
+            stats.received++;
+            continue;
+        }
+        else {
+            // First reception of this packet. When the window is full, the oldest packet is removed.
+            // If this packet is not yet output, it is output now, if there is room in the output buffer.
+            if (_window.size() >= _windowSize) {
+                if (_release == _windowStart && !releaseFirst()) {
+                    break;
+                }
+                pop();
+            }
+            // Insert the packet at the alignment point of the input. Packets which were lost on faster
+            // inputs are inserted in the right order.
+            position = state.synchronized ? state.next : _windowEnd;
+            insert(input, position, fingerprint, packets[n], mdata[n]);
+            stats.output++;
+        }
+        stats.received++;
+
+        // When the input delivered the previous packet in the window, the null packets in between are known.
+        if (state.synchronized && position == state.next && position > _release) {
+            setNulls(position - 1, state.nulls, fingerprint);
+        }
+        if (!state.started) {
+            state.started = true;
+            state.origin = position;
+        }
+        state.synchronized = true;
+        state.next = position + 1;
+        state.nulls = 0;
+    }
+
+    // Delivering packets from one input is a good time to check the others.
+    if (_timeout > cn::milliseconds::zero()) {
+        checkIdleInputs();
+    }
+    release();
+    return n;
+}
+
+
+//----------------------------------------------------------------------------
+// Declare that an input is terminated.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::stopInput(size_t input)
+{
+    assert(input < _inputs.size());
+    InputState& state(_inputs[input]);
+
+    // The losses on this input are now bounded by its last packet. If the input was late by more
+    // than the window size, all packets in the window are lost.
+    if (state.started) {
+        state.end = state.synchronized ? state.next : _windowEnd;
+    }
+    state.stopped = true;
+    state.synchronized = false;
+    state.nulls = 0;
+    release();
+}
+
+
+//----------------------------------------------------------------------------
+// Declare that all inputs are terminated.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::stopAllInputs()
+{
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        if (!_inputs[i].stopped) {
+            stopInput(i);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check the inputs which delivered no packet during the receive timeout.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::checkIdleInputs()
+{
+    if (_timeout <= cn::milliseconds::zero()) {
+        return;
+    }
+
+    // The receive timeouts start at the first check, when the inputs are started.
+    const monotonic_time now(monotonic_time::clock::now());
+    if (!_timing) {
+        _timing = true;
+        for (auto& state : _inputs) {
+            state.last_time = now;
+        }
+        return;
+    }
+
+    // An idle input loses its alignment point, it is resynchronized on its next packet. When it
+    // never delivered any packet, the output no longer waits for it at startup.
+    bool changed = false;
+    for (auto& state : _inputs) {
+        if (!state.stopped && !state.idle && now - state.last_time >= _timeout) {
+            state.idle = true;
+            state.synchronized = false;
+            state.nulls = 0;
+            changed = true;
+        }
+    }
+    if (changed) {
+        release();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Find the first position of a fingerprint, not delivered by an input.
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::Merger::find(uint64_t fingerprint, uint64_t start, uint64_t mask, uint64_t& position)
+{
+    // In the normal case, the packet is found at the alignment point of the input, in the first iteration.
+    for (position = std::max(start, _windowStart); position < _windowEnd; ++position) {
+        const Entry& e(entry(position));
+        if (e.fingerprint == fingerprint && (e.inputs & mask) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Find a fingerprint in the packets which were skipped by an input.
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::Merger::findSkipped(size_t input, uint64_t fingerprint, uint64_t& position)
+{
+    InputState& state(_inputs[input]);
+    const uint64_t mask = uint64_t(1) << input;
+
+    // Packets which are completely or partially output cannot be moved.
+    const uint64_t low = _release + (_releaseStep > 0 ? 1 : 0);
+
+    // Search backward, up to the last packet which was delivered by this input and another one.
+    for (uint64_t pos = state.next; pos > low; ) {
+        const Entry& e(entry(--pos));
+        if ((e.inputs & mask) != 0) {
+            if (e.inputs != mask) {
+                break;
+            }
+        }
+        else if (e.fingerprint == fingerprint) {
+            if (moveSkipped(input, pos)) {
+                // The found packet is now the first one after the last packet of the input.
+                position = state.next;
+                return true;
+            }
+            break;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Move the packets which were skipped by an input after its last packet.
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::Merger::moveSkipped(size_t input, uint64_t first)
+{
+    InputState& state(_inputs[input]);
+    const uint64_t mask = uint64_t(1) << input;
+    const size_t base = size_t(first - _windowStart);
+    const size_t size = size_t(state.next - first);
+
+    // A packet from the input cannot move before a skipped packet from an input which delivered both.
+    size_t kept = 0;
+    uint64_t moved_inputs = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const uint64_t inputs = _window[base + i].inputs;
+        if ((inputs & mask) == 0) {
+            moved_inputs |= inputs;
+        }
+        else if ((inputs & moved_inputs) != 0) {
+            return false;
+        }
+        else {
+            kept++;
+        }
+    }
+
+    // Compute the new positions, then move the packets.
+    std::vector<uint64_t> new_position(size);
+    for (size_t i = 0, k = 0, m = kept; i < size; ++i) {
+        new_position[i] = first + ((_window[base + i].inputs & mask) != 0 ? k++ : m++);
+    }
+    std::stable_partition(_window.begin() + base, _window.begin() + base + size, [mask](const Entry& e) { return (e.inputs & mask) != 0; });
+
+    // Update the positions in all other inputs: origin is the position of the first packet,
+    // next and end are the positions after the last packet.
+    const auto move_at = [&](uint64_t& pos) {
+        if (pos >= first && pos < first + size) {
+            pos = new_position[size_t(pos - first)];
+        }
+    };
+    const auto move_after = [&](uint64_t& pos) {
+        if (pos > first && pos <= first + size) {
+            pos = new_position[size_t(pos - first - 1)] + 1;
+        }
+    };
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        InputState& other(_inputs[i]);
+        if (other.started) {
+            move_at(other.origin);
+        }
+        if (i != input && other.synchronized) {
+            move_after(other.next);
+        }
+        if (other.end != NONE) {
+            move_after(other.end);
+        }
+    }
+    state.next = first + kept;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the number of null packets after a packet, as seen by an input.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::setNulls(uint64_t position, size_t count, uint64_t successor)
+{
+    Entry& e(entry(position));
+    for (auto& nulls : e.nulls) {
+        if (!nulls.valid || nulls.successor == successor) {
+            // Inputs which lost null packets see fewer of them.
+            nulls.count = nulls.valid ? std::max(nulls.count, count) : count;
+            nulls.successor = successor;
+            nulls.valid = true;
+            return;
+        }
+    }
+    // No free slot, drop the oldest count.
+    e.nulls[0] = e.nulls[1];
+    e.nulls[1].successor = successor;
+    e.nulls[1].count = count;
+}
+
+size_t ts::tsswitch::Merger::getNulls(uint64_t successor) const
+{
+    for (const auto& nulls : _releasedNulls) {
+        if (nulls.valid && nulls.successor == successor) {
+            return nulls.count;
+        }
+    }
+    return 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a new packet in the window.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::insert(size_t input, uint64_t position, uint64_t fingerprint, const TSPacket& pkt, const TSPacketMetadata& mdata)
+{
+    assert(_window.size() < _windowSize);
+    assert(position <= _windowEnd && (position > _release || (position == _release && _releaseStep == 0)));
+
+    const auto it = _window.emplace(_window.begin() + size_t(position - _windowStart));
+    it->fingerprint = fingerprint;
+    it->inputs = uint64_t(1) << input;
+    it->packet = pkt;
+    it->mdata = mdata;
+    _windowEnd++;
+
+    // All subsequent packets are shifted by one position.
+    if (position < _windowEnd - 1) {
+        for (size_t i = 0; i < _inputs.size(); ++i) {
+            if (i != input) {
+                InputState& other(_inputs[i]);
+                if (other.started && other.origin >= position) {
+                    other.origin++;
+                }
+                if (other.synchronized && other.next > position) {
+                    other.next++;
+                }
+                if (other.end != NONE && other.end > position) {
+                    other.end++;
+                }
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Remove the oldest packet in the window.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::pop()
+{
+    assert(!_window.empty());
+    assert(_release > _windowStart);
+
+    // The packet is lost on all inputs which did not deliver it, between their first and last packets.
+    const uint64_t mask = _window.front().inputs;
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        const InputState& state(_inputs[i]);
+        if (state.started && _windowStart >= state.origin && _windowStart < state.end && (mask & (uint64_t(1) << i)) == 0) {
+            _stats[i].lost++;
+        }
+    }
+    _window.pop_front();
+    _windowStart++;
+
+    // Inputs which are late by more than the window size lose their alignment point.
+    for (auto& state : _inputs) {
+        if (state.synchronized && state.next < _windowStart) {
+            state.synchronized = false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Output packets.
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::Merger::releaseFirst()
+{
+    assert(_release < _windowEnd);
+    const Entry& e(entry(_release));
+
+    // Output the null packets since the previous packet, then the packet. The position of the packet is
+    // final, the number of null packets since the previous one is the one which was seen before this one.
+    if (_releaseStep == 0) {
+        _releaseNulls = getNulls(e.fingerprint);
+    }
+    while (_releaseStep <= _releaseNulls && !outputFull()) {
+        const size_t index = (_outFirst + _outCount++) % _buffer.size();
+        _buffer[index] = _releaseStep++ < _releaseNulls ? NullPacket : e.packet;
+        _metadata[index] = e.mdata;
+    }
+    if (_releaseStep > _releaseNulls) {
+        _releasedNulls = e.nulls;
+        _release++;
+        _releaseStep = 0;
+        return true;
+    }
+    return false;
+}
+
+bool ts::tsswitch::Merger::isFinal(uint64_t position)
+{
+    const Entry& e(entry(position));
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        const InputState& state(_inputs[i]);
+        const uint64_t mask = uint64_t(1) << i;
+        if (state.synchronized) {
+            // The input must be aligned after the next packet, to know the null packets in between.
+            if (state.next <= position + 1) {
+                return false;
+            }
+            // If the input skipped this packet, it must have delivered a subsequent packet in common
+            // with the inputs which delivered this one. Otherwise, it may deliver this packet later.
+            if ((e.inputs & mask) == 0) {
+                bool lost = false;
+                for (uint64_t pos = position + 1; !lost && pos < state.next; ++pos) {
+                    const uint64_t inputs = entry(pos).inputs;
+                    lost = (inputs & mask) != 0 && (inputs & e.inputs) != 0;
+                }
+                if (!lost) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void ts::tsswitch::Merger::release()
+{
+    // At startup, wait for all inputs, unless the window is full.
+    if (_startup) {
+        _startup = _window.size() < _windowSize && std::any_of(_inputs.begin(), _inputs.end(), [](const InputState& state) { return !state.started && !state.stopped && !state.idle; });
+        if (_startup) {
+            return;
+        }
+    }
+
+    // A packet which is partially output must be completed.
+    while (_release < _windowEnd && (_releaseStep > 0 || isFinal(_release)) && releaseFirst()) {
+    }
+}
+
+void ts::tsswitch::Merger::getOutputArea(TSPacket*& first, TSPacketMetadata*& data, size_t& count)
+{
+    first = &_buffer[_outFirst];
+    data = &_metadata[_outFirst];
+    count = std::min(_outCount, _buffer.size() - _outFirst);
+}
+
+void ts::tsswitch::Merger::freeOutput(size_t count)
+{
+    assert(count <= _outCount);
+    _outFirst = (_outFirst + count) % _buffer.size();
+    _outCount -= count;
+    release();
+}
+
+
+//----------------------------------------------------------------------------
+// Flush the alignment window.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Merger::flushWindow()
+{
+    _release = _windowEnd;
+    _releaseStep = 0;
+    while (!_window.empty()) {
+        pop();
+    }
+}
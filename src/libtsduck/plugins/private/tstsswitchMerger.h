@@ -0,0 +1,257 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Input switch (tsswitch) seamless merge of redundant inputs.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsInputSwitcher.h"
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+
+namespace ts {
+    namespace tsswitch {
+        //!
+        //! Seamless merge of redundant copies of the same transport stream (SMPTE 2022-7 style).
+        //! @ingroup libtsduck plugin
+        //!
+        //! All inputs are supposed to carry the same sequence of TS packets, with independent losses.
+        //! Each packet is output once, from the input which delivered it first.
+        //!
+        //! The inputs are aligned using a 64-bit fingerprint of the packet content. The last packets
+        //! are kept in a bounded alignment window. Each input has an alignment point in the window,
+        //! after the last packet it delivered. A received packet is a duplicate when the same
+        //! fingerprint is found in the window, after the alignment point of the input. Otherwise,
+        //! this is a new packet which is inserted in the window at the alignment point of the input.
+        //!
+        //! Without sequence numbers, the order of packets which were lost on distinct inputs is
+        //! ambiguous. When an input delivers a packet which was previously inserted by another input
+        //! before its alignment point, the packets it skipped are moved after its last packet, if this
+        //! preserves the order of all inputs. A packet which was skipped by an input is known to be lost
+        //! on that input when it delivers a subsequent packet in common with the inputs which delivered
+        //! the skipped one.
+        //!
+        //! A packet is output when all inputs are aligned after the next one and its position is no longer
+        //! ambiguous, meaning that the packets which were lost on the fastest input are recovered from
+        //! slower inputs, in the right order. When the window is full, the oldest packet is output anyway.
+        //! An input which is late by more than the window size loses its alignment point, until a new packet
+        //! is received. A lost packet which is received after the output of the next packets is dropped.
+        //!
+        //! At startup, no packet is output until all inputs have delivered packets or the window is full.
+        //! Thus, the first packets which were lost on the first input can be recovered from the others.
+        //!
+        //! An input which stops delivering packets without terminating would delay the output until the
+        //! window is full. With a receive timeout, an input which delivered no packet during the timeout
+        //! is idle: it loses its alignment point and no longer delays the output, until it delivers a new
+        //! packet. Null packets do not count as delivered packets.
+        //!
+        //! Null packets are all identical and cannot be used for alignment. They are not stored in
+        //! the window. Each packet in the window records the number of null packets which follow it,
+        //! as seen by the inputs which delivered it, with the next packet they delivered. When the next
+        //! packet is output, the null packets are regenerated before it, using the count which was seen
+        //! before this next packet. If no input delivered both packets, the number of null packets in
+        //! between is unknown and no null packet is output. The null packets after the last packet of
+        //! the inputs are not output.
+        //!
+        //! When a packet leaves the window, it is counted as lost on all inputs which did not deliver it,
+        //! between the first and last packets of these inputs. Null packets are not counted in the statistics.
+        //!
+        //! This class is not thread-safe. Access must be protected by the caller.
+        //!
+        class Merger
+        {
+            TS_NOBUILD_NOCOPY(Merger);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] input_count Number of inputs to merge, at most InputSwitcherArgs::MAX_MERGE_INPUTS.
+            //! @param [in] window_size Maximum number of packets in the alignment window.
+            //! @param [in] buffer_size Size in packets of the output buffer.
+            //! @param [in] receive_timeout Receive timeout of the inputs. Zero means no timeout.
+            //!
+            Merger(size_t input_count, size_t window_size, size_t buffer_size, cn::milliseconds receive_timeout = cn::milliseconds::zero());
+
+            //!
+            //! Process packets from an input.
+            //! @param [in] input Index of the input.
+            //! @param [in] packets Address of the received packets.
+            //! @param [in] mdata Address of the metadata of the received packets.
+            //! @param [in] count Number of received packets.
+            //! @return Number of processed packets. This can be less than @a count when the output buffer is full.
+            //!
+            size_t feed(size_t input, const TSPacket* packets, const TSPacketMetadata* mdata, size_t count);
+
+            //!
+            //! Declare that an input is terminated.
+            //! The input no longer delays the output of packets. The packets which are later received
+            //! from other inputs are counted as lost on this input only if they precede its last packet.
+            //! @param [in] input Index of the input.
+            //!
+            void stopInput(size_t input);
+
+            //!
+            //! Declare that all inputs are terminated.
+            //! The output of the packets in the window no longer waits for any input.
+            //! All packets which are later received are ignored.
+            //!
+            void stopAllInputs();
+
+            //!
+            //! Check the inputs which delivered no packet during the receive timeout.
+            //! They become idle and no longer delay the output of packets.
+            //! This method shall be called periodically when no input delivers packets.
+            //!
+            void checkIdleInputs();
+
+            //!
+            //! Get the area of packets to output.
+            //! @param [out] first Returned address of first packet to output.
+            //! @param [out] data Returned address of metadata for the first packet to output.
+            //! @param [out] count Returned number of contiguous packets to output. Can be zero.
+            //!
+            void getOutputArea(TSPacket*& first, TSPacketMetadata*& data, size_t& count);
+
+            //!
+            //! Free an output area which was previously returned by getOutputArea().
+            //! @param [in] count Number of output packets to release.
+            //!
+            void freeOutput(size_t count);
+
+            //!
+            //! Get the number of packets to output in the output buffer.
+            //! @return The number of packets to output.
+            //!
+            size_t outputCount() const { return _outCount; }
+
+            //!
+            //! Check if the output buffer is full.
+            //! @return True if the output buffer is full.
+            //!
+            bool outputFull() const { return _outCount >= _buffer.size(); }
+
+            //!
+            //! Get the number of packets which are not yet output, in the window or in the output buffer.
+            //! @return The number of packets which are not yet output.
+            //!
+            size_t pendingCount() const { return _outCount + size_t(_windowEnd - _release); }
+
+            //!
+            //! Get the statistics of all inputs.
+            //! The packets which are still in the alignment window are not yet counted as lost.
+            //! @param [out] stats Statistics, one per input.
+            //!
+            void getStatistics(InputSwitcher::MergeStatisticsVector& stats) const { stats = _stats; }
+
+            //!
+            //! Flush the alignment window.
+            //! All packets which are not yet output in the window are lost.
+            //! All packets in the window are counted as lost on the inputs which did not deliver them.
+            //!
+            void flushWindow();
+
+        private:
+            // Number of null packets after a packet, as seen by an input, before its next packet.
+            struct Nulls
+            {
+                bool     valid = false;  // The count is set.
+                uint64_t successor = 0;  // Fingerprint of the next packet.
+                size_t   count = 0;      // Number of null packets.
+            };
+
+            // Description of a packet in the alignment window.
+            // Most of the time, there are at most two distinct next packets: the actual one and the one
+            // which was seen by an input which lost the packets in between. Older counts are dropped.
+            struct Entry
+            {
+                uint64_t         fingerprint = 0;  // Fingerprint of the packet content.
+                uint64_t         inputs = 0;       // Bit mask of inputs which delivered the packet.
+                std::array<Nulls, 2> nulls {};     // Number of null packets after this one, for distinct next packets.
+                TSPacket         packet {};        // Packet content, until output.
+                TSPacketMetadata mdata {};         // Packet metadata, until output.
+            };
+
+            // Alignment state of an input.
+            struct InputState
+            {
+                bool     started = false;       // At least one packet was received.
+                bool     stopped = false;       // The input is terminated.
+                bool     idle = false;          // No packet was delivered during the receive timeout.
+                bool     synchronized = false;  // The alignment point is in the window.
+                uint64_t origin = 0;            // Position of the first packet of the input in the window.
+                uint64_t end = NONE;            // Position after the last packet of the input, when stopped.
+                uint64_t next = 0;              // Alignment point: position after the last delivered packet.
+                size_t   nulls = 0;             // Number of null packets since the last delivered packet.
+                monotonic_time last_time {};    // Time of the last delivered packet, or start of the timeout.
+            };
+
+            // Positions in the window are absolute, they are not changed when old packets are removed.
+            // Entries in the window: [_windowStart, _release[ are output, [_release, _windowEnd[ are not.
+            // Null packets are not stored in the window.
+            const size_t              _windowSize;        // Maximum number of packets in the window.
+            const cn::milliseconds    _timeout;           // Receive timeout, zero if none.
+            bool                      _timing = false;    // The receive timeouts are started.
+            std::deque<Entry>         _window {};         // Alignment window.
+            uint64_t                  _windowStart = 0;   // Absolute position of first packet in window.
+            uint64_t                  _windowEnd = 0;     // Absolute position after last packet in window.
+            uint64_t                  _release = 0;       // Absolute position of first packet to output in window.
+            size_t                    _releaseStep = 0;   // Number of packets already output for the packet at _release.
+            size_t                    _releaseNulls = 0;  // Number of null packets to output before the packet at _release.
+            std::array<Nulls, 2>      _releasedNulls {};  // Number of null packets after the last output packet.
+            bool                      _startup = true;    // Waiting for all inputs to start, before the first output.
+            std::vector<InputState>   _inputs;            // Alignment state of each input.
+            InputSwitcher::MergeStatisticsVector _stats;  // Statistics, per input.
+            TSPacketVector            _buffer;            // Output packet buffer.
+            TSPacketMetadataVector    _metadata;          // Output packet metadata.
+            size_t                    _outFirst = 0;      // Index of first packet to output in _buffer.
+            size_t                    _outCount = 0;      // Number of packets to output, may wrap up.
+
+            // Undefined position.
+            static constexpr uint64_t NONE = std::numeric_limits<uint64_t>::max();
+
+            // Access a window entry by absolute position.
+            Entry& entry(uint64_t position) { return _window[size_t(position - _windowStart)]; }
+
+            // Find the first position of a fingerprint, at or after a given position, not delivered by an input.
+            // Return true if found.
+            bool find(uint64_t fingerprint, uint64_t start, uint64_t mask, uint64_t& position);
+
+            // Find a fingerprint before the alignment point of a synchronized input, in the packets it skipped
+            // since its last packet in common with other inputs. When found, the skipped packets are moved after
+            // the last packet of the input. Return true if found and moved, with the new position of the packet.
+            bool findSkipped(size_t input, uint64_t fingerprint, uint64_t& position);
+
+            // Move the packets which were not delivered by a synchronized input, from a given position up to
+            // its alignment point, after its last packet. Return false if this breaks the order of other inputs.
+            bool moveSkipped(size_t input, uint64_t first);
+
+            // Set the number of null packets after a packet, as seen by an input.
+            void setNulls(uint64_t position, size_t count, uint64_t successor);
+
+            // Get the number of null packets after the last output packet, before a given next packet.
+            size_t getNulls(uint64_t successor) const;
+
+            // Check if the position of a packet is final, for all synchronized inputs.
+            bool isFinal(uint64_t position);
+
+            // Insert a new packet in the window. There must be room in the window.
+            void insert(size_t input, uint64_t position, uint64_t fingerprint, const TSPacket& pkt, const TSPacketMetadata& mdata);
+
+            // Remove the oldest packet in the window. It must be already output.
+            void pop();
+
+            // Copy the first packet to output and the null packets before it in the output buffer, as long as there is room.
+            // Return true if the packet is completely output.
+            bool releaseFirst();
+
+            // Output all packets which are behind all inputs, as long as there is room in the output buffer.
+            void release();
+        };
+    }
+}
@@ -11,7 +11,8 @@
 //
 //  Definitions:
 //  - Main stream: the TS which is processed by tsp, including this plugin.
-//  - Merged stream: the additional TS which is read by this plugin through a pipe.
+//  - Merged stream: the additional TS which is read by this plugin through a pipe
+//    or, with --in-process, from the output of an embedded TSProcessor chain.
 //
 //----------------------------------------------------------------------------
 
@@ -19,6 +20,10 @@
 #include "tsPCRMerger.h"
 #include "tsPSIMerger.h"
 #include "tsTSForkPipe.h"
+#include "tsTSProcessor.h"
+#include "tsArgsWithPlugins.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
 #include "tsTSPacketQueue.h"
 #include "tsPacketInsertionController.h"
 #include "tsThread.h"
@@ -33,7 +38,7 @@
 //----------------------------------------------------------------------------
 
 namespace ts {
-    class MergePlugin: public ProcessorPlugin, private Thread
+    class MergePlugin: public ProcessorPlugin, private Thread, private PluginEventHandlerInterface
     {
         TS_PLUGIN_CONSTRUCTORS(MergePlugin);
     public:
@@ -50,6 +55,7 @@ namespace ts {
         size_t           _max_queue = DEFAULT_MAX_QUEUED_PACKETS;           // Maximum number of queued packets.
         size_t           _accel_threshold = DEFAULT_MAX_QUEUED_PACKETS / 2; // Queue threshold after which insertion is accelerated.
         bool             _no_wait = false;              // Do not wait for command completion.
+        bool             _in_process = false;           // Run the merge command as an embedded TSProcessor chain.
         bool             _merge_psi = false;            // Merge PSI/SI information.
         bool             _pcr_restamp = false;          // Restamp PCR from the merged stream.
         bool             _incremental_pcr = false;      // Use incremental method to restamp PCR's.
@@ -63,6 +69,7 @@ namespace ts {
         PIDSet           _allowed_pids {};              // List of PID's to merge (other PID's from the merged stream are dropped).
         TSPacketLabelSet _set_labels {};                // Labels to set on output packets.
         TSPacketLabelSet _reset_labels {};              // Labels to reset on output packets.
+        TSProcessorArgs  _tsp_args {};                  // Embedded TSProcessor chain, with --in-process.
 
         // The ForkPipe is dynamically allocated to avoid reusing the same object when the command is restarted.
         using TSForkPipePtr = std::shared_ptr<TSForkPipe>;
@@ -81,6 +88,17 @@ namespace ts {
         PSIMerger     _psi_merger {duck, PSIMerger::NONE};  // Used to merge PSI/SI from both streams.
         PacketInsertionController _insert_control {*this};  // Used to control insertion points for the merge
 
+        // With --in-process, the embedded TSProcessor is first started in start(), then restarted
+        // by the receiver thread. It can be aborted from the plugin thread during stop().
+        std::mutex                   _processor_mutex {};
+        std::unique_ptr<TSProcessor> _processor {};
+
+        // Analyze the merge command as a TSProcessor chain, with --in-process.
+        bool loadProcessorArgs();
+
+        // Create and start a new embedded TSProcessor chain, with --in-process.
+        bool startProcessor();
+
         // Start/restart/stop the merge command.
         bool startStopCommand(bool do_close, bool do_start);
 
@@ -88,6 +106,12 @@ namespace ts {
         // them to the main plugin thread. The following method is the thread main code.
         virtual void main() override;
 
+        // Receiver thread code, with --in-process: run the embedded TSProcessor chain until completion.
+        void runProcessor();
+
+        // Receive the output packets of the embedded TSProcessor chain, with --in-process.
+        virtual void handlePluginEvent(const PluginEventContext& context) override;
+
         // Process one packet coming from the merged stream.
         Status processMergePacket(TSPacket&, TSPacketMetadata&);
     };
@@ -111,7 +135,8 @@ ts::MergePlugin::MergePlugin(TSP* tsp_) :
 
     option(u"", 0, STRING, 1, 1);
     help(u"",
-         u"Specifies the command line to execute in the created process.");
+         u"Specifies the command line to execute in the created process. "
+         u"With --in-process, specifies a tsp command line instead.");
 
     option(u"acceleration-threshold", 0, UNSIGNED);
     help(u"acceleration-threshold",
@@ -143,6 +168,16 @@ ts::MergePlugin::MergePlugin(TSP* tsp_) :
          u"Warning: this is a dangerous option which can result in an inconsistent "
          u"transport stream.");
 
+    option(u"in-process");
+    help(u"in-process",
+         u"Run the merged stream as a chain of plugins inside the tsp process, instead of creating a process. "
+         u"The command parameter is not a shell command but a tsp command line, with tsp options, one input plugin "
+         u"and optional packet processor plugins, without output plugin, as in 'tsp -I file input.ts -P zap service'. "
+         u"The first word of the command, the application name, is ignored. "
+         u"The merged packets are directly passed in memory, without pipe and serialization. "
+         u"The option --format is ignored. "
+         u"Because the embedded chain runs in the same process, a plugin which crashes also terminates tsp.");
+
     option(u"incremental-pcr-restamp");
     help(u"incremental-pcr-restamp",
          u"When restamping PCR's from the merged TS into the main TS, compute each new "
@@ -252,6 +287,7 @@ bool ts::MergePlugin::getOptions()
 {
     getValue(_command);
     _no_wait = present(u"no-wait");
+    _in_process = present(u"in-process");
     const bool transparent = present(u"transparent");
     getIntValue(_max_queue, u"max-queue", DEFAULT_MAX_QUEUED_PACKETS);
     getIntValue(_accel_threshold, u"acceleration-threshold", _max_queue / 2);
@@ -274,6 +310,9 @@ bool ts::MergePlugin::getOptions()
         error(u"--restart, --terminate and --joint-termination are mutually exclusive");
         return false;
     }
+    if (_in_process && !loadProcessorArgs()) {
+        return false;
+    }
 
     // Compute list of allowed PID's from the merged stream. Start with all PID's allowed.
     _allowed_pids.set();
@@ -304,6 +343,34 @@ bool ts::MergePlugin::getOptions()
 }
 
 
+//----------------------------------------------------------------------------
+// Analyze the merge command as a TSProcessor chain, with --in-process.
+//----------------------------------------------------------------------------
+
+bool ts::MergePlugin::loadProcessorArgs()
+{
+    // Same options as tsp, exactly one input plugin, no output plugin.
+    ArgsWithPlugins args(1, 1, 0, UNLIMITED_COUNT, 0, 0,
+                         u"Merged stream", u"[tsp-options] -I input [-P processor ...]",
+                         Args::NO_EXIT_ON_ERROR | Args::NO_EXIT_ON_HELP | Args::NO_CONFIG_FILE | Args::HELP_ON_THIS);
+    args.delegateReport(this);
+    DuckContext context(&args);
+    _tsp_args.defineArgs(args);
+
+    // The command line is a tsp command without output plugin. The first word, typically "tsp", is ignored.
+    // It cannot be omitted since the merge command parameter cannot start with an option.
+    if (!args.analyze(_command, false) || !_tsp_args.loadArgs(context, args)) {
+        error(u"invalid in-process merge command: %s", _command);
+        return false;
+    }
+
+    // The output of the chain is directly received in handlePluginEvent().
+    _tsp_args.app_name = u"merge";
+    _tsp_args.output.set(u"memory");
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Start/restart the merge command.
 //----------------------------------------------------------------------------
@@ -392,8 +459,9 @@ bool ts::MergePlugin::start()
     _got_eof = false;
     _stopping = false;
 
-    // Create pipe & process, then start the internal thread which receives the TS to merge.
-    return startStopCommand(false, true) && Thread::start();
+    // Create pipe & process or embedded TSProcessor, then start the internal thread which receives the TS to merge.
+    // Starting the embedded TSProcessor here loads and checks all plugins of the chain.
+    return (_in_process ? startProcessor() : startStopCommand(false, true)) && Thread::start();
 }
 
 
@@ -410,9 +478,17 @@ bool ts::MergePlugin::stop()
     // Send the stop condition to the internal packet queue.
     _queue.stop();
 
-    // Close the pipe and terminate the created process.
+    // Close the pipe and terminate the created process or abort the embedded TSProcessor.
     _stopping = true;
-    startStopCommand(true, false);
+    if (_in_process) {
+        std::lock_guard<std::mutex> lock(_processor_mutex);
+        if (_processor != nullptr) {
+            _processor->abort();
+        }
+    }
+    else {
+        startStopCommand(true, false);
+    }
 
     // Wait for actual thread termination.
     Thread::waitForTermination();
@@ -433,6 +509,12 @@ void ts::MergePlugin::main()
     // When zero, packet queue will compute it from the PCR.
     _queue.setBitrate(_user_bitrate);
 
+    if (_in_process) {
+        runProcessor();
+        debug(u"receiver thread completed");
+        return;
+    }
+
     // Loop on packet reception until the plugin request to stop.
     bool success = true;
     while (success && !_queue.stopped()) {
@@ -483,6 +565,99 @@ void ts::MergePlugin::main()
 }
 
 
+//----------------------------------------------------------------------------
+// Create and start a new embedded TSProcessor chain, with --in-process.
+//----------------------------------------------------------------------------
+
+bool ts::MergePlugin::startProcessor()
+{
+    // A new object is used for each restart, as for the external command.
+    // The mutex prevents a concurrent abort() in stop().
+    std::lock_guard<std::mutex> lock(_processor_mutex);
+    if (_stopping) {
+        return false;
+    }
+    _processor = std::make_unique<TSProcessor>(*this);
+    _processor->registerEventHandler(this, PluginType::OUTPUT);
+    if (!_processor->start(_tsp_args)) {
+        _processor.reset();
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Receiver thread code, with --in-process.
+//----------------------------------------------------------------------------
+
+void ts::MergePlugin::runProcessor()
+{
+    // The first TSProcessor was started in start(). Only this thread deletes or replaces it.
+    for (;;) {
+        // Wait for the end of the merged stream.
+        if (_processor != nullptr) {
+            _processor->waitForTermination();
+        }
+        {
+            std::lock_guard<std::mutex> lock(_processor_mutex);
+            _processor.reset();
+        }
+
+        // Same restart logic as with an external command: a restart failure terminates the merge.
+        if (!_restart || _stopping || _queue.stopped()) {
+            break;
+        }
+        std::this_thread::sleep_for(_restart_interval);
+        info(u"restarting merge command");
+        if (!startProcessor()) {
+            break;
+        }
+    }
+
+    // Signal end-of-file to plugin thread.
+    _queue.setEOF();
+}
+
+
+//----------------------------------------------------------------------------
+// Receive the output packets of the embedded TSProcessor chain.
+// Invoked in the context of the output thread of the embedded TSProcessor.
+//----------------------------------------------------------------------------
+
+void ts::MergePlugin::handlePluginEvent(const PluginEventContext& context)
+{
+    PluginEventData* data = dynamic_cast<PluginEventData*>(context.pluginData());
+    if (data == nullptr) {
+        return;
+    }
+
+    // The output packets are directly copied into the inter-thread queue.
+    const TSPacket* packets = reinterpret_cast<const TSPacket*>(data->data());
+    size_t count = data->size() / PKT_SIZE;
+
+    while (count > 0) {
+        TSPacket* buffer = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        size_t max_pkt_count = 0;
+
+        // Wait for free space in the internal packet queue.
+        if (!_queue.lockWriteBuffer(buffer, mdata, max_pkt_count, std::min<size_t>(count, 16))) {
+            // The plugin thread has signalled a stop condition, abort the embedded TSProcessor.
+            data->setError(true);
+            return;
+        }
+
+        const size_t pkt_count = std::min(count, max_pkt_count);
+        TSPacket::Copy(buffer, packets, pkt_count);
+        TSPacketMetadata::Reset(mdata, pkt_count);
+        _queue.releaseWriteBuffer(pkt_count);
+        packets += pkt_count;
+        count -= pkt_count;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
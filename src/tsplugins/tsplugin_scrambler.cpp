@@ -81,9 +81,14 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
+        // Packets are scrambled by groups in offline mode.
+        static constexpr size_t DEFAULT_PACKET_WINDOW = 256;
+
         // Description of a crypto-period.
         // Each CryptoPeriod object points to its ScramblerPlugin parent object.
         // In case of error in a CryptoPeriod object, the _abort volatile flag
@@ -153,6 +158,7 @@ namespace ts {
         BitRate           _ecm_bitrate = 0;             // ECM PID's bitrate
         PID               _ecm_pid = PID_NULL;          // PID for ECM
         PacketCounter     _partial_scrambling = 0;      // Do not scramble all packets if > 1
+        size_t            _window_size = 0;             // Packet window size, zero in packet mode
         cn::seconds       _clear_period {0};            // Clear period before scrambling commences
         ECMGClientArgs    _ecmg_args {};                // Parameters for ECMG client
         tlv::Logger       _logger {Severity::Debug, this}; // Message logger for ECMG <=> SCS protocol
@@ -182,6 +188,10 @@ namespace ts {
         size_t            _current_ecm = 0;             // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling {*this};          // Scrambler
         CyclingPacketizer _pzer_pmt {duck};             // Packetizer for modified PMT
+        std::vector<TSPacket*> _batch_packets {};       // Pending batch of packets to scramble (packet window mode)
+
+        // Scramble the pending batch of packets.
+        bool flushBatch();
 
         // Initialize ECM and CP scheduling.
         void initializeScheduling();
@@ -277,6 +287,13 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"Specifying higher values is a way to reduce the scrambling CPU load "
          u"while keeping the service mostly scrambled.");
 
+    option(u"packet-window", 0, UNSIGNED);
+    help(u"packet-window", u"count",
+         u"Scramble packets by groups of 'count' packets. "
+         u"All packets of a group in the same crypto-period are scrambled at once, which is much faster with DVB-CSA2. "
+         u"The default is " + UString::Decimal(DEFAULT_PACKET_WINDOW) + u" packets in offline mode. "
+         u"In real-time mode, the default is zero, meaning one packet at a time, to avoid adding latency.");
+
     option(u"pid", 'p', PIDVAL, 0, UNLIMITED_COUNT);
     help(u"pid", u"pid1[-pid2]",
          u"Scramble packets with these PID values. "
@@ -342,6 +359,7 @@ bool ts::ScramblerPlugin::getOptions()
     _pre_reduce_cw = present(u"pre-reduce-cw");
     getChronoValue(_clear_period, u"clear-period", cn::seconds(0));
     getIntValue(_partial_scrambling, u"partial-scrambling", 1);
+    getIntValue(_window_size, u"packet-window", tsp->realtime() ? 0 : DEFAULT_PACKET_WINDOW);
     getIntValue(_ecm_pid, u"pid-ecm", PID_NULL);
     getValue(_ecm_bitrate, u"bitrate-ecm", DEFAULT_ECM_BITRATE);
     getHexaValue(_ca_desc_private, u"private-data");
@@ -401,6 +419,7 @@ bool ts::ScramblerPlugin::start()
     _delay_start = cn::milliseconds(0);
     _current_cw = 0;
     _current_ecm = 0;
+    _batch_packets.clear();
 
     // As long as the bitrate is unknown, delay changes to infinite.
     _pkt_insert_ecm = _pkt_change_cw = _pkt_change_ecm = std::numeric_limits<PacketCounter>::max();
@@ -680,6 +699,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // In packet window mode, scramble pending packets with the previous CW.
+    if (!flushBatch()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -848,8 +872,11 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
         _partial_clear = _partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
+    // Scramble the packet payload, now in packet mode, later in packet window mode.
+    if (_window_size > 0) {
+        _batch_packets.push_back(&pkt);
+    }
+    else if (!_scrambling.encrypt(pkt)) {
         return TSP_END;
     }
     _scrambled_count++;
@@ -858,6 +885,49 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Packet window processing.
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::getPacketWindowSize()
+{
+    return _window_size;
+}
+
+size_t ts::ScramblerPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Process packets in sequence, as in packet mode, but accumulate the packets to scramble.
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    for (size_t i = 0; i < win.size(); ++i) {
+        if (win.get(i, pkt, pkt_data)) {
+            switch (processPacket(*pkt, *pkt_data)) {
+                case TSP_OK:
+                    break;
+                case TSP_NULL:
+                    win.nullify(i);
+                    break;
+                case TSP_DROP:
+                    win.drop(i);
+                    break;
+                case TSP_END:
+                default:
+                    flushBatch();
+                    return i;
+            }
+        }
+    }
+    return flushBatch() ? win.size() : 0;
+}
+
+bool ts::ScramblerPlugin::flushBatch()
+{
+    const bool ok = _scrambling.encryptBatch(_batch_packets.data(), _batch_packets.size());
+    _batch_packets.clear();
+    return ok;
+}
+
+
 //----------------------------------------------------------------------------
 // Initialize first crypto period.
 //----------------------------------------------------------------------------
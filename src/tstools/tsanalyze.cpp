@@ -13,11 +13,19 @@
 #include "tsMain.h"
 #include "tsTSAnalyzerReport.h"
 #include "tsTSAnalyzerOptions.h"
+#include "tsTSChunkAnalyzer.h"
 #include "tsTSFile.h"
 #include "tsPagerArgs.h"
 #include "tsDuckContext.h"
+#include "tsFileUtils.h"
+#include "tsThread.h"
+#include "tsjsonObject.h"
 TS_MAIN(MainCode);
 
+#define PKT_BUFFER_COUNT 1024  // Number of packets to read at a time in input files.
+#define DEF_WIDTH         79   // Default width of batch summary, same as analysis reports.
+#define WIDE_WIDTH        94   // Wide display.
+
 
 //----------------------------------------------------------------------------
 //  Command line options
@@ -32,7 +40,11 @@ namespace {
 
         ts::DuckContext       duck {this};         // TSDuck execution context.
         ts::BitRate           bitrate = 0;         // Expected bitrate (188-byte packets)
-        fs::path              infile {};           // Input file name
+        ts::UStringVector     infiles {};          // Input file names
+        bool                  batch = false;       // Batch mode, analyze several files.
+        size_t                threads = 0;         // Max number of files to analyze in parallel.
+        size_t                chunks = 1;          // Number of chunks to analyze in parallel in one file.
+        ts::PacketCounter     chunk_context = 0;   // Number of context packets before each chunk.
         ts::TSPacketFormat    format = ts::TSPacketFormat::AUTODETECT; // Input file format.
         ts::TSAnalyzerOptions analysis {};         // Analysis options.
         ts::PagerArgs         pager {true, true};  // Output paging options.
@@ -40,7 +52,7 @@ namespace {
 }
 
 Options::Options(int argc, char *argv[]) :
-    ts::Args(u"Analyze the structure of a transport stream", u"[options] [filename]")
+    ts::Args(u"Analyze the structure of a transport stream", u"[options] [filename ...]")
 {
     // Define all standard analysis options.
     duck.defineArgsForStandards(*this);
@@ -51,8 +63,11 @@ Options::Options(int argc, char *argv[]) :
     analysis.defineArgs(*this);
     ts::DefineTSPacketFormatInputOption(*this);
 
-    option(u"", 0, FILENAME, 0, 1);
-    help(u"", u"Input transport stream file (standard input if omitted).");
+    option(u"", 0, FILENAME, 0, UNLIMITED_COUNT);
+    help(u"",
+         u"Input transport stream files (standard input if omitted). "
+         u"When more than one file, a directory or a wildcard is specified, "
+         u"all files are analyzed in batch mode, see option --threads.");
 
     option<ts::BitRate>(u"bitrate", 'b');
     help(u"bitrate",
@@ -60,6 +75,23 @@ Options::Options(int argc, char *argv[]) :
          u"(based on 188-byte packets). By default, the bitrate is "
          u"evaluated using the PCR in the transport stream.");
 
+    option(u"chunks", 0, POSITIVE);
+    help(u"chunks",
+         u"Split one large input file in the specified number of chunks which are analyzed in parallel. "
+         u"The input file must be a regular file. The analyses of all chunks are merged into one single report. "
+         u"By default, the file is analyzed sequentially. This option is ignored in batch mode.");
+
+    option(u"chunk-context", 0, POSITIVE);
+    help(u"chunk-context", u"count",
+         u"With --chunks, specify the number of packets which are read before each chunk to collect the PSI/SI context. "
+         u"It must be large enough to include all signalization tables (PAT, PMT, etc). "
+         u"The default is " + ts::UString::Decimal(ts::TSChunkAnalyzer::DEFAULT_CONTEXT_PACKETS) + u" packets.");
+
+    option(u"threads", 0, POSITIVE);
+    help(u"threads",
+         u"In batch mode, specify the maximum number of files which are analyzed in parallel. "
+         u"By default, use as many threads as CPU cores in the system.");
+
     analyze(argc, argv);
 
     // Define all standard analysis options.
@@ -67,14 +99,359 @@ Options::Options(int argc, char *argv[]) :
     pager.loadArgs(duck, *this);
     analysis.loadArgs(duck, *this);
 
-    getPathValue(infile, u"");
     getValue(bitrate, u"bitrate");
+    getIntValue(threads, u"threads", std::max<size_t>(1, std::thread::hardware_concurrency()));
+    getIntValue(chunks, u"chunks", 1);
+    getIntValue(chunk_context, u"chunk-context", ts::TSChunkAnalyzer::DEFAULT_CONTEXT_PACKETS);
     format = ts::LoadTSPacketFormatInputOption(*this);
 
+    // Expand directories and wildcards in input file names.
+    ts::UStringVector params;
+    getValues(params, u"");
+    for (const auto& name : params) {
+        std::error_code err;
+        if (!name.empty() && fs::is_directory(name, err)) {
+            // Analyze all regular files in the directory, in alphabetical order.
+            ts::UStringVector files;
+            for (const auto& entry : fs::directory_iterator(fs::path(name), err)) {
+                if (entry.is_regular_file(err)) {
+                    files.push_back(entry.path());
+                }
+            }
+            if (err) {
+                error(u"error reading directory %s: %s", name, err.message());
+            }
+            std::sort(files.begin(), files.end());
+            infiles.insert(infiles.end(), files.begin(), files.end());
+            batch = true;
+        }
+        else if (name.contains(u'*') || name.contains(u'?')) {
+            if (!ts::ExpandWildcardAndAppend(infiles, name)) {
+                error(u"error expanding wildcard %s", name);
+            }
+            batch = true;
+        }
+        else {
+            infiles.push_back(name);
+        }
+    }
+    batch = batch || infiles.size() > 1;
+
+    if (batch) {
+        if (infiles.empty()) {
+            error(u"no input file found");
+        }
+        for (const auto& name : infiles) {
+            if (name.empty() || name == u"-") {
+                error(u"standard input cannot be used in batch mode");
+                break;
+            }
+        }
+    }
+
     exitOnError();
 }
 
 
+//----------------------------------------------------------------------------
+// Analyze all packets of a file.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool AnalyzeFile(ts::TSAnalyzer& analyzer, const fs::path& filename, ts::TSPacketFormat format, ts::Report& report)
+    {
+        ts::TSFile file;
+        if (!file.openRead(filename, 1, 0, report, format)) {
+            return false;
+        }
+        ts::TSPacketVector pkt(PKT_BUFFER_COUNT);
+        ts::TSPacketMetadataVector mdata(PKT_BUFFER_COUNT);
+        size_t count = 0;
+        while ((count = file.readPackets(pkt.data(), mdata.data(), pkt.size(), report)) > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                analyzer.feedPacket(pkt[i], mdata[i]);
+            }
+        }
+        return file.close(report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Analysis of one file in batch mode.
+//----------------------------------------------------------------------------
+
+namespace {
+    class FileAnalysis: public ts::Report
+    {
+        TS_NOBUILD_NOCOPY(FileAnalysis);
+    public:
+        // Constructor.
+        FileAnalysis(Options& opt, const ts::DuckContext::SavedArgs& duck_args, const ts::UString& filename);
+
+        // Analyze the file, in the context of a worker thread.
+        void analyze();
+
+        // Report the analysis, in the context of the main thread.
+        void report(std::ostream& out, ts::TSAnalyzer::Statistics& stats);
+
+        // Analysis status.
+        bool success() const { return _success; }
+
+    protected:
+        // Implementation of Report: messages are logged later, in the main thread.
+        virtual void writeLog(int severity, const ts::UString& message) override;
+
+    private:
+        Options&                _opt;
+        const ts::UString       _filename;
+        bool                    _success = false;
+        ts::DuckContext         _duck {this};
+        ts::TSAnalyzerReport    _analyzer {_duck, _opt.bitrate, ts::BitRateConfidence::OVERRIDE};
+        std::list<std::pair<int, ts::UString>> _messages {};
+
+        // Log all buffered messages on the main report.
+        void flushLog();
+    };
+}
+
+FileAnalysis::FileAnalysis(Options& opt, const ts::DuckContext::SavedArgs& duck_args, const ts::UString& filename) :
+    ts::Report(opt.maxSeverity(), filename + u": "),
+    _opt(opt),
+    _filename(filename)
+{
+    _duck.restoreArgs(duck_args);
+    _analyzer.setAnalysisOptions(_opt.analysis);
+}
+
+void FileAnalysis::writeLog(int severity, const ts::UString& message)
+{
+    _messages.emplace_back(severity, message);
+}
+
+void FileAnalysis::flushLog()
+{
+    for (const auto& msg : _messages) {
+        _opt.log(msg.first, msg.second);
+    }
+    _messages.clear();
+}
+
+void FileAnalysis::analyze()
+{
+    _success = AnalyzeFile(_analyzer, _filename, _opt.format, *this);
+}
+
+void FileAnalysis::report(std::ostream& out, ts::TSAnalyzer::Statistics& stats)
+{
+    if (_success) {
+        // Each report is titled with the file name.
+        const ts::UString title(_opt.analysis.title);
+        _opt.analysis.title = title.empty() ? _filename : title + u" - " + _filename;
+        _analyzer.report(out, _opt.analysis, _opt);
+        _opt.analysis.title = title;
+        _analyzer.getStatistics(stats);
+    }
+    flushLog();
+}
+
+
+//----------------------------------------------------------------------------
+// Batch analysis of several files in parallel.
+//----------------------------------------------------------------------------
+
+namespace {
+    class BatchAnalysis
+    {
+        TS_NOBUILD_NOCOPY(BatchAnalysis);
+    public:
+        // Constructor.
+        BatchAnalysis(Options& opt);
+
+        // Analyze all files, report them in order, then report the summary.
+        // Return true if all files were successfully analyzed.
+        bool run();
+
+    private:
+        // Worker thread, analyzing files one after the other.
+        class Worker: public ts::Thread
+        {
+            TS_NOBUILD_NOCOPY(Worker);
+        public:
+            Worker(BatchAnalysis& batch) : _batch(batch) {}
+            virtual ~Worker() override { waitForTermination(); }
+        private:
+            BatchAnalysis& _batch;
+            virtual void main() override { _batch.analyzeFiles(); }
+        };
+
+        using FileAnalysisPtr = std::unique_ptr<FileAnalysis>;
+
+        Options&                     _opt;
+        ts::DuckContext::SavedArgs   _duck_args {};
+        const size_t                 _max_pending;       // Max number of analyzed files waiting to be reported.
+        std::mutex                   _mutex {};
+        std::condition_variable      _cond {};           // Signaled when a file is analyzed or reported.
+        size_t                       _next_analysis = 0; // Index of next file to analyze.
+        size_t                       _next_report = 0;   // Index of next file to report.
+        std::vector<FileAnalysisPtr> _results {};        // Completed analyses, waiting to be reported.
+
+        // Analyze files until there is none left, in the context of a worker thread.
+        void analyzeFiles();
+
+        // Report the aggregated statistics of all files.
+        void reportSummary(std::ostream& out, const ts::TSAnalyzer::Statistics& stats, size_t failed);
+    };
+}
+
+BatchAnalysis::BatchAnalysis(Options& opt) :
+    _opt(opt),
+    _max_pending(2 * opt.threads),
+    _results(opt.infiles.size())
+{
+    _opt.duck.saveArgs(_duck_args);
+}
+
+void BatchAnalysis::analyzeFiles()
+{
+    for (;;) {
+        // Get the next file to analyze. Don't run too far ahead of the reports to limit memory usage.
+        size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this]() { return _next_analysis >= _opt.infiles.size() || _next_analysis < _next_report + _max_pending; });
+            if (_next_analysis >= _opt.infiles.size()) {
+                return;
+            }
+            index = _next_analysis++;
+        }
+
+        // Analyze the file outside the lock.
+        auto fa = std::make_unique<FileAnalysis>(_opt, _duck_args, _opt.infiles[index]);
+        fa->analyze();
+
+        // Post the analysis for the main thread.
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _results[index] = std::move(fa);
+        }
+        _cond.notify_all();
+    }
+}
+
+bool BatchAnalysis::run()
+{
+    const size_t count = _opt.infiles.size();
+    _opt.debug(u"analyzing %d files using %d threads", count, _opt.threads);
+
+    // Start the worker threads.
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (size_t i = 0; i < std::min(count, _opt.threads); ++i) {
+        workers.push_back(std::make_unique<Worker>(*this));
+        workers.back()->start();
+    }
+
+    // Report analyses in the order of the files, as soon as they are available.
+    std::ostream& out(_opt.pager.output(_opt));
+    ts::TSAnalyzer::Statistics total;
+    size_t failed = 0;
+    for (size_t index = 0; index < count; ++index) {
+        FileAnalysisPtr fa;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this, index]() { return _results[index] != nullptr; });
+            fa = std::move(_results[index]);
+            _next_report = index + 1;
+        }
+        _cond.notify_all();
+
+        ts::TSAnalyzer::Statistics stats;
+        fa->report(out, stats);
+        if (fa->success()) {
+            total.packets += stats.packets;
+            total.invalid_sync += stats.invalid_sync;
+            total.transport_errors += stats.transport_errors;
+            total.suspect_ignored += stats.suspect_ignored;
+            total.unexp_discont += stats.unexp_discont;
+            total.duplicated += stats.duplicated;
+            total.services += stats.services;
+            total.pids += stats.pids;
+            total.duration += stats.duration;
+        }
+        else {
+            failed++;
+        }
+    }
+    workers.clear();
+
+    reportSummary(out, total, failed);
+    return failed == 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Report the aggregated statistics of all files.
+//----------------------------------------------------------------------------
+
+void BatchAnalysis::reportSummary(std::ostream& out, const ts::TSAnalyzer::Statistics& stats, size_t failed)
+{
+    const size_t analyzed = _opt.infiles.size() - failed;
+
+    // Average bitrate of all analyzed files, when the total duration is known.
+    const ts::BitRate bitrate(stats.duration.count() <= 0 ? 0 :
+        ts::BitRate(stats.packets * ts::PKT_SIZE_BITS) * 1000 / stats.duration.count());
+
+    if (_opt.analysis.json.useJSON()) {
+        ts::json::Object root;
+        if (!_opt.analysis.title.empty()) {
+            root.add(u"title", _opt.analysis.title);
+        }
+        ts::json::Value& jv(root.query(u"summary", true));
+        jv.add(u"files", _opt.infiles.size());
+        jv.add(u"analyzed", analyzed);
+        jv.add(u"failed", failed);
+        jv.add(u"packets", stats.packets);
+        jv.add(u"bytes", stats.packets * ts::PKT_SIZE);
+        jv.add(u"invalid-sync", stats.invalid_sync);
+        jv.add(u"transport-errors", stats.transport_errors);
+        jv.add(u"suspect-ignored", stats.suspect_ignored);
+        jv.add(u"unexpected-discontinuities", stats.unexp_discont);
+        jv.add(u"duplicated", stats.duplicated);
+        jv.add(u"services", stats.services);
+        jv.add(u"pids", stats.pids);
+        jv.add(u"duration", cn::duration_cast<cn::seconds>(stats.duration).count());
+        jv.add(u"bitrate", bitrate.toInt());
+        _opt.analysis.json.report(root, out, _opt);
+    }
+    else {
+        ts::Grid grid(out);
+        grid.setLineWidth(_opt.analysis.wide ? WIDE_WIDTH : DEF_WIDTH, 2);
+        grid.openTable();
+        grid.putLine(u"BATCH ANALYSIS SUMMARY", _opt.analysis.title);
+        grid.section();
+        grid.setLayout({grid.bothTruncateLeft(42, u'.'), grid.border(), grid.bothTruncateLeft(26, u'.')});
+        grid.putLayout({{u"Files:", ts::UString::Decimal(_opt.infiles.size())},
+                        {u"Analyzed:", ts::UString::Decimal(analyzed)}});
+        grid.putLayout({{u"TS packets:", ts::UString::Decimal(stats.packets)},
+                        {u"Failed:", ts::UString::Decimal(failed)}});
+        grid.putLayout({{u"   With invalid sync:", ts::UString::Decimal(stats.invalid_sync)},
+                        {u"Services:", ts::UString::Decimal(stats.services)}});
+        grid.putLayout({{u"   With transport error:", ts::UString::Decimal(stats.transport_errors)},
+                        {u"PID's:", ts::UString::Decimal(stats.pids)}});
+        grid.putLayout({{u"   Suspect and ignored:", ts::UString::Decimal(stats.suspect_ignored)},
+                        {u"", u""}});
+        grid.putLayout({{u"Unexpected discontinuities:", ts::UString::Decimal(stats.unexp_discont)},
+                        {u"Duplicated:", ts::UString::Decimal(stats.duplicated)}});
+        grid.subSection();
+        grid.setLayout({grid.bothTruncateLeft(73, u'.')});
+        const cn::seconds::rep sec = cn::duration_cast<cn::seconds>(stats.duration).count();
+        grid.putLayout({{u"Total broadcast time:", sec == 0 ? u"Unknown" : ts::UString::Format(u"%d sec (%d min %d sec)", sec, sec / 60, sec % 60)}});
+        grid.putLayout({{u"Average bitrate:", bitrate == 0 ? u"Unknown" : ts::UString::Format(u"%'d b/s", bitrate)}});
+        grid.closeTable();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -84,24 +461,24 @@ int MainCode(int argc, char *argv[])
     // Decode command line options.
     Options opt(argc, argv);
 
+    // Batch mode, analyze files in parallel.
+    if (opt.batch) {
+        BatchAnalysis batch(opt);
+        return batch.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     // Configure the TS analyzer.
     ts::TSAnalyzerReport analyzer(opt.duck, opt.bitrate, ts::BitRateConfidence::OVERRIDE);
     analyzer.setAnalysisOptions(opt.analysis);
 
-    // Open the TS file.
-    ts::TSFile file;
-    if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
+    // Analyze all packets in the file, possibly in parallel chunks.
+    const fs::path filename(opt.infiles.empty() ? fs::path() : fs::path(opt.infiles.front()));
+    ts::TSChunkAnalyzer chunks(opt.chunks);
+    chunks.setContextPacketCount(opt.chunk_context);
+    if (!(opt.chunks > 1 ? chunks.analyzeFile(analyzer, filename, opt.format, opt) : AnalyzeFile(analyzer, filename, opt.format, opt))) {
         return EXIT_FAILURE;
     }
 
-    // Analyze all packets in the file.
-    ts::TSPacket pkt;
-    ts::TSPacketMetadata mdata;
-    while (file.readPackets(&pkt, &mdata, 1, opt) > 0) {
-        analyzer.feedPacket(pkt, mdata);
-    }
-    file.close(opt);
-
     // Display analysis results.
     analyzer.report(opt.pager.output(opt), opt.analysis, opt);
 
@@ -15,6 +15,7 @@
 #include "tsOutputRedirector.h"
 #include "tsByteBlock.h"
 #include "tsTS.h"
+#include "tsTSPacket.h"
 TS_MAIN(MainCode);
 
 #define MIN_SYNC_SIZE       (1024)              // 1 kB
@@ -286,27 +287,28 @@ int MainCode(int argc, char *argv[])
         uint8_t* const end_search = sync_end - search_size + 1;
 
         // Search a range of valid packets. Try all expected packet sizes.
-        const uint8_t* start;
-        for (start = sync_buf; start < end_search; start++) {
-            if (opt.packet_size > 0) {
-                if (resync.checkSync(start, search_size, opt.packet_size, opt.header_size)) {
-                    // Found user-specified encapsulation of TS packets
-                    break;
-                }
-            }
-            else {
-                if (resync.checkSync(start, search_size, ts::PKT_SIZE, 0)) {
-                    // Found standard TS packets
-                    break;
-                }
-                if (resync.checkSync(start, search_size, ts::PKT_RS_SIZE, 0)) {
-                    // Found TS packets with trailing Reed-Solomon outer FEC
-                    break;
-                }
-                if (resync.checkSync(start, search_size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE)) {
-                    // Found TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
-                    break;
-                }
+        // For each packet size, locate the first candidate using the fast sync byte scanner.
+        // At the same position, the first packet size in the list is preferred.
+        std::vector<std::pair<size_t, size_t>> formats;  // packet size, header size
+        if (opt.packet_size > 0) {
+            // User-specified encapsulation of TS packets
+            formats.push_back({opt.packet_size, opt.header_size});
+        }
+        else {
+            // Standard TS packets, TS packets with trailing Reed-Solomon outer FEC,
+            // TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
+            formats.push_back({ts::PKT_SIZE, 0});
+            formats.push_back({ts::PKT_RS_SIZE, 0});
+            formats.push_back({ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE});
+        }
+        const size_t search_range = end_search - sync_buf;
+        const uint8_t* start = end_search;
+        for (const auto& fmt : formats) {
+            // All complete packets in search_size bytes must be valid.
+            const size_t count = search_size / fmt.first;
+            const size_t index = count == 0 ? 0 : ts::TSPacket::FindSync(sync_buf, search_range - 1 + count * fmt.first, fmt.first, fmt.second, count);
+            if (index != ts::NPOS && sync_buf + index < start && resync.checkSync(sync_buf + index, search_size, fmt.first, fmt.second)) {
+                start = sync_buf + index;
             }
         }
         if (resync.inputPacketSize() == 0) {
@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsByteBlock.h"
+#include "tsByteBlockPool.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
 #include "tsunit.h"
@@ -26,6 +27,7 @@ class ByteBlockTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(Find);
     TSUNIT_DECLARE_TEST(Append);
     TSUNIT_DECLARE_TEST(File);
+    TSUNIT_DECLARE_TEST(Pool);
 
 public:
     virtual void beforeTest() override;
@@ -262,3 +264,63 @@ TSUNIT_DEFINE_TEST(File)
     TSUNIT_EQUAL(999, bb1.size());
     TSUNIT_ASSERT(bb1 == bb);
 }
+
+TSUNIT_DEFINE_TEST(Pool)
+{
+    const uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    ts::ByteBlockPtr bb3;
+    ts::ByteBlock* bb1_address = nullptr;
+
+    {
+        ts::ByteBlockPool pool(2);
+
+        ts::ByteBlockPtr bb1(pool.allocate(data, sizeof(data)));
+        TSUNIT_EQUAL(5, bb1->size());
+        TSUNIT_ASSERT(*bb1 == ts::ByteBlock(data, sizeof(data)));
+        TSUNIT_ASSERT(bb1->capacity() >= ts::ByteBlockPool::MIN_BLOCK_SIZE);
+        bb1_address = bb1.get();
+
+        // Released block is reused in the same size class.
+        bb1.reset();
+        ts::ByteBlockPtr bb2(pool.allocate(40));
+        TSUNIT_EQUAL(40, bb2->size());
+        TSUNIT_ASSERT(bb2.get() == bb1_address);
+
+        // Different size class.
+        bb3 = pool.allocate(1000);
+        TSUNIT_EQUAL(1000, bb3->size());
+        TSUNIT_ASSERT(bb3.get() != bb1_address);
+        TSUNIT_ASSERT(bb3->capacity() >= 1024);
+
+        // Too large for the pool.
+        ts::ByteBlockPtr bb4(pool.allocate(10000));
+        TSUNIT_EQUAL(10000, bb4->size());
+
+        const ts::ByteBlockPool::Statistics stats(pool.statistics());
+        TSUNIT_EQUAL(4, stats.allocations);
+        TSUNIT_EQUAL(1, stats.reused);
+        TSUNIT_EQUAL(2, stats.heap_allocations);
+        TSUNIT_EQUAL(1, stats.oversized);
+        TSUNIT_EQUAL(0, stats.deallocations);
+
+        // A block which was shrunk below the smallest class is deallocated.
+        bb2->clear();
+        bb2->shrink_to_fit();
+        TSUNIT_ASSERT(bb2->capacity() < ts::ByteBlockPool::MIN_BLOCK_SIZE);
+        bb2.reset();
+        TSUNIT_EQUAL(1, pool.statistics().deallocations);
+
+        // Released blocks beyond the maximum number of free blocks per class are deallocated.
+        ts::ByteBlockPtr bb5(pool.allocate(10));
+        ts::ByteBlockPtr bb6(pool.allocate(10));
+        ts::ByteBlockPtr bb7(pool.allocate(10));
+        bb5.reset();
+        bb6.reset();
+        bb7.reset();
+        TSUNIT_EQUAL(2, pool.statistics().deallocations);
+    }
+
+    // The pool is gone but its blocks remain valid.
+    TSUNIT_EQUAL(1000, bb3->size());
+    bb3.reset();
+}
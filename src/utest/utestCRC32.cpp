@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsCRC32.h"
+#include "tsByteBlock.h"
 #include "tsunit.h"
 #include "utestTSUnitBenchmark.h"
 
@@ -22,11 +23,29 @@
 class CRC32Test: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(CRC);
+    TSUNIT_DECLARE_TEST(Portable);
+    TSUNIT_DECLARE_TEST(Backends);
+    TSUNIT_DECLARE_TEST(Benchmark);
+
+public:
+    virtual void afterTest() override;
 };
 
 TSUNIT_REGISTER(CRC32Test);
 
 
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite cleanup method.
+void CRC32Test::afterTest()
+{
+    // Always restore the default CRC32 implementation.
+    ts::CRC32::EnableAcceleration(true);
+}
+
+
 //----------------------------------------------------------------------------
 // Unitary tests.
 //----------------------------------------------------------------------------
@@ -160,3 +179,84 @@ TSUNIT_DEFINE_TEST(CRC)
 
     bench.report(u"CRC32Test::testCRC");
 }
+
+TSUNIT_DEFINE_TEST(Portable)
+{
+    // Same test vectors, using the portable implementation only.
+    ts::CRC32::EnableAcceleration(false);
+    TSUNIT_ASSERT(!ts::CRC32::IsAccelerated());
+
+    for (const auto* data = all_data; data->data_size != 0; ++data) {
+        ts::CRC32 c(data->data, data->data_size);
+        TSUNIT_EQUAL(data->crc, c.value());
+        c.reset();
+        for (size_t i = 0; i < data->data_size; ++i) {
+            c.add(data->data + i, 1);
+        }
+        TSUNIT_EQUAL(data->crc, c.value());
+    }
+}
+
+TSUNIT_DEFINE_TEST(Backends)
+{
+    // Compare the accelerated and portable implementations on all sizes and alignments.
+    ts::ByteBlock data(4096 + 16);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 37 + (i >> 8));
+    }
+
+    debug() << "CRC32Test::Backends: accelerated: " << ts::UString::YesNo(ts::CRC32::IsAccelerated()) << std::endl;
+
+    for (size_t offset = 0; offset < 16; offset += 3) {
+        for (size_t size = 0; size <= 4096; size = size < 300 ? size + 1 : size * 2 + 7) {
+            ts::CRC32::EnableAcceleration(false);
+            const uint32_t ref = ts::CRC32(data.data() + offset, size).value();
+            ts::CRC32::EnableAcceleration(true);
+            const ts::CRC32 c1(data.data() + offset, size);
+            TSUNIT_EQUAL(ref, c1.value());
+
+            // Same thing in two parts.
+            ts::CRC32 c2(data.data() + offset, size / 3);
+            c2.add(data.data() + offset + size / 3, size - size / 3);
+            TSUNIT_EQUAL(ref, c2.value());
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(Benchmark)
+{
+    // Compare the throughput of the accelerated and portable implementations.
+    utest::TSUnitBenchmark bench1(u"TSUNIT_CRC32_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_CRC32_ITERATIONS");
+    constexpr size_t size = 64 * 1024;
+    constexpr size_t count = 16;
+
+    ts::ByteBlock data(size);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 13 + (i >> 9));
+    }
+
+    ts::CRC32::EnableAcceleration(false);
+    uint32_t ref = 0;
+    bench1.start();
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        for (size_t i = 0; i < count; ++i) {
+            ref = ts::CRC32(data.data(), data.size()).value();
+        }
+    }
+    bench1.stop();
+
+    ts::CRC32::EnableAcceleration(true);
+    uint32_t crc = 0;
+    bench2.start();
+    for (size_t iter = 0; iter < bench2.iterations; ++iter) {
+        for (size_t i = 0; i < count; ++i) {
+            crc = ts::CRC32(data.data(), data.size()).value();
+        }
+    }
+    bench2.stop();
+
+    TSUNIT_EQUAL(ref, crc);
+    bench1.report(u"CRC32Test::Benchmark, portable (slicing-by-8)", size * count);
+    bench2.report(ts::UString::Format(u"CRC32Test::Benchmark, %s", ts::CRC32::IsAccelerated() ? u"accelerated" : u"portable (no acceleration)"), size * count);
+}
@@ -11,8 +11,10 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCharset.h"
+#include "tsDVBCharTableSingleByte.h"
 #include "tsByteBlock.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 //----------------------------------------------------------------------------
 // The test fixture
@@ -22,6 +24,7 @@ class DVBCharsetTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Repository);
     TSUNIT_DECLARE_TEST(DVB);
+    TSUNIT_DECLARE_TEST(DecodeUTF8);
 };
 
 TSUNIT_REGISTER(DVBCharsetTest);
@@ -57,3 +60,70 @@ TSUNIT_DEFINE_TEST(DVB)
     TSUNIT_EQUAL(str1, ts::DVBCharset::DVB.decoded(dvb1, sizeof(dvb1)));
     TSUNIT_ASSERT(ts::ByteBlock(dvb1, sizeof(dvb1)) == ts::DVBCharset::DVB.encoded(str1.toDecomposedDiacritical()));
 }
+
+TSUNIT_DEFINE_TEST(DecodeUTF8)
+{
+    // Typical event names and descriptions, as found in EIT's, using various character tables.
+    const ts::UString english(u"World News. The latest national and international news stories from the BBC News team, followed by weather.");
+    const ts::UString french(u"Journal télévisé : les grands titres de l'actualité, la météo et un reportage sur les fêtes de fin d'année.");
+    const ts::UString russian(u"Новости. Главные события дня в стране и в мире. Прогноз погоды на завтра.");
+
+    std::vector<ts::ByteBlock> texts;
+    texts.push_back(ts::DVBCharset::DVB.encoded(english));                          // ISO 6937, ASCII only
+    texts.push_back(ts::DVBCharset::DVB.encoded(french));                           // ISO 8859-15
+    texts.push_back(ts::DVBCharset::DVB.encoded(french.toDecomposedDiacritical())); // ISO 6937 with diacritical marks
+    texts.push_back(ts::DVBCharset::DVB.encoded(russian));                          // UTF-8
+    texts.push_back(ts::ByteBlock(1, 0x01));                                        // ISO 8859-5
+    texts.back().append(ts::DVBCharTableSingleByte::RAW_ISO_8859_5.encoded(russian));
+    texts.push_back(ts::ByteBlock(1, 0x15));                                        // UTF-8
+    texts.back().append(english.toUTF8());
+    texts.push_back(ts::ByteBlock({0x15, 'a', 0x80, 'b', 0xF8, 'c', 0xE2, 0x82}));  // invalid UTF-8
+    texts.push_back(ts::ByteBlock({0x1F, 0x01, 'a', 'b', 0xA0, 'c'}));              // unsupported table
+
+    TSUNIT_EQUAL(0x0B, texts[1][0]);
+    TSUNIT_EQUAL(0x15, texts[3][0]);
+
+    // The direct UTF-8 decoding must be identical to the decoding through UTF-16.
+    for (const auto& bb : texts) {
+        ts::UString str;
+        std::string utf8;
+        TSUNIT_EQUAL(ts::DVBCharset::DVB.decode(str, bb.data(), bb.size()), ts::DVBCharset::DVB.decodeUTF8(utf8, bb.data(), bb.size()));
+        TSUNIT_EQUAL(str.toUTF8(), utf8);
+    }
+    std::string utf8;
+    TSUNIT_ASSERT(ts::DVBCharset::DVB.decodeUTF8(utf8, texts[2].data(), texts[2].size()));
+    TSUNIT_EQUAL(french.toUTF8(), utf8);
+    TSUNIT_ASSERT(ts::DVBCharset::DVB.decodeUTF8(utf8, texts[4].data(), texts[4].size()));
+    TSUNIT_EQUAL(russian.toUTF8(), utf8);
+    TSUNIT_ASSERT(ts::DVBCharset::DVB.decodeUTF8(utf8, texts[6].data(), texts[6].size()));
+    TSUNIT_EQUAL("abc", utf8);
+
+    // Compare the performances of the two methods.
+    constexpr size_t count = 20000;
+    size_t data_size = 0;
+    for (const auto& bb : texts) {
+        data_size += count * bb.size();
+    }
+    utest::TSUnitBenchmark bench1(u"TSUNIT_CHARSET_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_CHARSET_ITERATIONS");
+    ts::UString str;
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        bench1.start();
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto& bb : texts) {
+                ts::DVBCharset::DVB.decode(str, bb.data(), bb.size());
+                str.toUTF8(utf8);
+            }
+        }
+        bench1.stop();
+        bench2.start();
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto& bb : texts) {
+                ts::DVBCharset::DVB.decodeUTF8(utf8, bb.data(), bb.size());
+            }
+        }
+        bench2.stop();
+    }
+    bench1.report(u"DVBCharsetTest::DecodeUTF8, through UTF-16", data_size);
+    bench2.report(u"DVBCharsetTest::DecodeUTF8, direct UTF-8", data_size);
+}
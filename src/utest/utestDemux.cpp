@@ -24,6 +24,7 @@
 #include "tsTOT.h"
 #include "tsTDT.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 #include "tables/psi_bat_cplus_packets.h"
 #include "tables/psi_bat_cplus_sections.h"
@@ -66,6 +67,8 @@ class DemuxTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(TDT);
     TSUNIT_DECLARE_TEST(TOT);
     TSUNIT_DECLARE_TEST(HEVC);
+    TSUNIT_DECLARE_TEST(EITSchedule);
+    TSUNIT_DECLARE_TEST(EITSchedulePool);
 
 private:
     // Compare a table with the list of reference sections
@@ -76,6 +79,12 @@ private:
 
     // Unitary test for one table.
     void testTable(const char* name, const uint8_t* ref_packets, size_t ref_packets_size, const uint8_t* ref_sections, size_t ref_sections_size);
+
+    // Build a large EIT schedule, with thousands of XTID on the same PID.
+    static constexpr uint16_t EIT_SERVICE_COUNT = 500;
+    static constexpr ts::TID EIT_TID_COUNT = 8;
+    static constexpr uint8_t EIT_SECTION_COUNT = 2;
+    static void buildEITSchedule(ts::DuckContext& duck, ts::TSPacketVector& packets);
 };
 
 TSUNIT_REGISTER(DemuxTest);
@@ -434,3 +443,126 @@ TSUNIT_DEFINE_TEST(HEVC)
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+// Build a large EIT schedule, with thousands of XTID on the same PID.
+void DemuxTest::buildEITSchedule(ts::DuckContext& duck, ts::TSPacketVector& packets)
+{
+    // Build EIT schedule sections with dummy events.
+    ts::SectionPtrVector sections;
+    std::array<uint8_t, 120> payload {};
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = uint8_t(i);
+    }
+    for (uint16_t srv = 0; srv < EIT_SERVICE_COUNT; ++srv) {
+        for (ts::TID tid = ts::TID_EIT_S_ACT_MIN; tid < ts::TID_EIT_S_ACT_MIN + EIT_TID_COUNT; ++tid) {
+            for (uint8_t sec = 0; sec < EIT_SECTION_COUNT; ++sec) {
+                sections.push_back(std::make_shared<ts::Section>(tid, true, srv, 1, true, sec, EIT_SECTION_COUNT - 1, payload.data(), payload.size(), ts::PID_EIT));
+            }
+        }
+    }
+
+    ts::OneShotPacketizer pzer(duck, ts::PID_EIT);
+    pzer.addSections(sections);
+    pzer.getPackets(packets);
+}
+
+namespace {
+    // Table and section handler which counts tables and sections.
+    class EITCounter: public ts::TableHandlerInterface, public ts::SectionHandlerInterface
+    {
+    public:
+        size_t tables = 0;
+        size_t sections = 0;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override
+        {
+            if (table.isValid()) {
+                tables++;
+            }
+        }
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& section) override
+        {
+            if (section.isValid()) {
+                sections++;
+            }
+        }
+    };
+}
+
+TSUNIT_DEFINE_TEST(EITSchedule)
+{
+    ts::DuckContext duck;
+    utest::TSUnitBenchmark bench(u"TSUNIT_DEMUX_ITERATIONS");
+
+    ts::TSPacketVector packets;
+    buildEITSchedule(duck, packets);
+
+    EITCounter counter;
+    ts::SectionDemux demux(duck, &counter, nullptr, ts::AllPIDs());
+
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        counter.tables = 0;
+        demux.reset();
+        for (const auto& pkt : packets) {
+            demux.feedPacket(pkt);
+        }
+    }
+    bench.stop();
+
+    TSUNIT_EQUAL(size_t(EIT_SERVICE_COUNT) * EIT_TID_COUNT, counter.tables);
+    debug() << "DemuxTest::EITSchedule: " << packets.size() << " packets, " << (counter.tables * EIT_SECTION_COUNT) << " sections" << std::endl;
+    bench.report(u"DemuxTest::EITSchedule");
+}
+
+// Same EIT schedule, with a section handler, with and without pool of sections.
+TSUNIT_DEFINE_TEST(EITSchedulePool)
+{
+    ts::DuckContext duck;
+    utest::TSUnitBenchmark bench1(u"TSUNIT_DEMUX_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_DEMUX_ITERATIONS");
+
+    ts::TSPacketVector packets;
+    buildEITSchedule(duck, packets);
+    const size_t expected_sections = size_t(EIT_SERVICE_COUNT) * EIT_TID_COUNT * EIT_SECTION_COUNT;
+
+    EITCounter counter;
+    ts::SectionDemux demux(duck, &counter, &counter, ts::AllPIDs());
+
+    bench1.start();
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        counter.sections = 0;
+        demux.reset();
+        for (const auto& pkt : packets) {
+            demux.feedPacket(pkt);
+        }
+    }
+    bench1.stop();
+    TSUNIT_EQUAL(expected_sections, counter.sections);
+
+    // Keep enough free blocks in the pool for the complete EIT schedule.
+    ts::ByteBlockPoolPtr pool(std::make_shared<ts::ByteBlockPool>(expected_sections));
+    demux.setBlockPool(pool);
+
+    bench2.start();
+    for (size_t iter = 0; iter < bench2.iterations; ++iter) {
+        counter.sections = 0;
+        demux.reset();
+        for (const auto& pkt : packets) {
+            demux.feedPacket(pkt);
+        }
+    }
+    bench2.stop();
+    TSUNIT_EQUAL(expected_sections, counter.sections);
+
+    // All sections were allocated in the pool. Sections are kept in the demux until
+    // it is reset. After the first iteration, all sections reuse previous blocks.
+    const ts::ByteBlockPool::Statistics stats(pool->statistics());
+    TSUNIT_EQUAL(expected_sections * bench2.iterations, stats.allocations);
+    TSUNIT_EQUAL(stats.allocations, stats.reused + stats.heap_allocations);
+    TSUNIT_EQUAL(expected_sections, stats.heap_allocations);
+
+    debug() << "DemuxTest::EITSchedulePool: " << expected_sections << " sections, pool allocations: " << stats.allocations
+            << ", reused: " << stats.reused << ", heap: " << stats.heap_allocations << ", deallocated: " << stats.deallocations << std::endl;
+    bench1.report(u"DemuxTest::EITSchedulePool, individual allocations");
+    bench2.report(u"DemuxTest::EITSchedulePool, pool of sections");
+}
@@ -0,0 +1,311 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the EIT generator.
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITGenerator.h"
+#include "tsDuckContext.h"
+#include "tsEIT.h"
+#include "tsShortEventDescriptor.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+#include "tsTSPacket.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class EITGeneratorTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(PresentFollowing);
+    TSUNIT_DECLARE_TEST(Schedule300);
+
+private:
+    // Description of a test event in the EPG database.
+    struct TestEvent
+    {
+        uint16_t    event_id = 0;
+        ts::Time    start {};
+        cn::minutes duration {};
+    };
+    using TestEventList = std::vector<TestEvent>;
+
+    // Event id for no present or following event.
+    static constexpr uint16_t NO_EVENT = 0xFFFF;
+
+    // Append a binary event description, with a short event descriptor, and add it in a database.
+    static void AddEvent(ts::ByteBlock& data, TestEventList& database, uint16_t event_id, const ts::Time& start, cn::minutes duration);
+
+    // Decode the next event of an EIT section payload and check it, with its descriptors, against the database.
+    // The data and size are updated. Return the event id.
+    static uint16_t CheckNextEvent(ts::DuckContext& duck, const uint8_t*& data, size_t& size, const TestEventList& database);
+
+    // Decode the EIT p/f and schedule of a service and check them against the database.
+    // The EIT schedule must contain exactly the events in the 'schedule' set.
+    static void CheckEITs(ts::DuckContext& duck, const ts::SectionPtrVector& sections, uint16_t service_id, const TestEventList& database,
+                          const std::set<uint16_t>& schedule, uint16_t present_id, uint16_t following_id);
+
+    // Count events in all EIT schedule sections.
+    static size_t ScheduleEventCount(const ts::SectionPtrVector& sections);
+};
+
+TSUNIT_REGISTER(EITGeneratorTest);
+
+
+//----------------------------------------------------------------------------
+// Test helpers.
+//----------------------------------------------------------------------------
+
+void EITGeneratorTest::AddEvent(ts::ByteBlock& data, TestEventList& database, uint16_t event_id, const ts::Time& start, cn::minutes duration)
+{
+    database.push_back({event_id, start, duration});
+
+    const std::string name(ts::UString::Format(u"Event %d", event_id).toUTF8());
+    const std::string text("Benchmark event");
+    const size_t desc_size = 5 + name.size() + text.size();
+
+    data.appendUInt16(event_id);
+    ts::EncodeMJD(start, data.enlarge(ts::MJDSize(ts::MJD_FULL)), ts::MJD_FULL);
+    data.appendUInt8(ts::EncodeBCD(int(duration.count() / 60)));
+    data.appendUInt8(ts::EncodeBCD(int(duration.count() % 60)));
+    data.appendUInt8(0);
+    data.appendUInt16(uint16_t(0x8000 | (2 + desc_size)));  // running, no CA, descriptor loop length
+    data.appendUInt8(0x4D);                                  // short_event_descriptor
+    data.appendUInt8(uint8_t(desc_size));
+    data.append(std::string("eng"));
+    data.appendUInt8(uint8_t(name.size()));
+    data.append(name);
+    data.appendUInt8(uint8_t(text.size()));
+    data.append(text);
+}
+
+uint16_t EITGeneratorTest::CheckNextEvent(ts::DuckContext& duck, const uint8_t*& data, size_t& size, const TestEventList& database)
+{
+    TSUNIT_ASSERT(size >= ts::EIT::EIT_EVENT_FIXED_SIZE);
+    const uint16_t event_id = ts::GetUInt16(data);
+    ts::Time start;
+    TSUNIT_ASSERT(ts::DecodeMJD(data + 2, ts::MJD_FULL, start));
+    const cn::minutes duration(60 * ts::DecodeBCD(data[7]) + ts::DecodeBCD(data[8]));
+    TSUNIT_EQUAL(0, ts::DecodeBCD(data[9]));
+    const size_t loop_size = ts::GetUInt16(data + 10) & 0x0FFF;
+    TSUNIT_ASSERT(ts::EIT::EIT_EVENT_FIXED_SIZE + loop_size <= size);
+    ts::DescriptorList dlist(nullptr);
+    TSUNIT_ASSERT(dlist.add(data + ts::EIT::EIT_EVENT_FIXED_SIZE, loop_size));
+    data += ts::EIT::EIT_EVENT_FIXED_SIZE + loop_size;
+    size -= ts::EIT::EIT_EVENT_FIXED_SIZE + loop_size;
+
+    const auto expected = std::find_if(database.begin(), database.end(), [event_id](const TestEvent& ev) { return ev.event_id == event_id; });
+    TSUNIT_ASSERT(expected != database.end());
+    TSUNIT_ASSERT(expected->start == start);
+    TSUNIT_EQUAL(expected->duration.count(), duration.count());
+
+    TSUNIT_EQUAL(1, dlist.size());
+    const ts::ShortEventDescriptor desc(duck, *dlist[0]);
+    TSUNIT_ASSERT(desc.isValid());
+    TSUNIT_EQUAL(u"eng", desc.language_code);
+    TSUNIT_EQUAL(ts::UString::Format(u"Event %d", event_id), desc.event_name);
+    TSUNIT_EQUAL(u"Benchmark event", desc.text);
+    return event_id;
+}
+
+void EITGeneratorTest::CheckEITs(ts::DuckContext& duck, const ts::SectionPtrVector& sections, uint16_t service_id, const TestEventList& database,
+                                 const std::set<uint16_t>& schedule, uint16_t present_id, uint16_t following_id)
+{
+    std::set<uint16_t> found;
+    bool present_found = false;
+    bool following_found = false;
+    for (const auto& sec : sections) {
+        if (sec->tableIdExtension() != service_id || (sec->tableId() != ts::TID_EIT_PF_ACT && !ts::EIT::IsSchedule(sec->tableId()))) {
+            continue;
+        }
+        TSUNIT_ASSERT(sec->payloadSize() >= ts::EIT::EIT_PAYLOAD_FIXED_SIZE);
+        const uint8_t* data = sec->payload() + ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+        size_t size = sec->payloadSize() - ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+        if (sec->tableId() == ts::TID_EIT_PF_ACT) {
+            // One section per present or following event, an empty section when there is no event.
+            TSUNIT_ASSERT(sec->sectionNumber() <= 1);
+            const uint16_t expected_id = sec->sectionNumber() == 0 ? present_id : following_id;
+            (sec->sectionNumber() == 0 ? present_found : following_found) = true;
+            if (expected_id == NO_EVENT) {
+                TSUNIT_EQUAL(0, size);
+            }
+            else {
+                TSUNIT_EQUAL(expected_id, CheckNextEvent(duck, data, size, database));
+                TSUNIT_EQUAL(0, size);
+            }
+        }
+        else {
+            while (size > 0) {
+                // Each event must be present only once.
+                TSUNIT_ASSERT(found.insert(CheckNextEvent(duck, data, size, database)).second);
+            }
+        }
+    }
+    TSUNIT_ASSERT(present_found);
+    TSUNIT_ASSERT(following_found);
+    TSUNIT_ASSERT(schedule == found);
+}
+
+size_t EITGeneratorTest::ScheduleEventCount(const ts::SectionPtrVector& sections)
+{
+    size_t count = 0;
+    for (const auto& sec : sections) {
+        if (ts::EIT::IsSchedule(sec->tableId())) {
+            const uint8_t* data = sec->payload() + ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+            size_t size = sec->payloadSize() - std::min(sec->payloadSize(), ts::EIT::EIT_PAYLOAD_FIXED_SIZE);
+            while (size >= ts::EIT::EIT_EVENT_FIXED_SIZE) {
+                const size_t ev_size = std::min(size, ts::EIT::EIT_EVENT_FIXED_SIZE + (ts::GetUInt16(data + 10) & 0x0FFF));
+                data += ev_size;
+                size -= ev_size;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(PresentFollowing)
+{
+    ts::DuckContext duck(&NULLREP);
+    ts::EITGenerator gen(duck, ts::PID_EIT, ts::EITOptions::GEN_ALL);
+    const ts::ServiceIdTriplet srv(10, 1, 1);
+    const ts::Time t0(2025, 3, 10, 22, 0, 0);
+
+    gen.setTransportStreamId(1);
+    gen.setTransportStreamBitRate(30'000'000);
+    gen.setCurrentTime(t0);
+
+    // Event 2 starts after a gap, event 3 crosses midnight.
+    ts::ByteBlock data;
+    TestEventList db;
+    AddEvent(data, db, 1, t0, cn::minutes(30));
+    AddEvent(data, db, 2, t0 + cn::minutes(40), cn::minutes(50));
+    AddEvent(data, db, 3, t0 + cn::minutes(90), cn::minutes(60));
+    AddEvent(data, db, 4, t0 + cn::minutes(150), cn::minutes(30));
+    TSUNIT_ASSERT(gen.loadEvents(srv, data.data(), data.size()));
+
+    ts::SectionPtrVector sections;
+    gen.saveEITs(sections);
+    CheckEITs(duck, sections, 10, db, {1, 2, 3, 4}, 1, 2);
+
+    // In the gap between events 1 and 2.
+    gen.setCurrentTime(t0 + cn::minutes(35));
+    sections.clear();
+    gen.saveEITs(sections);
+    CheckEITs(duck, sections, 10, db, {2, 3, 4}, NO_EVENT, 2);
+
+    // Event 2 starts.
+    gen.setCurrentTime(t0 + cn::minutes(45));
+    sections.clear();
+    gen.saveEITs(sections);
+    CheckEITs(duck, sections, 10, db, {2, 3, 4}, 2, 3);
+
+    // After midnight, during event 4.
+    gen.setCurrentTime(t0 + cn::minutes(160));
+    sections.clear();
+    gen.saveEITs(sections);
+    CheckEITs(duck, sections, 10, db, {4}, 4, NO_EVENT);
+
+    // Back in time, event 4 is not yet started. The past events were already dropped.
+    gen.setCurrentTime(t0 + cn::minutes(80));
+    sections.clear();
+    gen.saveEITs(sections);
+    CheckEITs(duck, sections, 10, db, {4}, NO_EVENT, 4);
+
+    // Delete the following event.
+    TSUNIT_ASSERT(gen.deleteEvent(srv, 4));
+    TSUNIT_ASSERT(!gen.deleteEvent(srv, 4));
+    TSUNIT_ASSERT(!gen.deleteEvent(srv, 3));
+    sections.clear();
+    gen.saveEITs(sections);
+    CheckEITs(duck, sections, 10, db, {}, NO_EVENT, NO_EVENT);
+}
+
+TSUNIT_DEFINE_TEST(Schedule300)
+{
+    // 300 services, events of 30 minutes during 7.5 days.
+    constexpr uint16_t service_count = 300;
+    constexpr size_t event_count = 360;
+    const ts::Time t0(2025, 3, 10, 6, 0, 0);
+
+    // Binary events are the same for all services.
+    ts::ByteBlock data;
+    TestEventList db;
+    std::set<uint16_t> all_ids;
+    for (size_t i = 0; i < event_count; ++i) {
+        all_ids.insert(uint16_t(i + 1));
+        AddEvent(data, db, uint16_t(i + 1), t0 + i * cn::minutes(30), cn::minutes(30));
+    }
+
+    ts::DuckContext duck(&NULLREP);
+    std::unique_ptr<ts::EITGenerator> gen;
+    ts::SectionPtrVector sections;
+
+    // Load the complete EPG, then reload it (all events are duplicates).
+    utest::TSUnitBenchmark bench1(u"TSUNIT_EITGEN_ITERATIONS");
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        gen = std::make_unique<ts::EITGenerator>(duck, ts::PID_EIT, ts::EITOptions::GEN_ALL);
+        gen->setTransportStreamId(1);
+        gen->setTransportStreamBitRate(30'000'000);
+        gen->setCurrentTime(t0);
+        bench1.start();
+        for (int pass = 0; pass < 2; ++pass) {
+            for (uint16_t srv = 1; srv <= service_count; ++srv) {
+                TSUNIT_ASSERT(gen->loadEvents(ts::ServiceIdTriplet(srv, 1, 1), data.data(), data.size()));
+            }
+        }
+        gen->saveEITs(sections);
+        bench1.stop();
+    }
+    TSUNIT_EQUAL(service_count * event_count, ScheduleEventCount(sections));
+    CheckEITs(duck, sections, 1, db, all_ids, 1, 2);
+    CheckEITs(duck, sections, service_count, db, all_ids, 1, 2);
+
+    // Steady state: the clock advances by 10 seconds steps during 26 hours, crossing midnight.
+    // The EIT's are injected in null packets, as in a real stream.
+    constexpr size_t step_count = 26 * 360;
+    constexpr size_t packets_per_step = 50;
+    utest::TSUnitBenchmark bench2(u"TSUNIT_EITGEN_ITERATIONS");
+    for (size_t iter = 0; iter < bench2.iterations; ++iter) {
+        gen = std::make_unique<ts::EITGenerator>(duck, ts::PID_EIT, ts::EITOptions::GEN_ALL);
+        gen->setTransportStreamId(1);
+        gen->setTransportStreamBitRate(30'000'000);
+        gen->setCurrentTime(t0);
+        for (uint16_t srv = 1; srv <= service_count; ++srv) {
+            TSUNIT_ASSERT(gen->loadEvents(ts::ServiceIdTriplet(srv, 1, 1), data.data(), data.size()));
+        }
+        bench2.start();
+        for (size_t step = 1; step <= step_count; ++step) {
+            gen->setCurrentTime(t0 + step * cn::seconds(10));
+            for (size_t i = 0; i < packets_per_step; ++i) {
+                ts::TSPacket pkt(ts::NullPacket);
+                gen->processPacket(pkt);
+            }
+        }
+        bench2.stop();
+    }
+    sections.clear();
+    gen->saveEITs(sections);
+    TSUNIT_EQUAL(service_count * (event_count - 52), ScheduleEventCount(sections));
+    all_ids.erase(all_ids.begin(), all_ids.find(53));
+    CheckEITs(duck, sections, 1, db, all_ids, 53, 54);
+    CheckEITs(duck, sections, service_count, db, all_ids, 53, 54);
+
+    bench1.report(u"EITGeneratorTest::Schedule300, load");
+    bench2.report(u"EITGeneratorTest::Schedule300, steady state");
+}
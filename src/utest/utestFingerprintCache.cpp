@@ -0,0 +1,171 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::FingerprintCache.
+//
+//----------------------------------------------------------------------------
+
+#include "tsFingerprintCache.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class FingerprintCacheTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Fingerprint);
+    TSUNIT_DECLARE_TEST(Insert);
+    TSUNIT_DECLARE_TEST(LeastRecentlyUsed);
+    TSUNIT_DECLARE_TEST(MemoryBound);
+    TSUNIT_DECLARE_TEST(LongRun);
+};
+
+TSUNIT_REGISTER(FingerprintCacheTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Fingerprint)
+{
+    const uint8_t data1[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B};
+    const uint8_t data2[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C};
+
+    TSUNIT_EQUAL(ts::FingerprintCache::Fingerprint(data1, sizeof(data1)), ts::FingerprintCache::Fingerprint(data1, sizeof(data1)));
+    TSUNIT_ASSERT(ts::FingerprintCache::Fingerprint(data1, sizeof(data1)) != ts::FingerprintCache::Fingerprint(data2, sizeof(data2)));
+    TSUNIT_ASSERT(ts::FingerprintCache::Fingerprint(data1, sizeof(data1)) != ts::FingerprintCache::Fingerprint(data1, sizeof(data1) - 1));
+    TSUNIT_ASSERT(ts::FingerprintCache::Fingerprint(data1, 8) != ts::FingerprintCache::Fingerprint(data2, 0));
+}
+
+TSUNIT_DEFINE_TEST(Insert)
+{
+    ts::FingerprintCache cache;
+    TSUNIT_EQUAL(ts::FingerprintCache::DEFAULT_MAX_MEMORY, cache.memorySize());
+    TSUNIT_EQUAL(0, cache.size());
+    TSUNIT_ASSERT(!cache.contains(12));
+
+    TSUNIT_ASSERT(cache.insert(12));
+    TSUNIT_ASSERT(cache.insert(0));
+    TSUNIT_ASSERT(cache.insert(0xFFFFFFFFFFFFFFFF));
+    TSUNIT_ASSERT(!cache.insert(12));
+    TSUNIT_ASSERT(!cache.insert(0));
+    TSUNIT_EQUAL(3, cache.size());
+    TSUNIT_ASSERT(cache.contains(12));
+    TSUNIT_ASSERT(cache.contains(0));
+    TSUNIT_ASSERT(cache.contains(0xFFFFFFFFFFFFFFFF));
+    TSUNIT_ASSERT(!cache.contains(13));
+    TSUNIT_EQUAL(0, cache.evictions());
+
+    cache.clear();
+    TSUNIT_EQUAL(0, cache.size());
+    TSUNIT_ASSERT(!cache.contains(12));
+}
+
+TSUNIT_DEFINE_TEST(LeastRecentlyUsed)
+{
+    // Minimum size: one single set.
+    ts::FingerprintCache cache(0);
+    TSUNIT_EQUAL(ts::FingerprintCache::SET_SIZE, cache.capacity());
+
+    for (uint64_t fp = 1; fp <= ts::FingerprintCache::SET_SIZE; ++fp) {
+        TSUNIT_ASSERT(cache.insert(fp));
+    }
+    TSUNIT_EQUAL(ts::FingerprintCache::SET_SIZE, cache.size());
+    TSUNIT_EQUAL(0, cache.evictions());
+
+    // Touch the oldest one, the second one becomes the least recently used.
+    TSUNIT_ASSERT(!cache.insert(1));
+    TSUNIT_ASSERT(cache.insert(100));
+    TSUNIT_EQUAL(ts::FingerprintCache::SET_SIZE, cache.size());
+    TSUNIT_EQUAL(1, cache.evictions());
+    TSUNIT_ASSERT(cache.contains(1));
+    TSUNIT_ASSERT(!cache.contains(2));
+    TSUNIT_ASSERT(cache.contains(3));
+    TSUNIT_ASSERT(cache.contains(100));
+
+    // contains() does not change the order.
+    TSUNIT_ASSERT(cache.contains(3));
+    TSUNIT_ASSERT(cache.insert(101));
+    TSUNIT_ASSERT(!cache.contains(3));
+    TSUNIT_EQUAL(2, cache.evictions());
+}
+
+TSUNIT_DEFINE_TEST(MemoryBound)
+{
+    // The memory size is rounded down to a power of two number of sets.
+    ts::FingerprintCache cache(100'000);
+    TSUNIT_ASSERT(cache.memorySize() <= 100'000);
+    TSUNIT_ASSERT(cache.memorySize() > 50'000);
+    const size_t capacity = cache.capacity();
+
+    // Insert 4 times the capacity: the size never exceeds the capacity.
+    for (uint64_t fp = 0; fp < 4 * capacity; ++fp) {
+        cache.insert(fp);
+    }
+    debug() << "FingerprintCacheTest::MemoryBound: capacity: " << capacity << ", size: " << cache.size() << ", evictions: " << cache.evictions() << std::endl;
+    TSUNIT_ASSERT(cache.size() <= capacity);
+    TSUNIT_ASSERT(cache.size() > capacity * 9 / 10);
+    TSUNIT_EQUAL(4 * capacity, cache.size() + cache.evictions());
+
+    // Recently inserted fingerprints are mostly kept, the oldest ones are mostly evicted.
+    size_t recent = 0;
+    size_t old = 0;
+    for (uint64_t fp = 0; fp < capacity / 2; ++fp) {
+        recent += cache.contains(4 * capacity - 1 - fp);
+        old += cache.contains(fp);
+    }
+    TSUNIT_ASSERT(recent > capacity / 2 * 9 / 10);
+    TSUNIT_EQUAL(0, old);
+
+    // Changing the maximum memory clears the cache.
+    cache.setMaxMemory(1'000'000);
+    TSUNIT_EQUAL(0, cache.size());
+    TSUNIT_EQUAL(0, cache.evictions());
+    TSUNIT_ASSERT(cache.capacity() > capacity);
+}
+
+TSUNIT_DEFINE_TEST(LongRun)
+{
+    // Simulate a long-running duplicate tracking: a stream of section fingerprints, mostly repeated
+    // from a small working set (recurring tables), plus a continuous flow of new ones (EIT, ECM).
+    constexpr size_t MAX_MEMORY = 1024 * 1024;
+    constexpr size_t SECTION_COUNT = 4'000'000;
+    constexpr size_t WORKING_SET = 1000;
+
+    size_t memory_size = 0;
+    size_t duplicates = 0;
+    uint64_t evictions = 0;
+    utest::TSUnitBenchmark bench(u"TSUNIT_FINGERPRINTCACHE_ITERATIONS");
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        ts::FingerprintCache cache(MAX_MEMORY);
+        duplicates = 0;
+        bench.start();
+        for (size_t i = 0; i < SECTION_COUNT; ++i) {
+            // One section out of 4 is new, the others are from the working set.
+            const uint64_t id = i % 4 == 0 ? WORKING_SET + i : i % WORKING_SET;
+            duplicates += !cache.insert(ts::FingerprintCache::Fingerprint(&id, sizeof(id)));
+        }
+        bench.stop();
+        memory_size = cache.memorySize();
+        evictions = cache.evictions();
+    }
+    bench.report(u"FingerprintCacheTest::LongRun", SECTION_COUNT * sizeof(uint64_t));
+
+    debug() << "FingerprintCacheTest::LongRun: memory: " << memory_size << " bytes, duplicates: " << duplicates << ", evictions: " << evictions << std::endl;
+
+    // The memory is bounded, old fingerprints are evicted but the recurring ones are always detected.
+    TSUNIT_ASSERT(memory_size <= MAX_MEMORY);
+    TSUNIT_ASSERT(evictions > 0);
+    // Only the first occurrence of each section of the working set is not a duplicate.
+    static_assert(WORKING_SET % 4 == 0);
+    TSUNIT_EQUAL(3 * (SECTION_COUNT - WORKING_SET) / 4, duplicates);
+}
@@ -11,6 +11,10 @@
 //----------------------------------------------------------------------------
 
 #include "tshlsPlayList.h"
+#include "tshlsSegmentPrefetcher.h"
+#include "tsTSPacket.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
 #include "tsunit.h"
 
 
@@ -25,6 +29,8 @@ class HLSTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(MediaPlaylist);
     TSUNIT_DECLARE_TEST(BuildMasterPlaylist);
     TSUNIT_DECLARE_TEST(BuildMediaPlaylist);
+    TSUNIT_DECLARE_TEST(PrefetchVOD);
+    TSUNIT_DECLARE_TEST(PrefetchLive);
 
 public:
     virtual void beforeTest() override;
@@ -32,6 +38,16 @@ public:
 
 private:
     int _previousSeverity = 0;
+    fs::path _tempDir {};
+
+    // Create a media segment file: segment 'index' contains 'index + 1' packets with payload bytes 'index'.
+    void createSegment(size_t index);
+
+    // Create a media playlist file with segments 0 to count-1.
+    fs::path createPlaylist(size_t count, bool end_list);
+
+    // Check the content of a segment.
+    static bool checkSegment(const ts::ByteBlock& data, size_t index);
 };
 
 TSUNIT_REGISTER(HLSTest);
@@ -48,12 +64,62 @@ void HLSTest::beforeTest()
     if (tsunit::Test::debugMode()) {
         CERR.setMaxSeverity(ts::Severity::Debug);
     }
+    if (_tempDir.empty()) {
+        _tempDir = ts::TempFile(u"");
+    }
+    fs::remove_all(_tempDir, &ts::ErrCodeReport());
+    fs::create_directories(_tempDir, &ts::ErrCodeReport());
 }
 
 // Test suite cleanup method.
 void HLSTest::afterTest()
 {
     CERR.setMaxSeverity(_previousSeverity);
+    fs::remove_all(_tempDir, &ts::ErrCodeReport());
+}
+
+
+//----------------------------------------------------------------------------
+// Test helpers.
+//----------------------------------------------------------------------------
+
+void HLSTest::createSegment(size_t index)
+{
+    ts::ByteBlock data;
+    for (size_t i = 0; i <= index; ++i) {
+        ts::TSPacket pkt;
+        pkt.init(0x0100, uint8_t(i), uint8_t(index));
+        data.append(pkt.b, ts::PKT_SIZE);
+    }
+    TSUNIT_ASSERT(data.saveToFile(_tempDir / ts::UString::Format(u"seg-%03d.ts", index), &CERR));
+}
+
+fs::path HLSTest::createPlaylist(size_t count, bool end_list)
+{
+    ts::UStringList lines {u"#EXTM3U", u"#EXT-X-VERSION:3", u"#EXT-X-TARGETDURATION:1", u"#EXT-X-MEDIA-SEQUENCE:0"};
+    for (size_t i = 0; i < count; ++i) {
+        lines.push_back(u"#EXTINF:1.000,");
+        lines.push_back(ts::UString::Format(u"seg-%03d.ts", i));
+    }
+    if (end_list) {
+        lines.push_back(u"#EXT-X-ENDLIST");
+    }
+    const fs::path filename(_tempDir / u"playlist.m3u8");
+    TSUNIT_ASSERT(ts::UString::Save(lines, filename));
+    return filename;
+}
+
+bool HLSTest::checkSegment(const ts::ByteBlock& data, size_t index)
+{
+    if (data.size() != (index + 1) * ts::PKT_SIZE) {
+        return false;
+    }
+    for (size_t i = 0; i < data.size(); i += ts::PKT_SIZE) {
+        if (data[i] != ts::SYNC_BYTE || data[i + ts::PKT_SIZE - 1] != uint8_t(index)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 
@@ -361,3 +427,86 @@ TSUNIT_DEFINE_TEST(BuildMediaPlaylist)
 
     TSUNIT_EQUAL(refContent2, pl.textContent());
 }
+
+TSUNIT_DEFINE_TEST(PrefetchVOD)
+{
+    constexpr size_t segment_count = 20;
+    for (size_t i = 0; i < segment_count; ++i) {
+        createSegment(i);
+    }
+    ts::hls::PlayList pl;
+    TSUNIT_ASSERT(pl.loadFile(createPlaylist(segment_count, true), true, ts::hls::PlayListType::UNKNOWN, CERR));
+    TSUNIT_ASSERT(pl.isMedia());
+    TSUNIT_ASSERT(!pl.isUpdatable());
+    TSUNIT_EQUAL(segment_count, pl.segmentCount());
+
+    // All segments are delivered in order.
+    ts::hls::SegmentPrefetcher prefetcher(CERR);
+    TSUNIT_ASSERT(prefetcher.start(pl, ts::WebRequestArgs(), 4, 6));
+    TSUNIT_ASSERT(prefetcher.isStarted());
+    TSUNIT_ASSERT(!prefetcher.start(pl, ts::WebRequestArgs(), 4, 6));
+
+    ts::ByteBlock data;
+    ts::hls::MediaSegment seg;
+    for (size_t i = 0; i < segment_count; ++i) {
+        TSUNIT_ASSERT(prefetcher.getNextSegment(data, seg));
+        TSUNIT_ASSERT(seg.urlString().ends_with(ts::UString::Format(u"seg-%03d.ts", i)));
+        TSUNIT_ASSERT(checkSegment(data, i));
+    }
+    TSUNIT_ASSERT(!prefetcher.getNextSegment(data, seg));
+    prefetcher.stop();
+    TSUNIT_ASSERT(!prefetcher.isStarted());
+
+    // Restart with a maximum number of segments.
+    TSUNIT_ASSERT(prefetcher.start(pl, ts::WebRequestArgs(), 2, 2, 5));
+    for (size_t i = 0; i < 5; ++i) {
+        TSUNIT_ASSERT(prefetcher.getNextSegment(data, seg));
+        TSUNIT_ASSERT(checkSegment(data, i));
+    }
+    TSUNIT_ASSERT(!prefetcher.getNextSegment(data, seg));
+    prefetcher.stop();
+
+    // A missing segment file is a download error.
+    fs::remove(_tempDir / u"seg-003.ts", &ts::ErrCodeReport());
+    TSUNIT_ASSERT(prefetcher.start(pl, ts::WebRequestArgs(), 3, 3));
+    for (size_t i = 0; i < 3; ++i) {
+        TSUNIT_ASSERT(prefetcher.getNextSegment(data, seg));
+        TSUNIT_ASSERT(checkSegment(data, i));
+    }
+    TSUNIT_ASSERT(!prefetcher.getNextSegment(data, seg));
+
+    // Abort while downloads are pending.
+    prefetcher.abort();
+    TSUNIT_ASSERT(!prefetcher.getNextSegment(data, seg));
+    prefetcher.stop();
+}
+
+TSUNIT_DEFINE_TEST(PrefetchLive)
+{
+    for (size_t i = 0; i < 6; ++i) {
+        createSegment(i);
+    }
+
+    // Live playlist with 3 segments.
+    const fs::path filename(createPlaylist(3, false));
+    ts::hls::PlayList pl;
+    TSUNIT_ASSERT(pl.loadFile(filename, true, ts::hls::PlayListType::UNKNOWN, CERR));
+    TSUNIT_EQUAL(ts::hls::PlayListType::LIVE, pl.type());
+    TSUNIT_ASSERT(pl.isUpdatable());
+
+    ts::hls::SegmentPrefetcher prefetcher(CERR);
+    TSUNIT_ASSERT(prefetcher.start(pl, ts::WebRequestArgs(), 2, 4));
+
+    ts::ByteBlock data;
+    ts::hls::MediaSegment seg;
+    TSUNIT_ASSERT(prefetcher.getNextSegment(data, seg));
+    TSUNIT_ASSERT(checkSegment(data, 0));
+
+    // The playlist is updated with 3 more segments and terminated. It is reloaded by the prefetcher.
+    createPlaylist(6, true);
+    for (size_t i = 1; i < 6; ++i) {
+        TSUNIT_ASSERT(prefetcher.getNextSegment(data, seg));
+        TSUNIT_ASSERT(checkSegment(data, i));
+    }
+    TSUNIT_ASSERT(!prefetcher.getNextSegment(data, seg));
+}
@@ -0,0 +1,425 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for InputSwitcher (tsswitch).
+//
+//----------------------------------------------------------------------------
+
+#include "tsInputSwitcher.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventContext.h"
+#include "tsPluginEventData.h"
+#include "tsAsyncReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class InputSwitcherTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Merge);
+    TSUNIT_DECLARE_TEST(MergeWindowOverflow);
+    TSUNIT_DECLARE_TEST(MergeLateStart);
+    TSUNIT_DECLARE_TEST(MergeTerminate);
+    TSUNIT_DECLARE_TEST(MergeStall);
+};
+
+TSUNIT_REGISTER(InputSwitcherTest);
+
+
+//----------------------------------------------------------------------------
+// An asynchronous report class which logs in debug output.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TestReport : public ts::AsyncReport
+    {
+        TS_NOCOPY(TestReport);
+    public:
+        TestReport() : ts::AsyncReport(ts::Severity::Info) {}
+    private:
+        virtual void asyncThreadLog(int severity, const ts::UString& message) override;
+    };
+
+    void TestReport::asyncThreadLog(int severity, const ts::UString& message)
+    {
+        tsunit::Test::debug() << "InputSwitcherTest: " << message << std::endl;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for two memory input plugins: send lossy copies of the
+// same stream on each input.
+//----------------------------------------------------------------------------
+
+namespace {
+    class LossyInputs : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(LossyInputs);
+    public:
+        LossyInputs(const ts::TSPacketVector& packets) : _packets(packets) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+        // Check if a packet is lost on an input. Losses are disjoint on the two inputs.
+        static bool IsLost(size_t input, size_t index);
+
+        // Configuration, to set before starting.
+        size_t first[2] {0, 0};                 // Index of the first packet to send on each input.
+        size_t end[2] {ts::NPOS, ts::NPOS};     // Index after the last packet to send on each input.
+        bool   lossless[2] {false, false};      // No packet is lost on the input.
+        size_t max_lead = ts::NPOS;             // Max number of packets an input can be ahead of the other.
+        bool   endless = false;                 // After its last packet, input 1 sends null packets until aborted.
+        cn::milliseconds pace {};               // Delay before each event on input 0.
+        std::vector<ts::monotonic_time>* send_times = nullptr;  // Sending time of each packet on input 0.
+
+    private:
+        static constexpr size_t CHUNK_PACKETS = 64;  // Max packets per input event.
+        const ts::TSPacketVector& _packets;
+        size_t _next[2] {0, 0};
+
+        // Index after the last packet to send on an input.
+        size_t last(size_t input) const { return std::min(_packets.size(), end[input]); }
+    };
+
+    bool LossyInputs::IsLost(size_t input, size_t index)
+    {
+        if (input == 0) {
+            // Bursts of 20 packets.
+            return index % 1000 >= 100 && index % 1000 < 120;
+        }
+        else {
+            // Bursts of 40 packets and isolated losses.
+            return (index % 1000 >= 600 && index % 1000 < 640) || index % 250 == 3;
+        }
+    }
+
+    void LossyInputs::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        // Plugin event handlers are serialized, no need to protect _next.
+        // Because of this serialization, an input which is too far ahead cannot wait for the other one.
+        // It is only slowed down, one packet per millisecond, until the other one catches up.
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        const size_t input = context.pluginIndex();
+        if (data != nullptr && input < 2) {
+            const size_t other = 1 - input;
+            _next[input] = std::max(_next[input], first[input]);
+            size_t max_count = CHUNK_PACKETS;
+            if (max_lead != ts::NPOS && _next[other] < last(other) && _next[input] >= std::max(_next[other], first[other]) + max_lead) {
+                std::this_thread::sleep_for(cn::milliseconds(1));
+                max_count = 1;
+            }
+            size_t count = 0;
+            if (input == 0 && pace > cn::milliseconds::zero()) {
+                std::this_thread::sleep_for(pace);
+            }
+            while (count < max_count && _next[input] < last(input) && data->remainingSize() >= ts::PKT_SIZE) {
+                const size_t i = _next[input]++;
+                if (lossless[input] || !IsLost(input, i)) {
+                    data->append(&_packets[i], ts::PKT_SIZE);
+                    count++;
+                    if (input == 0 && send_times != nullptr) {
+                        send_times->resize(std::max(send_times->size(), i + 1));
+                        (*send_times)[i] = ts::monotonic_time::clock::now();
+                    }
+                }
+            }
+            if (count == 0 && input == 1 && endless) {
+                std::this_thread::sleep_for(cn::milliseconds(1));
+                data->append(&ts::NullPacket, ts::PKT_SIZE);
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory output plugin: fill a vector of packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& output, std::vector<ts::monotonic_time>* times) : _output(output), _times(times) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        ts::TSPacketVector& _output;
+        std::vector<ts::monotonic_time>* _times;  // Reception time of each output packet, if not null.
+    };
+
+    void Output::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const size_t packets_count = data->size() / ts::PKT_SIZE;
+            const size_t index = _output.size();
+            _output.resize(index + packets_count);
+            ts::TSPacket::Copy(&_output[index], data->data(), packets_count);
+            if (_times != nullptr) {
+                _times->resize(_output.size(), ts::monotonic_time::clock::now());
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Common code for merge tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Reference stream: 3 PID's and one null packet every 4 packets. All non-null packets are distinct.
+    constexpr size_t PACKET_COUNT = 12'000;
+
+    void BuildReference(ts::TSPacketVector& packets)
+    {
+        packets.resize(PACKET_COUNT);
+        uint8_t cc[3] {0, 0, 0};
+        for (size_t i = 0; i < packets.size(); ++i) {
+            if (i % 4 == 2) {
+                packets[i] = ts::NullPacket;
+            }
+            else {
+                const size_t index = i % 3;
+                packets[i].init(ts::PID(100 + index), cc[index], 0xA5);
+                cc[index] = (cc[index] + 1) % ts::CC_MAX;
+                ts::PutUInt32(packets[i].b + 4, uint32_t(i));
+            }
+        }
+    }
+
+    // Merge the two inputs. Return the output packets and the merge statistics.
+    void RunMerge(LossyInputs& inputs, size_t window, bool terminate, ts::TSPacketVector& output_packets, ts::InputSwitcher::MergeStatisticsVector& stats,
+                  cn::milliseconds timeout = cn::milliseconds::zero(), std::vector<ts::monotonic_time>* output_times = nullptr)
+    {
+        ts::InputSwitcherArgs opt;
+        opt.appName = u"InputSwitcherTest";
+        opt.merge = true;
+        opt.terminate = terminate;
+        opt.mergeWindow = window;
+        opt.receiveTimeout = timeout;
+        opt.bufferedPackets = ts::InputSwitcherArgs::DEFAULT_BUFFERED_PACKETS;
+        opt.maxInputPackets = ts::InputSwitcherArgs::DEFAULT_MAX_INPUT_PACKETS;
+        opt.maxOutputPackets = ts::InputSwitcherArgs::DEFAULT_MAX_OUTPUT_PACKETS;
+        opt.inputs = {{u"memory", {}}, {u"memory", {}}};
+        opt.output = {u"memory", {}};
+
+        TestReport log;
+        Output output(output_packets, output_times);
+
+        ts::InputSwitcher tsswitch(log);
+        tsswitch.registerEventHandler(&inputs, ts::PluginType::INPUT);
+        tsswitch.registerEventHandler(&output, ts::PluginType::OUTPUT);
+        TSUNIT_ASSERT(tsswitch.start(opt));
+        tsswitch.waitForTermination();
+        tsswitch.getMergeStatistics(stats);
+
+        TSUNIT_EQUAL(2, stats.size());
+        for (size_t input = 0; input < stats.size(); ++input) {
+            tsunit::Test::debug() << "InputSwitcherTest: input " << input << ": received: " << stats[input].received
+                                  << ", output: " << stats[input].output << ", duplicates: " << stats[input].duplicates
+                                  << ", late: " << stats[input].late << ", lost: " << stats[input].lost << std::endl;
+        }
+    }
+
+    // Index of the first difference between two packet vectors.
+    size_t FirstDiff(const ts::TSPacketVector& pkts1, const ts::TSPacketVector& pkts2)
+    {
+        size_t index = 0;
+        while (index < pkts1.size() && index < pkts2.size() && pkts1[index] == pkts2[index]) {
+            index++;
+        }
+        return index;
+    }
+
+    // Check the merge of two lossy copies of the complete reference stream, when all losses are recovered.
+    void CheckFullRecovery(const ts::TSPacketVector& packets, const ts::TSPacketVector& output_packets, const ts::InputSwitcher::MergeStatisticsVector& stats)
+    {
+        // Expected statistics. Null packets are not counted.
+        ts::PacketCounter expected_received[2] {0, 0};
+        ts::PacketCounter expected_lost[2] {0, 0};
+        for (size_t i = 0; i < packets.size(); ++i) {
+            if (packets[i].getPID() != ts::PID_NULL) {
+                for (size_t input = 0; input < 2; ++input) {
+                    (LossyInputs::IsLost(input, i) ? expected_lost : expected_received)[input]++;
+                }
+            }
+        }
+
+        // All lost packets are recovered from the other input, in the right order.
+        TSUNIT_EQUAL(packets.size(), output_packets.size());
+        TSUNIT_EQUAL(packets.size(), FirstDiff(packets, output_packets));
+
+        TSUNIT_EQUAL(expected_received[0] + expected_lost[0], stats[0].output + stats[1].output);
+        for (size_t input = 0; input < 2; ++input) {
+            TSUNIT_EQUAL(expected_received[input], stats[input].received);
+            TSUNIT_EQUAL(expected_lost[input], stats[input].lost);
+            TSUNIT_EQUAL(0, stats[input].late);
+            TSUNIT_EQUAL(stats[input].received, stats[input].output + stats[input].duplicates);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Merge)
+{
+    // The complete stream fits in the alignment window: the result does not depend on the relative speed of the inputs.
+    static_assert(PACKET_COUNT <= ts::InputSwitcherArgs::DEFAULT_MERGE_WINDOW * 4 / 3);
+    ts::TSPacketVector packets;
+    BuildReference(packets);
+
+    LossyInputs inputs(packets);
+    ts::TSPacketVector output_packets;
+    ts::InputSwitcher::MergeStatisticsVector stats;
+    RunMerge(inputs, ts::InputSwitcherArgs::DEFAULT_MERGE_WINDOW, false, output_packets, stats);
+    CheckFullRecovery(packets, output_packets, stats);
+}
+
+TSUNIT_DEFINE_TEST(MergeWindowOverflow)
+{
+    // The stream is much larger than the alignment window. The window is still larger than the
+    // maximum distance between the inputs, plus the longest burst of losses: all losses are recovered.
+    constexpr size_t WINDOW = 1000;
+    constexpr size_t MAX_LEAD = 256;
+    static_assert(PACKET_COUNT > 8 * WINDOW);
+    static_assert(MAX_LEAD + 64 + 40 < WINDOW / 2);
+    ts::TSPacketVector packets;
+    BuildReference(packets);
+
+    LossyInputs inputs(packets);
+    inputs.max_lead = MAX_LEAD;
+    ts::TSPacketVector output_packets;
+    ts::InputSwitcher::MergeStatisticsVector stats;
+    RunMerge(inputs, WINDOW, false, output_packets, stats);
+    CheckFullRecovery(packets, output_packets, stats);
+}
+
+TSUNIT_DEFINE_TEST(MergeLateStart)
+{
+    // Input 1 joins the stream late. Before that point, the packets which are lost on input 0 cannot
+    // be recovered. Since no input delivered them, they are unknown and not counted as lost.
+    constexpr size_t START = 3000;
+    ts::TSPacketVector packets;
+    BuildReference(packets);
+
+    LossyInputs inputs(packets);
+    inputs.first[1] = START;
+    ts::TSPacketVector output_packets;
+    ts::InputSwitcher::MergeStatisticsVector stats;
+    RunMerge(inputs, ts::InputSwitcherArgs::DEFAULT_MERGE_WINDOW, false, output_packets, stats);
+
+    // Expected output and statistics.
+    ts::TSPacketVector expected;
+    ts::PacketCounter expected_output = 0;
+    ts::PacketCounter expected_received[2] {0, 0};
+    ts::PacketCounter expected_lost[2] {0, 0};
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const bool is_null = packets[i].getPID() == ts::PID_NULL;
+        if (i >= START || !LossyInputs::IsLost(0, i)) {
+            expected.push_back(packets[i]);
+            expected_output += !is_null;
+        }
+        if (!is_null) {
+            for (size_t input = 0; input < 2; ++input) {
+                if (!LossyInputs::IsLost(input, i) && (input == 0 || i >= START)) {
+                    expected_received[input]++;
+                }
+                else if (LossyInputs::IsLost(input, i) && i >= START) {
+                    expected_lost[input]++;
+                }
+            }
+        }
+    }
+
+    TSUNIT_EQUAL(expected.size(), output_packets.size());
+    TSUNIT_EQUAL(expected.size(), FirstDiff(expected, output_packets));
+    TSUNIT_EQUAL(expected_output, stats[0].output + stats[1].output);
+    for (size_t input = 0; input < 2; ++input) {
+        TSUNIT_EQUAL(expected_received[input], stats[input].received);
+        TSUNIT_EQUAL(expected_lost[input], stats[input].lost);
+        TSUNIT_EQUAL(0, stats[input].late);
+        TSUNIT_EQUAL(stats[input].received, stats[input].output + stats[input].duplicates);
+    }
+}
+
+TSUNIT_DEFINE_TEST(MergeTerminate)
+{
+    // Input 0 terminates early, input 1 is still running. With --terminate, the processing stops
+    // without waiting for the alignment of input 1. All packets from input 0 are output.
+    constexpr size_t END = 1000;
+    ts::TSPacketVector packets;
+    BuildReference(packets);
+    TSUNIT_ASSERT(packets[END - 1].getPID() != ts::PID_NULL);
+
+    LossyInputs inputs(packets);
+    inputs.end[0] = END;
+    inputs.lossless[0] = true;
+    inputs.endless = true;
+    ts::TSPacketVector output_packets;
+    ts::InputSwitcher::MergeStatisticsVector stats;
+    RunMerge(inputs, ts::InputSwitcherArgs::DEFAULT_MERGE_WINDOW, true, output_packets, stats);
+
+    ts::PacketCounter expected_received = 0;
+    for (size_t i = 0; i < END; ++i) {
+        expected_received += packets[i].getPID() != ts::PID_NULL;
+    }
+
+    // The packets after the end of input 0 depend on the progression of input 1.
+    TSUNIT_ASSERT(output_packets.size() >= END);
+    TSUNIT_ASSERT(FirstDiff(packets, output_packets) >= END);
+    TSUNIT_EQUAL(expected_received, stats[0].received);
+    TSUNIT_EQUAL(0, stats[0].lost);
+}
+
+TSUNIT_DEFINE_TEST(MergeStall)
+{
+    // Input 1 stalls without terminating: it only sends null packets. Input 0 delivers the complete
+    // stream at a slow pace. With a receive timeout, input 1 becomes idle and no longer delays the
+    // output of the packets from input 0. Without it, the packets would be held until the alignment
+    // window overflows, more than one second here.
+    constexpr size_t STALL = 500;
+    constexpr cn::milliseconds TIMEOUT = cn::milliseconds(100);
+    constexpr cn::milliseconds MAX_DELAY = cn::milliseconds(500);
+    ts::TSPacketVector packets;
+    BuildReference(packets);
+
+    LossyInputs inputs(packets);
+    inputs.end[1] = STALL;
+    inputs.lossless[0] = inputs.lossless[1] = true;
+    inputs.endless = true;
+    inputs.pace = cn::milliseconds(10);
+    std::vector<ts::monotonic_time> send_times;
+    inputs.send_times = &send_times;
+    ts::TSPacketVector output_packets;
+    std::vector<ts::monotonic_time> output_times;
+    ts::InputSwitcher::MergeStatisticsVector stats;
+    RunMerge(inputs, ts::InputSwitcherArgs::DEFAULT_MERGE_WINDOW, true, output_packets, stats, TIMEOUT, &output_times);
+
+    // All packets are output, in the right order.
+    TSUNIT_EQUAL(packets.size(), output_packets.size());
+    TSUNIT_EQUAL(packets.size(), FirstDiff(packets, output_packets));
+    TSUNIT_EQUAL(packets.size(), send_times.size());
+    TSUNIT_EQUAL(packets.size(), output_times.size());
+    TSUNIT_EQUAL(0, stats[0].lost);
+
+    // Maximum delay between the input and the output of a packet after the stall.
+    cn::milliseconds max_delay = cn::milliseconds::zero();
+    for (size_t i = STALL; i < output_times.size(); ++i) {
+        max_delay = std::max(max_delay, cn::duration_cast<cn::milliseconds>(output_times[i] - send_times[i]));
+    }
+    debug() << "InputSwitcherTest::MergeStall: max delay: " << max_delay.count() << " ms" << std::endl;
+    TSUNIT_ASSERT(max_delay < MAX_DELAY);
+}
@@ -17,6 +17,7 @@
 #include "tsjsonObject.h"
 #include "tsjsonArray.h"
 #include "tsjsonRunningDocument.h"
+#include "tsjsonTextWriter.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
 #include "tsIntegerUtils.h"
@@ -39,6 +40,7 @@ class JsonTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(RunningDocumentEmpty);
     TSUNIT_DECLARE_TEST(RunningDocument);
     TSUNIT_DECLARE_TEST(Issue1353);
+    TSUNIT_DECLARE_TEST(TextWriter);
 
 public:
     virtual void beforeTest() override;
@@ -886,3 +888,42 @@ TSUNIT_DEFINE_TEST(Issue1353)
                  "\"f5\": 1.2e-5, \"f6\": 1.2e-6, \"f7\": 1.2e-7, \"f8\": 1.2e-8, \"f9\": 1.2e-9 }",
                  root.oneLiner(CERR));
 }
+
+TSUNIT_DEFINE_TEST(TextWriter)
+{
+    // Reference value, serialized with oneLiner().
+    ts::json::ValuePtr jv;
+    TSUNIT_ASSERT(ts::json::Parse(jv, u"{\"a\": [1, -2, true, false, null, {}, []], \"b\": \"x\\\"y\\\\z\\n\\u00E9\", \"c\": {\"d\": -9223372036854775807}}", CERR));
+    TSUNIT_ASSERT(jv != nullptr);
+
+    ts::json::TextWriter tw;
+    for (int iter = 0; iter < 2; ++iter) {
+        // Serialize twice, the second time with a reused buffer.
+        tw.clear();
+        tw.beginObject();
+        tw.key(u"a");
+        tw.beginArray();
+        tw.integerValue(1);
+        tw.integerValue(-2);
+        tw.boolValue(true);
+        tw.boolValue(false);
+        tw.nullValue();
+        tw.beginObject();
+        tw.endObject();
+        tw.beginArray();
+        tw.endArray();
+        tw.endArray();
+        tw.key(u"b");
+        tw.stringValue(u"x\"y\\z\n\u00E9");
+        tw.key(u"c");
+        tw.beginObject();
+        tw.key(u"d");
+        tw.integerValue(-9223372036854775807LL);
+        tw.endObject();
+        tw.endObject();
+
+        debug() << "JsonTest::TextWriter: " << tw.text() << std::endl;
+        TSUNIT_EQUAL(jv->oneLiner(), tw.toString());
+        TSUNIT_EQUAL(u"{ \"a\": [ 1, -2, true, false, null, { }, [ ] ], \"b\": \"x\\\"y\\\\z\\n\\u00E9\", \"c\": { \"d\": -9223372036854775807 } }", tw.toString());
+    }
+}
@@ -0,0 +1,391 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the merge plugin with an embedded TSProcessor chain.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsTSProcessor.h"
+#include "tsReportBuffer.h"
+#include "tsCyclingPacketizer.h"
+#include "tsSectionDemux.h"
+#include "tsBinaryTable.h"
+#include "tsDuckContext.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsTSFile.h"
+#include "tsFileUtils.h"
+#include "tsSysUtils.h"
+#include "tsErrCodeReport.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MergePluginTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(InProcess);
+    TSUNIT_DECLARE_TEST(InvalidChain);
+    TSUNIT_DECLARE_TEST(SameAsForked);
+
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+private:
+    fs::path _mainFile {};
+    fs::path _mergeFile {};
+
+    // Main stream: one service, null packets in one packet out of two.
+    // Merged stream: one other service, PCR's at half the main bitrate.
+    static constexpr size_t MAIN_PACKETS = 60000;
+    static constexpr size_t MERGE_PACKETS = 4000;
+    static constexpr size_t MERGE_PCR_INTERVAL = 10;
+    static constexpr uint16_t MERGE_SERVICE = 2;
+    static constexpr ts::PID MERGE_PCR_PID = 0x1101;
+    static const ts::BitRate MAIN_BITRATE;
+    static const ts::BitRate MERGE_BITRATE;
+
+    // Original PCR of a packet in the merged stream.
+    static uint64_t MergePCR(size_t index);
+
+    // Create the test files.
+    static void CreateFile(const fs::path& name, size_t count, size_t period, const ts::TSPacketVector& psi, ts::PID data_pid, bool merged);
+};
+
+const ts::BitRate MergePluginTest::MAIN_BITRATE = 100'000'000;
+const ts::BitRate MergePluginTest::MERGE_BITRATE = 50'000'000;
+
+TSUNIT_REGISTER(MergePluginTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+void MergePluginTest::beforeTest()
+{
+    if (_mainFile.empty() || _mergeFile.empty()) {
+        _mainFile = ts::TempFile(u".main.ts");
+        _mergeFile = ts::TempFile(u".merge.ts");
+    }
+    fs::remove(_mainFile, &ts::ErrCodeReport());
+    fs::remove(_mergeFile, &ts::ErrCodeReport());
+}
+
+void MergePluginTest::afterTest()
+{
+    fs::remove(_mainFile, &ts::ErrCodeReport());
+    fs::remove(_mergeFile, &ts::ErrCodeReport());
+}
+
+uint64_t MergePluginTest::MergePCR(size_t index)
+{
+    return ((ts::BitRate(index) * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ) / MERGE_BITRATE).toInt();
+}
+
+// Create a TS file. The PSI packets are at the beginning of each period, the other ones are
+// data packets. In the main stream, odd packets are null packets. In the merged stream, one
+// data packet out of MERGE_PCR_INTERVAL has a PCR and all data packets contain their index in the file.
+void MergePluginTest::CreateFile(const fs::path& name, size_t count, size_t period, const ts::TSPacketVector& psi, ts::PID data_pid, bool merged)
+{
+    ts::TSPacketVector packets(count);
+    uint8_t cc = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ts::TSPacket& pkt(packets[i]);
+        const size_t slot = merged ? i % period : (i % 2 == 0 ? (i / 2) % period : ts::NPOS);
+        if (!merged && i % 2 != 0) {
+            pkt = ts::NullPacket;
+        }
+        else if (slot < psi.size()) {
+            pkt = psi[slot];
+            pkt.setCC(uint8_t(i / period) & ts::CC_MASK);
+        }
+        else {
+            pkt.init(data_pid, cc++ & ts::CC_MASK);
+            if (merged && i % MERGE_PCR_INTERVAL == MERGE_PCR_INTERVAL / 2) {
+                TSUNIT_ASSERT(pkt.setPCR(MergePCR(i), true));
+            }
+            ts::PutUInt32(pkt.getPayload(), uint32_t(i));
+        }
+    }
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(name, ts::TSFile::WRITE, CERR, ts::TSPacketFormat::TS));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory output plugin: count packets per PID.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Output : public ts::PluginEventHandlerInterface
+    {
+    public:
+        Output() = default;
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+        ts::PacketCounter total = 0;
+        std::map<ts::PID, ts::PacketCounter> pids {};
+    };
+
+    void Output::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const ts::TSPacket* packets = reinterpret_cast<const ts::TSPacket*>(data->data());
+            const size_t count = data->size() / ts::PKT_SIZE;
+            for (size_t i = 0; i < count; ++i) {
+                pids[packets[i].getPID()]++;
+            }
+            total += count;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory output plugin: collect last PSI and merged PCR's.
+//----------------------------------------------------------------------------
+
+namespace {
+    class PSIPCRCollector : public ts::PluginEventHandlerInterface, private ts::TableHandlerInterface
+    {
+    public:
+        PSIPCRCollector() = default;
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+        // A merged PCR packet in the output stream.
+        struct PCRPacket
+        {
+            ts::PacketCounter output_index = 0;  // Index in the output stream.
+            size_t            source_index = 0;  // Index in the merged file.
+            uint64_t          pcr = 0;           // PCR value in the output stream.
+        };
+
+        ts::PacketCounter total = 0;
+        ts::PacketCounter merged = 0;
+        std::vector<PCRPacket> pcrs {};
+        std::map<ts::PID, ts::BinaryTable> tables {};
+
+    private:
+        ts::DuckContext  _duck {};
+        ts::SectionDemux _demux {_duck, this, nullptr, ts::AllPIDs()};
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override;
+    };
+
+    void PSIPCRCollector::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const ts::TSPacket* packets = reinterpret_cast<const ts::TSPacket*>(data->data());
+            const size_t count = data->size() / ts::PKT_SIZE;
+            for (size_t i = 0; i < count; ++i) {
+                _demux.feedPacket(packets[i]);
+                if (packets[i].getPID() == 0x1101) {
+                    merged++;
+                    if (packets[i].hasPCR()) {
+                        pcrs.push_back({total + i, ts::GetUInt32(packets[i].getPayload()), packets[i].getPCR()});
+                    }
+                }
+            }
+            total += count;
+        }
+    }
+
+    void PSIPCRCollector::handleTable(ts::SectionDemux&, const ts::BinaryTable& table)
+    {
+        // Keep the last version of each table, the merged ones are the last ones.
+        if (table.tableId() == ts::TID_PAT || table.tableId() == ts::TID_PMT || table.tableId() == ts::TID_SDT_ACT) {
+            tables[table.sourcePID()] = table;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(InProcess)
+{
+    // Infinite null main stream, terminated after the last merged packet.
+    // The merged stream is an embedded chain which changes the PID of 1000 null packets.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"MergePluginTest::testInProcess";
+    opt.input = {u"null", {}};
+    opt.plugins = {
+        {u"merge", {u"--in-process", u"--terminate", u"--no-smoothing", u"tsp -I null 1000 -P craft --pid 0x0100"}},
+    };
+    opt.output = {u"memory", {}};
+
+    ts::ReportBuffer<ts::ThreadSafety::Full> log;
+    Output output;
+    ts::TSProcessor tsproc(log);
+    tsproc.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+    const bool started = tsproc.start(opt);
+    if (!started) {
+        debug() << "MergePluginTest::testInProcess: " << log.messages() << std::endl;
+    }
+    TSUNIT_ASSERT(started);
+    tsproc.waitForTermination();
+
+    debug() << "MergePluginTest::testInProcess: total packets: " << output.total << ", merged: " << output.pids[0x0100] << std::endl;
+    TSUNIT_EQUAL(1000, output.pids[0x0100]);
+    TSUNIT_EQUAL(output.total, output.pids[0x0100] + output.pids[ts::PID_NULL]);
+    TSUNIT_ASSERT(!log.gotErrors());
+}
+
+TSUNIT_DEFINE_TEST(InvalidChain)
+{
+    // The embedded chain is loaded when the merge plugin starts, an invalid one fails the start.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"MergePluginTest::testInvalidChain";
+    opt.input = {u"null", {u"1000"}};
+    opt.plugins = {
+        {u"merge", {u"--in-process", u"tsp -I null 1000 -P nonexistent-plugin"}},
+    };
+    opt.output = {u"drop", {}};
+
+    ts::ReportBuffer<ts::ThreadSafety::Full> log;
+    ts::TSProcessor tsproc(log);
+    TSUNIT_ASSERT(!tsproc.start(opt));
+    debug() << "MergePluginTest::testInvalidChain: " << log.messages() << std::endl;
+    TSUNIT_ASSERT(log.gotErrors());
+}
+
+TSUNIT_DEFINE_TEST(SameAsForked)
+{
+    // Build the main and merged files.
+    ts::DuckContext duck;
+    ts::TSPacketVector main_psi(3), merge_psi(3);
+
+    ts::PAT pat1(0, true, 0x0010);
+    pat1.pmts[1] = 0x1000;
+    ts::PMT pmt1(0, true, 1, 0x1001);
+    pmt1.streams[0x1001].stream_type = ts::ST_MPEG2_VIDEO;
+    ts::SDT sdt1(true, 0, true, 0x0010, 0x0001);
+    sdt1.services[1].setName(duck, u"Main");
+
+    ts::PAT pat2(0, true, 0x0020);
+    pat2.pmts[MERGE_SERVICE] = 0x1100;
+    ts::PMT pmt2(0, true, MERGE_SERVICE, MERGE_PCR_PID);
+    pmt2.streams[MERGE_PCR_PID].stream_type = ts::ST_MPEG2_VIDEO;
+    ts::SDT sdt2(true, 0, true, 0x0020, 0x0001);
+    sdt2.services[MERGE_SERVICE].setName(duck, u"Merged");
+
+    for (int i = 0; i < 2; ++i) {
+        ts::TSPacketVector& psi(i == 0 ? main_psi : merge_psi);
+        const ts::AbstractTable* tables[3] = {
+            i == 0 ? static_cast<const ts::AbstractTable*>(&pat1) : &pat2,
+            i == 0 ? static_cast<const ts::AbstractTable*>(&pmt1) : &pmt2,
+            i == 0 ? static_cast<const ts::AbstractTable*>(&sdt1) : &sdt2,
+        };
+        const ts::PID pids[3] = {ts::PID_PAT, ts::PID(i == 0 ? 0x1000 : 0x1100), ts::PID_SDT};
+        for (size_t t = 0; t < 3; ++t) {
+            ts::CyclingPacketizer pzer(duck, pids[t]);
+            pzer.addTable(duck, *tables[t]);
+            TSUNIT_ASSERT(pzer.getNextPacket(psi[t]));
+        }
+    }
+    CreateFile(_mainFile, MAIN_PACKETS, 50, main_psi, 0x1001, false);
+    CreateFile(_mergeFile, MERGE_PACKETS, 50, merge_psi, MERGE_PCR_PID, true);
+
+    // The forked tsp is the one next to the test executable.
+    const fs::path tsp(ts::ExecutableFile().parent_path() / (ts::UString(u"tsp") + ts::EXECUTABLE_FILE_SUFFIX));
+    const bool forked = fs::exists(tsp);
+    if (!forked) {
+        debug() << "MergePluginTest::testSameAsForked: " << tsp << " not found, testing in-process mode only" << std::endl;
+    }
+
+    // Merge in-process and, when possible, with a forked tsp. The main stream is regulated at
+    // a fixed bitrate so that it lasts longer than the merged stream, even with a forked tsp.
+    PSIPCRCollector outputs[2];
+    for (int mode = 0; mode < (forked ? 2 : 1); ++mode) {
+        const ts::UString command((mode == 0 ? u"tsp" : u"\"" + ts::UString(tsp) + u"\"") + u" -I file \"" + ts::UString(_mergeFile) + u"\"");
+        ts::TSProcessorArgs opt;
+        opt.app_name = u"MergePluginTest::testSameAsForked";
+        opt.fixed_bitrate = MAIN_BITRATE;
+        opt.input = {u"file", {ts::UString(_mainFile)}};
+        opt.plugins = {
+            {u"regulate", {}},
+            {u"merge", {u"--terminate", u"--no-smoothing", command}},
+        };
+        if (mode == 0) {
+            opt.plugins[1].args.insert(opt.plugins[1].args.begin(), u"--in-process");
+        }
+        opt.output = {u"memory", {}};
+
+        ts::ReportBuffer<ts::ThreadSafety::Full> log;
+        ts::TSProcessor tsproc(log);
+        tsproc.registerEventHandler(&outputs[mode], ts::PluginType::OUTPUT);
+        TSUNIT_ASSERT(tsproc.start(opt));
+        tsproc.waitForTermination();
+        debug() << "MergePluginTest::testSameAsForked: " << (mode == 0 ? "in-process" : "forked") << ", total packets: " << outputs[mode].total
+                << ", merged: " << outputs[mode].merged << ", PCR: " << outputs[mode].pcrs.size() << std::endl;
+        if (log.gotErrors()) {
+            debug() << "MergePluginTest::testSameAsForked: " << log.messages() << std::endl;
+        }
+        TSUNIT_ASSERT(!log.gotErrors());
+
+        // All merged data packets are in the output.
+        const PSIPCRCollector& out(outputs[mode]);
+        TSUNIT_EQUAL(MERGE_PACKETS - MERGE_PACKETS / 50 * merge_psi.size(), out.merged);
+        TSUNIT_EQUAL(MERGE_PACKETS / MERGE_PCR_INTERVAL, out.pcrs.size());
+
+        // Merged PSI: the PAT and SDT contain the two services.
+        TSUNIT_ASSERT(out.tables.contains(ts::PID_PAT));
+        TSUNIT_ASSERT(out.tables.contains(ts::PID_SDT));
+        TSUNIT_ASSERT(out.tables.contains(0x1100));
+        const ts::PAT pat(duck, out.tables.at(ts::PID_PAT));
+        TSUNIT_ASSERT(pat.isValid());
+        TSUNIT_EQUAL(2, pat.pmts.size());
+        TSUNIT_EQUAL(0x1100, pat.pmts.at(MERGE_SERVICE));
+        TSUNIT_EQUAL(1, pat.version);
+        const ts::SDT sdt(duck, out.tables.at(ts::PID_SDT));
+        TSUNIT_ASSERT(sdt.isValid());
+        TSUNIT_EQUAL(2, sdt.services.size());
+        TSUNIT_EQUAL(u"Merged", sdt.services.at(MERGE_SERVICE).serviceName(duck));
+
+        // Restamped PCR's: same computation as PCRMerger, from the position in the output stream.
+        uint64_t base_pcr = 0;
+        ts::PacketCounter base_pkt = 0;
+        size_t restamped = 0;
+        for (size_t i = 0; i < out.pcrs.size(); ++i) {
+            const auto& p(out.pcrs[i]);
+            const uint64_t source_pcr = MergePCR(p.source_index);
+            TSUNIT_EQUAL(i * MERGE_PCR_INTERVAL + MERGE_PCR_INTERVAL / 2, p.source_index);
+            const uint64_t expected = i == 0 ? source_pcr : base_pcr + ((ts::BitRate(p.output_index - base_pkt) * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ) / MAIN_BITRATE).toInt();
+            if (i == 0 || std::abs(std::intmax_t(expected) - std::intmax_t(source_pcr)) >= std::intmax_t(ts::SYSTEM_CLOCK_FREQ)) {
+                // First PCR or reset of the PCR restamping.
+                TSUNIT_EQUAL(source_pcr, p.pcr);
+                base_pcr = source_pcr;
+                base_pkt = p.output_index;
+            }
+            else {
+                TSUNIT_EQUAL(expected, p.pcr);
+                restamped++;
+            }
+        }
+        TSUNIT_ASSERT(restamped > 0);
+    }
+
+    // Same output PSI in the two modes.
+    if (forked) {
+        TSUNIT_ASSERT(outputs[0].tables == outputs[1].tables);
+    }
+}
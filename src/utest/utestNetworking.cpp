@@ -15,14 +15,20 @@
 #include "tsIPSocketAddress.h"
 #include "tsTCPConnection.h"
 #include "tsTCPServer.h"
+#include "tsTCPFanOutServer.h"
 #include "tsUDPSocket.h"
+#include "tsTSDatagramOutput.h"
+#include "tsDuckContext.h"
+#include "tsArgs.h"
 #include "tsMACAddress.h"
 #include "tsNetworkInterface.h"
 #include "tsIPPacket.h"
 #include "tsNullReport.h"
 #include "tsIPUtils.h"
 #include "tsCerrReport.h"
+#include "tsEnvironment.h"
 #include "utestTSUnitThread.h"
+#include "utestTSUnitBenchmark.h"
 #include "tsunit.h"
 
 
@@ -46,6 +52,13 @@ class NetworkingTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(IPv6SocketAddress);
     TSUNIT_DECLARE_TEST(TCPSocket);
     TSUNIT_DECLARE_TEST(UDPSocket);
+    TSUNIT_DECLARE_TEST(UDPReceiveMultiple);
+    TSUNIT_DECLARE_TEST(UDPSendMultiple);
+    TSUNIT_DECLARE_TEST(UDPSendBatchDelay);
+    TSUNIT_DECLARE_TEST(TCPFanOut);
+    TSUNIT_DECLARE_TEST(TCPFanOutSlowClient);
+    TSUNIT_DECLARE_TEST(TCPFanOutLargeSend);
+    TSUNIT_DECLARE_TEST(TCPFanOutLoad);
     TSUNIT_DECLARE_TEST(IPHeader);
     TSUNIT_DECLARE_TEST(IPProtocol);
     TSUNIT_DECLARE_TEST(TCPPacket);
@@ -883,6 +896,484 @@ TSUNIT_DEFINE_TEST(UDPSocket)
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+TSUNIT_DEFINE_TEST(UDPReceiveMultiple)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12346;
+    constexpr size_t msg_count = 5;
+    constexpr size_t max_size = 64;
+
+    // Create receiver socket.
+    ts::UDPSocket receiver(true, ts::IP::v4);
+    TSUNIT_ASSERT(receiver.isOpen());
+    TSUNIT_ASSERT(receiver.reusePort(true, CERR));
+    TSUNIT_ASSERT(receiver.setReceiveTimestamps(true, CERR));
+    TSUNIT_ASSERT(receiver.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+
+    // Send all messages at once. They are queued in the receiver socket.
+    ts::UDPSocket sender(true, ts::IP::v4);
+    TSUNIT_ASSERT(sender.isOpen());
+    TSUNIT_ASSERT(sender.setDefaultDestination(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+    for (size_t i = 0; i < msg_count; ++i) {
+        const std::string message(i + 1, char('A' + i));
+        TSUNIT_ASSERT(sender.send(message.data(), message.size(), CERR));
+    }
+
+    // Receive the messages, possibly in several batches.
+    uint8_t buffer[max_size * 8];
+    ts::UDPSocket::ReceivedMessageVector messages;
+    size_t received = 0;
+    while (received < msg_count) {
+        TSUNIT_ASSERT(receiver.receiveMultiple(buffer, max_size, 8, messages, nullptr, CERR));
+        TSUNIT_ASSERT(!messages.empty());
+        CERR.debug(u"UDPSocketTest: received %d messages in one call", messages.size());
+        for (const auto& msg : messages) {
+            TSUNIT_ASSERT(received < msg_count);
+            TSUNIT_EQUAL(received + 1, msg.size);
+            TSUNIT_EQUAL(0, msg.offset % max_size);
+            TSUNIT_EQUAL('A' + received, buffer[msg.offset]);
+            TSUNIT_ASSERT(ts::IPAddress(msg.sender) == ts::IPAddress::LocalHost4);
+#if defined(TS_LINUX)
+            TSUNIT_ASSERT(msg.timestamp >= cn::microseconds::zero());
+#endif
+            received++;
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(UDPSendMultiple)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12347;
+    constexpr size_t max_size = 256;
+
+    // Create receiver socket.
+    ts::UDPSocket receiver(true, ts::IP::v4);
+    TSUNIT_ASSERT(receiver.isOpen());
+    TSUNIT_ASSERT(receiver.reusePort(true, CERR));
+    TSUNIT_ASSERT(receiver.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+
+    // Create sender socket.
+    ts::UDPSocket sender(true, ts::IP::v4);
+    TSUNIT_ASSERT(sender.isOpen());
+    TSUNIT_ASSERT(sender.setDefaultDestination(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+
+    // Two batches: one with distinct sizes (always sendmmsg), one with equal sizes (eligible to segmentation offload).
+    const std::vector<std::vector<size_t>> batches {{10, 200, 1, 50}, {100, 100, 100, 40}};
+
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const std::vector<size_t>& sizes(batches[b]);
+        TSUNIT_ASSERT(sender.setSendSegmentation(b > 0, CERR));
+
+        // Build consecutive messages, each one filled with a distinct byte.
+        ts::ByteBlock data;
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            data.append(uint8_t('a' + i), sizes[i]);
+        }
+        TSUNIT_ASSERT(sender.sendMultiple(data.data(), sizes, CERR));
+
+        // Receive all messages, one by one.
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            uint8_t buffer[max_size];
+            size_t ret_size = 0;
+            ts::IPSocketAddress from, destination;
+            TSUNIT_ASSERT(receiver.receive(buffer, sizeof(buffer), ret_size, from, destination, nullptr, CERR));
+            TSUNIT_EQUAL(sizes[i], ret_size);
+            TSUNIT_EQUAL('a' + i, buffer[0]);
+            TSUNIT_EQUAL('a' + i, buffer[ret_size - 1]);
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(UDPSendBatchDelay)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12352;
+    const ts::UString destination(ts::UString::Format(u"127.0.0.1:%d", portNumber));
+
+    // Create receiver socket. Use a short timeout to check that no datagram is pending.
+    ts::UDPSocket receiver(true, ts::IP::v4);
+    TSUNIT_ASSERT(receiver.isOpen());
+    TSUNIT_ASSERT(receiver.reusePort(true, CERR));
+    TSUNIT_ASSERT(receiver.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+    TSUNIT_ASSERT(receiver.setReceiveTimeout(cn::milliseconds(50), CERR));
+
+    // Count the received datagrams until the timeout.
+    const auto received = [&receiver]() {
+        size_t count = 0;
+        uint8_t buffer[ts::PKT_SIZE + 1];
+        size_t ret_size = 0;
+        ts::IPSocketAddress from, dest;
+        while (receiver.receive(buffer, sizeof(buffer), ret_size, from, dest, nullptr, NULLREP)) {
+            TSUNIT_EQUAL(ts::PKT_SIZE, ret_size);
+            count++;
+        }
+        return count;
+    };
+
+    // Option --gso is useless without --send-batch.
+    {
+        ts::Args args(u"", u"", ts::Args::NO_ERROR_DISPLAY | ts::Args::NO_EXIT_ON_ERROR);
+        ts::TSDatagramOutput output(ts::TSDatagramOutputOptions::ALWAYS_BURST | ts::TSDatagramOutputOptions::KEEP_BATCH);
+        output.defineArgs(args);
+        TSUNIT_ASSERT(args.analyze(u"", {u"--gso", destination}));
+        ts::DuckContext duck;
+        TSUNIT_ASSERT(!output.loadArgs(duck, args));
+    }
+
+    // Keep incomplete batches between packets, as in the ip packet plugin.
+    ts::Args args(u"", u"", ts::Args::NO_ERROR_DISPLAY | ts::Args::NO_EXIT_ON_ERROR);
+    ts::TSDatagramOutput output(ts::TSDatagramOutputOptions::ALWAYS_BURST | ts::TSDatagramOutputOptions::KEEP_BATCH);
+    output.defineArgs(args);
+    TSUNIT_ASSERT(args.analyze(u"", {u"--packet-burst", u"1", u"--send-batch", u"8", u"--max-batch-delay", u"500", destination}));
+    ts::DuckContext duck;
+    TSUNIT_ASSERT(output.loadArgs(duck, args));
+    TSUNIT_ASSERT(output.open(CERR));
+
+    // The first datagrams are kept in an incomplete batch.
+    for (size_t i = 0; i < 3; ++i) {
+        TSUNIT_ASSERT(output.send(&ts::NullPacket, nullptr, 1, 0, CERR));
+    }
+    TSUNIT_EQUAL(0, received());
+
+    // After the maximum delay, the next packet sends the incomplete batch.
+    std::this_thread::sleep_for(cn::milliseconds(550));
+    TSUNIT_ASSERT(output.send(&ts::NullPacket, nullptr, 1, 0, CERR));
+    TSUNIT_EQUAL(4, received());
+
+    // Pending datagrams are sent on close.
+    for (size_t i = 0; i < 2; ++i) {
+        TSUNIT_ASSERT(output.send(&ts::NullPacket, nullptr, 1, 0, CERR));
+    }
+    TSUNIT_ASSERT(output.close(0, false, CERR));
+    TSUNIT_EQUAL(2, received());
+}
+
+// A thread class which implements a client of a TCPFanOutServer.
+namespace {
+    class FanOutClient: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(FanOutClient);
+    private:
+        uint16_t _portNumber;
+        bool     _sendRequest;
+        bool     _readData;
+        bool     _keepData;
+    public:
+        std::atomic_bool connected {false};  // Set when the client is connected.
+        std::atomic_bool release {false};    // Set to terminate a client which does not read data.
+        ts::ByteBlock    data {};            // All received data.
+        size_t           received = 0;       // Total received size.
+
+        // Constructor
+        FanOutClient(uint16_t portNumber, bool sendRequest, bool readData, bool keepData) :
+            utest::TSUnitThread(),
+            _portNumber(portNumber),
+            _sendRequest(sendRequest),
+            _readData(readData),
+            _keepData(keepData)
+        {
+        }
+
+        // Destructor
+        virtual ~FanOutClient() override
+        {
+            release = true;
+            waitForTermination();
+        }
+
+        // Thread execution
+        virtual void test() override
+        {
+            ts::TCPConnection session;
+            TSUNIT_ASSERT(session.open(ts::IP::v4, CERR));
+            if (!_readData) {
+                // Small buffer, to be quickly considered as too slow.
+                TSUNIT_ASSERT(session.setReceiveBufferSize(1024, CERR));
+            }
+            TSUNIT_ASSERT(session.connect(ts::IPSocketAddress(ts::IPAddress::LocalHost4, _portNumber), CERR));
+            if (_sendRequest) {
+                const char request[] = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+                TSUNIT_ASSERT(session.send(request, sizeof(request) - 1, CERR));
+            }
+            connected = true;
+            if (_readData) {
+                uint8_t buffer[65536];
+                size_t size = 0;
+                while (session.receive(buffer, sizeof(buffer), size, nullptr, NULLREP)) {
+                    if (_keepData) {
+                        data.append(buffer, size);
+                    }
+                    received += size;
+                }
+            }
+            else {
+                while (!release) {
+                    std::this_thread::sleep_for(cn::milliseconds(10));
+                }
+            }
+            session.close(NULLREP);
+        }
+    };
+
+    // A fan-out server with a simple request / response protocol.
+    class FanOutServer: public ts::TCPFanOutServer
+    {
+    public:
+        FanOutServer() = default;
+        virtual ~FanOutServer() override { stop(); }
+    protected:
+        virtual bool processRequest(const ts::IPSocketAddress&, const std::string& request, std::string& response) override
+        {
+            const bool ok = request.starts_with("GET / ") && request.ends_with("\r\n\r\n");
+            response = ok ? "OK\r\n\r\n" : "KO\r\n\r\n";
+            return ok;
+        }
+    };
+
+    // Wait for a condition, up to 5 seconds.
+    template <class PREDICATE>
+    bool WaitFor(PREDICATE pred)
+    {
+        for (int i = 0; i < 500 && !pred(); ++i) {
+            std::this_thread::sleep_for(cn::milliseconds(10));
+        }
+        return pred();
+    }
+}
+
+TSUNIT_DEFINE_TEST(TCPFanOut)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12348;
+    constexpr size_t client_count = 3;
+    constexpr size_t chunk_count = 200;
+    constexpr size_t chunk_size = 7 * 188;
+
+    FanOutServer server;
+    ts::TCPFanOutServer::Options opt;
+    opt.server_address = ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber);
+    opt.max_clients = client_count;
+    opt.client_buffer_size = chunk_count * chunk_size;
+    opt.wait_request = true;
+    TSUNIT_ASSERT(server.start(opt, CERR));
+    TSUNIT_ASSERT(server.isStarted());
+    TSUNIT_EQUAL(0, server.clientCount());
+
+    std::vector<std::unique_ptr<FanOutClient>> clients;
+    for (size_t i = 0; i < client_count; ++i) {
+        clients.push_back(std::make_unique<FanOutClient>(portNumber, true, true, true));
+        clients.back()->start();
+    }
+    TSUNIT_ASSERT(WaitFor([&]() { return server.clientCount() == client_count; }));
+
+    // One more client is rejected.
+    {
+        FanOutClient extra(portNumber, false, true, false);
+        extra.start();
+        extra.waitForTermination();
+        TSUNIT_EQUAL(0, extra.received);
+    }
+    TSUNIT_EQUAL(client_count, server.clientCount());
+
+    // Send chunks, each with a different content.
+    ts::ByteBlock chunk(chunk_size);
+    for (size_t i = 0; i < chunk_count; ++i) {
+        chunk.assign(chunk_size, uint8_t(i));
+        server.send(chunk.data(), chunk.size());
+    }
+
+    // Wait for all data to be received by all clients, then disconnect them.
+    const std::string response("OK\r\n\r\n");
+    TSUNIT_ASSERT(WaitFor([&]() { return server.statistics().bytes_sent == client_count * chunk_count * chunk_size; }));
+    server.stop();
+    TSUNIT_ASSERT(!server.isStarted());
+
+    for (const auto& client : clients) {
+        client->waitForTermination();
+        TSUNIT_EQUAL(response.size() + chunk_count * chunk_size, client->data.size());
+        TSUNIT_EQUAL(0, ts::MemCompare(client->data.data(), response.data(), response.size()));
+        for (size_t i = 0; i < chunk_count; ++i) {
+            TSUNIT_EQUAL(uint8_t(i), client->data[response.size() + i * chunk_size]);
+            TSUNIT_EQUAL(uint8_t(i), client->data[response.size() + (i + 1) * chunk_size - 1]);
+        }
+    }
+
+    const ts::TCPFanOutServer::Statistics stats(server.statistics());
+    TSUNIT_EQUAL(client_count, stats.accepted_clients);
+    TSUNIT_EQUAL(1, stats.rejected_clients);
+    TSUNIT_EQUAL(0, stats.dropped_clients);
+    TSUNIT_EQUAL(0, stats.bytes_skipped);
+}
+
+TSUNIT_DEFINE_TEST(TCPFanOutSlowClient)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12349;
+    constexpr size_t chunk_size = 7 * 188;
+    const ts::ByteBlock chunk(chunk_size, 0x47);
+
+    for (bool skip : {true, false}) {
+        FanOutServer server;
+        ts::TCPFanOutServer::Options opt;
+        opt.server_address = ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber);
+        opt.send_buffer_size = 4096;
+        opt.client_buffer_size = 16 * chunk_size;
+        opt.skip_slow_clients = skip;
+        TSUNIT_ASSERT(server.start(opt, CERR));
+
+        // A client which never reads.
+        FanOutClient client(portNumber, false, false, false);
+        client.start();
+        TSUNIT_ASSERT(WaitFor([&]() { return server.clientCount() == 1; }));
+
+        // Sending never blocks, whatever the client does.
+        for (size_t i = 0; i < 10000; ++i) {
+            server.send(chunk.data(), chunk.size());
+        }
+
+        if (skip) {
+            const ts::TCPFanOutServer::Statistics stats(server.statistics());
+            TSUNIT_ASSERT(stats.bytes_skipped > 0);
+            TSUNIT_EQUAL(0, stats.bytes_skipped % chunk_size);
+            TSUNIT_EQUAL(0, stats.dropped_clients);
+            TSUNIT_EQUAL(1, server.clientCount());
+        }
+        else {
+            TSUNIT_ASSERT(WaitFor([&]() { return server.statistics().dropped_clients == 1; }));
+            TSUNIT_EQUAL(0, server.clientCount());
+        }
+        client.release = true;
+        client.waitForTermination();
+        server.stop();
+    }
+}
+
+TSUNIT_DEFINE_TEST(TCPFanOutLargeSend)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12351;
+    constexpr size_t unit_size = 188;
+    constexpr size_t buffer_units = 100;
+    constexpr size_t send_units = 5 * buffer_units;
+
+    // Numbered data units, sent in one single call, much larger than the client buffer.
+    ts::ByteBlock data(send_units * unit_size, 0xFF);
+    for (size_t i = 0; i < send_units; ++i) {
+        data[i * unit_size] = 0x47;
+        ts::PutUInt16(&data[i * unit_size + 1], uint16_t(i));
+    }
+
+    for (bool skip : {true, false}) {
+        FanOutServer server;
+        ts::TCPFanOutServer::Options opt;
+        opt.server_address = ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber);
+        opt.client_buffer_size = buffer_units * unit_size + unit_size / 2;
+        opt.data_unit = unit_size;
+        opt.skip_slow_clients = skip;
+        TSUNIT_ASSERT(server.start(opt, CERR));
+
+        FanOutClient client(portNumber, false, true, true);
+        client.start();
+        TSUNIT_ASSERT(WaitFor([&]() { return server.clientCount() == 1; }));
+
+        // The complete units which fit in the empty buffer are queued, the slow client policy applies to the rest.
+        server.send(data.data(), data.size());
+
+        if (skip) {
+            // The client is still connected and receives the first units, then the next data.
+            TSUNIT_EQUAL((send_units - buffer_units) * unit_size, server.statistics().bytes_skipped);
+            TSUNIT_ASSERT(WaitFor([&]() { return server.statistics().bytes_sent == buffer_units * unit_size; }));
+            server.send(data.data(), unit_size);
+            TSUNIT_ASSERT(WaitFor([&]() { return server.statistics().bytes_sent == (buffer_units + 1) * unit_size; }));
+            TSUNIT_EQUAL(1, server.clientCount());
+            server.stop();
+            client.waitForTermination();
+            TSUNIT_EQUAL((buffer_units + 1) * unit_size, client.data.size());
+            for (size_t i = 0; i <= buffer_units; ++i) {
+                TSUNIT_EQUAL(0x47, client.data[i * unit_size]);
+                TSUNIT_EQUAL(i % buffer_units, ts::GetUInt16(&client.data[i * unit_size + 1]));
+            }
+        }
+        else {
+            // The rest of the data does not fit in the buffer, the client is disconnected.
+            TSUNIT_ASSERT(WaitFor([&]() { return server.statistics().dropped_clients == 1; }));
+            TSUNIT_EQUAL(0, server.clientCount());
+            client.waitForTermination();
+            TSUNIT_ASSERT(client.data.size() <= buffer_units * unit_size);
+            server.stop();
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(TCPFanOutLoad)
+{
+    // Loopback load test. The number of clients and the amount of data are configurable.
+    // Packets are sent as fast as possible, slow clients skip packets.
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12350;
+    size_t client_count = 0;
+    if (!ts::GetEnvironment(u"TSUNIT_FANOUT_CLIENTS").toInteger(client_count) || client_count == 0) {
+        client_count = 50;
+    }
+    utest::TSUnitBenchmark bench(u"TSUNIT_FANOUT_ITERATIONS");
+    constexpr size_t chunk_size = 7 * 188;
+    constexpr size_t chunk_count = 4000;  // About 5 MB per iteration.
+
+    FanOutServer server;
+    ts::TCPFanOutServer::Options opt;
+    opt.server_address = ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber);
+    opt.max_clients = client_count;
+    opt.skip_slow_clients = true;
+    TSUNIT_ASSERT(server.start(opt, CERR));
+
+    std::vector<std::unique_ptr<FanOutClient>> clients;
+    for (size_t i = 0; i < client_count; ++i) {
+        clients.push_back(std::make_unique<FanOutClient>(portNumber, false, true, false));
+        clients.back()->start();
+    }
+    TSUNIT_ASSERT(WaitFor([&]() { return server.clientCount() == client_count; }));
+
+    // The process CPU time includes the server thread and the clients threads.
+    const ts::ByteBlock chunk(chunk_size, 0x47);
+    const uint64_t total_size = uint64_t(client_count) * chunk_count * chunk_size * bench.iterations;
+    const auto start = std::chrono::steady_clock::now();
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        for (size_t i = 0; i < chunk_count; ++i) {
+            server.send(chunk.data(), chunk.size());
+        }
+    }
+
+    // Let the clients receive the rest of their buffers.
+    WaitFor([&]() { const auto st(server.statistics()); return st.bytes_sent + st.bytes_skipped >= total_size; });
+    bench.stop();
+    const auto duration = cn::duration_cast<cn::milliseconds>(std::chrono::steady_clock::now() - start);
+    server.stop();
+    for (const auto& client : clients) {
+        client->waitForTermination();
+        TSUNIT_ASSERT(client->received > 0);
+    }
+
+    const ts::TCPFanOutServer::Statistics stats(server.statistics());
+    TSUNIT_EQUAL(client_count, stats.accepted_clients);
+    TSUNIT_EQUAL(0, stats.dropped_clients);
+    const uint64_t per_client = stats.bytes_sent / client_count;
+    debug() << "NetworkingTest::TCPFanOutLoad: " << client_count << " clients, "
+            << per_client << " bytes per client, "
+            << (duration.count() > 0 ? per_client * 8 / uint64_t(duration.count()) / 1000 : 0) << " Mb/s per client, "
+            << stats.bytes_skipped << " bytes skipped, "
+            << duration.count() << " ms" << std::endl;
+    bench.report(u"NetworkingTest::TCPFanOutLoad, process CPU time");
+}
+
 TSUNIT_DEFINE_TEST(IPHeader)
 {
     static const uint8_t reference_header[] = {
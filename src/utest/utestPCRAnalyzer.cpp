@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for PCRAnalyzer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPCRAnalyzer.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PCRAnalyzerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(SameClock);
+    TSUNIT_DECLARE_TEST(IndependentClocks);
+    TSUNIT_DECLARE_TEST(Discontinuity);
+    TSUNIT_DECLARE_TEST(ManyPrograms);
+
+private:
+    // With 1000 PCR units per packet, the TS bitrate is exactly 40,608,000 b/s.
+    static constexpr uint64_t PCR_PER_PACKET = 1000;
+    static constexpr uint64_t BITRATE_188 = ts::SYSTEM_CLOCK_FREQ * ts::PKT_SIZE_BITS / PCR_PER_PACKET;
+    static constexpr uint64_t BITRATE_204 = ts::SYSTEM_CLOCK_FREQ * ts::PKT_RS_SIZE_BITS / PCR_PER_PACKET;
+
+    // Generate a stream with one PCR PID per program, the PID's are interleaved.
+    // Each PID carries a PCR every 10 packets. When independent_clocks is true,
+    // each program uses a distinct PCR origin.
+    static void GenerateStream(ts::TSPacketVector& packets, size_t program_count, size_t packet_count, bool independent_clocks);
+
+    // Feed the analyzer with all packets.
+    static void Feed(ts::PCRAnalyzer& zer, const ts::TSPacketVector& packets);
+};
+
+TSUNIT_REGISTER(PCRAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Test helpers.
+//----------------------------------------------------------------------------
+
+void PCRAnalyzerTest::GenerateStream(ts::TSPacketVector& packets, size_t program_count, size_t packet_count, bool independent_clocks)
+{
+    std::vector<uint8_t> cc(program_count, 0);
+    std::vector<size_t> pid_count(program_count, 0);
+
+    packets.resize(packet_count);
+    for (size_t i = 0; i < packet_count; ++i) {
+        const size_t prog = i % program_count;
+        ts::TSPacket& pkt(packets[i]);
+        pkt.init(ts::PID(0x0100 + prog), cc[prog], uint8_t(i));
+        cc[prog] = (cc[prog] + 1) % ts::CC_MAX;
+        if (pid_count[prog]++ % 10 == 0) {
+            // Distinct clock origins are 1/3 second apart. They all wrap around after about 2 seconds.
+            const uint64_t origin = independent_clocks ? ts::PCR_SCALE - 2 * ts::SYSTEM_CLOCK_FREQ + prog * ts::SYSTEM_CLOCK_FREQ / 3 : 0;
+            pkt.setPCR((origin + i * PCR_PER_PACKET) % ts::PCR_SCALE, true);
+        }
+    }
+}
+
+void PCRAnalyzerTest::Feed(ts::PCRAnalyzer& zer, const ts::TSPacketVector& packets)
+{
+    for (const auto& pkt : packets) {
+        zer.feedPacket(pkt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(SameClock)
+{
+    ts::TSPacketVector packets;
+    GenerateStream(packets, 4, 100'000, false);
+
+    ts::PCRAnalyzer zer;
+    Feed(zer, packets);
+
+    ts::PCRAnalyzer::Status status(zer);
+    debug() << "PCRAnalyzerTest::SameClock: " << status << std::endl;
+    TSUNIT_ASSERT(status.bitrate_valid);
+    TSUNIT_EQUAL(4, status.pcr_pids);
+    TSUNIT_EQUAL(BITRATE_188, status.bitrate_188.toInt());
+    TSUNIT_EQUAL(BITRATE_204, status.bitrate_204.toInt());
+    TSUNIT_EQUAL(BITRATE_188, status.instantaneous_bitrate_188.toInt());
+    TSUNIT_EQUAL(BITRATE_204, status.instantaneous_bitrate_204.toInt());
+    TSUNIT_EQUAL(BITRATE_188 / 4, zer.bitrate188(0x0101).toInt());
+}
+
+TSUNIT_DEFINE_TEST(IndependentClocks)
+{
+    // Programs using different clocks shall not interfere in the instantaneous bitrate.
+    ts::TSPacketVector packets;
+    GenerateStream(packets, 10, 100'000, true);
+
+    ts::PCRAnalyzer zer;
+    Feed(zer, packets);
+
+    ts::PCRAnalyzer::Status status(zer);
+    debug() << "PCRAnalyzerTest::IndependentClocks: " << status << std::endl;
+    TSUNIT_ASSERT(status.bitrate_valid);
+    TSUNIT_EQUAL(10, status.pcr_pids);
+    TSUNIT_EQUAL(BITRATE_188, status.bitrate_188.toInt());
+    TSUNIT_EQUAL(BITRATE_188, status.instantaneous_bitrate_188.toInt());
+}
+
+TSUNIT_DEFINE_TEST(Discontinuity)
+{
+    ts::TSPacketVector packets;
+    GenerateStream(packets, 2, 50'000, false);
+
+    // Drop one packet in the middle of the stream.
+    packets.erase(packets.begin() + 25'001);
+
+    ts::PCRAnalyzer zer;
+    Feed(zer, packets);
+
+    ts::PCRAnalyzer::Status status(zer);
+    debug() << "PCRAnalyzerTest::Discontinuity: " << status << std::endl;
+    TSUNIT_ASSERT(status.bitrate_valid);
+    TSUNIT_EQUAL(1, status.discontinuities);
+    TSUNIT_EQUAL(BITRATE_188, status.bitrate_188.toInt());
+    TSUNIT_EQUAL(BITRATE_188, status.instantaneous_bitrate_188.toInt());
+}
+
+TSUNIT_DEFINE_TEST(ManyPrograms)
+{
+    // 100 programs, 10 seconds of stream.
+    ts::TSPacketVector packets;
+    GenerateStream(packets, 100, 10 * ts::SYSTEM_CLOCK_FREQ / PCR_PER_PACKET, true);
+
+    ts::PCRAnalyzer::Status status;
+    utest::TSUnitBenchmark bench(u"TSUNIT_PCRANALYZER_ITERATIONS");
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        ts::PCRAnalyzer zer;
+        bench.start();
+        Feed(zer, packets);
+        bench.stop();
+        zer.getStatus(status);
+    }
+    bench.report(u"PCRAnalyzerTest::ManyPrograms", packets.size() * ts::PKT_SIZE);
+
+    debug() << "PCRAnalyzerTest::ManyPrograms: " << status << std::endl;
+    TSUNIT_ASSERT(status.bitrate_valid);
+    TSUNIT_EQUAL(100, status.pcr_pids);
+    TSUNIT_EQUAL(BITRATE_188, status.bitrate_188.toInt());
+    TSUNIT_EQUAL(BITRATE_188, status.instantaneous_bitrate_188.toInt());
+}
@@ -24,6 +24,7 @@
 class PESPacketizerTest: public tsunit::Test, private ts::PESHandlerInterface
 {
     TSUNIT_DECLARE_TEST(Packetizer);
+    TSUNIT_DECLARE_TEST(SharedPES);
 
 public:
     virtual void beforeTest() override;
@@ -31,6 +32,8 @@ public:
 
 private:
     size_t _pes_count = 0;
+    bool _retain = false;
+    std::list<ts::PESPacket> _retained {};
     virtual void handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& packet) override;
 };
 
@@ -45,6 +48,8 @@ TSUNIT_REGISTER(PESPacketizerTest);
 void PESPacketizerTest::beforeTest()
 {
     _pes_count = 0;
+    _retain = false;
+    _retained.clear();
 }
 
 // Test suite cleanup method.
@@ -115,8 +120,71 @@ TSUNIT_DEFINE_TEST(Packetizer)
     TSUNIT_EQUAL(2, _pes_count);
 }
 
+TSUNIT_DEFINE_TEST(SharedPES)
+{
+    // Build PES packets of various sizes on two PID's.
+    ts::DuckContext duck;
+    ts::PESOneShotPacketizer zer1(duck, 100);
+    ts::PESOneShotPacketizer zer2(duck, 200);
+    for (size_t i = 0; i < 20; ++i) {
+        ts::ByteBlock data(500 + 300 * i);
+        data[0] = 0x00;  // start code prefix
+        data[1] = 0x00;
+        data[2] = 0x01;
+        data[3] = 0xBE;  // padding stream
+        ts::PutUInt16(data.data() + 4, uint16_t(data.size() - 6));
+        for (size_t j = 6; j < data.size(); j++) {
+            data[j] = uint8_t(7 * i + j);
+        }
+        const ts::PESPacket pes(data);
+        (i % 2 == 0 ? zer1 : zer2).addPES(pes, ts::ShareMode::COPY);
+    }
+    ts::TSPacketVector packets1, packets2;
+    zer1.getPackets(packets1);
+    zer2.getPackets(packets2);
+
+    // Demux all packets, keeping a shared view on each PES packet.
+    // A non-PES unit start on PID 100 releases its context between the two series.
+    _retain = true;
+    ts::PESDemux demux(duck, this);
+    for (const auto& pkt : packets1) {
+        demux.feedPacket(pkt);
+    }
+    ts::TSPacket pkt(ts::NullPacket);
+    pkt.setPID(100);
+    pkt.setPUSI();
+    demux.feedPacket(pkt);
+    for (const auto& p : packets2) {
+        demux.feedPacket(p);
+    }
+    for (const auto& p : packets1) {
+        demux.feedPacket(p);
+    }
+
+    // The retained packets are not modified by the demux.
+    TSUNIT_EQUAL(30, _retained.size());
+    size_t index = 0;
+    for (const auto& pes : _retained) {
+        const size_t i = index < 10 ? 2 * index : index < 20 ? 2 * (index - 10) + 1 : 2 * (index - 20);
+        TSUNIT_ASSERT(pes.isValid());
+        TSUNIT_EQUAL(i % 2 == 0 ? 100 : 200, pes.sourcePID());
+        TSUNIT_EQUAL(500 + 300 * i, pes.size());
+        bool same = true;
+        for (size_t j = pes.headerSize(); same && j < pes.size(); j++) {
+            same = pes.content()[j] == uint8_t(7 * i + j);
+        }
+        TSUNIT_ASSERT(same);
+        index++;
+    }
+}
+
 void PESPacketizerTest::handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& pes)
 {
+    if (_retain) {
+        // Keep a shared view on the PES content, without copy.
+        _retained.emplace_back(pes, ts::ShareMode::SHARE);
+        return;
+    }
     _pes_count++;
     TSUNIT_ASSERT(pes.isValid());
     TSUNIT_EQUAL(100, pes.sourcePID());
@@ -14,7 +14,10 @@
 #include "tsReportFile.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
+#include "tsAsyncReport.h"
 #include "tsunit.h"
+#include "utestTSUnitThread.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -30,6 +33,8 @@ class ReportTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(ByStream);
     TSUNIT_DECLARE_TEST(ErrCodeReport);
     TSUNIT_DECLARE_TEST(Delegation);
+    TSUNIT_DECLARE_TEST(AsyncSynchronous);
+    TSUNIT_DECLARE_TEST(AsyncOverflow);
 
 public:
     virtual void beforeTest() override;
@@ -392,3 +397,124 @@ TSUNIT_DEFINE_TEST(Delegation)
     rep.info(u"text 6");
     TSUNIT_EQUAL(u"", log.messages());
 }
+
+// Asynchronous report which checks the order of messages "thread:index" from several threads.
+namespace {
+    class CheckAsyncReport: public ts::AsyncReport
+    {
+        TS_NOCOPY(CheckAsyncReport);
+    public:
+        size_t received = 0;
+        bool   ordered = true;
+        std::vector<size_t> next_index;
+
+        CheckAsyncReport(size_t thread_count, const ts::AsyncReportArgs& args) :
+            ts::AsyncReport(ts::Severity::Info, args),
+            next_index(thread_count, 0)
+        {
+        }
+        virtual ~CheckAsyncReport() override
+        {
+            terminate();
+        }
+    protected:
+        virtual void asyncThreadLog(int severity, const ts::UString& message) override
+        {
+            const size_t colon = message.find(u':');
+            size_t thread = 0, index = 0;
+            if (severity == ts::Severity::Info && colon != ts::NPOS &&
+                message.substr(0, colon).toInteger(thread) && message.substr(colon + 1).toInteger(index) &&
+                thread < next_index.size())
+            {
+                received++;
+                ordered = ordered && index >= next_index[thread];
+                next_index[thread] = index + 1;
+            }
+        }
+    };
+
+    class AsyncLogThread: public utest::TSUnitThread
+    {
+        TS_NOCOPY(AsyncLogThread);
+    private:
+        ts::Report& _report;
+        size_t      _thread;
+        size_t      _count;
+    public:
+        AsyncLogThread(ts::Report& report, size_t thread, size_t count) :
+            utest::TSUnitThread(),
+            _report(report),
+            _thread(thread),
+            _count(count)
+        {
+        }
+        virtual ~AsyncLogThread() override
+        {
+            waitForTermination();
+        }
+        virtual void test() override
+        {
+            for (size_t i = 0; i < _count; ++i) {
+                _report.info(u"%d:%d", _thread, i);
+            }
+        }
+    };
+
+    // Log messages from several threads, return when all threads are completed.
+    void AsyncLog(ts::Report& report, size_t thread_count, size_t message_count)
+    {
+        std::vector<std::unique_ptr<AsyncLogThread>> threads;
+        for (size_t t = 0; t < thread_count; ++t) {
+            threads.push_back(std::make_unique<AsyncLogThread>(report, t, message_count));
+            threads.back()->start();
+        }
+        for (auto& thread : threads) {
+            thread->waitForTermination();
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(AsyncSynchronous)
+{
+    // Small queue, the threads are frequently blocked.
+    constexpr size_t thread_count = 4;
+    constexpr size_t message_count = 20'000;
+    ts::AsyncReportArgs args;
+    args.sync_log = true;
+    args.log_msg_count = 64;
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_ASYNCREPORT_ITERATIONS");
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        CheckAsyncReport report(thread_count, args);
+        bench.start();
+        AsyncLog(report, thread_count, message_count);
+        report.terminate();
+        bench.stop();
+        TSUNIT_EQUAL(thread_count * message_count, report.received);
+        TSUNIT_ASSERT(report.ordered);
+        TSUNIT_EQUAL(0, report.droppedMessages());
+        for (size_t t = 0; t < thread_count; ++t) {
+            TSUNIT_EQUAL(message_count, report.next_index[t]);
+        }
+    }
+    bench.report(u"ReportTest::AsyncSynchronous, 4 threads");
+    if (bench.cpuTime() > cn::milliseconds::zero()) {
+        debug() << "ReportTest::AsyncSynchronous: " << (1000 * thread_count * message_count * bench.iterations / bench.cpuTime().count()) << " messages/s" << std::endl;
+    }
+}
+
+TSUNIT_DEFINE_TEST(AsyncOverflow)
+{
+    // Default asynchronous mode, messages are dropped on overflow, but all are accounted for.
+    constexpr size_t thread_count = 4;
+    constexpr size_t message_count = 20'000;
+    ts::AsyncReportArgs args;
+    args.log_msg_count = 64;
+
+    CheckAsyncReport report(thread_count, args);
+    AsyncLog(report, thread_count, message_count);
+    report.terminate();
+    debug() << "ReportTest::AsyncOverflow: " << report.received << " messages received, " << report.droppedMessages() << " dropped" << std::endl;
+    TSUNIT_EQUAL(thread_count * message_count, report.received + report.droppedMessages());
+    TSUNIT_ASSERT(report.ordered);
+}
@@ -0,0 +1,286 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the scrambler and descrambler plugins in
+//  packet-window mode and per-packet mode.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsTSProcessor.h"
+#include "tsReportBuffer.h"
+#include "tsCyclingPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsTSFile.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ScramblerPluginTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(WindowSameAsPacket);
+
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+private:
+    fs::path _clearFile {};
+    fs::path _scrambledFile {};
+    fs::path _cwFile {};
+
+    // Test stream: one service with a video and an audio PID, plus a clear PID and null packets.
+    static constexpr size_t   PACKET_COUNT = 20000;
+    static constexpr uint16_t SERVICE_ID = 1;
+    static constexpr ts::PID  PMT_PID = 0x1000;
+    static constexpr ts::PID  VIDEO_PID = 0x0100;
+    static constexpr ts::PID  AUDIO_PID = 0x0101;
+    static constexpr ts::PID  CLEAR_PID = 0x0200;
+    static const ts::BitRate  BITRATE;
+
+    // Create the clear test stream.
+    void createClearFile(ts::TSPacketVector& packets);
+
+    // Run a tsp chain with one plugin from a file into a vector of packets.
+    void run(const fs::path& input, const ts::PluginOptions& plugin, ts::TSPacketVector& output, utest::TSUnitBenchmark* bench = nullptr);
+};
+
+TSUNIT_REGISTER(ScramblerPluginTest);
+
+// At 1 Mb/s, one-second crypto-periods are 664 packets long, not aligned on windows.
+const ts::BitRate ScramblerPluginTest::BITRATE = 1'000'000;
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+void ScramblerPluginTest::beforeTest()
+{
+    if (_clearFile.empty()) {
+        _clearFile = ts::TempFile(u".clear.ts");
+        _scrambledFile = ts::TempFile(u".scrambled.ts");
+        _cwFile = ts::TempFile(u".cw.txt");
+    }
+    fs::remove(_clearFile, &ts::ErrCodeReport());
+    fs::remove(_scrambledFile, &ts::ErrCodeReport());
+    fs::remove(_cwFile, &ts::ErrCodeReport());
+}
+
+void ScramblerPluginTest::afterTest()
+{
+    fs::remove(_clearFile, &ts::ErrCodeReport());
+    fs::remove(_scrambledFile, &ts::ErrCodeReport());
+    fs::remove(_cwFile, &ts::ErrCodeReport());
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory output plugin: collect all packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Output : public ts::PluginEventHandlerInterface
+    {
+    public:
+        Output(ts::TSPacketVector& packets) : _packets(packets) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        ts::TSPacketVector& _packets;
+    };
+
+    void Output::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const ts::TSPacket* packets = reinterpret_cast<const ts::TSPacket*>(data->data());
+            _packets.insert(_packets.end(), packets, packets + data->size() / ts::PKT_SIZE);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Create the clear test stream.
+//----------------------------------------------------------------------------
+
+void ScramblerPluginTest::createClearFile(ts::TSPacketVector& packets)
+{
+    ts::DuckContext duck;
+    ts::PAT pat(0, true, 0x0010);
+    pat.pmts[SERVICE_ID] = PMT_PID;
+    ts::PMT pmt(0, true, SERVICE_ID, VIDEO_PID);
+    pmt.streams[VIDEO_PID].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt.streams[AUDIO_PID].stream_type = ts::ST_MPEG1_AUDIO;
+
+    ts::CyclingPacketizer pzer_pat(duck, ts::PID_PAT);
+    ts::CyclingPacketizer pzer_pmt(duck, PMT_PID);
+    pzer_pat.addTable(duck, pat);
+    pzer_pmt.addTable(duck, pmt);
+
+    // Interleave the two scrambled PID's with clear packets, packets without payload and short payloads.
+    packets.resize(PACKET_COUNT);
+    std::map<ts::PID, uint8_t> cc;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        ts::TSPacket& pkt(packets[i]);
+        if (i % 100 == 0) {
+            TSUNIT_ASSERT(pzer_pat.getNextPacket(pkt));
+        }
+        else if (i % 100 == 1) {
+            TSUNIT_ASSERT(pzer_pmt.getNextPacket(pkt));
+        }
+        else if (i % 7 == 3) {
+            pkt = ts::NullPacket;
+        }
+        else {
+            const ts::PID pid = i % 11 == 5 ? CLEAR_PID : (i % 3 == 0 ? AUDIO_PID : VIDEO_PID);
+            pkt.init(pid, cc[pid]++ & ts::CC_MASK);
+            for (size_t k = 4; k < ts::PKT_SIZE; ++k) {
+                pkt.b[k] = uint8_t(i * 31 + k * 7);
+            }
+            if (pid == VIDEO_PID && i % 13 == 6) {
+                // Adaptation field only, no payload.
+                TSUNIT_ASSERT(pkt.setPayloadSize(0));
+            }
+            else if (pid == VIDEO_PID && i % 17 == 8) {
+                // Shorter payload with a PCR.
+                TSUNIT_ASSERT(pkt.setPCR(uint64_t(i) * 1000, true));
+            }
+        }
+    }
+
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_clearFile, ts::TSFile::WRITE, CERR, ts::TSPacketFormat::TS));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+
+//----------------------------------------------------------------------------
+// Run a tsp chain with one plugin from a file into a vector of packets.
+//----------------------------------------------------------------------------
+
+void ScramblerPluginTest::run(const fs::path& input, const ts::PluginOptions& plugin, ts::TSPacketVector& output, utest::TSUnitBenchmark* bench)
+{
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"ScramblerPluginTest";
+    opt.fixed_bitrate = BITRATE;
+    opt.input = {u"file", {ts::UString(input)}};
+    opt.plugins = {plugin};
+    opt.output = {u"memory", {}};
+
+    output.clear();
+    Output handler(output);
+    ts::ReportBuffer<ts::ThreadSafety::Full> log;
+    ts::TSProcessor tsproc(log);
+    tsproc.registerEventHandler(&handler, ts::PluginType::OUTPUT);
+
+    if (bench != nullptr) {
+        bench->start();
+    }
+    const bool started = tsproc.start(opt);
+    if (started) {
+        tsproc.waitForTermination();
+    }
+    if (bench != nullptr) {
+        bench->stop();
+    }
+    if (!started || log.gotErrors()) {
+        debug() << "ScramblerPluginTest: " << plugin.name << ": " << log.messages() << std::endl;
+    }
+    TSUNIT_ASSERT(started);
+    TSUNIT_ASSERT(!log.gotErrors());
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(WindowSameAsPacket)
+{
+    ts::TSPacketVector clear;
+    createClearFile(clear);
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringList({u"0123456789ABCDEF", u"FEDCBA9876543210", u"00112233445566FF", u"8899AABBCCDDEEFF"}), _cwFile));
+
+    // Scramble the service in per-packet mode and in packet-window mode, with a CW change every second.
+    // Windows of 7 packets do not contain all scrambled PID's, windows of 256 packets contain CW changes.
+    const ts::UString cw_file(_cwFile);
+    ts::TSPacketVector ref, out;
+    utest::TSUnitBenchmark bench_packet(u"TSUNIT_SCRAMBLER_ITERATIONS");
+    utest::TSUnitBenchmark bench_window(u"TSUNIT_SCRAMBLER_ITERATIONS");
+    for (size_t iter = 0; iter < bench_packet.iterations; ++iter) {
+        run(_clearFile, {u"scrambler", {u"--cw-file", cw_file, u"--cp-duration", u"1", u"--packet-window", u"0", ts::UString::Decimal(SERVICE_ID)}}, ref, &bench_packet);
+        run(_clearFile, {u"scrambler", {u"--cw-file", cw_file, u"--cp-duration", u"1", u"--packet-window", u"256", ts::UString::Decimal(SERVICE_ID)}}, out, &bench_window);
+    }
+    bench_packet.report(u"ScramblerPluginTest::WindowSameAsPacket, per packet");
+    bench_window.report(u"ScramblerPluginTest::WindowSameAsPacket, 256-packet window");
+    TSUNIT_EQUAL(clear.size(), ref.size());
+    TSUNIT_ASSERT(out == ref);
+
+    run(_clearFile, {u"scrambler", {u"--cw-file", cw_file, u"--cp-duration", u"1", u"--packet-window", u"7", ts::UString::Decimal(SERVICE_ID)}}, out);
+    TSUNIT_ASSERT(out == ref);
+
+    // Check what was scrambled: only payloads of the service PID's, with the two parities.
+    std::map<uint8_t, size_t> parities;
+    size_t compared = 0;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        const ts::PID pid = clear[i].getPID();
+        if (ref[i].getPID() != pid || pid == PMT_PID) {
+            // Nullified before the PMT was found, or modified PMT.
+            continue;
+        }
+        compared++;
+        if ((pid == VIDEO_PID || pid == AUDIO_PID) && clear[i].getPayloadSize() > 0) {
+            TSUNIT_ASSERT(ref[i].isScrambled());
+            TSUNIT_EQUAL(clear[i].getHeaderSize(), ref[i].getHeaderSize());
+            TSUNIT_ASSERT(!std::equal(clear[i].getPayload(), clear[i].b + ts::PKT_SIZE, ref[i].getPayload()));
+            parities[ref[i].getScrambling()]++;
+        }
+        else if (pid == VIDEO_PID || pid == AUDIO_PID) {
+            // Empty payload, only the scrambling control may change.
+            ts::TSPacket pkt(ref[i]);
+            pkt.setScrambling(clear[i].getScrambling());
+            TSUNIT_ASSERT(pkt == clear[i]);
+        }
+        else {
+            TSUNIT_ASSERT(ref[i] == clear[i]);
+        }
+    }
+    debug() << "ScramblerPluginTest::WindowSameAsPacket: compared: " << compared << ", even: " << parities[ts::SC_EVEN_KEY] << ", odd: " << parities[ts::SC_ODD_KEY] << std::endl;
+    TSUNIT_ASSERT(compared > clear.size() * 9 / 10);
+    TSUNIT_EQUAL(2, parities.size());
+    TSUNIT_ASSERT(parities[ts::SC_EVEN_KEY] > 0);
+    TSUNIT_ASSERT(parities[ts::SC_ODD_KEY] > 0);
+
+    // Descramble in the two modes and get the clear stream back.
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_scrambledFile, ts::TSFile::WRITE, CERR, ts::TSPacketFormat::TS));
+    TSUNIT_ASSERT(file.writePackets(ref.data(), nullptr, ref.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    for (const ts::UChar* window : {u"0", u"7", u"256"}) {
+        run(_scrambledFile, {u"descrambler", {u"--cw-file", cw_file, u"--packet-window", window, u"--pid", ts::UString::Decimal(VIDEO_PID), u"--pid", ts::UString::Decimal(AUDIO_PID)}}, out);
+        TSUNIT_EQUAL(ref.size(), out.size());
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (ref[i].getPID() == clear[i].getPID() && clear[i].getPID() != PMT_PID) {
+                TSUNIT_ASSERT(out[i] == clear[i]);
+            }
+        }
+    }
+}
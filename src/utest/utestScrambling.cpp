@@ -6,14 +6,16 @@
 //
 //----------------------------------------------------------------------------
 //
-//  TSUnit test suite for class ts::DVBCSA2
+//  TSUnit test suite for class ts::DVBCSA2 and ts::TSScrambling
 //
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsTSScrambling.h"
 #include "tsTSPacket.h"
 #include "tsNames.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -23,6 +25,12 @@
 class ScramblingTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Scrambling);
+    TSUNIT_DECLARE_TEST(Batch);
+    TSUNIT_DECLARE_TEST(BatchBenchmark);
+
+private:
+    // Build a set of clear packets with various payload sizes.
+    static void BuildPackets(ts::TSPacketVector& packets, size_t count);
 };
 
 TSUNIT_REGISTER(ScramblingTest);
@@ -166,3 +174,101 @@ TSUNIT_DEFINE_TEST(Scrambling)
         TSUNIT_EQUAL(0, ts::MemCompare(pkt.b + header_size, vec->cipher.b + header_size, payload_size));
     }
 }
+
+void ScramblingTest::BuildPackets(ts::TSPacketVector& packets, size_t count)
+{
+    packets.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        packets[i].init(100, uint8_t(i));
+        // Full payloads, with some shorter ones, including residues and packets without payload.
+        packets[i].setPayloadSize(i % 4 != 0 ? 184 : (i * 37) % 185);
+        for (size_t j = 0; j < packets[i].getPayloadSize(); ++j) {
+            packets[i].getPayload()[j] = uint8_t(i + 3 * j);
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(Batch)
+{
+    debug() << "ScramblingTest::Batch: engine: " << ts::DVBCSA2::BatchEngineName() << ", " << ts::DVBCSA2::BatchEngineLanes() << " lanes" << std::endl;
+
+    const ts::ByteBlock cw_even({0xC0, 0xB1, 0xF0, 0x61, 0xA6, 0xED, 0x71, 0x04});
+    const ts::ByteBlock cw_odd({0xB2, 0x92, 0xD3, 0x17, 0x7C, 0xCC, 0xCE, 0x16});
+
+    for (size_t count : {1, 7, 64, 100, 130, 600}) {
+        ts::TSPacketVector plain, scalar, batch;
+        BuildPackets(plain, count);
+        scalar = batch = plain;
+        std::vector<ts::TSPacket*> pointers(count);
+        for (size_t i = 0; i < count; ++i) {
+            pointers[i] = &batch[i];
+        }
+
+        // Encrypt half of the packets with each parity.
+        ts::TSScrambling scr1, scr2;
+        TSUNIT_ASSERT(scr1.setCW(cw_even, 0));
+        TSUNIT_ASSERT(scr1.setCW(cw_odd, 1));
+        TSUNIT_ASSERT(scr2.setCW(cw_even, 0));
+        TSUNIT_ASSERT(scr2.setCW(cw_odd, 1));
+        const size_t half = count / 2;
+        TSUNIT_ASSERT(scr1.setEncryptParity(0));
+        TSUNIT_ASSERT(scr2.setEncryptParity(0));
+        for (size_t i = 0; i < half; ++i) {
+            TSUNIT_ASSERT(scr1.encrypt(scalar[i]));
+        }
+        TSUNIT_ASSERT(scr2.encryptBatch(pointers.data(), half));
+        TSUNIT_ASSERT(scr1.setEncryptParity(1));
+        TSUNIT_ASSERT(scr2.setEncryptParity(1));
+        for (size_t i = half; i < count; ++i) {
+            TSUNIT_ASSERT(scr1.encrypt(scalar[i]));
+        }
+        TSUNIT_ASSERT(scr2.encryptBatch(pointers.data() + half, count - half));
+        TSUNIT_ASSERT(scalar == batch);
+
+        // Scrambling an already scrambled packet is an error.
+        TSUNIT_ASSERT(!scr2.encryptBatch(pointers.data(), count));
+
+        // Decrypt all packets at once, with parity changes in the middle.
+        TSUNIT_ASSERT(scr2.decryptBatch(pointers.data(), count));
+        TSUNIT_ASSERT(plain == batch);
+    }
+}
+
+TSUNIT_DEFINE_TEST(BatchBenchmark)
+{
+    // Compare packet-per-packet and batch descrambling on full packets.
+    utest::TSUnitBenchmark bench1(u"TSUNIT_DVBCSA2_BATCH_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_DVBCSA2_BATCH_ITERATIONS");
+    constexpr size_t count = 512;
+
+    ts::TSPacketVector packets(count);
+    std::vector<ts::TSPacket*> pointers(count);
+    for (size_t i = 0; i < count; ++i) {
+        packets[i].init(100, uint8_t(i), uint8_t(i));
+        pointers[i] = &packets[i];
+    }
+
+    ts::TSScrambling scr;
+    TSUNIT_ASSERT(scr.setCW(ts::ByteBlock({0xA6, 0x34, 0x69, 0x43, 0xD3, 0xEE, 0x85, 0x46}), 0));
+
+    bench1.start();
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        for (auto& pkt : packets) {
+            pkt.setScrambling(ts::SC_EVEN_KEY);
+            TSUNIT_ASSERT(scr.decrypt(pkt));
+        }
+    }
+    bench1.stop();
+
+    bench2.start();
+    for (size_t iter = 0; iter < bench2.iterations; ++iter) {
+        for (auto& pkt : packets) {
+            pkt.setScrambling(ts::SC_EVEN_KEY);
+        }
+        TSUNIT_ASSERT(scr.decryptBatch(pointers.data(), count));
+    }
+    bench2.stop();
+
+    bench1.report(u"ScramblingTest::BatchBenchmark, 512 packets, one by one");
+    bench2.report(u"ScramblingTest::BatchBenchmark, 512 packets, batch");
+}
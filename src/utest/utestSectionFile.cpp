@@ -16,13 +16,25 @@
 #include "tsCAT.h"
 #include "tsTDT.h"
 #include "tsCAIdentifierDescriptor.h"
+#include "tsEIT.h"
+#include "tsSDT.h"
+#include "tsShortEventDescriptor.h"
+#include "tsExtendedEventDescriptor.h"
+#include "tsComponentDescriptor.h"
+#include "tsContentDescriptor.h"
+#include "tsParentalRatingDescriptor.h"
+#include "tsServiceDescriptor.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
 #include "tsxmlElement.h"
 #include "tsxmlDeclaration.h"
+#include "tsxmlJSONConverter.h"
+#include "tsjsonValue.h"
+#include "tsjsonTextWriter.h"
 #include "tsDuckContext.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 #include "tables/psi_pat1_xml.h"
 #include "tables/psi_pat1_sections.h"
@@ -48,6 +60,9 @@ class SectionFileTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(MultiSectionsAtProgramLevelPMT);
     TSUNIT_DECLARE_TEST(MultiSectionsAtStreamLevelPMT);
     TSUNIT_DECLARE_TEST(Attribute);
+    TSUNIT_DECLARE_TEST(JSONLine);
+    TSUNIT_DECLARE_TEST(JSONLineEIT);
+    TSUNIT_DECLARE_TEST(JSONLineDirect);
 
 public:
     virtual void beforeTest() override;
@@ -57,6 +72,17 @@ private:
     // Unitary test for one table.
     void testTable(const char* name, const ts::UChar* ref_xml, const uint8_t* ref_sections, size_t ref_sections_size);
     ts::Report& report();
+
+    // Build a large EIT schedule, with many events per service.
+    static constexpr uint16_t EIT_SERVICE_COUNT = 50;
+    static constexpr uint16_t EIT_EVENT_COUNT = 200;
+    static void buildEITSchedule(ts::DuckContext& duck, ts::BinaryTablePtrVector& tables);
+
+    // Count JSON values in a tree, each one being a separate allocation.
+    static size_t CountValues(const ts::json::Value& value);
+
+    // Reference JSON one-liner of a table, through XML DOM and JSON values.
+    ts::UString referenceJSONLine(ts::DuckContext& duck, const ts::xml::JSONConverter& conv, const ts::BinaryTable& table, const ts::BinaryTable::XMLOptions& opt = ts::BinaryTable::XMLOptions());
     fs::path _tempFileNameBin {};
     fs::path _tempFileNameXML {};
 };
@@ -803,3 +829,261 @@ TSUNIT_DEFINE_TEST(Attribute)
     table2.toXML(duck, root3);
     TSUNIT_EQUAL(xmlref, doc3.toString());
 }
+
+
+//----------------------------------------------------------------------------
+// Direct serialization of one-line JSON text, compared with JSON values.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(JSONLine)
+{
+    ts::xml::JSONConverter conv(report());
+    TSUNIT_ASSERT(ts::SectionFile::LoadModel(conv));
+
+    for (const ts::UChar* ref_xml : {psi_pat1_xml, psi_pmt_scte35_xml}) {
+        ts::xml::Document doc(report());
+        TSUNIT_ASSERT(doc.parse(ref_xml));
+        TSUNIT_ASSERT(doc.rootElement() != nullptr);
+
+        // Complete document, with and without root.
+        ts::json::TextWriter tw;
+        conv.convertToJSON(doc, tw, true);
+        TSUNIT_EQUAL(conv.convertToJSON(doc, true)->oneLiner(), tw.toString());
+        tw.clear();
+        conv.convertToJSON(doc, tw, false);
+        TSUNIT_EQUAL(conv.convertToJSON(doc, false)->oneLiner(), tw.toString());
+
+        // First table only, as logged by tables --log-json-line.
+        tw.clear();
+        conv.convertToJSON(doc.rootElement()->firstChildElement(), tw);
+        debug() << "SectionFileTest::JSONLine: " << tw.text() << std::endl;
+        TSUNIT_EQUAL(conv.convertToJSON(doc, true)->query(u"#nodes[0]").oneLiner(), tw.toString());
+    }
+}
+
+size_t SectionFileTest::CountValues(const ts::json::Value& value)
+{
+    size_t count = 1;
+    if (value.isObject()) {
+        ts::UStringList names;
+        value.getNames(names);
+        for (const auto& name : names) {
+            count += CountValues(value.value(name));
+        }
+    }
+    else if (value.isArray()) {
+        for (size_t i = 0; i < value.size(); ++i) {
+            count += CountValues(value.at(i));
+        }
+    }
+    return count;
+}
+
+void SectionFileTest::buildEITSchedule(ts::DuckContext& duck, ts::BinaryTablePtrVector& tables)
+{
+    const ts::Time start(2025, 1, 1, 0, 0, 0);
+    ts::ComponentDescriptor component;
+    component.stream_content = 0x05;
+    component.component_type = 0x0B;
+    component.component_tag = 1;
+    component.language_code = u"fre";
+    component.text = u"HD";
+
+    for (uint16_t srv = 1; srv <= EIT_SERVICE_COUNT; ++srv) {
+        ts::EIT eit(true, false, 0, 1, true, srv, 1, 1);
+        for (uint16_t evt = 0; evt < EIT_EVENT_COUNT; ++evt) {
+            ts::EIT::Event& event(eit.events.newEntry());
+            event.event_id = evt;
+            event.start_time = start + cn::minutes(30 * evt);
+            event.duration = cn::minutes(30);
+            event.running_status = 1;
+            event.descs.add(duck, ts::ShortEventDescriptor(u"fre", ts::UString::Format(u"Événement %d", evt), u"Résumé de l'événement \"test\""));
+            event.descs.add(duck, component);
+        }
+        auto table = std::make_shared<ts::BinaryTable>();
+        TSUNIT_ASSERT(eit.serialize(duck, *table));
+        TSUNIT_ASSERT(table->isValid());
+        tables.push_back(table);
+    }
+}
+
+TSUNIT_DEFINE_TEST(JSONLineEIT)
+{
+    ts::DuckContext duck;
+    ts::xml::JSONConverter conv(report());
+    TSUNIT_ASSERT(ts::SectionFile::LoadModel(conv));
+
+    ts::BinaryTablePtrVector tables;
+    buildEITSchedule(duck, tables);
+    size_t section_count = 0;
+    for (const auto& table : tables) {
+        section_count += table->sectionCount();
+    }
+
+    // Reference path: XML DOM, then JSON values, then one-line text.
+    utest::TSUnitBenchmark bench1(u"TSUNIT_JSON_ITERATIONS");
+    ts::UStringVector ref_lines(tables.size());
+    size_t value_count = 0;
+    bench1.start();
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        for (size_t i = 0; i < tables.size(); ++i) {
+            ts::xml::Document doc(report());
+            doc.initialize(u"tsduck");
+            TSUNIT_ASSERT(tables[i]->toXML(duck, doc.rootElement()) != nullptr);
+            const ts::json::ValuePtr root(conv.convertToJSON(doc, true));
+            ref_lines[i] = root->query(u"#nodes[0]").oneLiner();
+            if (iter == 0) {
+                value_count += CountValues(root->query(u"#nodes[0]"));
+            }
+        }
+    }
+    bench1.stop();
+
+    // Direct path: XML DOM, then one-line text, in a reused buffer.
+    utest::TSUnitBenchmark bench2(u"TSUNIT_JSON_ITERATIONS");
+    ts::json::TextWriter tw;
+    size_t growth_count = 0;
+    bench2.start();
+    for (size_t iter = 0; iter < bench2.iterations; ++iter) {
+        for (size_t i = 0; i < tables.size(); ++i) {
+            ts::xml::Document doc(report());
+            doc.initialize(u"tsduck");
+            const ts::xml::Element* elem = tables[i]->toXML(duck, doc.rootElement());
+            const size_t capacity = tw.text().capacity();
+            tw.clear();
+            conv.convertToJSON(elem, tw);
+            if (tw.text().capacity() != capacity) {
+                growth_count++;
+            }
+            if (iter == 0) {
+                TSUNIT_EQUAL(ref_lines[i], tw.toString());
+            }
+        }
+    }
+    bench2.stop();
+
+    // Table path: direct serialization of the tables, without XML DOM.
+    utest::TSUnitBenchmark bench3(u"TSUNIT_JSON_ITERATIONS");
+    bench3.start();
+    for (size_t iter = 0; iter < bench3.iterations; ++iter) {
+        for (size_t i = 0; i < tables.size(); ++i) {
+            tw.clear();
+            TSUNIT_ASSERT(tables[i]->toJSON(duck, tw));
+            if (iter == 0) {
+                TSUNIT_EQUAL(ref_lines[i], tw.toString());
+            }
+        }
+    }
+    bench3.stop();
+
+    debug() << "SectionFileTest::JSONLineEIT: " << tables.size() << " tables, " << section_count << " sections, "
+            << value_count << " JSON values in reference path, "
+            << growth_count << " buffer reallocations in direct path" << std::endl;
+    bench1.report(u"SectionFileTest::JSONLineEIT, JSON values");
+    bench2.report(u"SectionFileTest::JSONLineEIT, direct text");
+    bench3.report(u"SectionFileTest::JSONLineEIT, direct table");
+    if (bench1.cpuTime() > cn::milliseconds::zero() && bench2.cpuTime() > cn::milliseconds::zero() && bench3.cpuTime() > cn::milliseconds::zero()) {
+        debug() << "SectionFileTest::JSONLineEIT: JSON values: " << (1000 * section_count * bench1.iterations / bench1.cpuTime().count()) << " sections/s"
+                << ", direct text: " << (1000 * section_count * bench2.iterations / bench2.cpuTime().count()) << " sections/s"
+                << ", direct table: " << (1000 * section_count * bench3.iterations / bench3.cpuTime().count()) << " sections/s" << std::endl;
+    }
+}
+
+ts::UString SectionFileTest::referenceJSONLine(ts::DuckContext& duck, const ts::xml::JSONConverter& conv, const ts::BinaryTable& table, const ts::BinaryTable::XMLOptions& opt)
+{
+    ts::xml::Document doc(report());
+    doc.initialize(u"tsduck");
+    TSUNIT_ASSERT(table.toXML(duck, doc.rootElement(), opt) != nullptr);
+    return conv.convertToJSON(doc, true)->query(u"#nodes[0]").oneLiner();
+}
+
+TSUNIT_DEFINE_TEST(JSONLineDirect)
+{
+    ts::DuckContext duck;
+    ts::xml::JSONConverter conv(report());
+    TSUNIT_ASSERT(ts::SectionFile::LoadModel(conv));
+
+    ts::BinaryTable::XMLOptions meta;
+    meta.setPID = true;
+    meta.setPackets = true;
+
+    // EIT p/f with all directly serialized descriptors, empty texts, an event without descriptor.
+    ts::EIT eit(false, true, 0, 3, true, 0x1234, 0x0010, 0x20FA);
+    ts::EIT::Event& ev1(eit.events.newEntry());
+    ev1.event_id = 0xABCD;
+    ev1.start_time = ts::Time(2025, 6, 30, 23, 45, 10);
+    ev1.duration = cn::seconds(5410);
+    ev1.running_status = 4;
+    ev1.CA_controlled = true;
+    ev1.descs.add(duck, ts::ShortEventDescriptor(u"eng", u"News <live> & \"more\"", u""));
+    ts::ExtendedEventDescriptor ext;
+    ext.descriptor_number = 1;
+    ext.last_descriptor_number = 2;
+    ext.language_code = u"deu";
+    ext.text = u"Straße\nZeile";
+    ext.entries.push_back(ts::ExtendedEventDescriptor::Entry(u"Regie", u"Müller"));
+    ext.entries.push_back(ts::ExtendedEventDescriptor::Entry(u"", u""));
+    ev1.descs.add(duck, ext);
+    ts::ContentDescriptor content;
+    content.entries.push_back(ts::ContentDescriptor::Entry(0x1234));
+    content.entries.push_back(ts::ContentDescriptor::Entry(0xF0A5));
+    ev1.descs.add(duck, content);
+    ts::ParentalRatingDescriptor rating;
+    rating.entries.push_back(ts::ParentalRatingDescriptor::Entry(u"FRA", 0x0C));
+    rating.entries.push_back(ts::ParentalRatingDescriptor::Entry(u"GBR", 0x00));
+    ev1.descs.add(duck, rating);
+    ts::EIT::Event& ev2(eit.events.newEntry());
+    ev2.event_id = 2;
+    ev2.start_time = ts::Time(2025, 7, 1, 1, 15, 10);
+    ev2.duration = cn::minutes(90);
+    ev2.running_status = 7;
+
+    ts::BinaryTable bin_eit;
+    TSUNIT_ASSERT(eit.serialize(duck, bin_eit));
+    bin_eit.setSourcePID(0x0012);
+
+    // SDT with and without service descriptor, empty SDT.
+    ts::SDT sdt(true, 7, true, 0x0010, 0x20FA);
+    sdt.services[0x0101].EITs_present = true;
+    sdt.services[0x0101].running_status = 4;
+    sdt.services[0x0101].descs.add(duck, ts::ServiceDescriptor(0x19, u"Provider \"1\"", u"Chaîne Un"));
+    sdt.services[0x0102].EITpf_present = true;
+    sdt.services[0x0102].CA_controlled = true;
+
+    ts::BinaryTable bin_sdt;
+    TSUNIT_ASSERT(sdt.serialize(duck, bin_sdt));
+    bin_sdt.setSourcePID(0x0011);
+
+    ts::BinaryTable bin_empty;
+    TSUNIT_ASSERT(ts::SDT(false, 1, true, 0x0020, 0x20FA).serialize(duck, bin_empty));
+
+    // EIT schedule.
+    ts::BinaryTablePtrVector schedule;
+    buildEITSchedule(duck, schedule);
+    TSUNIT_ASSERT(!schedule.empty());
+
+    // The direct serialization shall be identical to the XML-to-JSON conversion.
+    for (const ts::BinaryTable* table : {&bin_eit, &bin_sdt, &bin_empty, schedule.front().get()}) {
+        for (const auto& opt : {ts::BinaryTable::XMLOptions(), meta}) {
+            ts::json::TextWriter tw;
+            TSUNIT_ASSERT(table->toJSON(duck, tw, opt));
+            debug() << "SectionFileTest::JSONLineDirect: " << tw.text() << std::endl;
+            TSUNIT_EQUAL(referenceJSONLine(duck, conv, *table, opt), tw.toString());
+        }
+    }
+
+    // Tables, descriptors and options without direct serialization.
+    ts::json::TextWriter tw;
+    ts::BinaryTable bin_pat;
+    TSUNIT_ASSERT(ts::PAT(1, true, 0x0010).serialize(duck, bin_pat));
+    TSUNIT_ASSERT(!bin_pat.toJSON(duck, tw));
+
+    ts::BinaryTable::XMLOptions sections;
+    sections.setSections = true;
+    TSUNIT_ASSERT(!bin_sdt.toJSON(duck, tw, sections));
+
+    eit.events.begin()->second.descs.add(duck, ts::CAIdentifierDescriptor({0x0100}));
+    ts::BinaryTable bin_ca;
+    TSUNIT_ASSERT(eit.serialize(duck, bin_ca));
+    TSUNIT_ASSERT(!bin_ca.toJSON(duck, tw));
+}
@@ -0,0 +1,416 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for TSAnalyzer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzerReport.h"
+#include "tsTSAnalyzerOptions.h"
+#include "tsTSChunkAnalyzer.h"
+#include "tsOneShotPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsTSFile.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsTDT.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(PIDIndex);
+    TSUNIT_DECLARE_TEST(LazyPES);
+    TSUNIT_DECLARE_TEST(ChunkMerge);
+    TSUNIT_DECLARE_TEST(ChunkUnaligned);
+
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+private:
+    fs::path _tempFileName {};
+
+    // Generate a synthetic transport stream with various errors.
+    static void GenerateStream(ts::TSPacketVector& packets, size_t count);
+
+    // Analyze a file, in chunks if chunk_count is not 1, and return the normalized and JSON reports.
+    static ts::UString Analyze(const fs::path& filename, size_t chunk_count, ts::PacketCounter context_packets, ts::TSPacketFormat format = ts::TSPacketFormat::AUTODETECT);
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// An analyzer which exposes the PID contexts.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TestAnalyzer : public ts::TSAnalyzer
+    {
+        TS_NOBUILD_NOCOPY(TestAnalyzer);
+    public:
+        TestAnalyzer(ts::DuckContext& duck) : ts::TSAnalyzer(duck) {}
+        using ts::TSAnalyzer::pidExists;
+        using ts::TSAnalyzer::getPID;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSAnalyzerTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".ts");
+    }
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+}
+
+// Test suite cleanup method.
+void TSAnalyzerTest::afterTest()
+{
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+}
+
+
+//----------------------------------------------------------------------------
+// Test helpers.
+//----------------------------------------------------------------------------
+
+void TSAnalyzerTest::GenerateStream(ts::TSPacketVector& packets, size_t count)
+{
+    ts::DuckContext duck;
+
+    // One service with a video PID (with PCR) and a scrambled audio PID.
+    // The PMT is updated in the middle of the stream.
+    ts::PAT pat(0, true, 1);
+    pat.pmts[1] = 0x0100;
+    ts::PMT pmt(0, true, 1, 0x0101);
+    pmt.streams[0x0101].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt.streams[0x0102].stream_type = ts::ST_MPEG1_AUDIO;
+    ts::SDT sdt(true, 0, true, 1, 2);
+    sdt.services[1].setName(duck, u"Test service with a rather long name", 0x01);
+    sdt.services[1].setProvider(duck, u"TSDuck");
+    sdt.services[1].running_status = 4;
+
+    ts::OneShotPacketizer pat_pzer(duck, ts::PID_PAT);
+    ts::OneShotPacketizer pmt_pzer(duck, 0x0100);
+    ts::OneShotPacketizer sdt_pzer(duck, ts::PID_SDT);
+    ts::OneShotPacketizer tdt_pzer(duck, ts::PID_TDT);
+    pat_pzer.addTable(duck, pat);
+    pmt_pzer.addTable(duck, pmt);
+    sdt_pzer.addTable(duck, sdt);
+
+    ts::TSPacketVector psi;
+    uint8_t video_cc = 0;
+    uint8_t audio_cc = 0;
+    uint8_t other_cc = 0;
+    size_t video_count = 0;
+    size_t audio_count = 0;
+    size_t other_count = 0;
+    uint64_t pcr_offset = 0;
+    const ts::Time start_time(2025, 6, 1, 12, 0, 0);
+
+    packets.clear();
+    packets.reserve(count + 16);
+    for (size_t slot = 0; packets.size() < count; ++slot) {
+
+        // PSI/SI: PAT and PMT every 100 slots, SDT every 500 slots, TDT every 5000 slots.
+        if (slot % 100 == 0) {
+            if (slot == count / 2) {
+                pmt.version = 1;
+                pmt.streams[0x0103].stream_type = ts::ST_MPEG1_AUDIO;
+                pmt_pzer.removeSections(ts::TID_PMT, 1);
+                pmt_pzer.addTable(duck, pmt);
+            }
+            pat_pzer.getPackets(psi);
+            packets.insert(packets.end(), psi.begin(), psi.end());
+            pmt_pzer.getPackets(psi);
+            packets.insert(packets.end(), psi.begin(), psi.end());
+            if (slot % 500 == 0) {
+                sdt_pzer.getPackets(psi);
+                packets.insert(packets.end(), psi.begin(), psi.end());
+            }
+            if (slot % 5000 == 0) {
+                tdt_pzer.removeAll();
+                tdt_pzer.addTable(duck, ts::TDT(start_time + cn::seconds(slot / 5000)));
+                tdt_pzer.getPackets(psi);
+                packets.insert(packets.end(), psi.begin(), psi.end());
+            }
+        }
+
+        ts::TSPacket pkt;
+        switch (slot % 4) {
+            case 0: {
+                // Video PID, with a PES packet every 16 packets and a PCR every 8 packets.
+                // Inject a skipped packet, a duplicated packet and a discontinuity with PCR leap.
+                video_count++;
+                if (video_count % 1000 == 0) {
+                    video_cc++;
+                }
+                pkt.init(0x0101, video_cc, uint8_t(video_count));
+                video_cc = (video_cc + 1) % ts::CC_MAX;
+                if (video_count % 16 == 1) {
+                    static const uint8_t pes_header[] = {0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0x80, 0x05, 0x21, 0x00, 0x01, 0x00, 0x01};
+                    pkt.setPUSI();
+                    ts::MemCopy(pkt.b + 4, pes_header, sizeof(pes_header));
+                    pkt.setPTS((packets.size() * 2707 + pcr_offset) / ts::SYSTEM_CLOCK_SUBFACTOR + 90000);
+                }
+                if (video_count % 2500 == 0) {
+                    pcr_offset += 2 * ts::SYSTEM_CLOCK_FREQ;
+                    pkt.setDiscontinuityIndicator(true);
+                }
+                if (video_count % 8 == 1) {
+                    pkt.setPCR(packets.size() * 2707 + pcr_offset, true);
+                }
+                if (video_count % 1500 == 0) {
+                    packets.push_back(pkt);
+                }
+                break;
+            }
+            case 1: {
+                // Scrambled audio PID, crypto-periods of 2500 packets.
+                pkt.init(0x0102, audio_cc, uint8_t(slot));
+                audio_cc = (audio_cc + 1) % ts::CC_MAX;
+                pkt.setScrambling((audio_count++ / 2500) % 2 == 0 ? ts::SC_EVEN_KEY : ts::SC_ODD_KEY);
+                break;
+            }
+            case 2: {
+                // Unreferenced PID with PES packets, from time to time.
+                if (slot % 50 == 2) {
+                    pkt.init(0x0200, other_cc);
+                    other_cc = (other_cc + 1) % ts::CC_MAX;
+                    if (other_count++ % 10 == 0) {
+                        static const uint8_t pes_header[] = {0x00, 0x00, 0x01, 0xBD, 0x00, 0x00, 0x80, 0x00, 0x00};
+                        pkt.setPUSI();
+                        ts::MemCopy(pkt.b + 4, pes_header, sizeof(pes_header));
+                    }
+                }
+                else {
+                    pkt = ts::NullPacket;
+                }
+                break;
+            }
+            default: {
+                // Null packets, some of them with transport errors.
+                pkt = ts::NullPacket;
+                if (slot % 7777 == 3) {
+                    pkt.setTEI();
+                }
+                break;
+            }
+        }
+        packets.push_back(pkt);
+    }
+    packets.resize(count);
+}
+
+ts::UString TSAnalyzerTest::Analyze(const fs::path& filename, size_t chunk_count, ts::PacketCounter context_packets, ts::TSPacketFormat format)
+{
+    ts::DuckContext duck;
+    ts::TSAnalyzerReport analyzer(duck);
+    ts::TSChunkAnalyzer chunks(chunk_count);
+    chunks.setContextPacketCount(context_packets);
+    TSUNIT_ASSERT(chunks.analyzeFile(analyzer, filename, format, CERR));
+
+    ts::TSAnalyzerOptions opt;
+    opt.deterministic = true;
+    std::ostringstream strm;
+    analyzer.reportNormalized(opt, strm);
+    analyzer.reportJSON(opt, strm);
+    return ts::UString::FromUTF8(strm.str());
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(PIDIndex)
+{
+    // One packet on every PID, then two more packets on a few PID's.
+    ts::DuckContext duck;
+    TestAnalyzer analyzer(duck);
+    const ts::TSPacketMetadata mdata;
+    for (ts::PID pid = 0; pid < ts::PID_MAX; ++pid) {
+        ts::TSPacket pkt;
+        pkt.init(pid, 0);
+        analyzer.feedPacket(pkt, mdata);
+    }
+    for (ts::PID pid : {ts::PID(0x0000), ts::PID(0x0100), ts::PID(0x1000), ts::PID(ts::PID_NULL)}) {
+        for (uint8_t cc = 1; cc <= 2; ++cc) {
+            ts::TSPacket pkt;
+            pkt.init(pid, cc);
+            analyzer.feedPacket(pkt, mdata);
+        }
+    }
+
+    std::vector<ts::PID> pids;
+    analyzer.getPIDs(pids);
+    TSUNIT_EQUAL(ts::PID_MAX, pids.size());
+    TSUNIT_ASSERT(!analyzer.pidExists(ts::PID_MAX));
+    for (ts::PID pid = 0; pid < ts::PID_MAX; ++pid) {
+        TSUNIT_ASSERT(analyzer.pidExists(pid));
+        const bool more = pid == 0x0000 || pid == 0x0100 || pid == 0x1000 || pid == ts::PID_NULL;
+        TSUNIT_EQUAL(more ? 3 : 1, analyzer.getPID(pid)->ts_pkt_cnt);
+    }
+
+    // After a reset, the PID index is empty.
+    analyzer.reset();
+    analyzer.getPIDs(pids);
+    TSUNIT_ASSERT(pids.empty());
+    TSUNIT_ASSERT(!analyzer.pidExists(0x0100));
+
+    ts::TSPacket pkt;
+    pkt.init(0x0100, 0);
+    analyzer.feedPacket(pkt, mdata);
+    analyzer.getPIDs(pids);
+    TSUNIT_EQUAL(1, pids.size());
+    TSUNIT_ASSERT(analyzer.pidExists(0x0100));
+    TSUNIT_EQUAL(1, analyzer.getPID(0x0100)->ts_pkt_cnt);
+}
+
+TSUNIT_DEFINE_TEST(LazyPES)
+{
+    ts::DuckContext duck;
+    TestAnalyzer analyzer(duck);
+    const ts::TSPacketMetadata mdata;
+
+    // One service with an MPEG-2 video PID 0x0101.
+    ts::PAT pat(0, true, 1);
+    pat.pmts[1] = 0x0100;
+    ts::PMT pmt(0, true, 1, 0x0101);
+    pmt.streams[0x0101].stream_type = ts::ST_MPEG2_VIDEO;
+
+    ts::TSPacketVector psi;
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+    pzer.addTable(duck, pat);
+    pzer.getPackets(psi);
+    for (const auto& pkt : psi) {
+        analyzer.feedPacket(pkt, mdata);
+    }
+    pzer.setPID(0x0100);
+    pzer.removeAll();
+    pzer.addTable(duck, pmt);
+    pzer.getPackets(psi);
+    for (const auto& pkt : psi) {
+        analyzer.feedPacket(pkt, mdata);
+    }
+
+    // Each video PES packet fits in one TS packet: PES header, MPEG-2 sequence header and extension, picture start code.
+    static const uint8_t video[] = {
+        0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0xB3, 0x2D, 0x02, 0x40, 0x23, 0xFF, 0xFF, 0xE0, 0x18,
+        0x00, 0x00, 0x01, 0xB5, 0x14, 0x8A, 0x00, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x00, 0x00, 0x0F, 0xFF, 0xF8,
+    };
+
+    // Video on the declared PID 0x0101 and on the undeclared PID 0x0200.
+    // Data without PES start code on the undeclared PID 0x0300.
+    uint8_t cc = 0;
+    for (size_t i = 0; i < 10; ++i) {
+        for (ts::PID pid : {ts::PID(0x0101), ts::PID(0x0200), ts::PID(0x0300)}) {
+            ts::TSPacket pkt;
+            pkt.init(pid, cc, 0x00);
+            pkt.setPUSI();
+            if (pid != 0x0300) {
+                ts::MemCopy(pkt.b + 4, video, sizeof(video));
+            }
+            else {
+                ts::MemSet(pkt.b + 4, 0x47, 16);
+            }
+            analyzer.feedPacket(pkt, mdata);
+        }
+        cc = (cc + 1) % ts::CC_MAX;
+    }
+
+    // Video attributes are found on PID's with PES packets, declared or not.
+    const auto declared = analyzer.getPID(0x0101);
+    const auto undeclared = analyzer.getPID(0x0200);
+    const auto no_pes = analyzer.getPID(0x0300);
+    debug() << "TSAnalyzerTest::LazyPES: attributes: " << ts::UString::Join(declared->attributes) << std::endl;
+    TSUNIT_ASSERT(!declared->attributes.empty());
+    TSUNIT_ASSERT(declared->attributes == undeclared->attributes);
+    TSUNIT_EQUAL(0xE0, undeclared->pes_stream_id);
+    TSUNIT_EQUAL(0, declared->inv_pes_start);
+    TSUNIT_EQUAL(0, undeclared->inv_pes_start);
+
+    // The other PID's are not analyzed as PES.
+    TSUNIT_EQUAL(10, no_pes->inv_pes_start);
+    TSUNIT_EQUAL(0, no_pes->inv_pes);
+    TSUNIT_ASSERT(no_pes->attributes.empty());
+    TSUNIT_EQUAL(0, analyzer.getPID(ts::PID_PAT)->inv_pes);
+    TSUNIT_EQUAL(0, analyzer.getPID(0x0100)->inv_pes);
+}
+
+TSUNIT_DEFINE_TEST(ChunkMerge)
+{
+    ts::TSPacketVector packets;
+    GenerateStream(packets, 50'000);
+
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    // Reference sequential analysis.
+    const ts::UString ref(Analyze(_tempFileName, 1, 0));
+    debug() << "TSAnalyzerTest::ChunkMerge: sequential analysis:" << std::endl << ref << std::endl;
+    TSUNIT_ASSERT(ref.contains(u"pid=257:"));
+    TSUNIT_ASSERT(ref.contains(u":name=Test service with a rather long name"));
+
+    // Merged analyses of chunks shall be identical, as long as the context covers all PSI/SI.
+    TSUNIT_EQUAL(ref, Analyze(_tempFileName, 2, ts::TSChunkAnalyzer::DEFAULT_CONTEXT_PACKETS));
+    TSUNIT_EQUAL(ref, Analyze(_tempFileName, 3, ts::TSChunkAnalyzer::DEFAULT_CONTEXT_PACKETS));
+    TSUNIT_EQUAL(ref, Analyze(_tempFileName, 7, 1000));
+    TSUNIT_EQUAL(ref, Analyze(_tempFileName, 16, 700));
+
+    // Compare the performance of the sequential and parallel analyses.
+    utest::TSUnitBenchmark bench1(u"TSUNIT_TSANALYZER_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_TSANALYZER_ITERATIONS");
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        bench1.start();
+        Analyze(_tempFileName, 1, 0);
+        bench1.stop();
+        bench2.start();
+        Analyze(_tempFileName, 0, ts::TSChunkAnalyzer::DEFAULT_CONTEXT_PACKETS);
+        bench2.stop();
+    }
+    bench1.report(u"TSAnalyzerTest::ChunkMerge, sequential");
+    bench2.report(u"TSAnalyzerTest::ChunkMerge, parallel chunks");
+}
+
+TSUNIT_DEFINE_TEST(ChunkUnaligned)
+{
+    ts::TSPacketVector packets;
+    GenerateStream(packets, 10'000);
+
+    // The file starts with a few garbage bytes: the packets are not aligned from byte 0.
+    std::ofstream strm(_tempFileName, std::ios::out | std::ios::binary);
+    strm.write("\x00\x01\x02\x03\x04", 5);
+    strm.write(reinterpret_cast<const char*>(packets.data()), std::streamsize(packets.size() * ts::PKT_SIZE));
+    strm.close();
+    TSUNIT_ASSERT(!strm.fail());
+
+    // The file is sequentially analyzed, whatever the number of chunks.
+    const ts::UString ref(Analyze(_tempFileName, 1, 0, ts::TSPacketFormat::TS));
+    TSUNIT_EQUAL(ref, Analyze(_tempFileName, 4, 1000, ts::TSPacketFormat::TS));
+}
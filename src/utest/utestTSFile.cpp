@@ -17,6 +17,7 @@
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -30,6 +31,7 @@ class TSFileTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(Duck);
     TSUNIT_DECLARE_TEST(StuffingRead);
     TSUNIT_DECLARE_TEST(StuffingWrite);
+    TSUNIT_DECLARE_TEST(IOModes);
 
 public:
     virtual void beforeTest() override;
@@ -358,3 +360,88 @@ TSUNIT_DEFINE_TEST(StuffingWrite)
     TSUNIT_EQUAL(184, packets[5].getPayloadSize());
     TSUNIT_EQUAL(0xFF, packets[5].getPayload()[0]);
 }
+
+TSUNIT_DEFINE_TEST(IOModes)
+{
+    // Create a reference file, larger than a few asynchronous requests.
+    constexpr size_t packet_count = 20000;
+    ts::TSPacketVector packets(512);
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    for (size_t i = 0; i < packet_count; ++i) {
+        ts::TSPacket& pkt(packets[i % packets.size()]);
+        pkt = ts::NullPacket;
+        pkt.setPID(ts::PID(i % 8000));
+        ts::PutUInt32(pkt.getPayload(), uint32_t(i));
+        if (i % packets.size() == packets.size() - 1 || i == packet_count - 1) {
+            TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, i % packets.size() + 1, CERR));
+        }
+    }
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_EQUAL(packet_count * ts::PKT_SIZE, fs::file_size(_tempFileName, &ts::ErrCodeReport(CERR)));
+
+    // Check the content of a file, from a given packet index.
+    auto check = [&](ts::TSFile& in, size_t start, size_t count) {
+        size_t index = start;
+        size_t total = 0;
+        size_t n = 0;
+        while ((n = in.readPackets(packets.data(), nullptr, packets.size(), CERR)) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                TSUNIT_EQUAL(index % 8000, packets[i].getPID());
+                TSUNIT_EQUAL(index, ts::GetUInt32(packets[i].getPayload()));
+                index = (index + 1) % packet_count == 0 ? start : index + 1;
+            }
+            total += n;
+        }
+        TSUNIT_EQUAL(count, total);
+    };
+
+    static const std::vector<std::pair<ts::TSFile::IOMode, const ts::UChar*>> modes {
+        {ts::TSFile::IOMode::STANDARD, u"standard"},
+        {ts::TSFile::IOMode::MMAP, u"mmap"},
+        {ts::TSFile::IOMode::ASYNC, u"async"},
+    };
+
+    // Read the file twice, after an initial offset, in all modes.
+    for (const auto& mode : modes) {
+        ts::TSFile in;
+        in.setIOMode(mode.first, 3);
+        TSUNIT_ASSERT(in.openRead(_tempFileName, 2, 1000 * ts::PKT_SIZE, CERR));
+        debug() << "TSFileTest::IOModes: read mode " << mode.second << ", actual: " << int(in.actualIOMode()) << std::endl;
+        check(in, 1000, 2 * (packet_count - 1000));
+        TSUNIT_ASSERT(in.close(CERR));
+    }
+
+    // Copy the file, file-to-file, in all modes. Memory mapping is for input files only.
+    const fs::path out_name(ts::TempFile(u".ts"));
+    for (const auto& in_mode : modes) {
+        for (const auto& out_mode : modes) {
+            if (out_mode.first == ts::TSFile::IOMode::MMAP) {
+                continue;
+            }
+            utest::TSUnitBenchmark bench(u"TSUNIT_TSFILE_ITERATIONS");
+            for (size_t iter = 0; iter < bench.iterations; ++iter) {
+                ts::TSFile in, out;
+                in.setIOMode(in_mode.first);
+                out.setIOMode(out_mode.first);
+                bench.start();
+                TSUNIT_ASSERT(in.openRead(_tempFileName, 1, 0, CERR));
+                TSUNIT_ASSERT(out.open(out_name, ts::TSFile::WRITE, CERR));
+                size_t n = 0;
+                while ((n = in.readPackets(packets.data(), nullptr, packets.size(), CERR)) > 0) {
+                    TSUNIT_ASSERT(out.writePackets(packets.data(), nullptr, n, CERR));
+                }
+                TSUNIT_ASSERT(in.close(CERR));
+                TSUNIT_ASSERT(out.close(CERR));
+                bench.stop();
+            }
+            bench.report(ts::UString::Format(u"TSFileTest::IOModes, copy %s to %s", in_mode.second, out_mode.second), packet_count * ts::PKT_SIZE);
+
+            ts::TSFile in;
+            TSUNIT_ASSERT(in.openRead(out_name, 1, 0, CERR));
+            check(in, 0, packet_count);
+            TSUNIT_ASSERT(in.close(CERR));
+        }
+    }
+    fs::remove(out_name, &ts::ErrCodeReport());
+}
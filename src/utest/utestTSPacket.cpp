@@ -14,6 +14,7 @@
 #include "tsByteBlock.h"
 #include "tsMemory.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -32,6 +33,16 @@ class TSPacketTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(PrivateData);
     TSUNIT_DECLARE_TEST(BitRate);
     TSUNIT_DECLARE_TEST(PCR);
+    TSUNIT_DECLARE_TEST(FindSync);
+    TSUNIT_DECLARE_TEST(Locate);
+    TSUNIT_DECLARE_TEST(FindSyncBenchmark);
+
+private:
+    // Build a corrupted capture: garbage, then packets, with some corrupted sync bytes.
+    static void BuildCapture(ts::ByteBlock& data, size_t garbage_size, size_t packet_count, size_t packet_size, size_t header_size);
+
+    // Reference scalar implementation of FindSync().
+    static size_t FindSyncReference(const uint8_t* buffer, size_t buffer_size, size_t packet_size, size_t header_size, size_t min_packets);
 };
 
 TSUNIT_REGISTER(TSPacketTest);
@@ -524,3 +535,135 @@ TSUNIT_DEFINE_TEST(PCR)
     TSUNIT_EQUAL(ts::PCR_SCALE - 90, ts::AddPCR(10, -100));
     TSUNIT_EQUAL(ts::INVALID_PCR, ts::AddPCR(ts::PCR_SCALE, 100));
 }
+
+void TSPacketTest::BuildCapture(ts::ByteBlock& data, size_t garbage_size, size_t packet_count, size_t packet_size, size_t header_size)
+{
+    data.resize(garbage_size + packet_count * packet_size);
+    uint32_t seed = 0x12345678;
+    for (auto& b : data) {
+        // Pseudo-random garbage, with many 0x47 bytes.
+        seed = seed * 1103515245 + 12345;
+        b = (seed >> 24) < 24 ? ts::SYNC_BYTE : uint8_t(seed >> 16);
+    }
+    for (size_t i = 0; i < packet_count; ++i) {
+        data[garbage_size + i * packet_size + header_size] = ts::SYNC_BYTE;
+    }
+}
+
+size_t TSPacketTest::FindSyncReference(const uint8_t* buffer, size_t buffer_size, size_t packet_size, size_t header_size, size_t min_packets)
+{
+    for (size_t index = 0; index + packet_size <= buffer_size; ++index) {
+        const size_t count = min_packets == ts::NPOS ? (buffer_size - index) / packet_size : min_packets;
+        if (index + count * packet_size > buffer_size) {
+            break;
+        }
+        size_t i = 0;
+        while (i < count && buffer[index + header_size + i * packet_size] == ts::SYNC_BYTE) {
+            ++i;
+        }
+        if (i == count) {
+            return index;
+        }
+    }
+    return ts::NPOS;
+}
+
+TSUNIT_DEFINE_TEST(FindSync)
+{
+    ts::ByteBlock data;
+    for (size_t garbage : {0, 1, 15, 16, 17, 100, 1000, 5000}) {
+        for (auto [pkt_size, header_size] : {std::pair<size_t, size_t>{188, 0}, {204, 0}, {192, 4}}) {
+            BuildCapture(data, garbage, 20, pkt_size, header_size);
+            for (size_t min : {size_t(1), size_t(2), size_t(5), size_t(20), size_t(21), ts::NPOS}) {
+                const size_t ref = FindSyncReference(data.data(), data.size(), pkt_size, header_size, min);
+                TSUNIT_EQUAL(ref, ts::TSPacket::FindSync(data.data(), data.size(), pkt_size, header_size, min));
+            }
+            TSUNIT_EQUAL(garbage, ts::TSPacket::FindSync(data.data(), data.size(), pkt_size, header_size, 5));
+            TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(data.data(), data.size(), pkt_size, header_size, 21));
+
+            // Corrupt one sync byte in the middle.
+            data[garbage + 5 * pkt_size + header_size] = 0x00;
+            TSUNIT_EQUAL(garbage + 6 * pkt_size, ts::TSPacket::FindSync(data.data(), data.size(), pkt_size, header_size, 9));
+            TSUNIT_EQUAL(FindSyncReference(data.data(), data.size(), pkt_size, header_size, ts::NPOS),
+                         ts::TSPacket::FindSync(data.data(), data.size(), pkt_size, header_size, ts::NPOS));
+        }
+    }
+    TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(data.data(), 100));
+    TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(nullptr, 1000));
+
+    // Buffers ending with a trailing partial packet: with min_packets == NPOS, the only
+    // candidates may have one single complete packet, without a second sync byte.
+    for (size_t garbage : {0, 1, 15, 16, 17, 100, 1000}) {
+        for (size_t trailer : {1, 15, 16, 17, 100, 187}) {
+            data.resize(garbage + ts::PKT_SIZE + trailer);
+            std::memset(data.data(), 0xFF, data.size());
+            data[garbage] = ts::SYNC_BYTE;
+            TSUNIT_EQUAL(garbage, FindSyncReference(data.data(), data.size(), ts::PKT_SIZE, 0, ts::NPOS));
+            TSUNIT_EQUAL(garbage, ts::TSPacket::FindSync(data.data(), data.size(), ts::PKT_SIZE, 0, ts::NPOS));
+            TSUNIT_EQUAL(garbage, ts::TSPacket::FindSync(data.data(), data.size(), ts::PKT_SIZE, 0, 1));
+            TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(data.data(), data.size(), ts::PKT_SIZE, 0, 2));
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(Locate)
+{
+    // A datagram with a 12-byte header and 7 packets.
+    ts::ByteBlock data(12 + 7 * ts::PKT_SIZE, 0x00);
+    for (size_t i = 0; i < 7; ++i) {
+        data[12 + i * ts::PKT_SIZE] = ts::SYNC_BYTE;
+    }
+    size_t start = 0, count = 0, size = 0;
+    TSUNIT_ASSERT(ts::TSPacket::Locate(data.data(), data.size(), start, count, size));
+    TSUNIT_EQUAL(12, start);
+    TSUNIT_EQUAL(7, count);
+    TSUNIT_EQUAL(ts::PKT_SIZE, size);
+
+    // Same with a 10-byte trailer.
+    data.append(ts::ByteBlock(10, 0x00));
+    size = 0;
+    TSUNIT_ASSERT(ts::TSPacket::Locate(data.data(), data.size(), start, count, size));
+    TSUNIT_EQUAL(12, start);
+    TSUNIT_EQUAL(7, count);
+    TSUNIT_EQUAL(ts::PKT_SIZE, size);
+
+    // One single packet, followed by a trailing partial packet without sync byte.
+    data.resize(1400);
+    std::memset(data.data(), 0x00, data.size());
+    data[1190] = ts::SYNC_BYTE;
+    size = 0;
+    TSUNIT_ASSERT(ts::TSPacket::Locate(data.data(), data.size(), start, count, size));
+    TSUNIT_EQUAL(1190, start);
+    TSUNIT_EQUAL(1, count);
+    TSUNIT_EQUAL(ts::PKT_SIZE, size);
+}
+
+TSUNIT_DEFINE_TEST(FindSyncBenchmark)
+{
+    // Resynchronize after 1 MB of garbage with many 0x47 bytes, compare with a scalar scan.
+    utest::TSUnitBenchmark bench1(u"TSUNIT_FINDSYNC_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_FINDSYNC_ITERATIONS");
+    constexpr size_t garbage = 1000000;
+
+    ts::ByteBlock data;
+    BuildCapture(data, garbage, 100, ts::PKT_SIZE, 0);
+
+    size_t ref = 0;
+    bench1.start();
+    for (size_t iter = 0; iter < bench1.iterations; ++iter) {
+        ref = FindSyncReference(data.data(), data.size(), ts::PKT_SIZE, 0, 10);
+    }
+    bench1.stop();
+
+    size_t index = 0;
+    bench2.start();
+    for (size_t iter = 0; iter < bench2.iterations; ++iter) {
+        index = ts::TSPacket::FindSync(data.data(), data.size(), ts::PKT_SIZE, 0, 10);
+    }
+    bench2.stop();
+
+    TSUNIT_EQUAL(garbage, ref);
+    TSUNIT_EQUAL(garbage, index);
+    bench1.report(u"TSPacketTest::FindSyncBenchmark, scalar", garbage);
+    bench2.report(u"TSPacketTest::FindSyncBenchmark, FindSync", garbage);
+}
@@ -13,6 +13,8 @@
 #include "tsTSProcessor.h"
 #include "tsPluginRepository.h"
 #include "tsCerrReport.h"
+#include "tsReportBuffer.h"
+#include "utestTSUnitBenchmark.h"
 #include "tsunit.h"
 
 
@@ -23,6 +25,7 @@
 class TSProcessorTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Processing);
+    TSUNIT_DECLARE_TEST(HandOff);
 };
 
 TSUNIT_REGISTER(TSProcessorTest);
@@ -274,3 +277,61 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
 }
+
+
+//----------------------------------------------------------------------------
+// Compare the global mutex and lock-free hand-off between plugins.
+// Use environment variable TSUNIT_TSP_ITERATIONS to run the benchmark on
+// larger streams (iterations x 10,000 packets).
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(HandOff)
+{
+    ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_TSP_ITERATIONS");
+    const ts::PacketCounter packet_count = 10'000 * bench.iterations;
+    const ts::UString packets(ts::UString::Decimal(packet_count, 0, true, u""));
+
+    // Only collect stop events, they contain the number of packets which were processed by each plugin.
+    ts::TSProcessor::Criteria crit;
+    crit.event_code = TestPlugin::EVENT_STOP;
+
+    for (size_t chain : {2, 8, 32}) {
+        for (bool lock_free : {false, true}) {
+            ts::TSProcessorArgs opt;
+            opt.app_name = u"TSProcessorTest::testHandOff";
+            opt.lock_free = lock_free;
+            opt.input = {u"null", {packets}};
+            opt.plugins.resize(chain, {u"test1", {u"--count", packets}});
+            opt.output = {u"drop"};
+
+            // Use a private report: the error state of a shared one may be already set by another test.
+            ts::ReportBuffer<ts::ThreadSafety::Full> log;
+            TestEventHandler handler;
+            ts::TSProcessor tsproc(log);
+            tsproc.registerEventHandler(&handler, crit);
+
+            const auto start = std::chrono::steady_clock::now();
+            const bool started = tsproc.start(opt);
+            if (!started) {
+                debug() << "TSProcessorTest::testHandOff: " << log.messages() << std::endl;
+            }
+            TSUNIT_ASSERT(started);
+            tsproc.waitForTermination();
+            const auto duration = cn::duration_cast<cn::microseconds>(std::chrono::steady_clock::now() - start);
+
+            debug() << ts::UString::Format(u"TSProcessorTest::testHandOff: %d plugins, %s: %s packets in %'d us, %'d packets/s",
+                                           chain, lock_free ? u"lock-free" : u"global mutex", packets, duration.count(),
+                                           duration.count() == 0 ? 0 : (packet_count * 1'000'000) / duration.count())
+                    << std::endl;
+
+            // All plugins in the chain processed all packets.
+            TSUNIT_EQUAL(chain, handler.logs.size());
+            for (const auto& entry : handler.logs) {
+                TSUNIT_EQUAL(u"test1", entry.name);
+                TSUNIT_EQUAL(packet_count, entry.packets);
+            }
+        }
+    }
+}
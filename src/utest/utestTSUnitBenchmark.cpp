@@ -54,12 +54,18 @@ void utest::TSUnitBenchmark::stop()
 // Report acuumulated CPU time on utest debug output.
 //----------------------------------------------------------------------------
 
-void utest::TSUnitBenchmark::report(const ts::UString& test_name)
+void utest::TSUnitBenchmark::report(const ts::UString& test_name, uint64_t data_size)
 {
     if (_started) {
         // Restart to accumulate until now.
         stop();
         start();
     }
-    tsunit::Test::debug() << ts::UString::Format(u"%s: %'d sequences of %'d iterations, %'d ms", test_name, _sequences, iterations, _accumulated.count()) << std::endl;
+    ts::UString line(ts::UString::Format(u"%s: %'d sequences of %'d iterations, %'d ms", test_name, _sequences, iterations, _accumulated.count()));
+    if (data_size > 0 && _accumulated.count() > 0) {
+        // One byte per millisecond is 10^-6 GB/s.
+        const double gbps = double(data_size) * double(iterations) * double(_sequences) / double(_accumulated.count()) / 1.0e6;
+        line += ts::UString::Format(u", %.3f GB/s", gbps);
+    }
+    tsunit::Test::debug() << line << std::endl;
 }
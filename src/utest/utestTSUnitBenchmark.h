@@ -47,8 +47,16 @@ namespace utest {
         //!
         //! Report acuumulated CPU time on utest debug output.
         //! @param [in] test_name Test name.
+        //! @param [in] data_size Optional size in bytes of the data which are processed in each
+        //! iteration. When not zero, the throughput is also reported.
         //!
-        void report(const ts::UString& test_name);
+        void report(const ts::UString& test_name, uint64_t data_size = 0);
+
+        //!
+        //! Get the accumulated CPU time.
+        //! @return The accumulated CPU time of all start() / stop() sequences.
+        //!
+        cn::milliseconds cpuTime() const { return _accumulated; }
 
     private:
         bool             _started = false;
@@ -23,6 +23,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsThreadAttributes.h"
+#include "tsNUMA.h"
 #include "tsunit.h"
 
 
@@ -35,6 +36,7 @@ class ThreadAttributesTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(StackSize);
     TSUNIT_DECLARE_TEST(DeleteWhenTerminated);
     TSUNIT_DECLARE_TEST(Priority);
+    TSUNIT_DECLARE_TEST(Placement);
 };
 
 TSUNIT_REGISTER(ThreadAttributesTest);
@@ -87,3 +89,27 @@ TSUNIT_DEFINE_TEST(Priority)
     attr.setPriority (ts::ThreadAttributes::GetNormalPriority());
     TSUNIT_ASSERT(attr.getPriority() == ts::ThreadAttributes::GetNormalPriority());
 }
+
+TSUNIT_DEFINE_TEST(Placement)
+{
+    ts::ThreadAttributes attr;
+    TSUNIT_ASSERT(attr.getCPUs().empty()); // default value
+    TSUNIT_EQUAL(ts::NPOS, attr.getNUMANode()); // default value
+
+    TSUNIT_EQUAL(2, attr.setCPUs({0, 3}).getCPUs().size());
+    TSUNIT_ASSERT(attr.getCPUs().contains(3));
+    TSUNIT_EQUAL(1, attr.setNUMANode(1).getNUMANode());
+    TSUNIT_ASSERT(attr.setCPUs({}).getCPUs().empty());
+    TSUNIT_EQUAL(ts::NPOS, attr.setNUMANode(ts::NPOS).getNUMANode());
+
+    const size_t node_count = ts::NUMANodeCount();
+    debug() << "ThreadAttributesTest: NUMANodeCount() = " << node_count << std::endl;
+    TSUNIT_ASSUME(node_count >= 1);
+
+    std::set<size_t> cpus;
+    if (ts::GetNUMANodeCPUs(0, cpus)) {
+        debug() << "ThreadAttributesTest: CPUs in NUMA node 0: " << cpus.size() << std::endl;
+        TSUNIT_ASSERT(!cpus.empty());
+    }
+    TSUNIT_ASSERT(!ts::GetNUMANodeCPUs(node_count + 10, cpus));
+}